@@ -9,7 +9,8 @@ namespace Core {
 // Estructura interna para el contexto del analizador
 struct CSSParser::ParserContext {
     std::vector<StyleSheet> styleSheets;
-    std::unordered_map<void*, std::unordered_map<std::string, std::string>> elementStyles;
+    // Estilos por árbol (DOMTree::getId, que no se reutiliza como la dirección) y elemento
+    std::unordered_map<uint64_t, std::unordered_map<DOMTree::NodeHandle, std::unordered_map<std::string, std::string>>> elementStyles;
     
     ParserContext() {}
 };
@@ -52,45 +53,58 @@ void CSSParser::applyStyleSheet(const StyleSheet& styleSheet, DOMTree* domTree)
     if (!domTree) return;
     
     // Obtener el elemento raíz del documento
-    void* documentElement = domTree->getDocumentElement();
-    if (!documentElement) return;
+    DOMTree::NodeHandle documentElement = domTree->getDocumentElement();
+    if (documentElement == DOMTree::INVALID_NODE) return;
     
     // Aplicar cada regla a los elementos que coincidan con su selector
     for (const auto& rule : styleSheet.rules) {
         // Buscar elementos que coincidan con el selector
-        std::vector<void*> matchingElements;
+        std::vector<DOMTree::NodeHandle> matchingElements;
         
-        // Implementación simplificada: solo soportamos selectores de etiqueta básicos
+        // Implementación simplificada: solo soportamos selectores simples de
+        // etiqueta, ID y clase, resueltos con los índices del árbol
         if (rule.selector.front() != '.' && rule.selector.front() != '#') {
             // Selector de etiqueta
             matchingElements = domTree->getElementsByTagName(rule.selector);
         } else if (rule.selector.front() == '#') {
             // Selector de ID
-            void* element = domTree->getElementById(rule.selector.substr(1));
-            if (element) {
+            DOMTree::NodeHandle element = domTree->getElementById(rule.selector.substr(1));
+            if (element != DOMTree::INVALID_NODE) {
                 matchingElements.push_back(element);
             }
+        } else {
+            // Selector de clase
+            matchingElements = domTree->getElementsByClassName(rule.selector.substr(1));
         }
-        // Nota: Los selectores de clase y otros más complejos requerirían una implementación más sofisticada
+        // Nota: Los selectores compuestos y otros más complejos requerirían una implementación más sofisticada
         
         // Aplicar la regla a cada elemento coincidente
-        for (void* element : matchingElements) {
+        for (DOMTree::NodeHandle element : matchingElements) {
             applyRuleToElement(rule, element, domTree);
         }
     }
 }
 
-std::unordered_map<std::string, std::string> CSSParser::getComputedStyles(void* element) const {
-    if (!element) return {};
+std::unordered_map<std::string, std::string> CSSParser::getComputedStyles(const DOMTree* domTree, DOMTree::NodeHandle element) const {
+    if (!domTree || element == DOMTree::INVALID_NODE) return {};
     
-    auto it = m_context->elementStyles.find(element);
-    if (it != m_context->elementStyles.end()) {
+    auto treeIt = m_context->elementStyles.find(domTree->getId());
+    if (treeIt == m_context->elementStyles.end()) return {};
+    
+    auto it = treeIt->second.find(element);
+    if (it != treeIt->second.end()) {
         return it->second;
     }
     
     return {};
 }
 
+void CSSParser::releaseTree(const DOMTree* domTree) {
+    if (!domTree) return;
+    
+    m_context->elementStyles.erase(domTree->getId());
+}
+
 void CSSParser::parseRules(const std::string& css, StyleSheet& styleSheet) {
     // Implementación simplificada del análisis de reglas CSS
     // En una implementación real, se utilizaría un analizador más sofisticado
@@ -190,8 +204,8 @@ void CSSParser::parseDeclarations(const std::string& declarationsStr, std::unord
     }
 }
 
-bool CSSParser::selectorMatches(const std::string& selector, void* element, DOMTree* domTree) {
-    if (!element || !domTree) return false;
+bool CSSParser::selectorMatches(const std::string& selector, DOMTree::NodeHandle element, DOMTree* domTree) {
+    if (element == DOMTree::INVALID_NODE || !domTree) return false;
     
     // Implementación simplificada: solo soportamos selectores básicos
     
@@ -218,14 +232,14 @@ bool CSSParser::selectorMatches(const std::string& selector, void* element, DOMT
     return false;
 }
 
-void CSSParser::applyRuleToElement(const CSSRule& rule, void* element, DOMTree* domTree) {
-    if (!element || !domTree) return;
+void CSSParser::applyRuleToElement(const CSSRule& rule, DOMTree::NodeHandle element, DOMTree* domTree) {
+    if (element == DOMTree::INVALID_NODE || !domTree) return;
     
     // Verificar si el selector coincide con el elemento
     if (!selectorMatches(rule.selector, element, domTree)) return;
     
     // Aplicar las declaraciones al elemento
-    auto& elementStyle = m_context->elementStyles[element];
+    auto& elementStyle = m_context->elementStyles[domTree->getId()][element];
     for (const auto& declaration : rule.declarations) {
         elementStyle[declaration.first] = declaration.second;
     }
@@ -62,10 +62,19 @@ public:
 
     /**
      * @brief Obtiene los estilos computados para un elemento
+     * @param domTree Árbol DOM al que pertenece el elemento
      * @param element Elemento del que se obtendrán los estilos
      * @return Mapa de propiedades y valores de estilo
      */
-    std::unordered_map<std::string, std::string> getComputedStyles(void* element) const;
+    std::unordered_map<std::string, std::string> getComputedStyles(const DOMTree* domTree, DOMTree::NodeHandle element) const;
+
+    /**
+     * @brief Descarta los estilos aplicados a un árbol DOM
+     *
+     * Debe llamarse antes de destruir un árbol al que se aplicaron estilos.
+     * @param domTree Árbol DOM cuyos estilos se descartarán
+     */
+    void releaseTree(const DOMTree* domTree);
 
 private:
     // Estructuras internas para el análisis
@@ -75,8 +84,8 @@ private:
     // Métodos privados para el procesamiento interno
     void parseRules(const std::string& css, StyleSheet& styleSheet);
     void parseDeclarations(const std::string& declarationsStr, std::unordered_map<std::string, std::string>& declarations);
-    bool selectorMatches(const std::string& selector, void* element, DOMTree* domTree);
-    void applyRuleToElement(const CSSRule& rule, void* element, DOMTree* domTree);
+    bool selectorMatches(const std::string& selector, DOMTree::NodeHandle element, DOMTree* domTree);
+    void applyRuleToElement(const CSSRule& rule, DOMTree::NodeHandle element, DOMTree* domTree);
 };
 
 } // namespace Core
@@ -0,0 +1,185 @@
+#include "AtomTable.h"
+#include <algorithm>
+#include <mutex>
+
+namespace BlackWidow {
+namespace Core {
+
+namespace {
+
+// Vocabulario conocido de HTML: etiquetas y atributos habituales (en minúsculas)
+constexpr std::string_view KNOWN_NAMES[] = {
+    // Etiquetas
+    "a", "abbr", "address", "area", "article", "aside", "audio", "b", "base", "bdi", "bdo",
+    "blockquote", "body", "br", "button", "canvas", "caption", "center", "cite", "code", "col",
+    "colgroup", "data", "datalist", "dd", "del", "details", "dfn", "dialog", "div", "dl", "dt",
+    "em", "embed", "fieldset", "figcaption", "figure", "font", "footer", "form", "frame",
+    "frameset", "h1", "h2", "h3", "h4", "h5", "h6", "head", "header", "hgroup", "hr", "html",
+    "i", "iframe", "img", "input", "ins", "kbd", "label", "legend", "li", "link", "main", "map",
+    "mark", "marquee", "menu", "meta", "meter", "nav", "noembed", "noframes", "noscript",
+    "object", "ol", "optgroup", "option", "output", "p", "param", "picture", "pre", "progress",
+    "q", "rp", "rt", "ruby", "s", "samp", "script", "search", "section", "select", "slot",
+    "small", "source", "span", "strike", "strong", "style", "sub", "summary", "sup", "svg",
+    "table", "tbody", "td", "template", "textarea", "tfoot", "th", "thead", "time", "title",
+    "tr", "track", "tt", "u", "ul", "var", "video", "wbr", "xmp", "math", "path", "g", "use",
+    "circle", "rect", "line", "polygon", "polyline", "defs", "symbol", "#document",
+
+    // Atributos
+    "accept", "accept-charset", "accesskey", "action", "align", "allow", "allowfullscreen",
+    "alt", "as", "async", "autocapitalize", "autocomplete", "autofocus", "autoplay", "bgcolor",
+    "border", "charset", "checked", "class", "color", "cols", "colspan", "content",
+    "contenteditable", "controls", "coords", "crossorigin", "d", "datetime", "decoding",
+    "default", "defer", "dir", "dirname", "disabled", "download", "draggable", "enctype",
+    "enterkeyhint", "fill", "for", "formaction", "formenctype", "formmethod", "formnovalidate",
+    "formtarget", "headers", "height", "hidden", "high", "href", "hreflang", "http-equiv", "id",
+    "inert", "inputmode", "integrity", "is", "ismap", "itemprop", "itemscope", "itemtype",
+    "kind", "lang", "list", "loading", "loop", "low", "max", "maxlength", "media", "method",
+    "min", "minlength", "multiple", "muted", "name", "nomodule", "nonce", "novalidate", "onblur",
+    "onchange", "onclick", "onerror", "onfocus", "oninput", "onkeydown", "onkeyup", "onload",
+    "onmouseout", "onmouseover", "onsubmit", "open", "optimum", "pattern", "ping", "placeholder",
+    "playsinline", "poster", "preload", "property", "readonly", "referrerpolicy", "rel",
+    "required", "reversed", "role", "rows", "rowspan", "sandbox", "scope", "selected", "shape",
+    "size", "sizes", "spellcheck", "src", "srcdoc", "srclang", "srcset", "start", "step",
+    "stroke", "tabindex", "target", "translate", "type", "usemap", "value", "viewbox", "width",
+    "wrap", "xmlns", "aria-hidden", "aria-label", "aria-labelledby", "aria-describedby",
+    "aria-expanded", "aria-controls", "aria-current", "aria-haspopup", "data-id", "data-src",
+    "data-toggle", "data-target"
+};
+
+/**
+ * @brief Hash FNV-1a con semilla
+ */
+uint32_t hashName(std::string_view name, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    // Mezclar los bits altos para usar la máscara de las posiciones
+    hash ^= hash >> 15;
+    hash *= 0x2c1b3c6du;
+    hash ^= hash >> 12;
+    return hash;
+}
+
+} // namespace
+
+AtomTable& AtomTable::instance() {
+    static AtomTable table;
+    return table;
+}
+
+AtomTable::AtomTable() : m_slotMask(0), m_dynamicFull(false) {
+    // Los identificadores del vocabulario conocido son su posición (sin repetidos)
+    m_staticNames.push_back({});
+    for (std::string_view name : KNOWN_NAMES) {
+        if (std::find(m_staticNames.begin(), m_staticNames.end(), name) == m_staticNames.end()) {
+            m_staticNames.push_back(name);
+        }
+    }
+
+    // Hash perfecto por desplazamiento: cada nombre cae en un cubo según la
+    // semilla 0 y cada cubo busca la primera semilla que coloca todos sus
+    // nombres en posiciones libres. Los cubos grandes se colocan primero.
+    const uint32_t count = static_cast<uint32_t>(m_staticNames.size() - 1);
+    uint32_t slotCount = 1;
+    while (slotCount < count * 2) {
+        slotCount <<= 1;
+    }
+    m_slotMask = slotCount - 1;
+    m_slots.assign(slotCount, INVALID_ATOM);
+    m_displacements.assign(count, 0);
+
+    std::vector<std::vector<Atom>> buckets(count);
+    for (Atom atom = 1; atom <= count; ++atom) {
+        buckets[hashName(m_staticNames[atom], 0) % count].push_back(atom);
+    }
+
+    std::vector<uint32_t> order(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&buckets](uint32_t a, uint32_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    std::vector<uint32_t> taken;
+    for (uint32_t bucket : order) {
+        if (buckets[bucket].empty()) break;
+
+        for (uint32_t seed = 1;; ++seed) {
+            taken.clear();
+            bool placed = true;
+            for (Atom atom : buckets[bucket]) {
+                uint32_t slot = hashName(m_staticNames[atom], seed) & m_slotMask;
+                if (m_slots[slot] != INVALID_ATOM || std::find(taken.begin(), taken.end(), slot) != taken.end()) {
+                    placed = false;
+                    break;
+                }
+                taken.push_back(slot);
+            }
+
+            if (placed) {
+                for (size_t i = 0; i < taken.size(); ++i) {
+                    m_slots[taken[i]] = buckets[bucket][i];
+                }
+                m_displacements[bucket] = seed;
+                break;
+            }
+        }
+    }
+}
+
+Atom AtomTable::intern(std::string_view name) {
+    Atom atom = find(name);
+    if (atom != INVALID_ATOM || name.empty() || m_dynamicFull.load(std::memory_order_relaxed)) return atom;
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+    // Otro hilo pudo añadirlo mientras se esperaba el cerrojo
+    auto it = m_dynamicAtoms.find(name);
+    if (it != m_dynamicAtoms.end()) return it->second;
+    if (m_dynamicNames.size() >= MAX_DYNAMIC_NAMES) {
+        m_dynamicFull = true;
+        return INVALID_ATOM;
+    }
+
+    m_dynamicNames.emplace_back(name);
+    atom = static_cast<Atom>(m_staticNames.size() + m_dynamicNames.size() - 1);
+    m_dynamicAtoms.emplace(m_dynamicNames.back(), atom);
+    return atom;
+}
+
+Atom AtomTable::find(std::string_view name) const {
+    if (name.empty()) return INVALID_ATOM;
+
+    Atom atom = findStatic(name);
+    if (atom != INVALID_ATOM) return atom;
+
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_dynamicAtoms.find(name);
+    return it != m_dynamicAtoms.end() ? it->second : INVALID_ATOM;
+}
+
+std::string_view AtomTable::getName(Atom atom) const {
+    if (atom < m_staticNames.size()) return m_staticNames[atom];
+
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    size_t index = atom - m_staticNames.size();
+    return index < m_dynamicNames.size() ? std::string_view(m_dynamicNames[index]) : std::string_view();
+}
+
+size_t AtomTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_staticNames.size() - 1 + m_dynamicNames.size();
+}
+
+Atom AtomTable::findStatic(std::string_view name) const {
+    const uint32_t count = static_cast<uint32_t>(m_displacements.size());
+    uint32_t seed = m_displacements[hashName(name, 0) % count];
+    Atom atom = m_slots[hashName(name, seed) & m_slotMask];
+    return m_staticNames[atom] == name ? atom : INVALID_ATOM;
+}
+
+} // namespace Core
+} // namespace BlackWidow
@@ -0,0 +1,98 @@
+#ifndef BLACKWIDOW_ATOMTABLE_H
+#define BLACKWIDOW_ATOMTABLE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <atomic>
+#include <cstdint>
+
+namespace BlackWidow {
+namespace Core {
+
+// Identificador de un nombre de etiqueta o atributo (0 si no hay nombre)
+using Atom = uint32_t;
+constexpr Atom INVALID_ATOM = 0;
+
+/**
+ * @brief Tabla global de nombres de etiquetas y atributos
+ *
+ * Asigna a cada nombre un entero pequeño, de modo que los árboles DOM
+ * guardan y comparan enteros en lugar de cadenas. El vocabulario conocido
+ * de HTML se resuelve con un hash perfecto calculado al crear la tabla
+ * (sin colisiones ni cerrojos); los nombres desconocidos se añaden a una
+ * extensión dinámica protegida por un cerrojo de lectura/escritura y se
+ * conservan mientras dure el proceso.
+ *
+ * La extensión dinámica admite como mucho MAX_DYNAMIC_NAMES nombres, para
+ * que los documentos con nombres inventados no la hagan crecer sin límite;
+ * a partir de ahí intern() devuelve INVALID_ATOM y el árbol guarda el
+ * nombre como texto.
+ */
+class AtomTable {
+public:
+    // Nombres que se pueden añadir a la extensión dinámica
+    static constexpr size_t MAX_DYNAMIC_NAMES = 65536;
+
+    /**
+     * @brief Obtiene la tabla compartida por todos los árboles
+     * @return Tabla de nombres
+     */
+    static AtomTable& instance();
+
+    AtomTable(const AtomTable&) = delete;
+    AtomTable& operator=(const AtomTable&) = delete;
+
+    /**
+     * @brief Obtiene el identificador de un nombre, añadiéndolo si no existe
+     * @param name Nombre (se distinguen mayúsculas y minúsculas)
+     * @return Identificador del nombre (INVALID_ATOM si el nombre está vacío
+     *         o la extensión dinámica está llena)
+     */
+    Atom intern(std::string_view name);
+
+    /**
+     * @brief Busca el identificador de un nombre sin añadirlo
+     * @param name Nombre
+     * @return Identificador o INVALID_ATOM si el nombre no se ha visto nunca
+     */
+    Atom find(std::string_view name) const;
+
+    /**
+     * @brief Obtiene el nombre de un identificador
+     * @param atom Identificador
+     * @return Nombre (vacío si el identificador no existe)
+     */
+    std::string_view getName(Atom atom) const;
+
+    /**
+     * @brief Obtiene el número de nombres de la tabla
+     * @return Nombres conocidos más los añadidos
+     */
+    size_t size() const;
+
+private:
+    AtomTable();
+
+    Atom findStatic(std::string_view name) const;
+
+    // Vocabulario conocido: m_staticNames[atom], con la posición 0 sin usar
+    std::vector<std::string_view> m_staticNames;
+    std::vector<uint32_t> m_displacements;   // Semilla de cada cubo del hash perfecto
+    std::vector<Atom> m_slots;               // Posición del hash perfecto -> identificador
+    uint32_t m_slotMask;
+
+    // Extensión dinámica
+    mutable std::shared_mutex m_mutex;
+    std::deque<std::string> m_dynamicNames;               // No mueve los nombres al crecer
+    std::unordered_map<std::string_view, Atom> m_dynamicAtoms;
+    std::atomic<bool> m_dynamicFull;   // Llena: intern() ya no toma el cerrojo exclusivo
+};
+
+} // namespace Core
+} // namespace BlackWidow
+
+#endif // BLACKWIDOW_ATOMTABLE_H
@@ -0,0 +1,41 @@
+#include "DOMArena.h"
+#include <cstring>
+
+namespace BlackWidow {
+namespace Core {
+
+DOMArena::DOMArena(size_t blockSize)
+    : m_blockSize(blockSize)
+    , m_next(nullptr)
+    , m_remaining(0)
+    , m_reservedBytes(0) {
+}
+
+std::string_view DOMArena::store(std::string_view text) {
+    if (text.empty()) return {};
+
+    if (text.size() > m_remaining) {
+        if (text.size() > m_blockSize / 4) {
+            // Los textos grandes van en su propio bloque para no desperdiciar el actual
+            m_blocks.push_back(std::unique_ptr<char[]>(new char[text.size()]));
+            m_reservedBytes += text.size();
+            std::memcpy(m_blocks.back().get(), text.data(), text.size());
+            return std::string_view(m_blocks.back().get(), text.size());
+        }
+
+        // Sin inicializar: cada byte se escribe antes de leerlo
+        m_blocks.push_back(std::unique_ptr<char[]>(new char[m_blockSize]));
+        m_reservedBytes += m_blockSize;
+        m_next = m_blocks.back().get();
+        m_remaining = m_blockSize;
+    }
+
+    char* copy = m_next;
+    std::memcpy(copy, text.data(), text.size());
+    m_next += text.size();
+    m_remaining -= text.size();
+    return std::string_view(copy, text.size());
+}
+
+} // namespace Core
+} // namespace BlackWidow
@@ -0,0 +1,55 @@
+#ifndef BLACKWIDOW_DOMARENA_H
+#define BLACKWIDOW_DOMARENA_H
+
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace BlackWidow {
+namespace Core {
+
+/**
+ * @brief Almacén por bloques para los textos de un árbol DOM
+ *
+ * Copia cada texto a continuación del anterior dentro de bloques grandes,
+ * de modo que miles de nombres, atributos y textos cuestan unas pocas
+ * reservas de memoria y se liberan todos a la vez con el árbol. Lo que se
+ * sustituye no se libera hasta entonces.
+ */
+class DOMArena {
+public:
+    /**
+     * @brief Constructor
+     * @param blockSize Tamaño de cada bloque
+     */
+    explicit DOMArena(size_t blockSize = 64 * 1024);
+
+    DOMArena(const DOMArena&) = delete;
+    DOMArena& operator=(const DOMArena&) = delete;
+
+    /**
+     * @brief Copia un texto en el almacén
+     * @param text Texto a copiar
+     * @return Vista de la copia, válida mientras viva el almacén
+     */
+    std::string_view store(std::string_view text);
+
+    /**
+     * @brief Obtiene la memoria reservada por el almacén
+     * @return Bytes reservados en bloques
+     */
+    size_t getReservedBytes() const { return m_reservedBytes; }
+
+private:
+    size_t m_blockSize;
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char* m_next;          // Siguiente byte libre del bloque actual
+    size_t m_remaining;    // Bytes libres en el bloque actual
+    size_t m_reservedBytes;
+};
+
+} // namespace Core
+} // namespace BlackWidow
+
+#endif // BLACKWIDOW_DOMARENA_H
@@ -1,230 +1,472 @@
 #include "DOMTree.h"
 #include <algorithm>
-#include <queue>
+#include <atomic>
 
 namespace BlackWidow {
 namespace Core {
 
-DOMTree::DOMTree() {
+namespace {
+
+Atom idAtom() {
+    static const Atom atom = AtomTable::instance().intern("id");
+    return atom;
+}
+
+Atom classAtom() {
+    static const Atom atom = AtomTable::instance().intern("class");
+    return atom;
+}
+
+// Identificadores de árbol; empiezan en 1 y no se reutilizan
+std::atomic<uint64_t> nextTreeId{1};
+
+bool isClassSeparator(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\f' || c == '\r';
+}
+
+} // namespace
+
+DOMTree::DOMTree()
+    : m_nodeCount(0), m_attributeCount(0), m_id(nextTreeId.fetch_add(1, std::memory_order_relaxed)),
+      m_indexesBuilt(false), m_nextTreeOrder(1), m_treeOrderValid(true) {
+    // Reservar las posiciones 0, que representan "ningún nodo" y "ningún atributo"
+    createNode(NodeType::DOCUMENT_NODE);
+    createAttribute(INVALID_ATOM, {}, 0);
+
     // Crear el nodo documento raíz
-    m_document = std::make_unique<Node>(NodeType::DOCUMENT_NODE);
-    m_document->tagName = "#document";
+    m_document = createNode(NodeType::DOCUMENT_NODE);
+    nodeAt(m_document).tagName = AtomTable::instance().intern("#document");
+    nodeAt(m_document).treeOrder = m_nextTreeOrder++;
 }
 
 DOMTree::~DOMTree() {
-    // La limpieza se realiza automáticamente gracias a los smart pointers
-}
-
-void* DOMTree::createDocumentElement() {
-    return m_document.get();
-}
-
-void* DOMTree::createElement(const std::string& tagName) {
-    auto element = std::make_unique<Node>(NodeType::ELEMENT_NODE);
-    element->tagName = tagName;
-    
-    // Devolver el puntero al nodo, pero mantener la propiedad
-    Node* elementPtr = element.get();
-    
-    // Almacenar el elemento (se transferirá al padre cuando se llame a appendChild)
-    m_document->children.push_back(std::move(element));
-    
-    return elementPtr;
-}
-
-void* DOMTree::createTextNode(const std::string& text) {
-    auto textNode = std::make_unique<Node>(NodeType::TEXT_NODE);
-    textNode->textContent = text;
-    
-    // Devolver el puntero al nodo, pero mantener la propiedad
-    Node* textNodePtr = textNode.get();
-    
-    // Almacenar el nodo (se transferirá al padre cuando se llame a appendChild)
-    m_document->children.push_back(std::move(textNode));
-    
-    return textNodePtr;
-}
-
-void* DOMTree::createCommentNode(const std::string& comment) {
-    auto commentNode = std::make_unique<Node>(NodeType::COMMENT_NODE);
-    commentNode->textContent = comment;
-    
-    // Devolver el puntero al nodo, pero mantener la propiedad
-    Node* commentNodePtr = commentNode.get();
-    
-    // Almacenar el nodo (se transferirá al padre cuando se llame a appendChild)
-    m_document->children.push_back(std::move(commentNode));
-    
-    return commentNodePtr;
-}
-
-void DOMTree::appendChild(void* parent, void* child) {
-    if (!parent || !child) return;
-    
-    Node* parentNode = static_cast<Node*>(parent);
-    Node* childNode = static_cast<Node*>(child);
-    
-    // Buscar el nodo hijo en los hijos del documento
-    auto it = std::find_if(m_document->children.begin(), m_document->children.end(),
-                          [childNode](const std::unique_ptr<Node>& node) {
-                              return node.get() == childNode;
-                          });
-    
-    if (it != m_document->children.end()) {
-        // Transferir la propiedad del nodo hijo al padre
-        std::unique_ptr<Node> childPtr = std::move(*it);
-        m_document->children.erase(it);
-        
-        // Establecer el padre del nodo hijo
-        childPtr->parent = parentNode;
-        
-        // Agregar el nodo hijo a los hijos del padre
-        parentNode->children.push_back(std::move(childPtr));
-    }
-}
-
-void DOMTree::setAttribute(void* element, const std::string& name, const std::string& value) {
-    if (!element) return;
-    
-    Node* elementNode = static_cast<Node*>(element);
-    if (elementNode->type != NodeType::ELEMENT_NODE) return;
-    
-    elementNode->attributes[name] = value;
-}
-
-std::string DOMTree::getAttribute(void* element, const std::string& name) const {
-    if (!element) return "";
-    
-    Node* elementNode = static_cast<Node*>(element);
-    if (elementNode->type != NodeType::ELEMENT_NODE) return "";
-    
-    auto it = elementNode->attributes.find(name);
-    if (it != elementNode->attributes.end()) {
-        return it->second;
-    }
-    
-    return "";
+    // Los nodos, atributos y textos se liberan por bloques, sin recorrer el árbol
+}
+
+DOMTree::NodeHandle DOMTree::createDocumentElement() {
+    return m_document;
+}
+
+DOMTree::NodeHandle DOMTree::createElement(std::string_view tagName) {
+    NodeHandle element = createNode(NodeType::ELEMENT_NODE);
+    nodeAt(element).tagName = AtomTable::instance().intern(tagName);
+    if (nodeAt(element).tagName == INVALID_ATOM) {
+        nodeAt(element).textContent = m_arena.store(tagName);
+    }
+    return element;
+}
+
+DOMTree::NodeHandle DOMTree::createTextNode(std::string_view text) {
+    NodeHandle textNode = createNode(NodeType::TEXT_NODE);
+    nodeAt(textNode).textContent = m_arena.store(text);
+    return textNode;
+}
+
+DOMTree::NodeHandle DOMTree::createCommentNode(std::string_view comment) {
+    NodeHandle commentNode = createNode(NodeType::COMMENT_NODE);
+    nodeAt(commentNode).textContent = m_arena.store(comment);
+    return commentNode;
+}
+
+void DOMTree::appendChild(NodeHandle parent, NodeHandle child) {
+    if (!isValid(parent) || !isValid(child) || parent == child || child == m_document) return;
+
+    // No permitir que un nodo pase a ser descendiente de sí mismo
+    for (NodeHandle ancestor = nodeAt(parent).parent; ancestor != INVALID_NODE; ancestor = nodeAt(ancestor).parent) {
+        if (ancestor == child) return;
+    }
+
+    detach(child);
+    purgeIndexes();
+
+    // Enlazar el nodo al final de la lista de hijos del padre
+    Node& parentNode = nodeAt(parent);
+    Node& childNode = nodeAt(child);
+    childNode.parent = parent;
+    childNode.previousSibling = parentNode.lastChild;
+    if (parentNode.lastChild != INVALID_NODE) {
+        nodeAt(parentNode.lastChild).nextSibling = child;
+    } else {
+        parentNode.firstChild = child;
+    }
+    parentNode.lastChild = child;
+
+    if (isConnected(parent)) {
+        connectSubtree(child);
+    }
+}
+
+void DOMTree::setAttribute(NodeHandle element, std::string_view name, std::string_view value) {
+    if (!isValid(element)) return;
+    if (nodeAt(element).type != NodeType::ELEMENT_NODE) return;
+
+    if (name.empty()) return;
+    Atom atom = AtomTable::instance().intern(name);
+
+    // Sustituir el valor si el atributo ya existe
+    uint32_t index = findAttributeIndex(element, atom, name);
+
+    bool indexed = m_indexesBuilt && isConnected(element) && (atom == idAtom() || atom == classAtom());
+    if (index != 0) {
+        if (indexed) {
+            visitAttributeEntries(atom, attributeAt(index).value, [element](IndexEntry& entry) {
+                entry.nodes.erase(std::remove(entry.nodes.begin(), entry.nodes.end(), element), entry.nodes.end());
+            });
+        }
+        attributeAt(index).value = m_arena.store(value);
+    } else {
+        // Agregar el atributo al principio de la lista del elemento
+        index = createAttribute(atom, m_arena.store(value), nodeAt(element).firstAttribute);
+        nodeAt(element).firstAttribute = index;
+        if (atom == INVALID_ATOM) {
+            m_attributeNames.emplace(index, m_arena.store(name));
+        }
+    }
+
+    if (indexed) {
+        visitAttributeEntries(atom, attributeAt(index).value, [this, element](IndexEntry& entry) {
+            addToEntry(entry, element);
+        });
+    }
+}
+
+std::string DOMTree::getAttribute(NodeHandle element, std::string_view name) const {
+    if (!isValid(element) || name.empty()) return "";
+
+    uint32_t index = findAttributeIndex(element, AtomTable::instance().find(name), name);
+    return index != 0 ? std::string(attributeAt(index).value) : "";
+}
+
+std::string DOMTree::getTagName(NodeHandle element) const {
+    if (!isValid(element)) return "";
+    if (nodeAt(element).type != NodeType::ELEMENT_NODE) return "";
+
+    const Node& node = nodeAt(element);
+    return std::string(node.tagName != INVALID_ATOM ? AtomTable::instance().getName(node.tagName) : node.textContent);
 }
 
-std::string DOMTree::getTagName(void* element) const {
-    if (!element) return "";
-    
-    Node* elementNode = static_cast<Node*>(element);
-    if (elementNode->type != NodeType::ELEMENT_NODE) return "";
-    
-    return elementNode->tagName;
+Atom DOMTree::getTagAtom(NodeHandle element) const {
+    if (!isValid(element)) return INVALID_ATOM;
+    if (nodeAt(element).type != NodeType::ELEMENT_NODE) return INVALID_ATOM;
+
+    return nodeAt(element).tagName;
 }
 
-DOMTree::NodeType DOMTree::getNodeType(void* node) const {
-    if (!node) return NodeType::ELEMENT_NODE; // Valor predeterminado
-    
-    Node* domNode = static_cast<Node*>(node);
-    return domNode->type;
+DOMTree::NodeType DOMTree::getNodeType(NodeHandle node) const {
+    if (!isValid(node)) return NodeType::ELEMENT_NODE; // Valor predeterminado
+
+    return nodeAt(node).type;
 }
 
-std::string DOMTree::getTextContent(void* node) const {
-    if (!node) return "";
-    
-    Node* domNode = static_cast<Node*>(node);
-    
-    if (domNode->type == NodeType::TEXT_NODE || domNode->type == NodeType::COMMENT_NODE) {
-        return domNode->textContent;
-    } else if (domNode->type == NodeType::ELEMENT_NODE) {
-        // Para elementos, concatenar el contenido de texto de todos los nodos hijos
+std::string DOMTree::getTextContent(NodeHandle node) const {
+    if (!isValid(node)) return "";
+
+    const Node& domNode = nodeAt(node);
+
+    if (domNode.type == NodeType::TEXT_NODE || domNode.type == NodeType::COMMENT_NODE) {
+        return std::string(domNode.textContent);
+    } else if (domNode.type == NodeType::ELEMENT_NODE) {
+        // Para elementos, concatenar el contenido de todos los nodos de texto descendientes
         std::string result;
-        for (const auto& child : domNode->children) {
-            result += getTextContent(child.get());
+        for (NodeHandle current = nextInTree(node, node); current != INVALID_NODE; current = nextInTree(current, node)) {
+            if (nodeAt(current).type == NodeType::TEXT_NODE) {
+                result += nodeAt(current).textContent;
+            }
         }
         return result;
     }
-    
+
     return "";
 }
 
-void DOMTree::setTextContent(void* node, const std::string& text) {
-    if (!node) return;
-    
-    Node* domNode = static_cast<Node*>(node);
-    
-    if (domNode->type == NodeType::TEXT_NODE || domNode->type == NodeType::COMMENT_NODE) {
-        domNode->textContent = text;
-    } else if (domNode->type == NodeType::ELEMENT_NODE) {
-        // Para elementos, eliminar todos los nodos hijos y crear un nuevo nodo de texto
-        domNode->children.clear();
-        
+void DOMTree::setTextContent(NodeHandle node, std::string_view text) {
+    if (!isValid(node)) return;
+
+    Node& domNode = nodeAt(node);
+
+    if (domNode.type == NodeType::TEXT_NODE || domNode.type == NodeType::COMMENT_NODE) {
+        domNode.textContent = m_arena.store(text);
+    } else if (domNode.type == NodeType::ELEMENT_NODE) {
+        // Para elementos, desenlazar todos los nodos hijos y crear un nuevo nodo de texto
+        while (nodeAt(node).firstChild != INVALID_NODE) {
+            detach(nodeAt(node).firstChild);
+        }
+        purgeIndexes();
+
         if (!text.empty()) {
-            auto textNode = std::make_unique<Node>(NodeType::TEXT_NODE);
-            textNode->textContent = text;
-            textNode->parent = domNode;
-            domNode->children.push_back(std::move(textNode));
+            appendChild(node, createTextNode(text));
         }
     }
 }
 
-void* DOMTree::getDocumentElement() const {
-    return m_document.get();
+DOMTree::NodeHandle DOMTree::getDocumentElement() const {
+    return m_document;
 }
 
-std::vector<void*> DOMTree::getElementsByTagName(const std::string& tagName) const {
-    std::vector<void*> result;
-    collectElementsByTagName(m_document.get(), tagName, result);
-    return result;
+DOMTree::NodeHandle DOMTree::getParentNode(NodeHandle node) const {
+    return isValid(node) ? nodeAt(node).parent : INVALID_NODE;
+}
+
+DOMTree::NodeHandle DOMTree::getFirstChild(NodeHandle node) const {
+    return isValid(node) ? nodeAt(node).firstChild : INVALID_NODE;
 }
 
-void* DOMTree::getElementById(const std::string& id) const {
-    return findElementById(m_document.get(), id);
+DOMTree::NodeHandle DOMTree::getNextSibling(NodeHandle node) const {
+    return isValid(node) ? nodeAt(node).nextSibling : INVALID_NODE;
 }
 
-void DOMTree::collectElementsByTagName(Node* node, const std::string& tagName, std::vector<void*>& result) const {
-    if (!node) return;
-    
-    // Buscar en todos los nodos usando BFS (Breadth-First Search)
-    std::queue<Node*> queue;
-    queue.push(node);
-    
-    while (!queue.empty()) {
-        Node* current = queue.front();
-        queue.pop();
-        
-        if (current->type == NodeType::ELEMENT_NODE) {
-            if (tagName == "*" || current->tagName == tagName) {
+std::vector<DOMTree::NodeHandle> DOMTree::getElementsByTagName(const std::string& tagName) const {
+    std::vector<NodeHandle> result;
+
+    if (tagName == "*") {
+        // Todos los elementos: recorrer los descendientes del documento en orden
+        for (NodeHandle current = nextInTree(m_document, m_document); current != INVALID_NODE;
+             current = nextInTree(current, m_document)) {
+            if (nodeAt(current).type == NodeType::ELEMENT_NODE) {
                 result.push_back(current);
             }
-            
-            // Agregar los hijos a la cola
-            for (const auto& child : current->children) {
-                queue.push(child.get());
-            }
         }
+        return result;
     }
+
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    buildIndexes();
+    Atom atom = AtomTable::instance().find(tagName);
+    auto it = m_tagIndex.find(atom);
+    if (it == m_tagIndex.end() || tagName.empty()) {
+        return result;
+    }
+
+    result = sortedNodes(it->second);
+    if (atom == INVALID_ATOM) {
+        // Los elementos sin átomo comparten la entrada INVALID_ATOM del índice
+        std::erase_if(result, [this, &tagName](NodeHandle element) { return nodeAt(element).textContent != tagName; });
+    }
+    return result;
 }
 
-void* DOMTree::findElementById(Node* node, const std::string& id) const {
-    if (!node) return nullptr;
-    
-    // Buscar en todos los nodos usando BFS (Breadth-First Search)
-    std::queue<Node*> queue;
-    queue.push(node);
-    
-    while (!queue.empty()) {
-        Node* current = queue.front();
-        queue.pop();
-        
-        if (current->type == NodeType::ELEMENT_NODE) {
-            auto it = current->attributes.find("id");
-            if (it != current->attributes.end() && it->second == id) {
-                return current;
-            }
-            
-            // Agregar los hijos a la cola
-            for (const auto& child : current->children) {
-                queue.push(child.get());
+std::vector<DOMTree::NodeHandle> DOMTree::getElementsByClassName(const std::string& className) const {
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    buildIndexes();
+    auto it = m_classIndex.find(className);
+    return it != m_classIndex.end() ? sortedNodes(it->second) : std::vector<NodeHandle>();
+}
+
+DOMTree::NodeHandle DOMTree::getElementById(const std::string& id) const {
+    // Si varios elementos comparten id se devuelve el primero del documento
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    buildIndexes();
+    auto it = m_idIndex.find(id);
+    if (it == m_idIndex.end() || it->second.nodes.empty()) return INVALID_NODE;
+
+    return sortedNodes(it->second).front();
+}
+
+DOMTree::NodeHandle DOMTree::createNode(NodeType type) {
+    if ((m_nodeCount & (BLOCK_SIZE - 1)) == 0) {
+        m_nodeBlocks.push_back(std::unique_ptr<Node[]>(new Node[BLOCK_SIZE]));
+    }
+
+    NodeHandle handle = m_nodeCount++;
+    nodeAt(handle) = Node{type, INVALID_ATOM, {}, INVALID_NODE, INVALID_NODE, INVALID_NODE, INVALID_NODE, INVALID_NODE, 0, 0};
+    return handle;
+}
+
+uint32_t DOMTree::createAttribute(Atom name, std::string_view value, uint32_t next) {
+    if ((m_attributeCount & (BLOCK_SIZE - 1)) == 0) {
+        m_attributeBlocks.push_back(std::unique_ptr<Attribute[]>(new Attribute[BLOCK_SIZE]));
+    }
+
+    uint32_t index = m_attributeCount++;
+    attributeAt(index) = Attribute{value, name, next};
+    return index;
+}
+
+bool DOMTree::isValid(NodeHandle handle) const {
+    return handle != INVALID_NODE && handle < m_nodeCount;
+}
+
+void DOMTree::detach(NodeHandle node) {
+    Node& domNode = nodeAt(node);
+    if (domNode.parent == INVALID_NODE) return;
+
+    Node& parentNode = nodeAt(domNode.parent);
+    if (domNode.previousSibling != INVALID_NODE) {
+        nodeAt(domNode.previousSibling).nextSibling = domNode.nextSibling;
+    } else {
+        parentNode.firstChild = domNode.nextSibling;
+    }
+    if (domNode.nextSibling != INVALID_NODE) {
+        nodeAt(domNode.nextSibling).previousSibling = domNode.previousSibling;
+    } else {
+        parentNode.lastChild = domNode.previousSibling;
+    }
+
+    domNode.parent = INVALID_NODE;
+    domNode.previousSibling = INVALID_NODE;
+    domNode.nextSibling = INVALID_NODE;
+
+    if (isConnected(node)) {
+        disconnectSubtree(node);
+    }
+}
+
+DOMTree::NodeHandle DOMTree::nextInTree(NodeHandle node, NodeHandle root) const {
+    // Recorrido en preorden sin pila: primero los hijos, después los hermanos
+    // del nodo o del ancestro más cercano que los tenga, sin salir de root
+    if (nodeAt(node).firstChild != INVALID_NODE) {
+        return nodeAt(node).firstChild;
+    }
+    while (node != root) {
+        if (nodeAt(node).nextSibling != INVALID_NODE) {
+            return nodeAt(node).nextSibling;
+        }
+        node = nodeAt(node).parent;
+    }
+    return INVALID_NODE;
+}
+
+uint32_t DOMTree::findAttributeIndex(NodeHandle element, Atom atom, std::string_view name) const {
+    if (nodeAt(element).type != NodeType::ELEMENT_NODE) return 0;
+
+    for (uint32_t index = nodeAt(element).firstAttribute; index != 0; index = attributeAt(index).next) {
+        if (attributeAt(index).name != atom) continue;
+        // Sin átomo hay que comparar el nombre guardado
+        if (atom != INVALID_ATOM || m_attributeNames.at(index) == name) {
+            return index;
+        }
+    }
+    return 0;
+}
+
+void DOMTree::connectSubtree(NodeHandle root) {
+    // Si root queda al final del documento, los nuevos nodos siguen a todos
+    // los conectados y basta con seguir numerando; si no, el orden se
+    // recalcula en la siguiente consulta que lo necesite
+    for (NodeHandle ancestor = root; ancestor != m_document; ancestor = nodeAt(ancestor).parent) {
+        if (nodeAt(ancestor).nextSibling != INVALID_NODE) {
+            m_treeOrderValid = false;
+            break;
+        }
+    }
+
+    for (NodeHandle current = root; current != INVALID_NODE; current = nextInTree(current, root)) {
+        nodeAt(current).treeOrder = m_nextTreeOrder++;
+        if (m_indexesBuilt) {
+            indexElement(current);
+        }
+    }
+}
+
+void DOMTree::disconnectSubtree(NodeHandle root) {
+    // Los nodos se quitan de los índices más tarde (purgeIndexes), recorriendo
+    // una sola vez cada lista afectada aunque se desconecten muchos nodos
+    const std::function<void(IndexEntry&)> schedule = [this](IndexEntry& entry) { schedulePurge(entry); };
+
+    for (NodeHandle current = root; current != INVALID_NODE; current = nextInTree(current, root)) {
+        Node& node = nodeAt(current);
+        node.treeOrder = 0;
+        if (!m_indexesBuilt || node.type != NodeType::ELEMENT_NODE) continue;
+
+        schedulePurge(m_tagIndex[node.tagName]);
+        for (uint32_t index = node.firstAttribute; index != 0; index = attributeAt(index).next) {
+            visitAttributeEntries(attributeAt(index).name, attributeAt(index).value, schedule);
+        }
+    }
+}
+
+void DOMTree::buildIndexes() const {
+    if (m_indexesBuilt) return;
+
+    // Los nodos se recorren (y se numeran) en orden del documento, así que
+    // las listas quedan ordenadas
+    m_nextTreeOrder = 1;
+    m_treeOrderValid = true;
+    for (NodeHandle current = m_document; current != INVALID_NODE; current = nextInTree(current, m_document)) {
+        nodeAt(current).treeOrder = m_nextTreeOrder++;
+        indexElement(current);
+    }
+    m_indexesBuilt = true;
+}
+
+void DOMTree::indexElement(NodeHandle element) const {
+    const Node& node = nodeAt(element);
+    if (node.type != NodeType::ELEMENT_NODE) return;
+
+    addToEntry(m_tagIndex[node.tagName], element);
+    for (uint32_t index = node.firstAttribute; index != 0; index = attributeAt(index).next) {
+        visitAttributeEntries(attributeAt(index).name, attributeAt(index).value, [this, element](IndexEntry& entry) {
+            addToEntry(entry, element);
+        });
+    }
+}
+
+void DOMTree::visitAttributeEntries(Atom name, std::string_view value, const std::function<void(IndexEntry&)>& visit) const {
+    if (name == idAtom()) {
+        if (!value.empty()) {
+            visit(m_idIndex[value]);
+        }
+    } else if (name == classAtom()) {
+        // El atributo class es una lista de nombres separados por espacios
+        size_t position = 0;
+        while (position < value.size()) {
+            while (position < value.size() && isClassSeparator(value[position])) ++position;
+            size_t start = position;
+            while (position < value.size() && !isClassSeparator(value[position])) ++position;
+            if (position > start) {
+                visit(m_classIndex[value.substr(start, position - start)]);
             }
         }
     }
-    
-    return nullptr;
+}
+
+void DOMTree::addToEntry(IndexEntry& entry, NodeHandle element) const {
+    // Una clase repetida en el mismo atributo se registra una sola vez
+    if (!entry.nodes.empty() && entry.nodes.back() == element) return;
+
+    if (!entry.nodes.empty() && (!m_treeOrderValid || nodeAt(entry.nodes.back()).treeOrder > nodeAt(element).treeOrder)) {
+        entry.sorted = false;
+    }
+    entry.nodes.push_back(element);
+}
+
+void DOMTree::schedulePurge(IndexEntry& entry) const {
+    if (entry.pendingPurge) return;
+
+    entry.pendingPurge = true;
+    m_pendingPurges.push_back(&entry);
+}
+
+void DOMTree::purgeIndexes() {
+    // Los valores de unordered_map no se mueven al insertar, así que los
+    // punteros pendientes siguen siendo válidos
+    for (IndexEntry* entry : m_pendingPurges) {
+        entry->nodes.erase(std::remove_if(entry->nodes.begin(), entry->nodes.end(),
+                                          [this](NodeHandle element) { return !isConnected(element); }),
+                           entry->nodes.end());
+        entry->pendingPurge = false;
+    }
+    m_pendingPurges.clear();
+}
+
+const std::vector<DOMTree::NodeHandle>& DOMTree::sortedNodes(IndexEntry& entry) const {
+    if (entry.sorted) return entry.nodes;
+
+    if (!m_treeOrderValid) {
+        // Renumerar los nodos conectados en orden del documento
+        m_nextTreeOrder = 1;
+        for (NodeHandle current = m_document; current != INVALID_NODE; current = nextInTree(current, m_document)) {
+            nodeAt(current).treeOrder = m_nextTreeOrder++;
+        }
+        m_treeOrderValid = true;
+    }
+
+    std::sort(entry.nodes.begin(), entry.nodes.end(), [this](NodeHandle a, NodeHandle b) {
+        return nodeAt(a).treeOrder < nodeAt(b).treeOrder;
+    });
+    entry.sorted = true;
+    return entry.nodes;
 }
 
 } // namespace Core
-} // namespace BlackWidow
\ No newline at end of file
+} // namespace BlackWidow
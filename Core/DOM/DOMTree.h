@@ -2,18 +2,45 @@
 #define BLACKWIDOW_DOMTREE_H
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
 #include <memory>
+#include <functional>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include "DOMArena.h"
+#include "AtomTable.h"
 
 namespace BlackWidow {
 namespace Core {
 
 /**
  * @brief Árbol de Modelo de Objetos del Documento (DOM)
- * 
+ *
  * Esta clase implementa un árbol DOM que representa la estructura
  * de un documento HTML, permitiendo su manipulación y consulta.
+ *
+ * Los nodos se guardan seguidos en bloques propios del árbol y se
+ * identifican por su índice (NodeHandle), enlazados por primer hijo y
+ * hermano siguiente; los textos se copian en un DOMArena y los nombres de
+ * etiquetas y atributos se guardan como identificadores de la AtomTable
+ * global, que se comparan como enteros (si la tabla está llena, el nombre
+ * se copia como texto en el árbol). Crear un nodo no
+ * reserva memoria propia y destruir el documento libera unos pocos bloques
+ * independientemente del número de nodos. Los nodos que se descartan
+ * (por ejemplo con setTextContent) no se reutilizan hasta destruir el árbol.
+ *
+ * Los elementos conectados al documento se registran en índices por
+ * etiqueta, id y clase. Los índices se construyen en la primera búsqueda
+ * (analizar un documento que nunca se consulta no los paga) y desde
+ * entonces se actualizan al agregar, mover o quitar nodos y al cambiar
+ * los atributos id y class, de modo que las búsquedas no recorren el árbol.
+ *
+ * Hilos: los métodos const se pueden llamar a la vez desde varios hilos
+ * mientras ninguno modifique el árbol; las búsquedas construyen y ordenan
+ * los índices bajo un mutex propio. Los métodos que modifican el árbol
+ * necesitan acceso exclusivo.
  */
 class DOMTree {
 public:
@@ -24,55 +51,52 @@ public:
         COMMENT_NODE = 8,
         DOCUMENT_NODE = 9
     };
-    
-    // Estructura para representar un nodo DOM
-    struct Node {
-        NodeType type;
-        std::string tagName;  // Para elementos
-        std::string textContent;  // Para texto y comentarios
-        std::unordered_map<std::string, std::string> attributes;
-        std::vector<std::unique_ptr<Node>> children;
-        Node* parent;
-        
-        Node(NodeType nodeType) : type(nodeType), parent(nullptr) {}
-    };
+
+    // Identificador de un nodo dentro de su árbol
+    using NodeHandle = uint32_t;
+    static constexpr NodeHandle INVALID_NODE = 0;
 
     DOMTree();
     ~DOMTree();
 
+    DOMTree(const DOMTree&) = delete;
+    DOMTree& operator=(const DOMTree&) = delete;
+
     /**
      * @brief Crea el elemento raíz del documento
-     * @return Puntero al elemento documento
+     * @return Identificador del elemento documento
      */
-    void* createDocumentElement();
+    NodeHandle createDocumentElement();
 
     /**
      * @brief Crea un elemento con la etiqueta especificada
      * @param tagName Nombre de la etiqueta
-     * @return Puntero al elemento creado
+     * @return Identificador del elemento creado
      */
-    void* createElement(const std::string& tagName);
+    NodeHandle createElement(std::string_view tagName);
 
     /**
      * @brief Crea un nodo de texto
      * @param text Contenido del texto
-     * @return Puntero al nodo de texto creado
+     * @return Identificador del nodo de texto creado
      */
-    void* createTextNode(const std::string& text);
+    NodeHandle createTextNode(std::string_view text);
 
     /**
      * @brief Crea un nodo de comentario
      * @param comment Contenido del comentario
-     * @return Puntero al nodo de comentario creado
+     * @return Identificador del nodo de comentario creado
      */
-    void* createCommentNode(const std::string& comment);
+    NodeHandle createCommentNode(std::string_view comment);
 
     /**
      * @brief Agrega un nodo hijo a un elemento padre
+     *
+     * Si el nodo ya tenía padre, se mueve.
      * @param parent Elemento padre
      * @param child Nodo hijo a agregar
      */
-    void appendChild(void* parent, void* child);
+    void appendChild(NodeHandle parent, NodeHandle child);
 
     /**
      * @brief Establece un atributo en un elemento
@@ -80,7 +104,7 @@ public:
      * @param name Nombre del atributo
      * @param value Valor del atributo
      */
-    void setAttribute(void* element, const std::string& name, const std::string& value);
+    void setAttribute(NodeHandle element, std::string_view name, std::string_view value);
 
     /**
      * @brief Obtiene el valor de un atributo de un elemento
@@ -88,65 +112,191 @@ public:
      * @param name Nombre del atributo
      * @return Valor del atributo o cadena vacía si no existe
      */
-    std::string getAttribute(void* element, const std::string& name) const;
+    std::string getAttribute(NodeHandle element, std::string_view name) const;
 
     /**
      * @brief Obtiene el nombre de la etiqueta de un elemento
      * @param element Elemento del que se obtendrá el nombre
      * @return Nombre de la etiqueta
      */
-    std::string getTagName(void* element) const;
+    std::string getTagName(NodeHandle element) const;
+
+    /**
+     * @brief Obtiene el identificador del nombre de la etiqueta de un elemento
+     * @param element Elemento
+     * @return Identificador en la AtomTable (INVALID_ATOM si no es un elemento)
+     */
+    Atom getTagAtom(NodeHandle element) const;
 
     /**
      * @brief Obtiene el tipo de un nodo
      * @param node Nodo del que se obtendrá el tipo
      * @return Tipo del nodo
      */
-    NodeType getNodeType(void* node) const;
+    NodeType getNodeType(NodeHandle node) const;
 
     /**
      * @brief Obtiene el contenido de texto de un nodo
      * @param node Nodo del que se obtendrá el texto
      * @return Contenido de texto
      */
-    std::string getTextContent(void* node) const;
+    std::string getTextContent(NodeHandle node) const;
 
     /**
      * @brief Establece el contenido de texto de un nodo
      * @param node Nodo al que se le asignará el texto
      * @param text Contenido de texto
      */
-    void setTextContent(void* node, const std::string& text);
+    void setTextContent(NodeHandle node, std::string_view text);
 
     /**
      * @brief Obtiene el elemento raíz del documento
-     * @return Puntero al elemento documento
+     * @return Identificador del elemento documento
      */
-    void* getDocumentElement() const;
+    NodeHandle getDocumentElement() const;
+
+    /**
+     * @brief Obtiene el padre de un nodo
+     * @param node Nodo
+     * @return Padre o INVALID_NODE si no tiene
+     */
+    NodeHandle getParentNode(NodeHandle node) const;
+
+    /**
+     * @brief Obtiene el primer hijo de un nodo
+     * @param node Nodo
+     * @return Primer hijo o INVALID_NODE si no tiene
+     */
+    NodeHandle getFirstChild(NodeHandle node) const;
+
+    /**
+     * @brief Obtiene el hermano siguiente de un nodo
+     * @param node Nodo
+     * @return Hermano siguiente o INVALID_NODE si es el último
+     */
+    NodeHandle getNextSibling(NodeHandle node) const;
 
     /**
      * @brief Busca elementos por etiqueta
-     * @param tagName Nombre de la etiqueta a buscar
-     * @return Vector de punteros a los elementos encontrados
+     * @param tagName Nombre de la etiqueta a buscar ("*" para todos)
+     * @return Elementos encontrados, en orden del documento
+     */
+    std::vector<NodeHandle> getElementsByTagName(const std::string& tagName) const;
+
+    /**
+     * @brief Busca elementos por clase
+     * @param className Nombre de una de las clases del atributo class
+     * @return Elementos encontrados, en orden del documento
      */
-    std::vector<void*> getElementsByTagName(const std::string& tagName) const;
+    std::vector<NodeHandle> getElementsByClassName(const std::string& className) const;
 
     /**
      * @brief Busca un elemento por ID
      * @param id Valor del atributo id a buscar
-     * @return Puntero al elemento encontrado o nullptr si no existe
+     * @return Elemento encontrado o INVALID_NODE si no existe
+     */
+    NodeHandle getElementById(const std::string& id) const;
+
+    /**
+     * @brief Obtiene el número de nodos creados en el árbol
+     * @return Nodos creados, incluidos el documento y los descartados
      */
-    void* getElementById(const std::string& id) const;
+    size_t getNodeCount() const { return m_nodeCount - 1; }
+
+    /**
+     * @brief Obtiene el identificador del árbol
+     *
+     * Es único en el proceso y no se reutiliza al destruir el árbol, a
+     * diferencia de su dirección; sirve para asociar datos externos a un
+     * árbol junto con los NodeHandle, que solo son únicos dentro de él.
+     * @return Identificador del árbol
+     */
+    uint64_t getId() const { return m_id; }
 
 private:
-    std::unique_ptr<Node> m_document;
-    
+    // Nodo DOM; los textos apuntan al almacén del árbol
+    struct Node {
+        NodeType type;
+        Atom tagName;                  // Para elementos
+        std::string_view textContent;  // Para texto y comentarios; en elementos sin átomo, el nombre
+        NodeHandle parent;
+        NodeHandle firstChild;
+        NodeHandle lastChild;
+        NodeHandle previousSibling;
+        NodeHandle nextSibling;
+        uint32_t firstAttribute;       // Índice del primer atributo (0 si no tiene)
+        mutable uint32_t treeOrder;    // Orden en el documento (0 si no está conectado)
+    };
+
+    // Atributo de un elemento, enlazado con el siguiente del mismo elemento;
+    // si el nombre no tiene átomo, name es INVALID_ATOM y el nombre está en
+    // m_attributeNames
+    struct Attribute {
+        std::string_view value;
+        Atom name;
+        uint32_t next;
+    };
+
+    // Elementos conectados con una misma etiqueta, id o clase
+    struct IndexEntry {
+        std::vector<NodeHandle> nodes;
+        bool sorted = true;            // Los nodos están en orden del documento
+        bool pendingPurge = false;     // Tiene nodos desconectados por quitar
+    };
+
+    // Los nodos y atributos se reservan en bloques que no se mueven al crecer;
+    // el identificador indica el bloque (bits altos) y la posición en él
+    static constexpr uint32_t BLOCK_SHIFT = 12;
+    static constexpr uint32_t BLOCK_SIZE = 1u << BLOCK_SHIFT;
+
+    std::vector<std::unique_ptr<Node[]>> m_nodeBlocks;
+    std::vector<std::unique_ptr<Attribute[]>> m_attributeBlocks;
+    uint32_t m_nodeCount;         // La posición 0 no se usa (INVALID_NODE)
+    uint32_t m_attributeCount;    // La posición 0 no se usa
+    DOMArena m_arena;
+    NodeHandle m_document;
+    uint64_t m_id;
+
+    // Nombres de los atributos sin átomo (AtomTable llena), por índice
+    std::unordered_map<uint32_t, std::string_view> m_attributeNames;
+
+    // Índices de los elementos conectados; las claves de id y clase apuntan
+    // a los valores de los atributos guardados en m_arena. Son mutables
+    // porque las búsquedas los construyen y los ordenan cuando hace falta,
+    // con m_indexMutex tomado (junto con los treeOrder que renumeran).
+    mutable std::mutex m_indexMutex;
+    mutable std::unordered_map<Atom, IndexEntry> m_tagIndex;
+    mutable std::unordered_map<std::string_view, IndexEntry> m_idIndex;
+    mutable std::unordered_map<std::string_view, IndexEntry> m_classIndex;
+    mutable std::vector<IndexEntry*> m_pendingPurges;
+    mutable bool m_indexesBuilt;
+    mutable uint32_t m_nextTreeOrder;
+    mutable bool m_treeOrderValid;   // Los treeOrder siguen el orden del documento
+
     // Métodos auxiliares
-    void collectElementsByTagName(Node* node, const std::string& tagName, std::vector<void*>& result) const;
-    void* findElementById(Node* node, const std::string& id) const;
+    Node& nodeAt(NodeHandle handle) { return m_nodeBlocks[handle >> BLOCK_SHIFT][handle & (BLOCK_SIZE - 1)]; }
+    const Node& nodeAt(NodeHandle handle) const { return m_nodeBlocks[handle >> BLOCK_SHIFT][handle & (BLOCK_SIZE - 1)]; }
+    Attribute& attributeAt(uint32_t index) { return m_attributeBlocks[index >> BLOCK_SHIFT][index & (BLOCK_SIZE - 1)]; }
+    const Attribute& attributeAt(uint32_t index) const { return m_attributeBlocks[index >> BLOCK_SHIFT][index & (BLOCK_SIZE - 1)]; }
+    NodeHandle createNode(NodeType type);
+    uint32_t createAttribute(Atom name, std::string_view value, uint32_t next);
+    bool isValid(NodeHandle node) const;
+    void detach(NodeHandle node);
+    NodeHandle nextInTree(NodeHandle node, NodeHandle root) const;
+    uint32_t findAttributeIndex(NodeHandle element, Atom atom, std::string_view name) const;
+    bool isConnected(NodeHandle node) const { return nodeAt(node).treeOrder != 0; }
+    void connectSubtree(NodeHandle root);
+    void disconnectSubtree(NodeHandle root);
+    void buildIndexes() const;
+    void indexElement(NodeHandle element) const;
+    void visitAttributeEntries(Atom name, std::string_view value, const std::function<void(IndexEntry&)>& visit) const;
+    void addToEntry(IndexEntry& entry, NodeHandle element) const;
+    void schedulePurge(IndexEntry& entry) const;
+    void purgeIndexes();
+    const std::vector<NodeHandle>& sortedNodes(IndexEntry& entry) const;
 };
 
 } // namespace Core
 } // namespace BlackWidow
 
-#endif // BLACKWIDOW_DOMTREE_H
\ No newline at end of file
+#endif // BLACKWIDOW_DOMTREE_H
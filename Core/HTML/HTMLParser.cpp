@@ -1,23 +1,76 @@
 #include "HTMLParser.h"
-#include <sstream>
-#include <stack>
-#include <unordered_map>
 #include <algorithm>
+#include <sstream>
 
 namespace BlackWidow {
 namespace Core {
 
+namespace {
+
+// Elementos que no tienen etiqueta de cierre
+constexpr std::string_view VOID_ELEMENTS[] = {
+    "area", "base", "br", "col", "embed", "hr", "img", "input",
+    "link", "meta", "param", "source", "track", "wbr"
+};
+
+/**
+ * @brief Obtiene un nombre de etiqueta o atributo en minúsculas
+ *
+ * Los nombres que ya están en minúsculas (casi todos) se devuelven tal cual;
+ * el resto se copia en buffer, que se reutiliza entre llamadas. La vista
+ * devuelta deja de ser válida en la siguiente llamada con el mismo buffer.
+ */
+std::string_view toLowerName(std::string_view name, std::string& buffer) {
+    auto isUpper = [](char c) { return c >= 'A' && c <= 'Z'; };
+    if (std::none_of(name.begin(), name.end(), isUpper)) {
+        return name;
+    }
+    buffer.assign(name);
+    for (char& c : buffer) {
+        if (isUpper(c)) c = static_cast<char>(c + ('a' - 'A'));
+    }
+    return buffer;
+}
+
+bool isVoidElement(Atom tag) {
+    static const std::vector<Atom> voidAtoms = [] {
+        std::vector<Atom> atoms;
+        for (std::string_view element : VOID_ELEMENTS) {
+            atoms.push_back(AtomTable::instance().intern(element));
+        }
+        return atoms;
+    }();
+    
+    for (Atom element : voidAtoms) {
+        if (tag == element) return true;
+    }
+    return false;
+}
+
+} // namespace
+
 // Estructura interna para el contexto del analizador
 struct HTMLParser::ParserContext {
-    std::vector<std::string> tokens;
-    std::stack<void*> elementStack;
-    std::unique_ptr<DOMTree> domTree;
+    // Elemento abierto junto con su etiqueta, para cerrar sin consultar el árbol
+    struct OpenElement {
+        DOMTree::NodeHandle element;
+        Atom tagName;
+    };
+
+    HTMLTokenizer tokenizer;
+    std::vector<OpenElement> elementStack;
+    std::unique_ptr<DOMTree> ownedTree;   // Vacío al analizar un fragmento de un árbol ajeno
+    DOMTree* domTree;
     std::string baseUrl;
-    
-    ParserContext() : domTree(std::make_unique<DOMTree>()) {}
+    std::string nameBuffer;   // Reutilizado por toLowerName
+
+    explicit ParserContext(HTMLParser* parser)
+        : tokenizer([parser](const HTMLToken& token) { parser->processToken(token); })
+        , ownedTree(std::make_unique<DOMTree>())
+        , domTree(ownedTree.get()) {}
 };
 
-HTMLParser::HTMLParser() : m_context(std::make_unique<ParserContext>()) {
+HTMLParser::HTMLParser() : m_context(std::make_unique<ParserContext>(this)) {
 }
 
 HTMLParser::~HTMLParser() {
@@ -28,38 +81,55 @@ void HTMLParser::initialize() {
     // Configuración inicial del analizador HTML
     
     // Reiniciar el contexto
-    m_context = std::make_unique<ParserContext>();
+    m_context = std::make_unique<ParserContext>(this);
 }
 
 std::unique_ptr<DOMTree> HTMLParser::parse(const std::string& html, const std::string& baseUrl) {
+    beginParse(baseUrl);
+    parseChunk(html);
+    return finishParse();
+}
+
+void HTMLParser::beginParse(const std::string& baseUrl) {
     // Reiniciar el contexto para un nuevo análisis
-    m_context = std::make_unique<ParserContext>();
+    m_context = std::make_unique<ParserContext>(this);
     m_context->baseUrl = baseUrl;
     
-    // Tokenizar el HTML
-    tokenize(html);
+    // Crear el documento raíz
+    DOMTree::NodeHandle documentElement = m_context->domTree->createDocumentElement();
+    m_context->elementStack.push_back({documentElement, INVALID_ATOM});
+}
+
+void HTMLParser::parseChunk(std::string_view chunk) {
+    // Los tokens completos del trozo se incorporan al árbol según aparecen
+    m_context->tokenizer.feed(chunk);
+}
+
+std::unique_ptr<DOMTree> HTMLParser::finishParse() {
+    m_context->tokenizer.finish();
     
-    // Construir el árbol DOM
-    buildTree();
+    // Los elementos que quedaron abiertos se cierran al final del documento
+    m_context->elementStack.clear();
     
     // Devolver el árbol DOM construido
-    return std::move(m_context->domTree);
+    return std::move(m_context->ownedTree);
 }
 
-void HTMLParser::parseFragment(const std::string& html, DOMTree* domTree, void* parentElement) {
-    if (!domTree || !parentElement) return;
+void HTMLParser::parseFragment(const std::string& html, DOMTree* domTree, DOMTree::NodeHandle parentElement) {
+    if (!domTree || parentElement == DOMTree::INVALID_NODE) return;
     
     // Guardar el contexto actual
     auto savedContext = std::move(m_context);
     
-    // Crear un nuevo contexto para el fragmento
-    m_context = std::make_unique<ParserContext>();
-    m_context->domTree.reset(domTree); // No tomar posesión, solo usar
-    m_context->elementStack.push(parentElement);
+    // Crear un nuevo contexto para el fragmento que usa el árbol sin tomar posesión
+    m_context = std::make_unique<ParserContext>(this);
+    m_context->ownedTree.reset();
+    m_context->domTree = domTree;
+    m_context->elementStack.push_back({parentElement, domTree->getTagAtom(parentElement)});
     
-    // Tokenizar y procesar el fragmento
-    tokenize(html);
-    buildTree();
+    // Procesar el fragmento
+    m_context->tokenizer.feed(html);
+    m_context->tokenizer.finish();
     
     // Restaurar el contexto original
     m_context = std::move(savedContext);
@@ -83,217 +153,69 @@ std::string HTMLParser::serialize(const DOMTree* domTree) {
     return output.str();
 }
 
-void HTMLParser::tokenize(const std::string& html) {
-    m_context->tokens.clear();
-    
-    // Implementación simplificada de tokenización
-    // En una implementación real, se utilizaría un tokenizador más sofisticado
-    
-    std::string currentToken;
-    bool inTag = false;
-    bool inComment = false;
-    
-    for (size_t i = 0; i < html.length(); ++i) {
-        char c = html[i];
-        
-        if (inComment) {
-            currentToken += c;
-            
-            // Verificar fin de comentario
-            if (i >= 2 && html[i-2] == '-' && html[i-1] == '-' && c == '>') {
-                m_context->tokens.push_back(currentToken);
-                currentToken.clear();
-                inComment = false;
-                inTag = false;
-            }
-            continue;
-        }
-        
-        if (inTag) {
-            currentToken += c;
-            
-            // Verificar inicio de comentario
-            if (currentToken == "<!--") {
-                inComment = true;
-                continue;
-            }
-            
-            if (c == '>') {
-                m_context->tokens.push_back(currentToken);
-                currentToken.clear();
-                inTag = false;
-            }
-        } else {
-            if (c == '<') {
-                if (!currentToken.empty()) {
-                    m_context->tokens.push_back(currentToken);
-                    currentToken.clear();
-                }
-                currentToken += c;
-                inTag = true;
-            } else {
-                currentToken += c;
-            }
-        }
-    }
-    
-    // Agregar el último token si existe
-    if (!currentToken.empty()) {
-        m_context->tokens.push_back(currentToken);
-    }
-}
-
-void HTMLParser::buildTree() {
-    // Crear el documento raíz
-    void* documentElement = m_context->domTree->createDocumentElement();
-    m_context->elementStack.push(documentElement);
-    
-    // Procesar todos los tokens
-    for (const auto& token : m_context->tokens) {
-        processToken(token);
-    }
-    
-    // Asegurarse de que solo quede el documento raíz en la pila
-    while (m_context->elementStack.size() > 1) {
-        m_context->elementStack.pop();
-    }
-}
-
-void HTMLParser::processToken(const std::string& token) {
-    if (token.empty()) return;
-    
-    if (token[0] == '<') {
-        // Es una etiqueta
-        if (token.size() > 1 && token[1] == '/') {
-            // Es una etiqueta de cierre
-            std::string tagName = token.substr(2, token.size() - 3);
-            // Eliminar posibles espacios y atributos
-            size_t spacePos = tagName.find(' ');
-            if (spacePos != std::string::npos) {
-                tagName = tagName.substr(0, spacePos);
-            }
-            handleEndTag(tagName);
-        } else if (token.size() > 3 && token.substr(0, 4) == "<!--") {
-            // Es un comentario
-            std::string comment = token.substr(4, token.size() - 7);
-            handleComment(comment);
-        } else {
-            // Es una etiqueta de apertura
-            std::string tagContent = token.substr(1, token.size() - 2);
-            // Verificar si es una etiqueta auto-cerrada
-            bool selfClosing = false;
-            if (!tagContent.empty() && tagContent.back() == '/') {
-                selfClosing = true;
-                tagContent.pop_back();
-            }
-            
-            // Extraer el nombre de la etiqueta y los atributos
-            std::string tagName;
-            std::vector<std::pair<std::string, std::string>> attributes;
-            
-            size_t spacePos = tagContent.find(' ');
-            if (spacePos != std::string::npos) {
-                tagName = tagContent.substr(0, spacePos);
-                std::string attributesStr = tagContent.substr(spacePos + 1);
-                
-                // Parsear atributos (implementación simplificada)
-                std::istringstream attributeStream(attributesStr);
-                std::string attribute;
-                while (attributeStream >> attribute) {
-                    size_t equalsPos = attribute.find('=');
-                    if (equalsPos != std::string::npos) {
-                        std::string name = attribute.substr(0, equalsPos);
-                        std::string value = attribute.substr(equalsPos + 1);
-                        
-                        // Eliminar comillas si existen
-                        if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && 
-                            value.front() == value.back()) {
-                            value = value.substr(1, value.size() - 2);
-                        }
-                        
-                        attributes.emplace_back(name, value);
-                    } else {
-                        // Atributo sin valor
-                        attributes.emplace_back(attribute, "");
-                    }
-                }
-            } else {
-                tagName = tagContent;
-            }
-            
-            // Procesar la etiqueta
-            handleStartTag(tagName, attributes);
-            
-            // Si es auto-cerrada, procesar también el cierre
-            if (selfClosing) {
-                handleEndTag(tagName);
-            }
-        }
-    } else {
-        // Es texto
-        handleText(token);
+void HTMLParser::processToken(const HTMLToken& token) {
+    switch (token.type) {
+        case HTMLToken::Type::START_TAG:
+            handleStartTag(token.name, token.attributes, token.selfClosing);
+            break;
+        case HTMLToken::Type::END_TAG:
+            handleEndTag(token.name);
+            break;
+        case HTMLToken::Type::TEXT:
+            handleText(token.data);
+            break;
+        case HTMLToken::Type::COMMENT:
+            handleComment(token.data);
+            break;
+        case HTMLToken::Type::DOCTYPE:
+            // El DOCTYPE no genera nodos en el árbol
+            break;
     }
 }
 
-void HTMLParser::handleStartTag(const std::string& tag, const std::vector<std::pair<std::string, std::string>>& attributes) {
+void HTMLParser::handleStartTag(std::string_view tag, const std::vector<HTMLAttribute>& attributes, bool selfClosing) {
     if (m_context->elementStack.empty()) return;
     
-    void* parentElement = m_context->elementStack.top();
-    void* newElement = m_context->domTree->createElement(tag);
+    DOMTree::NodeHandle parentElement = m_context->elementStack.back().element;
+    DOMTree::NodeHandle newElement = m_context->domTree->createElement(toLowerName(tag, m_context->nameBuffer));
+    Atom tagName = m_context->domTree->getTagAtom(newElement);
     
     // Agregar atributos al elemento
     for (const auto& attr : attributes) {
-        m_context->domTree->setAttribute(newElement, attr.first, attr.second);
+        m_context->domTree->setAttribute(newElement, toLowerName(attr.name, m_context->nameBuffer), attr.value);
     }
     
     // Agregar el elemento al árbol
     m_context->domTree->appendChild(parentElement, newElement);
     
-    // Elementos que no tienen etiqueta de cierre
-    static const std::unordered_map<std::string, bool> voidElements = {
-        {"area", true}, {"base", true}, {"br", true}, {"col", true},
-        {"embed", true}, {"hr", true}, {"img", true}, {"input", true},
-        {"link", true}, {"meta", true}, {"param", true}, {"source", true},
-        {"track", true}, {"wbr", true}
-    };
-    
-    // Si no es un elemento vacío, agregarlo a la pila
-    if (voidElements.find(tag) == voidElements.end()) {
-        m_context->elementStack.push(newElement);
+    // Si no es un elemento vacío ni auto-cerrado, agregarlo a la pila
+    if (!selfClosing && !isVoidElement(tagName)) {
+        m_context->elementStack.push_back({newElement, tagName});
     }
 }
 
-void HTMLParser::handleEndTag(const std::string& tag) {
-    // Buscar la etiqueta correspondiente en la pila y cerrarla
-    std::stack<void*> tempStack;
-    bool found = false;
-    
-    while (!m_context->elementStack.empty() && !found) {
-        void* element = m_context->elementStack.top();
-        m_context->elementStack.pop();
-        
-        std::string elementTag = m_context->domTree->getTagName(element);
-        if (elementTag == tag) {
-            found = true;
-            break;
+void HTMLParser::handleEndTag(std::string_view tag) {
+    // Buscar la etiqueta correspondiente en la pila y cerrarla junto con los
+    // elementos que quedaron sin cerrar por encima; la raíz no se cierra nunca
+    std::string_view name = toLowerName(tag, m_context->nameBuffer);
+    if (name.empty()) return;
+    Atom tagName = AtomTable::instance().find(name);
+    
+    auto& stack = m_context->elementStack;
+    
+    for (size_t i = stack.size(); i > 1; --i) {
+        // Sin átomo (AtomTable llena) se compara el nombre guardado en el árbol
+        if (stack[i - 1].tagName == tagName &&
+            (tagName != INVALID_ATOM || m_context->domTree->getTagName(stack[i - 1].element) == name)) {
+            stack.resize(i - 1);
+            return;
         }
-        
-        tempStack.push(element);
     }
     
-    // Si no se encontró la etiqueta, restaurar la pila
-    if (!found) {
-        while (!tempStack.empty()) {
-            m_context->elementStack.push(tempStack.top());
-            tempStack.pop();
-        }
-    } else {
-        // Descartar los elementos que quedaron sin cerrar
-        tempStack = std::stack<void*>();
-    }
+    // Si no se encontró la etiqueta, se ignora el cierre
 }
 
-void HTMLParser::handleText(const std::string& text) {
+void HTMLParser::handleText(std::string_view text) {
     if (m_context->elementStack.empty()) return;
     
     // Verificar si el texto solo contiene espacios en blanco
@@ -307,17 +229,17 @@ void HTMLParser::handleText(const std::string& text) {
     
     // Si no es solo espacios en blanco, crear un nodo de texto
     if (!onlyWhitespace) {
-        void* parentElement = m_context->elementStack.top();
-        void* textNode = m_context->domTree->createTextNode(text);
+        DOMTree::NodeHandle parentElement = m_context->elementStack.back().element;
+        DOMTree::NodeHandle textNode = m_context->domTree->createTextNode(text);
         m_context->domTree->appendChild(parentElement, textNode);
     }
 }
 
-void HTMLParser::handleComment(const std::string& comment) {
+void HTMLParser::handleComment(std::string_view comment) {
     if (m_context->elementStack.empty()) return;
     
-    void* parentElement = m_context->elementStack.top();
-    void* commentNode = m_context->domTree->createCommentNode(comment);
+    DOMTree::NodeHandle parentElement = m_context->elementStack.back().element;
+    DOMTree::NodeHandle commentNode = m_context->domTree->createCommentNode(comment);
     m_context->domTree->appendChild(parentElement, commentNode);
 }
 
@@ -2,9 +2,11 @@
 #define BLACKWIDOW_HTMLPARSER_H
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <vector>
 #include "../DOM/DOMTree.h"
+#include "HTMLTokenizer.h"
 
 namespace BlackWidow {
 namespace Core {
@@ -33,13 +35,34 @@ public:
      */
     std::unique_ptr<DOMTree> parse(const std::string& html, const std::string& baseUrl);
 
+    /**
+     * @brief Comienza el análisis incremental de un documento
+     *
+     * El documento se entrega después por trozos con parseChunk() a medida
+     * que llega de la red, y el árbol se va construyendo sin esperar al final.
+     * @param baseUrl URL base para resolver referencias relativas
+     */
+    void beginParse(const std::string& baseUrl);
+
+    /**
+     * @brief Analiza el siguiente trozo del documento
+     * @param chunk Trozo del documento (puede cortar etiquetas por la mitad)
+     */
+    void parseChunk(std::string_view chunk);
+
+    /**
+     * @brief Termina el análisis incremental
+     * @return Árbol DOM construido a partir de los trozos recibidos
+     */
+    std::unique_ptr<DOMTree> finishParse();
+
     /**
      * @brief Analiza un fragmento HTML y lo integra en un árbol DOM existente
      * @param html Fragmento HTML a analizar
      * @param domTree Árbol DOM donde se integrará el fragmento
      * @param parentElement Elemento padre donde se insertará el fragmento
      */
-    void parseFragment(const std::string& html, DOMTree* domTree, void* parentElement);
+    void parseFragment(const std::string& html, DOMTree* domTree, DOMTree::NodeHandle parentElement);
 
     /**
      * @brief Serializa un árbol DOM a HTML
@@ -54,13 +77,11 @@ private:
     std::unique_ptr<ParserContext> m_context;
 
     // Métodos privados para el procesamiento interno
-    void tokenize(const std::string& html);
-    void buildTree();
-    void processToken(const std::string& token);
-    void handleStartTag(const std::string& tag, const std::vector<std::pair<std::string, std::string>>& attributes);
-    void handleEndTag(const std::string& tag);
-    void handleText(const std::string& text);
-    void handleComment(const std::string& comment);
+    void processToken(const HTMLToken& token);
+    void handleStartTag(std::string_view tag, const std::vector<HTMLAttribute>& attributes, bool selfClosing);
+    void handleEndTag(std::string_view tag);
+    void handleText(std::string_view text);
+    void handleComment(std::string_view comment);
 };
 
 } // namespace Core
@@ -0,0 +1,175 @@
+#include "HTMLScanner.h"
+#include <algorithm>
+#include <atomic>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BLACKWIDOW_HTMLSCANNER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace BlackWidow {
+namespace Core {
+
+namespace {
+
+// Mayor byte que cuenta como espacio o control
+constexpr unsigned char CONTROL_LIMIT = 0x20;
+
+// Bytes que se examinan uno a uno antes de pasar a bloques cuando se buscan
+// espacios: los nombres y valores sin comillas suelen terminar enseguida y
+// no compensa preparar los vectores
+constexpr size_t SHORT_SCAN = 16;
+
+size_t findScalar(const char* data, size_t from, size_t size, const bool* table) {
+    for (size_t i = from; i < size; ++i) {
+        if (table[static_cast<unsigned char>(data[i])]) return i;
+    }
+    return size;
+}
+
+#ifdef BLACKWIDOW_HTMLSCANNER_X86
+
+__attribute__((target("sse2")))
+size_t findSse2(const char* data, size_t from, size_t size, const char* delimiters,
+                bool controlChars, const bool* table) {
+    const __m128i d0 = _mm_set1_epi8(delimiters[0]);
+    const __m128i d1 = _mm_set1_epi8(delimiters[1]);
+    const __m128i d2 = _mm_set1_epi8(delimiters[2]);
+    const __m128i d3 = _mm_set1_epi8(delimiters[3]);
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(CONTROL_LIMIT));
+
+    size_t i = from;
+    for (; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, d0), _mm_cmpeq_epi8(block, d1)),
+                                       _mm_or_si128(_mm_cmpeq_epi8(block, d2), _mm_cmpeq_epi8(block, d3)));
+        if (controlChars) {
+            // Un byte sin signo es <= 0x20 si el mínimo con 0x20 es él mismo
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(_mm_min_epu8(block, limit), block));
+        }
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches));
+        if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+
+    // Los últimos bytes se examinan uno a uno para no leer fuera de la entrada
+    return findScalar(data, i, size, table);
+}
+
+__attribute__((target("avx2")))
+size_t findAvx2(const char* data, size_t from, size_t size, const char* delimiters,
+                bool controlChars, const bool* table) {
+    const __m256i d0 = _mm256_set1_epi8(delimiters[0]);
+    const __m256i d1 = _mm256_set1_epi8(delimiters[1]);
+    const __m256i d2 = _mm256_set1_epi8(delimiters[2]);
+    const __m256i d3 = _mm256_set1_epi8(delimiters[3]);
+    const __m256i limit = _mm256_set1_epi8(static_cast<char>(CONTROL_LIMIT));
+
+    size_t i = from;
+    for (; i + 32 <= size; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i matches = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, d0), _mm256_cmpeq_epi8(block, d1)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, d2), _mm256_cmpeq_epi8(block, d3)));
+        if (controlChars) {
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(_mm256_min_epu8(block, limit), block));
+        }
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(matches));
+        if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+
+    return findSse2(data, i, size, delimiters, controlChars, table);
+}
+
+#endif // BLACKWIDOW_HTMLSCANNER_X86
+
+HTMLScanner::Implementation detectImplementation() {
+#ifdef BLACKWIDOW_HTMLSCANNER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return HTMLScanner::Implementation::AVX2;
+    if (__builtin_cpu_supports("sse2")) return HTMLScanner::Implementation::SSE2;
+#endif
+    return HTMLScanner::Implementation::SCALAR;
+}
+
+std::atomic<HTMLScanner::Implementation>& currentImplementation() {
+    static std::atomic<HTMLScanner::Implementation> implementation(detectImplementation());
+    return implementation;
+}
+
+} // namespace
+
+HTMLScanner::HTMLScanner(std::string_view delimiters, bool controlChars)
+    : m_controlChars(controlChars)
+    , m_table() {
+    if (delimiters.size() > MAX_DELIMITERS) {
+        delimiters = delimiters.substr(0, MAX_DELIMITERS);
+    }
+
+    // Sin delimitadores se rellena con NUL, que solo cuenta si se buscan bytes de control
+    char filler = delimiters.empty() ? '\0' : delimiters[0];
+    for (size_t i = 0; i < MAX_DELIMITERS; ++i) {
+        m_delimiters[i] = i < delimiters.size() ? delimiters[i] : filler;
+    }
+
+    for (char delimiter : delimiters) {
+        m_table[static_cast<unsigned char>(delimiter)] = true;
+    }
+    if (controlChars) {
+        for (size_t c = 0; c <= CONTROL_LIMIT; ++c) {
+            m_table[c] = true;
+        }
+    }
+}
+
+size_t HTMLScanner::find(std::string_view input, size_t from) const {
+    const size_t size = input.size();
+    const size_t shortEnd = std::min(size, from + (m_controlChars ? SHORT_SCAN : 0));
+    for (; from < shortEnd; ++from) {
+        if (m_table[static_cast<unsigned char>(input[from])]) return from;
+    }
+    if (from == size) return size;
+
+    // Sin delimitadores el relleno NUL no está en la tabla y no debe detener los bloques
+    if (!m_controlChars && !m_table[static_cast<unsigned char>(m_delimiters[0])]) return size;
+
+#ifdef BLACKWIDOW_HTMLSCANNER_X86
+    switch (currentImplementation().load(std::memory_order_relaxed)) {
+        case Implementation::AVX2:
+            return findAvx2(input.data(), from, size, m_delimiters, m_controlChars, m_table);
+        case Implementation::SSE2:
+            return findSse2(input.data(), from, size, m_delimiters, m_controlChars, m_table);
+        case Implementation::SCALAR:
+            break;
+    }
+#endif
+
+    return findScalar(input.data(), from, size, m_table);
+}
+
+HTMLScanner::Implementation HTMLScanner::implementation() {
+    return currentImplementation().load();
+}
+
+bool HTMLScanner::setImplementation(Implementation implementation) {
+    if (!isSupported(implementation)) return false;
+    currentImplementation().store(implementation);
+    return true;
+}
+
+bool HTMLScanner::isSupported(Implementation implementation) {
+    switch (implementation) {
+        case Implementation::SCALAR:
+            return true;
+#ifdef BLACKWIDOW_HTMLSCANNER_X86
+        case Implementation::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case Implementation::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+} // namespace Core
+} // namespace BlackWidow
@@ -0,0 +1,79 @@
+#ifndef BLACKWIDOW_HTMLSCANNER_H
+#define BLACKWIDOW_HTMLSCANNER_H
+
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+namespace BlackWidow {
+namespace Core {
+
+/**
+ * @brief Búsqueda vectorizada de delimitadores en la entrada HTML
+ *
+ * Localiza el siguiente byte de un conjunto pequeño de delimitadores ('<',
+ * '>', comillas, '=', '/'...) y opcionalmente de cualquier byte de control
+ * o espacio (<= 0x20), que es como el tokenizador encuentra el final de los
+ * textos, nombres y valores sin examinar cada byte por separado. Compara
+ * bloques de 32 bytes con AVX2 o de 16 con SSE2 según lo que ofrezca el
+ * procesador, comprobado en tiempo de ejecución, y recurre a una tabla byte
+ * a byte en el resto de plataformas.
+ */
+class HTMLScanner {
+public:
+    /**
+     * @brief Implementaciones disponibles de la búsqueda
+     */
+    enum class Implementation {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * @brief Constructor
+     * @param delimiters Bytes que detienen la búsqueda (hasta 4)
+     * @param controlChars true para detenerse también en espacios y bytes de control
+     */
+    explicit HTMLScanner(std::string_view delimiters, bool controlChars = false);
+
+    /**
+     * @brief Busca el siguiente delimitador
+     * @param input Entrada
+     * @param from Posición desde la que buscar
+     * @return Posición del delimitador o el tamaño de la entrada si no hay ninguno
+     */
+    size_t find(std::string_view input, size_t from) const;
+
+    /**
+     * @brief Obtiene la implementación que usan todas las búsquedas
+     * @return Implementación elegida según el procesador
+     */
+    static Implementation implementation();
+
+    /**
+     * @brief Fuerza una implementación, para comparar su rendimiento
+     * @param implementation Implementación a usar
+     * @return false si el procesador no la admite (se mantiene la actual)
+     */
+    static bool setImplementation(Implementation implementation);
+
+    /**
+     * @brief Indica si el procesador admite una implementación
+     * @param implementation Implementación a comprobar
+     * @return true si se puede usar
+     */
+    static bool isSupported(Implementation implementation);
+
+private:
+    static constexpr size_t MAX_DELIMITERS = 4;
+
+    char m_delimiters[MAX_DELIMITERS];   // Los que sobran repiten el primero
+    bool m_controlChars;
+    bool m_table[256];                   // Tabla de la búsqueda escalar
+};
+
+} // namespace Core
+} // namespace BlackWidow
+
+#endif // BLACKWIDOW_HTMLSCANNER_H
@@ -0,0 +1,416 @@
+#include "HTMLTokenizer.h"
+#include "HTMLScanner.h"
+#include "../../Utils/Text/StringUtils.h"
+#include <algorithm>
+
+namespace BlackWidow {
+namespace Core {
+
+namespace {
+
+// Elementos cuyo contenido es texto hasta su etiqueta de cierre
+constexpr std::string_view RAW_TEXT_ELEMENTS[] = {"script", "style", "textarea", "title"};
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+bool isAlpha(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+using Utils::Text::equalsIgnoreCase;
+
+// Delimitadores que terminan cada tramo; los espacios se buscan como bytes de control
+const HTMLScanner TEXT_END("<");
+const HTMLScanner TAG_NAME_END("/>", true);
+const HTMLScanner ATTRIBUTE_NAME_END("/=>", true);
+const HTMLScanner UNQUOTED_VALUE_END(">", true);
+const HTMLScanner DOUBLE_QUOTED_VALUE_END("\"");
+const HTMLScanner SINGLE_QUOTED_VALUE_END("'");
+const HTMLScanner MARKUP_END(">");
+
+} // namespace
+
+HTMLTokenizer::HTMLTokenizer(TokenHandler handler)
+    : m_handler(std::move(handler))
+    , m_state(State::DATA)
+    , m_scanned(0)
+    , m_textEnd(0)
+    , m_nameBegin(0)
+    , m_nameEnd(0)
+    , m_commentBegin(0)
+    , m_endTag(false)
+    , m_selfClosing(false) {
+}
+
+void HTMLTokenizer::feed(std::string_view chunk) {
+    if (chunk.empty()) return;
+
+    if (m_buffer.empty()) {
+        // Caso habitual: los tokens completos se entregan directamente desde el trozo
+        size_t consumed = run(chunk);
+        m_buffer.assign(chunk.substr(consumed));
+    } else {
+        // Completar el token que quedó a medias
+        m_buffer.append(chunk);
+        size_t consumed = run(m_buffer);
+        m_buffer.erase(0, consumed);
+    }
+}
+
+void HTMLTokenizer::finish() {
+    std::string_view rest = m_buffer;
+
+    switch (m_state) {
+        case State::DATA:
+        case State::RAW_TEXT:
+        case State::TAG_OPEN:
+        case State::END_TAG_OPEN:
+            // Un '<' o "</" sin etiqueta detrás es texto
+            if (!rest.empty()) emitText(rest);
+            break;
+
+        case State::MARKUP_DECLARATION:
+            emitComment(HTMLToken::Type::COMMENT, rest.substr(std::min<size_t>(2, rest.size())));
+            break;
+
+        case State::COMMENT:
+        case State::DECLARATION:
+        case State::BOGUS_COMMENT:
+            emitComment(HTMLToken::Type::COMMENT, rest.substr(std::min(m_commentBegin, rest.size())));
+            break;
+
+        default:
+            // Una etiqueta sin terminar se descarta
+            break;
+    }
+
+    reset();
+}
+
+void HTMLTokenizer::reset() {
+    m_state = State::DATA;
+    m_buffer.clear();
+    m_scanned = 0;
+    m_spans.clear();
+    m_rawTextTag = {};
+}
+
+size_t HTMLTokenizer::run(std::string_view input) {
+    const size_t size = input.size();
+    size_t start = 0;           // Inicio del token en curso
+    size_t i = m_scanned;
+    bool stalled = false;       // Hace falta más entrada para decidir
+
+    while (i < size && !stalled) {
+        char c = input[i];
+
+        switch (m_state) {
+            case State::DATA:
+                i = TEXT_END.find(input, i);
+                if (i < size) {
+                    // El texto no se entrega hasta saber si el '<' abre una etiqueta
+                    m_textEnd = i - start;
+                    m_state = State::TAG_OPEN;
+                    ++i;
+                }
+                break;
+
+            case State::RAW_TEXT: {
+                i = TEXT_END.find(input, i);
+                if (i == size) break;
+
+                size_t nameBegin = i + 2;
+                if (nameBegin + m_rawTextTag.size() >= size) {
+                    stalled = true;
+                    break;
+                }
+                if (input[i + 1] == '/' &&
+                    equalsIgnoreCase(input.substr(nameBegin, m_rawTextTag.size()), m_rawTextTag)) {
+                    char next = input[nameBegin + m_rawTextTag.size()];
+                    if (isSpace(next) || next == '/' || next == '>') {
+                        if (i > start) emitText(input.substr(start, i - start));
+                        start = i;
+                        beginTag(true, 2);
+                        m_state = State::TAG_NAME;
+                        i = nameBegin;
+                        break;
+                    }
+                }
+                ++i;
+                break;
+            }
+
+            case State::TAG_OPEN:
+                if (isAlpha(c) || c == '/' || c == '!' || c == '?') {
+                    // Es marcado: entregar el texto anterior
+                    size_t open = start + m_textEnd;
+                    if (open > start) emitText(input.substr(start, open - start));
+                    start = open;
+
+                    if (isAlpha(c)) {
+                        beginTag(false, 1);
+                        m_state = State::TAG_NAME;
+                    } else if (c == '/') {
+                        m_state = State::END_TAG_OPEN;
+                    } else if (c == '!') {
+                        m_state = State::MARKUP_DECLARATION;
+                    } else {
+                        m_commentBegin = 1;
+                        m_state = State::BOGUS_COMMENT;
+                    }
+                    ++i;
+                } else {
+                    // El '<' forma parte del texto; se vuelve a examinar este carácter
+                    m_state = State::DATA;
+                }
+                break;
+
+            case State::END_TAG_OPEN:
+                if (isAlpha(c)) {
+                    beginTag(true, 2);
+                    m_state = State::TAG_NAME;
+                    ++i;
+                } else if (c == '>') {
+                    // "</>" se ignora
+                    start = ++i;
+                    m_state = State::DATA;
+                } else {
+                    m_commentBegin = 2;
+                    m_state = State::BOGUS_COMMENT;
+                }
+                break;
+
+            case State::TAG_NAME:
+                i = TAG_NAME_END.find(input, i);
+                if (i == size) break;
+                c = input[i];
+
+                if (isSpace(c)) {
+                    m_nameEnd = i - start;
+                    m_state = State::BEFORE_ATTRIBUTE_NAME;
+                } else if (c == '/') {
+                    m_nameEnd = i - start;
+                    m_state = State::SELF_CLOSING_START_TAG;
+                } else if (c == '>') {
+                    m_nameEnd = i - start;
+                    emitTag(input.substr(start, i + 1 - start));
+                    start = i + 1;
+                }
+                ++i;
+                break;
+
+            case State::BEFORE_ATTRIBUTE_NAME:
+            case State::AFTER_ATTRIBUTE_NAME:
+                if (isSpace(c)) {
+                    // Espacios entre atributos
+                } else if (c == '/') {
+                    m_state = State::SELF_CLOSING_START_TAG;
+                } else if (c == '>') {
+                    emitTag(input.substr(start, i + 1 - start));
+                    start = i + 1;
+                } else if (c == '=' && m_state == State::AFTER_ATTRIBUTE_NAME) {
+                    m_state = State::BEFORE_ATTRIBUTE_VALUE;
+                } else {
+                    m_spans.push_back(AttributeSpan{i - start, i - start, 0, 0});
+                    m_state = State::ATTRIBUTE_NAME;
+                }
+                ++i;
+                break;
+
+            case State::ATTRIBUTE_NAME:
+                i = ATTRIBUTE_NAME_END.find(input, i);
+                if (i == size) break;
+                c = input[i];
+
+                if (isSpace(c)) {
+                    m_spans.back().nameEnd = i - start;
+                    m_state = State::AFTER_ATTRIBUTE_NAME;
+                } else if (c == '/') {
+                    m_spans.back().nameEnd = i - start;
+                    m_state = State::SELF_CLOSING_START_TAG;
+                } else if (c == '=') {
+                    m_spans.back().nameEnd = i - start;
+                    m_state = State::BEFORE_ATTRIBUTE_VALUE;
+                } else if (c == '>') {
+                    m_spans.back().nameEnd = i - start;
+                    emitTag(input.substr(start, i + 1 - start));
+                    start = i + 1;
+                }
+                ++i;
+                break;
+
+            case State::BEFORE_ATTRIBUTE_VALUE:
+                if (isSpace(c)) {
+                    // Espacios tras el '='
+                } else if (c == '"') {
+                    m_spans.back().valueBegin = i + 1 - start;
+                    m_state = State::ATTRIBUTE_VALUE_DOUBLE_QUOTED;
+                } else if (c == '\'') {
+                    m_spans.back().valueBegin = i + 1 - start;
+                    m_state = State::ATTRIBUTE_VALUE_SINGLE_QUOTED;
+                } else if (c == '>') {
+                    emitTag(input.substr(start, i + 1 - start));
+                    start = i + 1;
+                } else {
+                    m_spans.back().valueBegin = i - start;
+                    m_state = State::ATTRIBUTE_VALUE_UNQUOTED;
+                }
+                ++i;
+                break;
+
+            case State::ATTRIBUTE_VALUE_DOUBLE_QUOTED:
+            case State::ATTRIBUTE_VALUE_SINGLE_QUOTED:
+                i = (m_state == State::ATTRIBUTE_VALUE_DOUBLE_QUOTED ? DOUBLE_QUOTED_VALUE_END
+                                                                     : SINGLE_QUOTED_VALUE_END).find(input, i);
+                if (i < size) {
+                    m_spans.back().valueEnd = i - start;
+                    m_state = State::BEFORE_ATTRIBUTE_NAME;
+                    ++i;
+                }
+                break;
+
+            case State::ATTRIBUTE_VALUE_UNQUOTED:
+                i = UNQUOTED_VALUE_END.find(input, i);
+                if (i == size) break;
+                c = input[i];
+
+                if (isSpace(c)) {
+                    m_spans.back().valueEnd = i - start;
+                    m_state = State::BEFORE_ATTRIBUTE_NAME;
+                } else if (c == '>') {
+                    m_spans.back().valueEnd = i - start;
+                    emitTag(input.substr(start, i + 1 - start));
+                    start = i + 1;
+                }
+                ++i;
+                break;
+
+            case State::SELF_CLOSING_START_TAG:
+                if (c == '>') {
+                    m_selfClosing = true;
+                    emitTag(input.substr(start, i + 1 - start));
+                    start = i + 1;
+                    ++i;
+                } else {
+                    // Un '/' suelto entre atributos se ignora
+                    m_state = State::BEFORE_ATTRIBUTE_NAME;
+                }
+                break;
+
+            case State::MARKUP_DECLARATION:
+                if (c != '-') {
+                    m_commentBegin = 2;
+                    m_state = State::DECLARATION;
+                } else if (i + 1 == size) {
+                    stalled = true;
+                } else if (input[i + 1] == '-') {
+                    m_commentBegin = i + 2 - start;
+                    m_state = State::COMMENT;
+                    i += 2;
+                } else {
+                    m_commentBegin = 2;
+                    m_state = State::DECLARATION;
+                }
+                break;
+
+            case State::COMMENT: {
+                i = MARKUP_END.find(input, i);
+                if (i == size) break;
+
+                size_t contentBegin = start + m_commentBegin;
+                size_t contentEnd;
+                if (i >= contentBegin + 2 && input[i - 1] == '-' && input[i - 2] == '-') {
+                    contentEnd = i - 2;
+                } else if (i == contentBegin || (i == contentBegin + 1 && input[i - 1] == '-')) {
+                    // "<!-->" y "<!--->" son comentarios vacíos
+                    contentEnd = contentBegin;
+                } else {
+                    ++i;
+                    break;
+                }
+                emitComment(HTMLToken::Type::COMMENT, input.substr(contentBegin, contentEnd - contentBegin));
+                start = ++i;
+                break;
+            }
+
+            case State::DECLARATION:
+            case State::BOGUS_COMMENT: {
+                i = MARKUP_END.find(input, i);
+                if (i == size) break;
+
+                std::string_view content = input.substr(start + m_commentBegin, i - start - m_commentBegin);
+                bool doctype = m_state == State::DECLARATION && content.size() >= 7 &&
+                               equalsIgnoreCase(content.substr(0, 7), "doctype");
+                if (doctype) {
+                    emitComment(HTMLToken::Type::DOCTYPE, content.substr(7));
+                } else {
+                    emitComment(HTMLToken::Type::COMMENT, content);
+                }
+                start = ++i;
+                break;
+            }
+        }
+    }
+
+    m_scanned = i - start;
+    return start;
+}
+
+void HTMLTokenizer::beginTag(bool endTag, size_t nameBegin) {
+    m_endTag = endTag;
+    m_selfClosing = false;
+    m_nameBegin = nameBegin;
+    m_spans.clear();
+}
+
+void HTMLTokenizer::emitTag(std::string_view markup) {
+    m_token.type = m_endTag ? HTMLToken::Type::END_TAG : HTMLToken::Type::START_TAG;
+    m_token.name = markup.substr(m_nameBegin, m_nameEnd - m_nameBegin);
+    m_token.data = {};
+    m_token.selfClosing = m_selfClosing;
+    m_token.attributes.clear();
+    m_state = State::DATA;
+
+    if (!m_endTag) {
+        for (const auto& span : m_spans) {
+            m_token.attributes.push_back(HTMLAttribute{
+                markup.substr(span.nameBegin, span.nameEnd - span.nameBegin),
+                span.valueEnd > span.valueBegin ? markup.substr(span.valueBegin, span.valueEnd - span.valueBegin)
+                                                : std::string_view()});
+        }
+
+        for (std::string_view element : RAW_TEXT_ELEMENTS) {
+            if (equalsIgnoreCase(m_token.name, element)) {
+                m_rawTextTag = element;
+                m_state = State::RAW_TEXT;
+                break;
+            }
+        }
+    }
+
+    m_handler(m_token);
+}
+
+void HTMLTokenizer::emitText(std::string_view text) {
+    m_token.type = HTMLToken::Type::TEXT;
+    m_token.name = {};
+    m_token.data = text;
+    m_token.selfClosing = false;
+    m_token.attributes.clear();
+    m_handler(m_token);
+}
+
+void HTMLTokenizer::emitComment(HTMLToken::Type type, std::string_view data) {
+    m_token.type = type;
+    m_token.name = {};
+    m_token.data = data;
+    m_token.selfClosing = false;
+    m_token.attributes.clear();
+    m_state = State::DATA;
+    m_handler(m_token);
+}
+
+} // namespace Core
+} // namespace BlackWidow
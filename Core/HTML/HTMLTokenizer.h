@@ -0,0 +1,143 @@
+#ifndef BLACKWIDOW_HTMLTOKENIZER_H
+#define BLACKWIDOW_HTMLTOKENIZER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+
+namespace BlackWidow {
+namespace Core {
+
+/**
+ * @brief Atributo de una etiqueta de apertura
+ *
+ * Las vistas apuntan a la entrada del tokenizador y solo son válidas
+ * mientras dura la llamada a la función que recibe el token.
+ */
+struct HTMLAttribute {
+    std::string_view name;
+    std::string_view value;
+};
+
+/**
+ * @brief Token producido por el tokenizador HTML
+ */
+struct HTMLToken {
+    enum class Type {
+        START_TAG,
+        END_TAG,
+        TEXT,
+        COMMENT,
+        DOCTYPE
+    };
+
+    Type type = Type::TEXT;
+    std::string_view name;                    // Nombre de la etiqueta, tal como aparece en la entrada
+    std::string_view data;                    // Texto, comentario o contenido del DOCTYPE
+    std::vector<HTMLAttribute> attributes;    // Solo en etiquetas de apertura
+    bool selfClosing = false;                 // Etiqueta terminada en "/>"
+};
+
+/**
+ * @brief Tokenizador HTML incremental de una sola pasada
+ *
+ * Implementa una máquina de estados que recorre la entrada una única vez y
+ * entrega cada token en cuanto está completo, sin copiarlo: los nombres,
+ * atributos y textos son vistas sobre el fragmento recibido. Se puede
+ * alimentar por trozos a medida que llegan de la red; solo el token que
+ * queda a medias al final de un trozo se guarda hasta el siguiente.
+ *
+ * El contenido de script, style, textarea y title se trata como texto
+ * hasta su etiqueta de cierre.
+ */
+class HTMLTokenizer {
+public:
+    /**
+     * @brief Función que recibe cada token
+     *
+     * El token y sus vistas solo son válidos durante la llamada.
+     */
+    using TokenHandler = std::function<void(const HTMLToken&)>;
+
+    /**
+     * @brief Constructor
+     * @param handler Función que recibe los tokens
+     */
+    explicit HTMLTokenizer(TokenHandler handler);
+
+    /**
+     * @brief Procesa un trozo del documento
+     * @param chunk Siguiente trozo de la entrada
+     */
+    void feed(std::string_view chunk);
+
+    /**
+     * @brief Indica el final del documento y entrega lo que quedaba pendiente
+     *
+     * Después el tokenizador queda listo para un documento nuevo.
+     */
+    void finish();
+
+    /**
+     * @brief Descarta el estado y lo pendiente para empezar un documento nuevo
+     */
+    void reset();
+
+private:
+    enum class State {
+        DATA,
+        RAW_TEXT,
+        TAG_OPEN,
+        END_TAG_OPEN,
+        TAG_NAME,
+        BEFORE_ATTRIBUTE_NAME,
+        ATTRIBUTE_NAME,
+        AFTER_ATTRIBUTE_NAME,
+        BEFORE_ATTRIBUTE_VALUE,
+        ATTRIBUTE_VALUE_DOUBLE_QUOTED,
+        ATTRIBUTE_VALUE_SINGLE_QUOTED,
+        ATTRIBUTE_VALUE_UNQUOTED,
+        SELF_CLOSING_START_TAG,
+        MARKUP_DECLARATION,
+        COMMENT,
+        DECLARATION,
+        BOGUS_COMMENT
+    };
+
+    // Posiciones de un atributo relativas al inicio de la etiqueta
+    struct AttributeSpan {
+        size_t nameBegin;
+        size_t nameEnd;
+        size_t valueBegin;
+        size_t valueEnd;
+    };
+
+    size_t run(std::string_view input);
+    void beginTag(bool endTag, size_t nameBegin);
+    void emitTag(std::string_view markup);
+    void emitText(std::string_view text);
+    void emitComment(HTMLToken::Type type, std::string_view data);
+
+    TokenHandler m_handler;
+    HTMLToken m_token;          // Se reutiliza para no reservar memoria en cada token
+
+    State m_state;
+    std::string m_buffer;       // Token incompleto del trozo anterior
+    size_t m_scanned;           // Bytes del token actual ya examinados
+
+    // Token en curso (posiciones relativas a su inicio)
+    size_t m_textEnd;           // Fin del texto pendiente cuando se ve un '<'
+    size_t m_nameBegin;
+    size_t m_nameEnd;
+    size_t m_commentBegin;
+    bool m_endTag;
+    bool m_selfClosing;
+    std::vector<AttributeSpan> m_spans;
+    std::string_view m_rawTextTag;   // Elemento cuyo cierre termina el texto en RAW_TEXT
+};
+
+} // namespace Core
+} // namespace BlackWidow
+
+#endif // BLACKWIDOW_HTMLTOKENIZER_H
@@ -11,8 +11,9 @@ struct JSInterpreter::InterpreterContext {
     // Funciones nativas registradas
     std::unordered_map<std::string, std::function<std::string(const std::string&)>> nativeFunctions;
     
-    // Manejadores de eventos para elementos
-    std::unordered_map<void*, std::unordered_map<std::string, std::string>> eventHandlers;
+    // Manejadores de eventos por árbol (DOMTree::getId) y elemento; los
+    // identificadores de nodo son propios de cada árbol
+    std::unordered_map<uint64_t, std::unordered_map<DOMTree::NodeHandle, std::unordered_map<std::string, std::string>>> eventHandlers;
     
     // Variables globales del contexto
     std::unordered_map<std::string, std::string> globalVariables;
@@ -54,8 +55,8 @@ void JSInterpreter::initialize() {
         }
         
         // Buscar el elemento por ID
-        void* element = m_context->currentDomTree->getElementById(id);
-        if (element) {
+        DOMTree::NodeHandle element = m_context->currentDomTree->getElementById(id);
+        if (element != DOMTree::INVALID_NODE) {
             // Devolver una referencia al elemento (en una implementación real, esto sería un objeto JavaScript)
             return "{ \"_elementRef\": \"" + id + "\" }";
         }
@@ -75,10 +76,12 @@ void JSInterpreter::initialize() {
         }
         
         // Crear el elemento
-        void* element = m_context->currentDomTree->createElement(tagName);
-        if (element) {
-            // Generar un ID único para el elemento
-            std::string id = "js_element_" + std::to_string(reinterpret_cast<uintptr_t>(element));
+        DOMTree::NodeHandle element = m_context->currentDomTree->createElement(tagName);
+        if (element != DOMTree::INVALID_NODE) {
+            // Generar un ID único para el elemento; el del árbol evita que
+            // coincida con el de un elemento de otro documento
+            std::string id = "js_element_" + std::to_string(m_context->currentDomTree->getId()) + "_" +
+                             std::to_string(element);
             m_context->currentDomTree->setAttribute(element, "id", id);
             
             // Devolver una referencia al elemento
@@ -147,27 +150,41 @@ void JSInterpreter::registerNativeFunction(const std::string& name, std::functio
     m_context->nativeFunctions[name] = callback;
 }
 
-void JSInterpreter::setEventHandler(void* element, const std::string& eventType, const std::string& script) {
-    if (!element) return;
+void JSInterpreter::setEventHandler(const DOMTree* domTree, DOMTree::NodeHandle element, const std::string& eventType,
+                                    const std::string& script) {
+    if (!domTree || element == DOMTree::INVALID_NODE) return;
     
     // Almacenar el manejador de eventos
-    m_context->eventHandlers[element][eventType] = script;
+    m_context->eventHandlers[domTree->getId()][element][eventType] = script;
 }
 
-void JSInterpreter::triggerEvent(void* element, const std::string& eventType, const std::string& eventData) {
-    if (!element || !m_context->currentDomTree) return;
+void JSInterpreter::triggerEvent(DOMTree* domTree, DOMTree::NodeHandle element, const std::string& eventType,
+                                 const std::string& eventData) {
+    if (!domTree || element == DOMTree::INVALID_NODE) return;
     
     // Buscar el manejador de eventos
-    auto elementIt = m_context->eventHandlers.find(element);
-    if (elementIt != m_context->eventHandlers.end()) {
+    auto treeIt = m_context->eventHandlers.find(domTree->getId());
+    if (treeIt == m_context->eventHandlers.end()) return;
+    
+    auto elementIt = treeIt->second.find(element);
+    if (elementIt != treeIt->second.end()) {
         auto eventIt = elementIt->second.find(eventType);
         if (eventIt != elementIt->second.end()) {
             // Ejecutar el script del manejador
-            executeScript(eventIt->second, m_context->currentDomTree);
+            executeScript(eventIt->second, domTree);
         }
     }
 }
 
+void JSInterpreter::releaseTree(const DOMTree* domTree) {
+    if (!domTree) return;
+    
+    m_context->eventHandlers.erase(domTree->getId());
+    if (m_context->currentDomTree == domTree) {
+        m_context->currentDomTree = nullptr;
+    }
+}
+
 std::string JSInterpreter::evaluateExpression(const std::string& expression) {
     // En una implementación real, aquí se evaluaría la expresión JavaScript
     // Por ahora, devolvemos un valor predeterminado
@@ -180,9 +197,9 @@ void JSInterpreter::updateDOM(DOMTree* domTree, const std::string& selector, con
     // Implementación simplificada: solo soportamos selectores de ID
     if (selector.size() > 1 && selector.front() == '#') {
         std::string id = selector.substr(1);
-        void* element = domTree->getElementById(id);
+        DOMTree::NodeHandle element = domTree->getElementById(id);
         
-        if (element) {
+        if (element != DOMTree::INVALID_NODE) {
             // Actualizar la propiedad del elemento
             if (property == "textContent") {
                 domTree->setTextContent(element, value);
@@ -193,8 +210,8 @@ void JSInterpreter::updateDOM(DOMTree* domTree, const std::string& selector, con
     }
 }
 
-std::string JSInterpreter::getElementProperty(void* element, DOMTree* domTree, const std::string& property) {
-    if (!element || !domTree) return "null";
+std::string JSInterpreter::getElementProperty(DOMTree::NodeHandle element, DOMTree* domTree, const std::string& property) {
+    if (element == DOMTree::INVALID_NODE || !domTree) return "null";
     
     // Obtener la propiedad del elemento
     if (property == "textContent") {
@@ -20,7 +20,7 @@ namespace Core {
 class JSInterpreter {
 public:
     // Tipo para callbacks de eventos
-    using EventCallback = std::function<void(const std::string&, void*)>;
+    using EventCallback = std::function<void(const std::string&, DOMTree::NodeHandle)>;
     
     JSInterpreter();
     ~JSInterpreter();
@@ -47,19 +47,31 @@ public:
 
     /**
      * @brief Establece un manejador de eventos para un elemento del DOM
+     * @param domTree Árbol DOM al que pertenece el elemento
      * @param element Elemento al que se asignará el manejador
      * @param eventType Tipo de evento ("click", "mouseover", etc.)
      * @param script Código JavaScript a ejecutar cuando ocurra el evento
      */
-    void setEventHandler(void* element, const std::string& eventType, const std::string& script);
+    void setEventHandler(const DOMTree* domTree, DOMTree::NodeHandle element, const std::string& eventType,
+                         const std::string& script);
 
     /**
      * @brief Dispara un evento en un elemento
+     * @param domTree Árbol DOM al que pertenece el elemento, en cuyo contexto se ejecuta el manejador
      * @param element Elemento en el que se disparará el evento
      * @param eventType Tipo de evento a disparar
      * @param eventData Datos adicionales del evento (en formato JSON)
      */
-    void triggerEvent(void* element, const std::string& eventType, const std::string& eventData = "{}");
+    void triggerEvent(DOMTree* domTree, DOMTree::NodeHandle element, const std::string& eventType,
+                      const std::string& eventData = "{}");
+
+    /**
+     * @brief Descarta los manejadores de eventos de un árbol DOM
+     *
+     * Debe llamarse antes de destruir un árbol con manejadores registrados.
+     * @param domTree Árbol DOM cuyos manejadores se descartarán
+     */
+    void releaseTree(const DOMTree* domTree);
 
 private:
     // Estructuras internas para el intérprete
@@ -69,7 +81,7 @@ private:
     // Métodos privados para el procesamiento interno
     std::string evaluateExpression(const std::string& expression);
     void updateDOM(DOMTree* domTree, const std::string& selector, const std::string& property, const std::string& value);
-    std::string getElementProperty(void* element, DOMTree* domTree, const std::string& property);
+    std::string getElementProperty(DOMTree::NodeHandle element, DOMTree* domTree, const std::string& property);
 };
 
 } // namespace Core
@@ -0,0 +1,208 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación del análisis pasivo del tráfico en segundo plano
+ */
+
+#include "AnalysisPipeline.h"
+#include "TrafficAnalyzer.h"
+#include "../../Utils/Logging/Logger.h"
+#include <algorithm>
+
+namespace Core::Network {
+
+namespace {
+
+/**
+ * Redondea la capacidad a la siguiente potencia de dos
+ * @param capacity Capacidad pedida
+ * @return Capacidad del buffer circular (al menos 2)
+ */
+size_t ringCapacity(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+} // namespace
+
+AnalysisPipeline::AnalysisPipeline(TrafficAnalyzer& analyzer, size_t capacity, size_t workers)
+    : m_analyzer(analyzer)
+    , m_cells(std::make_unique<Cell[]>(ringCapacity(capacity)))
+    , m_mask(ringCapacity(capacity) - 1)
+    , m_enqueuePos(0)
+    , m_dequeuePos(0)
+    , m_items(0)
+    , m_slots(static_cast<std::ptrdiff_t>(ringCapacity(capacity)))
+    , m_policy(OverflowPolicy::DROP_NEWEST)
+    , m_stopping(false)
+    , m_submitted(0)
+    , m_analyzed(0)
+    , m_dropped(0)
+{
+    for (size_t i = 0; i <= m_mask; i++) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < std::max<size_t>(workers, 1); i++) {
+        m_workers.emplace_back(&AnalysisPipeline::run, this);
+    }
+}
+
+AnalysisPipeline::~AnalysisPipeline() {
+    m_stopping = true;
+    m_items.release(static_cast<std::ptrdiff_t>(m_workers.size()));
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+
+    ExchangeSnapshot pending;
+    while (tryPop(pending)) {
+        m_dropped++;
+    }
+}
+
+bool AnalysisPipeline::submit(ExchangeSnapshot snapshot) {
+    m_submitted++;
+
+    // Reservar una celda según la política de desbordamiento
+    if (!m_slots.try_acquire()) {
+        switch (m_policy.load()) {
+            case OverflowPolicy::DROP_NEWEST:
+                m_dropped++;
+                return false;
+
+            case OverflowPolicy::DROP_OLDEST: {
+                // La celda del intercambio descartado pasa a ser la nuestra; si
+                // los hilos de análisis se llevaron los que había, se descarta este
+                if (!m_items.try_acquire()) {
+                    m_dropped++;
+                    return false;
+                }
+                ExchangeSnapshot oldest;
+                while (!tryPop(oldest)) {
+                    std::this_thread::yield();
+                }
+                m_dropped++;
+                break;
+            }
+
+            case OverflowPolicy::BLOCK:
+                m_slots.acquire();
+                break;
+        }
+    }
+
+    // Con la celda reservada el hueco existe, aunque un hilo de análisis
+    // puede estar terminando de vaciar la siguiente posición
+    while (!tryPush(snapshot)) {
+        std::this_thread::yield();
+    }
+    m_items.release();
+    return true;
+}
+
+void AnalysisPipeline::setOverflowPolicy(OverflowPolicy policy) {
+    m_policy = policy;
+}
+
+void AnalysisPipeline::setFindingHandler(FindingHandler handler) {
+    std::lock_guard<std::mutex> lock(m_handlerMutex);
+    m_handler = std::move(handler);
+}
+
+AnalysisPipelineStats AnalysisPipeline::getStats() const {
+    size_t enqueued = m_enqueuePos.load();
+    size_t dequeued = m_dequeuePos.load();
+    return AnalysisPipelineStats{m_submitted.load(), m_analyzed.load(), m_dropped.load(),
+                                 enqueued > dequeued ? enqueued - dequeued : 0, m_mask + 1};
+}
+
+bool AnalysisPipeline::tryPush(ExchangeSnapshot& snapshot) {
+    size_t position = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = m_cells[position & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+        if (difference == 0) {
+            if (m_enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.snapshot = std::move(snapshot);
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;   // Llena: la celda aún guarda el intercambio de la vuelta anterior
+        } else {
+            position = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool AnalysisPipeline::tryPop(ExchangeSnapshot& snapshot) {
+    size_t position = m_dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = m_cells[position & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+        if (difference == 0) {
+            if (m_dequeuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                snapshot = std::move(cell.snapshot);
+                cell.snapshot = ExchangeSnapshot();   // Soltar los bloques de los cuerpos
+                cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;   // Vacía, o el productor aún está escribiendo la celda
+        } else {
+            position = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void AnalysisPipeline::run() {
+    for (;;) {
+        m_items.acquire();
+        if (m_stopping) {
+            return;
+        }
+
+        ExchangeSnapshot snapshot;
+        while (!tryPop(snapshot)) {
+            std::this_thread::yield();
+        }
+        m_slots.release();
+
+        std::vector<std::string> findings = m_analyzer.analyzeRequest(snapshot.url, snapshot.method,
+                                                                      snapshot.requestHeaders, snapshot.requestBody);
+        if (snapshot.statusCode != 0) {
+            std::vector<std::string> responseFindings = m_analyzer.analyzeResponse(
+                snapshot.statusCode, snapshot.responseHeaders, snapshot.responseBody);
+            findings.insert(findings.end(), std::make_move_iterator(responseFindings.begin()),
+                            std::make_move_iterator(responseFindings.end()));
+        }
+        m_analyzed++;
+
+        if (findings.empty()) {
+            continue;
+        }
+
+        FindingHandler handler;
+        {
+            std::lock_guard<std::mutex> lock(m_handlerMutex);
+            handler = m_handler;
+        }
+        if (handler) {
+            handler(snapshot, findings);
+        } else {
+            for (const auto& finding : findings) {
+                Utils::Logging::Logger::warning("AnalysisPipeline: " + snapshot.url + ": " + finding);
+            }
+        }
+    }
+}
+
+} // namespace Core::Network
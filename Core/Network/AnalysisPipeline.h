@@ -0,0 +1,157 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Análisis pasivo del tráfico en segundo plano
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <semaphore>
+#include "ByteBuffer.h"
+
+namespace Core::Network {
+
+class TrafficAnalyzer;
+
+/**
+ * Copia inmutable de un intercambio solicitud/respuesta
+ * Los cuerpos comparten los bloques de los originales, así que copiarla es barato.
+ */
+struct ExchangeSnapshot {
+    std::string url;
+    std::string method;
+    std::vector<std::pair<std::string, std::string>> requestHeaders;
+    ByteBuffer requestBody;
+    int statusCode = 0;    // 0 si la solicitud falló
+    std::vector<std::pair<std::string, std::string>> responseHeaders;
+    ByteBuffer responseBody;
+};
+
+/**
+ * Qué hacer cuando la cola de análisis está llena
+ */
+enum class OverflowPolicy {
+    DROP_NEWEST,   // Descartar el intercambio que llega (nunca frena el tráfico)
+    DROP_OLDEST,   // Descartar el intercambio más antiguo de la cola
+    BLOCK          // Esperar a que haya hueco (frena el tráfico hasta que el análisis lo alcance)
+};
+
+/**
+ * Estadísticas del análisis en segundo plano
+ */
+struct AnalysisPipelineStats {
+    size_t submitted;    // Intercambios entregados
+    size_t analyzed;     // Intercambios analizados
+    size_t dropped;      // Intercambios descartados por la política de desbordamiento
+    size_t queued;       // Intercambios en espera
+    size_t capacity;     // Tamaño de la cola
+};
+
+/**
+ * Cola de análisis pasivo del tráfico
+ * El camino del tráfico solo deja una copia de cada intercambio en un buffer
+ * circular acotado y sin cerrojos (cada celda lleva un número de secuencia
+ * que indica si está libre u ocupada, por lo que los productores y los
+ * hilos de análisis solo compiten por dos contadores atómicos). Un grupo de
+ * hilos la vacía pasando cada intercambio por el TrafficAnalyzer, de modo que
+ * la latencia del análisis no se suma a la de las páginas.
+ *
+ * Cuando la cola se llena se aplica la política de desbordamiento y los
+ * descartes se cuentan en las estadísticas. Es segura para usarla desde
+ * varios hilos; el analizador debe vivir más que la cola.
+ */
+class AnalysisPipeline {
+public:
+    /**
+     * Función a la que se entregan las vulnerabilidades de un intercambio
+     * Se llama desde los hilos de análisis.
+     */
+    using FindingHandler = std::function<void(const ExchangeSnapshot&, const std::vector<std::string>&)>;
+
+    /**
+     * Constructor
+     * @param analyzer Analizador que examina los intercambios
+     * @param capacity Intercambios en espera como máximo (se redondea a potencia de dos)
+     * @param workers Hilos de análisis
+     */
+    explicit AnalysisPipeline(TrafficAnalyzer& analyzer, size_t capacity = 1024, size_t workers = 2);
+
+    /**
+     * Destructor
+     * Detiene los hilos de análisis; los intercambios en espera se descartan.
+     */
+    ~AnalysisPipeline();
+
+    AnalysisPipeline(const AnalysisPipeline&) = delete;
+    AnalysisPipeline& operator=(const AnalysisPipeline&) = delete;
+
+    /**
+     * Entrega un intercambio para analizarlo
+     * @param snapshot Intercambio
+     * @return true si quedó en la cola, false si se descartó
+     */
+    bool submit(ExchangeSnapshot snapshot);
+
+    /**
+     * Establece la política de desbordamiento
+     * @param policy Política (por defecto DROP_NEWEST)
+     */
+    void setOverflowPolicy(OverflowPolicy policy);
+
+    /**
+     * Establece la función que recibe las vulnerabilidades encontradas
+     * @param handler Función (se ignoran los resultados si está vacía)
+     */
+    void setFindingHandler(FindingHandler handler);
+
+    /**
+     * Obtiene las estadísticas del análisis
+     * @return Estadísticas actuales
+     */
+    AnalysisPipelineStats getStats() const;
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        ExchangeSnapshot snapshot;
+    };
+
+    bool tryPush(ExchangeSnapshot& snapshot);
+    bool tryPop(ExchangeSnapshot& snapshot);
+    void run();
+
+    TrafficAnalyzer& m_analyzer;
+
+    // Buffer circular: una celda está libre para la posición p cuando su
+    // secuencia vale p y ocupada cuando vale p + 1
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask;
+    alignas(64) std::atomic<size_t> m_enqueuePos;
+    alignas(64) std::atomic<size_t> m_dequeuePos;
+
+    // Espera de los hilos sin trabajo y de los productores con BLOCK
+    std::counting_semaphore<> m_items;
+    std::counting_semaphore<> m_slots;
+
+    std::atomic<OverflowPolicy> m_policy;
+    std::atomic<bool> m_stopping;
+
+    std::mutex m_handlerMutex;
+    FindingHandler m_handler;
+
+    // Estadísticas
+    std::atomic<size_t> m_submitted;
+    std::atomic<size_t> m_analyzed;
+    std::atomic<size_t> m_dropped;
+
+    std::vector<std::thread> m_workers;
+};
+
+} // namespace Core::Network
@@ -0,0 +1,178 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación de la descompresión en flujo de cuerpos HTTP
+ */
+
+#include "BodyDecoder.h"
+#include "../../Utils/Text/StringUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <string_view>
+
+namespace Core::Network {
+
+namespace {
+
+// Tamaño de los bloques donde se escribe el cuerpo descomprimido
+constexpr size_t DECODE_BLOCK_SIZE = 64 * 1024;
+
+// Espacio libre mínimo para seguir escribiendo en el bloque actual
+constexpr size_t MIN_DECODE_SPACE = 4 * 1024;
+
+// Proporción máxima entre salida y entrada; deflate no pasa de ~1032:1, así que
+// solo la alcanzan datos triviales o bombas de compresión anidadas
+constexpr size_t MAX_COMPRESSION_RATIO = 1000;
+
+// Salida a partir de la cual se aplica la proporción máxima
+constexpr size_t RATIO_CHECK_THRESHOLD = 1024 * 1024;
+
+using Utils::Text::equalsIgnoreCase;
+using Utils::Text::trim;
+
+} // namespace
+
+BodyDecoder::BodyDecoder(Format format) :
+    m_format(format),
+    m_initialized(false),
+    m_finished(false),
+    m_blockUsed(DECODE_BLOCK_SIZE),
+    m_maxDecodedSize(DEFAULT_MAX_DECODED_SIZE),
+    m_inputSize(0),
+    m_outputSize(0) {
+    std::memset(&m_stream, 0, sizeof(m_stream));
+}
+
+BodyDecoder::~BodyDecoder() {
+    if (m_initialized) {
+        inflateEnd(&m_stream);
+    }
+}
+
+std::unique_ptr<BodyDecoder> BodyDecoder::forContentEncoding(const std::string& contentEncoding) {
+    std::string_view selected;
+    size_t count = 0;
+
+    size_t start = 0;
+    while (start <= contentEncoding.size()) {
+        size_t end = contentEncoding.find(',', start);
+        if (end == std::string::npos) end = contentEncoding.size();
+        std::string_view item = trim(std::string_view(contentEncoding.data() + start, end - start));
+        if (!item.empty() && !equalsIgnoreCase(item, "identity")) {
+            selected = item;
+            count++;
+        }
+        start = end + 1;
+    }
+
+    if (count != 1) {
+        return nullptr;
+    }
+    if (equalsIgnoreCase(selected, "gzip") || equalsIgnoreCase(selected, "x-gzip")) {
+        return std::make_unique<BodyDecoder>(Format::GZIP);
+    }
+    if (equalsIgnoreCase(selected, "deflate")) {
+        return std::make_unique<BodyDecoder>(Format::DEFLATE);
+    }
+    return nullptr;
+}
+
+bool BodyDecoder::decode(const uint8_t* data, size_t length, ByteBuffer& output) {
+    if (!m_initialized) {
+        // deflate debería llevar cabecera zlib, pero hay servidores que envían
+        // deflate sin envoltura: se decide con los dos primeros bytes
+        m_sniff.insert(m_sniff.end(), data, data + length);
+        if (m_format == Format::DEFLATE && m_sniff.size() < 2) {
+            return true;
+        }
+
+        int windowBits = 15 + 16;
+        if (m_format == Format::DEFLATE) {
+            bool zlibHeader = (m_sniff[0] & 0x0F) == 8 && ((m_sniff[0] << 8) | m_sniff[1]) % 31 == 0;
+            windowBits = zlibHeader ? 15 : -15;
+        }
+        if (inflateInit2(&m_stream, windowBits) != Z_OK) {
+            return fail("No se pudo inicializar zlib");
+        }
+        m_initialized = true;
+
+        std::vector<uint8_t> pending;
+        pending.swap(m_sniff);
+        return inflateInput(pending.data(), pending.size(), output);
+    }
+
+    return inflateInput(data, length, output);
+}
+
+bool BodyDecoder::inflateInput(const uint8_t* data, size_t length, ByteBuffer& output) {
+    m_stream.next_in = const_cast<Bytef*>(data);
+    m_stream.avail_in = static_cast<uInt>(length);
+
+    while (true) {
+        if (m_finished) {
+            if (m_stream.avail_in == 0) {
+                break;
+            }
+            // Varios miembros gzip concatenados forman un único cuerpo
+            if (m_format != Format::GZIP || inflateReset(&m_stream) != Z_OK) {
+                return true; // Datos sobrantes tras el final: se ignoran
+            }
+            m_finished = false;
+        }
+
+        if (DECODE_BLOCK_SIZE - m_blockUsed < MIN_DECODE_SPACE) {
+            m_block = std::make_shared_for_overwrite<uint8_t[]>(DECODE_BLOCK_SIZE);
+            m_blockUsed = 0;
+        }
+
+        uint8_t* out = m_block.get() + m_blockUsed;
+        m_stream.next_out = out;
+        m_stream.avail_out = static_cast<uInt>(DECODE_BLOCK_SIZE - m_blockUsed);
+
+        uInt availableInput = m_stream.avail_in;
+        int result = inflate(&m_stream, Z_NO_FLUSH);
+        m_inputSize += availableInput - m_stream.avail_in;
+        if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+            return fail("Cuerpo comprimido corrupto");
+        }
+
+        size_t produced = static_cast<size_t>(m_stream.next_out - out);
+        m_outputSize += produced;
+        if (m_maxDecodedSize > 0 && m_outputSize > m_maxDecodedSize) {
+            return fail("El cuerpo descomprimido supera el tamaño máximo");
+        }
+        if (m_outputSize > RATIO_CHECK_THRESHOLD && m_outputSize / MAX_COMPRESSION_RATIO > m_inputSize) {
+            return fail("Proporción de compresión anómala (posible bomba de compresión)");
+        }
+        if (produced > 0) {
+            output.append(std::shared_ptr<const void>(m_block), out, produced);
+            m_blockUsed += produced;
+        }
+
+        if (result == Z_STREAM_END) {
+            m_finished = true;
+        } else if (result == Z_BUF_ERROR && produced == 0) {
+            break;
+        } else if (m_stream.avail_in == 0 && m_stream.avail_out > 0) {
+            // Sin salida pendiente: zlib solo retiene datos si llenó el bloque
+            break;
+        }
+    }
+    return true;
+}
+
+void BodyDecoder::setMaxDecodedSize(size_t maxSize) {
+    m_maxDecodedSize = maxSize;
+}
+
+const std::string& BodyDecoder::getError() const {
+    return m_error;
+}
+
+bool BodyDecoder::fail(const std::string& message) {
+    m_error = message;
+    return false;
+}
+
+} // namespace Core::Network
@@ -0,0 +1,95 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Descompresión en flujo de cuerpos HTTP (gzip y deflate)
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <zlib.h>
+#include "ByteBuffer.h"
+
+namespace Core::Network {
+
+/**
+ * Descompresor en flujo de gzip y deflate basado en zlib
+ * La salida se escribe en bloques compartidos y se entrega como trozos de ByteBuffer.
+ * Para protegerse de bombas de compresión, la descompresión falla si el cuerpo
+ * supera un tamaño máximo o una proporción de compresión anómala.
+ */
+class BodyDecoder {
+public:
+    enum class Format {
+        GZIP,
+        DEFLATE
+    };
+
+    // Tamaño máximo por defecto del cuerpo descomprimido
+    static constexpr size_t DEFAULT_MAX_DECODED_SIZE = 256 * 1024 * 1024;
+
+    /**
+     * Constructor
+     * @param format Formato de los datos comprimidos
+     */
+    explicit BodyDecoder(Format format);
+
+    /**
+     * Destructor
+     */
+    ~BodyDecoder();
+
+    BodyDecoder(const BodyDecoder&) = delete;
+    BodyDecoder& operator=(const BodyDecoder&) = delete;
+
+    /**
+     * Crea el descompresor adecuado para una cabecera Content-Encoding
+     * Solo se admite una única codificación conocida; con varias o con una
+     * desconocida el cuerpo debe entregarse tal cual.
+     * @param contentEncoding Valor de la cabecera Content-Encoding
+     * @return Descompresor, o nullptr si no hay que descomprimir
+     */
+    static std::unique_ptr<BodyDecoder> forContentEncoding(const std::string& contentEncoding);
+
+    /**
+     * Descomprime datos y añade el resultado a output
+     * @param data Datos comprimidos
+     * @param length Número de bytes
+     * @param output Búfer donde se añaden los datos descomprimidos
+     * @return false si los datos están corruptos o se superan los límites
+     */
+    bool decode(const uint8_t* data, size_t length, ByteBuffer& output);
+
+    /**
+     * Establece el tamaño máximo del cuerpo descomprimido
+     * @param maxSize Bytes descomprimidos permitidos (0 = sin límite)
+     */
+    void setMaxDecodedSize(size_t maxSize);
+
+    /**
+     * Obtiene el motivo del último fallo de decode
+     * @return Descripción del error
+     */
+    const std::string& getError() const;
+
+private:
+    bool inflateInput(const uint8_t* data, size_t length, ByteBuffer& output);
+    bool fail(const std::string& message);
+
+    Format m_format;
+    z_stream m_stream;
+    bool m_initialized;
+    bool m_finished;
+    std::vector<uint8_t> m_sniff;
+    std::shared_ptr<uint8_t[]> m_block;
+    size_t m_blockUsed;
+    size_t m_maxDecodedSize;
+    size_t m_inputSize;
+    size_t m_outputSize;
+    std::string m_error;
+};
+
+} // namespace Core::Network
@@ -0,0 +1,242 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación del búfer de bytes compartido
+ */
+
+#include "ByteBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace Core::Network {
+
+ByteBuffer::ByteBuffer(ByteBuffer&& other) noexcept :
+    m_chunks(std::move(other.m_chunks)),
+    m_size(std::exchange(other.m_size, 0)) {
+    other.m_chunks.clear();
+}
+
+ByteBuffer& ByteBuffer::operator=(ByteBuffer&& other) noexcept {
+    if (this != &other) {
+        m_chunks = std::move(other.m_chunks);
+        m_size = std::exchange(other.m_size, 0);
+        other.m_chunks.clear();
+    }
+    return *this;
+}
+
+ByteBuffer::ByteBuffer(std::vector<uint8_t>&& data) {
+    if (data.empty()) {
+        return;
+    }
+    auto owner = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+    append(owner, owner->data(), owner->size());
+}
+
+ByteBuffer::ByteBuffer(std::string&& data) {
+    if (data.empty()) {
+        return;
+    }
+    auto owner = std::make_shared<const std::string>(std::move(data));
+    append(owner, reinterpret_cast<const uint8_t*>(owner->data()), owner->size());
+}
+
+ByteBuffer ByteBuffer::copyOf(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    return ByteBuffer(std::vector<uint8_t>(bytes, bytes + size));
+}
+
+ByteBuffer ByteBuffer::wrap(std::shared_ptr<const void> owner, const uint8_t* data, size_t size) {
+    ByteBuffer buffer;
+    buffer.append(owner, data, size);
+    return buffer;
+}
+
+void ByteBuffer::append(const ByteBuffer& other) {
+    if (&other == this) {
+        std::vector<Chunk> copy = m_chunks;
+        for (const auto& chunk : copy) {
+            append(chunk.owner, chunk.data, chunk.size);
+        }
+        return;
+    }
+    for (const auto& chunk : other.m_chunks) {
+        append(chunk.owner, chunk.data, chunk.size);
+    }
+}
+
+void ByteBuffer::append(const std::shared_ptr<const void>& owner, const uint8_t* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    // Datos recibidos seguidos en el mismo bloque forman un único fragmento
+    if (!m_chunks.empty()) {
+        Chunk& last = m_chunks.back();
+        if (last.owner == owner && last.data + last.size == data) {
+            last.size += size;
+            m_size += size;
+            return;
+        }
+    }
+
+    m_chunks.push_back({owner, data, size});
+    m_size += size;
+}
+
+void ByteBuffer::clear() {
+    m_chunks.clear();
+    m_size = 0;
+}
+
+std::span<const uint8_t> ByteBuffer::chunk(size_t index) const {
+    const Chunk& chunk = m_chunks.at(index);
+    return {chunk.data, chunk.size};
+}
+
+std::string_view ByteBuffer::chunkView(size_t index) const {
+    const Chunk& chunk = m_chunks.at(index);
+    return {reinterpret_cast<const char*>(chunk.data), chunk.size};
+}
+
+ByteBuffer ByteBuffer::slice(size_t offset, size_t length) const {
+    ByteBuffer result;
+    if (offset >= m_size) {
+        return result;
+    }
+    length = std::min(length, m_size - offset);
+
+    size_t index = locate(offset);
+    while (length > 0 && index < m_chunks.size()) {
+        const Chunk& chunk = m_chunks[index];
+        size_t take = std::min(length, chunk.size - offset);
+        result.append(chunk.owner, chunk.data + offset, take);
+        length -= take;
+        offset = 0;
+        index++;
+    }
+    return result;
+}
+
+uint8_t ByteBuffer::at(size_t index) const {
+    if (index >= m_size) {
+        throw std::out_of_range("ByteBuffer::at");
+    }
+    size_t chunkIndex = locate(index);
+    return m_chunks[chunkIndex].data[index];
+}
+
+std::string_view ByteBuffer::view() const {
+    if (m_chunks.empty()) {
+        return {};
+    }
+
+    if (m_chunks.size() > 1) {
+        auto joined = std::make_shared<std::vector<uint8_t>>(m_size);
+        copyTo(joined->data(), 0, m_size);
+        m_chunks.clear();
+        m_chunks.push_back({joined, joined->data(), joined->size()});
+    }
+
+    return {reinterpret_cast<const char*>(m_chunks[0].data), m_chunks[0].size};
+}
+
+size_t ByteBuffer::find(std::string_view needle, size_t from) const {
+    if (needle.empty()) {
+        return from <= m_size ? from : npos;
+    }
+    if (from >= m_size || needle.size() > m_size - from) {
+        return npos;
+    }
+
+    size_t base = 0;
+    for (size_t i = 0; i < m_chunks.size(); i++) {
+        const Chunk& chunk = m_chunks[i];
+        std::string_view text(reinterpret_cast<const char*>(chunk.data), chunk.size);
+        size_t start = from > base ? from - base : 0;
+
+        // Coincidencias completas dentro del fragmento
+        if (start < text.size()) {
+            size_t found = text.find(needle, start);
+            if (found != std::string_view::npos) {
+                return base + found;
+            }
+
+            // Coincidencias que empiezan al final del fragmento y siguen en los siguientes
+            size_t tailStart = std::max(start, text.size() >= needle.size() ? text.size() - needle.size() + 1 : 0);
+            for (size_t position = tailStart; position < text.size(); position++) {
+                size_t absolute = base + position;
+                if (absolute + needle.size() > m_size) {
+                    break;
+                }
+                size_t matched = 0;
+                size_t chunkIndex = i;
+                size_t chunkOffset = position;
+                while (matched < needle.size()) {
+                    if (chunkOffset == m_chunks[chunkIndex].size) {
+                        chunkIndex++;
+                        chunkOffset = 0;
+                        continue;
+                    }
+                    if (static_cast<char>(m_chunks[chunkIndex].data[chunkOffset]) != needle[matched]) {
+                        break;
+                    }
+                    matched++;
+                    chunkOffset++;
+                }
+                if (matched == needle.size()) {
+                    return absolute;
+                }
+            }
+        }
+
+        base += chunk.size;
+    }
+    return npos;
+}
+
+size_t ByteBuffer::copyTo(void* destination, size_t offset, size_t length) const {
+    if (offset >= m_size) {
+        return 0;
+    }
+    length = std::min(length, m_size - offset);
+
+    uint8_t* output = static_cast<uint8_t*>(destination);
+    size_t copied = 0;
+    size_t index = locate(offset);
+    while (copied < length && index < m_chunks.size()) {
+        const Chunk& chunk = m_chunks[index];
+        size_t take = std::min(length - copied, chunk.size - offset);
+        std::memcpy(output + copied, chunk.data + offset, take);
+        copied += take;
+        offset = 0;
+        index++;
+    }
+    return copied;
+}
+
+std::string ByteBuffer::toString() const {
+    std::string result(m_size, '\0');
+    copyTo(result.data(), 0, m_size);
+    return result;
+}
+
+std::vector<uint8_t> ByteBuffer::toVector() const {
+    std::vector<uint8_t> result(m_size);
+    copyTo(result.data(), 0, m_size);
+    return result;
+}
+
+size_t ByteBuffer::locate(size_t& offset) const {
+    for (size_t i = 0; i < m_chunks.size(); i++) {
+        if (offset < m_chunks[i].size) {
+            return i;
+        }
+        offset -= m_chunks[i].size;
+    }
+    return m_chunks.size();
+}
+
+} // namespace Core::Network
@@ -0,0 +1,200 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Búfer de bytes compartido y troceable para los cuerpos de las respuestas
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <span>
+#include <cstdint>
+
+namespace Core::Network {
+
+/**
+ * Secuencia de bytes formada por fragmentos compartidos (rope)
+ * Cada fragmento apunta a memoria con contador de referencias, normalmente el
+ * bloque donde se recibieron los datos del socket. Copiar, concatenar y trocear
+ * un ByteBuffer solo copia referencias, nunca los bytes.
+ *
+ * Los bytes son inmutables. Una misma instancia no debe usarse desde varios
+ * hilos sin sincronización (view() puede reorganizarla), pero sí copias distintas
+ * que compartan los mismos fragmentos.
+ */
+class ByteBuffer {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * Constructor de un búfer vacío
+     */
+    ByteBuffer() = default;
+
+    ByteBuffer(const ByteBuffer&) = default;
+    ByteBuffer& operator=(const ByteBuffer&) = default;
+    ByteBuffer(ByteBuffer&& other) noexcept;
+    ByteBuffer& operator=(ByteBuffer&& other) noexcept;
+
+    /**
+     * Constructor que toma posesión de un vector sin copiarlo
+     * @param data Datos del búfer
+     */
+    explicit ByteBuffer(std::vector<uint8_t>&& data);
+
+    /**
+     * Constructor que toma posesión de una cadena sin copiarla
+     * @param data Datos del búfer
+     */
+    explicit ByteBuffer(std::string&& data);
+
+    /**
+     * Crea un búfer con una copia de los datos
+     * @param data Datos a copiar
+     * @param size Número de bytes
+     * @return Búfer con los datos copiados
+     */
+    static ByteBuffer copyOf(const void* data, size_t size);
+
+    /**
+     * Crea un búfer que referencia memoria ya existente
+     * @param owner Propietario de la memoria; se mantiene vivo mientras se use el búfer
+     * @param data Inicio de los datos dentro de la memoria de owner
+     * @param size Número de bytes
+     * @return Búfer que referencia los datos
+     */
+    static ByteBuffer wrap(std::shared_ptr<const void> owner, const uint8_t* data, size_t size);
+
+    /**
+     * Añade al final los fragmentos de otro búfer
+     * @param other Búfer a añadir
+     */
+    void append(const ByteBuffer& other);
+
+    /**
+     * Añade al final un fragmento de memoria compartida
+     * Si continúa al último fragmento en la misma memoria, ambos se fusionan.
+     * @param owner Propietario de la memoria
+     * @param data Inicio de los datos
+     * @param size Número de bytes
+     */
+    void append(const std::shared_ptr<const void>& owner, const uint8_t* data, size_t size);
+
+    /**
+     * Obtiene el número total de bytes
+     * @return Tamaño del búfer
+     */
+    size_t size() const { return m_size; }
+
+    /**
+     * Comprueba si el búfer está vacío
+     * @return true si no contiene bytes
+     */
+    bool empty() const { return m_size == 0; }
+
+    /**
+     * Vacía el búfer liberando sus referencias
+     */
+    void clear();
+
+    /**
+     * Obtiene el número de fragmentos
+     * @return Número de fragmentos
+     */
+    size_t chunkCount() const { return m_chunks.size(); }
+
+    /**
+     * Obtiene un fragmento
+     * @param index Índice del fragmento
+     * @return Bytes del fragmento
+     */
+    std::span<const uint8_t> chunk(size_t index) const;
+
+    /**
+     * Obtiene un fragmento como texto
+     * @param index Índice del fragmento
+     * @return Vista del fragmento
+     */
+    std::string_view chunkView(size_t index) const;
+
+    /**
+     * Obtiene un trozo del búfer sin copiar los bytes
+     * @param offset Posición inicial
+     * @param length Número de bytes (npos hasta el final)
+     * @return Búfer con el trozo
+     */
+    ByteBuffer slice(size_t offset, size_t length = npos) const;
+
+    /**
+     * Obtiene un byte
+     * @param index Posición del byte
+     * @return Valor del byte
+     */
+    uint8_t at(size_t index) const;
+
+    /**
+     * Comprueba si todos los bytes están en un único fragmento
+     * @return true si el búfer es contiguo
+     */
+    bool isContiguous() const { return m_chunks.size() <= 1; }
+
+    /**
+     * Obtiene una vista contigua de todo el búfer
+     * Si hay varios fragmentos se unen en uno solo (la única copia de los datos)
+     * y la instancia pasa a usarlo en adelante.
+     * @return Vista de los bytes
+     */
+    std::string_view view() const;
+
+    /**
+     * Busca una secuencia de bytes, también a través de los límites entre fragmentos
+     * @param needle Secuencia a buscar
+     * @param from Posición desde la que buscar
+     * @return Posición de la primera aparición, o npos si no aparece
+     */
+    size_t find(std::string_view needle, size_t from = 0) const;
+
+    /**
+     * Copia bytes a memoria externa
+     * @param destination Memoria de destino
+     * @param offset Posición inicial en el búfer
+     * @param length Número máximo de bytes
+     * @return Número de bytes copiados
+     */
+    size_t copyTo(void* destination, size_t offset, size_t length) const;
+
+    /**
+     * Copia el contenido a una cadena
+     * @return Cadena con los bytes
+     */
+    std::string toString() const;
+
+    /**
+     * Copia el contenido a un vector
+     * @return Vector con los bytes
+     */
+    std::vector<uint8_t> toVector() const;
+
+private:
+    struct Chunk {
+        std::shared_ptr<const void> owner;
+        const uint8_t* data;
+        size_t size;
+    };
+
+    // Fragmentos en orden; mutable porque view() los puede unir
+    mutable std::vector<Chunk> m_chunks;
+    size_t m_size = 0;
+
+    /**
+     * Localiza el fragmento que contiene una posición
+     * @param offset Posición en el búfer (se convierte en posición dentro del fragmento)
+     * @return Índice del fragmento
+     */
+    size_t locate(size_t& offset) const;
+};
+
+} // namespace Core::Network
@@ -0,0 +1,1020 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación de la resolución DNS asíncrona y de la caché
+ */
+
+#include "DnsResolver.h"
+#include "../../Utils/Logging/Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+namespace Core::Network {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Tipos de registro
+constexpr uint16_t TYPE_A = 1;
+constexpr uint16_t TYPE_CNAME = 5;
+constexpr uint16_t TYPE_SOA = 6;
+constexpr uint16_t TYPE_AAAA = 28;
+constexpr uint16_t TYPE_OPT = 41;
+
+// Tipo de cada pregunta de una consulta
+constexpr uint16_t QUESTION_TYPES[2] = {TYPE_A, TYPE_AAAA};
+
+// Bit TC de la cabecera: la respuesta no cabía en UDP
+constexpr uint16_t FLAG_TRUNCATED = 0x0200;
+
+// Códigos de respuesta
+constexpr int RCODE_NOERROR = 0;
+constexpr int RCODE_NXDOMAIN = 3;
+
+// Intentos por consulta; el tiempo de espera se duplica en cada uno
+constexpr int MAX_ATTEMPTS = 3;
+constexpr auto FIRST_TIMEOUT = std::chrono::milliseconds(1000);
+
+// TTL de las respuestas negativas sin SOA y de los fallos (tiempo agotado, SERVFAIL)
+constexpr std::chrono::seconds DEFAULT_NEGATIVE_TTL(30);
+constexpr std::chrono::seconds FAILURE_TTL(5);
+
+// Entradas máximas de la caché antes de descartar las más antiguas
+constexpr size_t MAX_CACHE_ENTRIES = 10000;
+
+// Tamaño de UDP que se anuncia con EDNS0 para evitar respuestas truncadas
+constexpr uint16_t EDNS_UDP_SIZE = 1232;
+
+// ndots predeterminado de resolv.conf y máximo que admite la libc
+constexpr int DEFAULT_NDOTS = 1;
+constexpr int MAX_NDOTS = 15;
+
+/**
+ * Normaliza un nombre: minúsculas, sin punto final ni corchetes de IPv6
+ */
+std::string normalizeHost(const std::string& host) {
+    std::string name = host;
+    if (name.size() > 2 && name.front() == '[' && name.back() == ']') {
+        name = name.substr(1, name.size() - 2);
+    }
+    if (!name.empty() && name.back() == '.') {
+        name.pop_back();
+    }
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return name;
+}
+
+uint16_t readUint16(const uint8_t* data) {
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+uint32_t readUint32(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+void writeUint16(std::vector<uint8_t>& output, uint16_t value) {
+    output.push_back(static_cast<uint8_t>(value >> 8));
+    output.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * Lee un nombre de un mensaje DNS siguiendo los punteros de compresión
+ * @param offset Posición del nombre; avanza hasta después del nombre
+ */
+bool readName(const uint8_t* message, size_t length, size_t& offset, std::string& name) {
+    name.clear();
+    size_t position = offset;
+    bool jumped = false;
+
+    for (int jumps = 0; jumps < 32;) {
+        if (position >= length) {
+            return false;
+        }
+        uint8_t labelLength = message[position];
+
+        if ((labelLength & 0xC0) == 0xC0) {
+            if (position + 1 >= length) {
+                return false;
+            }
+            if (!jumped) {
+                offset = position + 2;
+                jumped = true;
+            }
+            position = static_cast<size_t>(((labelLength & 0x3F) << 8) | message[position + 1]);
+            jumps++;
+            continue;
+        }
+        if (labelLength & 0xC0) {
+            return false;
+        }
+
+        position++;
+        if (labelLength == 0) {
+            if (!jumped) {
+                offset = position;
+            }
+            return true;
+        }
+        if (position + labelLength > length || name.size() + labelLength > 255) {
+            return false;
+        }
+        if (!name.empty()) {
+            name += '.';
+        }
+        for (size_t i = 0; i < labelLength; i++) {
+            name += static_cast<char>(std::tolower(message[position + i]));
+        }
+        position += labelLength;
+    }
+    return false;
+}
+
+/**
+ * Construye una consulta con recursión y EDNS0
+ */
+bool buildQuery(uint16_t id, const std::string& host, uint16_t type, std::vector<uint8_t>& packet) {
+    packet.clear();
+    writeUint16(packet, id);
+    writeUint16(packet, 0x0100);   // RD
+    writeUint16(packet, 1);        // QDCOUNT
+    writeUint16(packet, 0);
+    writeUint16(packet, 0);
+    writeUint16(packet, 1);        // ARCOUNT (OPT)
+
+    size_t start = 0;
+    while (start < host.size()) {
+        size_t end = host.find('.', start);
+        if (end == std::string::npos) end = host.size();
+        size_t labelLength = end - start;
+        if (labelLength == 0 || labelLength > 63) {
+            return false;
+        }
+        packet.push_back(static_cast<uint8_t>(labelLength));
+        packet.insert(packet.end(), host.begin() + start, host.begin() + end);
+        start = end + 1;
+    }
+    packet.push_back(0);
+    if (packet.size() > 12 + 255) {
+        return false;
+    }
+    writeUint16(packet, type);
+    writeUint16(packet, 1);        // IN
+
+    // Registro OPT: nombre raíz, tamaño UDP en la clase, sin opciones
+    packet.push_back(0);
+    writeUint16(packet, TYPE_OPT);
+    writeUint16(packet, EDNS_UDP_SIZE);
+    writeUint16(packet, 0);
+    writeUint16(packet, 0);
+    writeUint16(packet, 0);
+    return true;
+}
+
+/**
+ * Divide "host", "host:puerto" o "[v6]:puerto" en dirección y puerto
+ */
+bool parseServer(const std::string& text, ResolvedAddress& address, int& port) {
+    port = 53;
+    std::string host = text;
+
+    if (!host.empty() && host.front() == '[') {
+        size_t close = host.find(']');
+        if (close == std::string::npos) {
+            return false;
+        }
+        if (close + 2 < host.size() && host[close + 1] == ':') {
+            port = std::atoi(host.c_str() + close + 2);
+        }
+        host = host.substr(1, close - 1);
+    } else if (std::count(host.begin(), host.end(), ':') == 1) {
+        size_t colon = host.find(':');
+        port = std::atoi(host.c_str() + colon + 1);
+        host = host.substr(0, colon);
+    }
+
+    return port > 0 && port < 65536 && ResolvedAddress::parse(host, address);
+}
+
+} // namespace
+
+bool ResolvedAddress::parse(const std::string& text, ResolvedAddress& address) {
+    std::memset(&address, 0, sizeof(address));
+    if (inet_pton(AF_INET, text.c_str(), address.bytes) == 1) {
+        address.family = AF_INET;
+        return true;
+    }
+    if (inet_pton(AF_INET6, text.c_str(), address.bytes) == 1) {
+        address.family = AF_INET6;
+        return true;
+    }
+    return false;
+}
+
+socklen_t ResolvedAddress::toSockaddr(int port, sockaddr_storage& storage) const {
+    std::memset(&storage, 0, sizeof(storage));
+    if (family == AF_INET) {
+        sockaddr_in* ipv4 = reinterpret_cast<sockaddr_in*>(&storage);
+        ipv4->sin_family = AF_INET;
+        ipv4->sin_port = htons(static_cast<uint16_t>(port));
+        std::memcpy(&ipv4->sin_addr, bytes, 4);
+        return sizeof(sockaddr_in);
+    }
+
+    sockaddr_in6* ipv6 = reinterpret_cast<sockaddr_in6*>(&storage);
+    ipv6->sin6_family = AF_INET6;
+    ipv6->sin6_port = htons(static_cast<uint16_t>(port));
+    std::memcpy(&ipv6->sin6_addr, bytes, 16);
+    return sizeof(sockaddr_in6);
+}
+
+std::string ResolvedAddress::toString() const {
+    char buffer[INET6_ADDRSTRLEN] = {};
+    inet_ntop(family, bytes, buffer, sizeof(buffer));
+    return buffer;
+}
+
+DnsCache::DnsCache() :
+    m_maxTtl(3600),
+    m_maxNegativeTtl(300),
+    m_stats{} {
+    loadHostsFile("/etc/hosts");
+
+    // localhost siempre apunta a la interfaz local (RFC 6761)
+    if (!m_systemHosts.count("localhost")) {
+        ResolvedAddress address;
+        ResolvedAddress::parse("127.0.0.1", address);
+        m_systemHosts["localhost"].push_back(address);
+        ResolvedAddress::parse("::1", address);
+        m_systemHosts["localhost"].push_back(address);
+    }
+}
+
+DnsCache::Status DnsCache::lookup(const std::string& host, std::vector<ResolvedAddress>& addresses) {
+    std::string name = normalizeHost(host);
+    addresses.clear();
+
+    ResolvedAddress literal;
+    if (ResolvedAddress::parse(name, literal)) {
+        addresses.push_back(literal);
+        return Status::FOUND;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto overrideIt = m_overrides.find(name);
+    if (overrideIt != m_overrides.end()) {
+        addresses = overrideIt->second;
+        return Status::FOUND;
+    }
+    auto hostsIt = m_systemHosts.find(name);
+    if (hostsIt != m_systemHosts.end()) {
+        addresses = hostsIt->second;
+        return Status::FOUND;
+    }
+
+    auto it = m_entries.find(name);
+    if (it == m_entries.end() || it->second.expires <= Clock::now()) {
+        return Status::MISS;
+    }
+    if (it->second.addresses.empty()) {
+        m_stats.negativeHits++;
+        return Status::NOT_FOUND;
+    }
+    m_stats.hits++;
+    addresses = it->second.addresses;
+    return Status::FOUND;
+}
+
+void DnsCache::storePositive(const std::string& host, const std::vector<ResolvedAddress>& addresses,
+                             std::chrono::seconds ttl) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Clock::time_point now = Clock::now();
+    purge(now);
+    m_stats.misses++;
+    // TTL 0 significa no guardar, pero la respuesta debe sobrevivir hasta usarse
+    ttl = std::clamp(ttl, std::chrono::seconds(1), std::max(m_maxTtl, std::chrono::seconds(1)));
+    m_entries[normalizeHost(host)] = {addresses, now + ttl};
+}
+
+void DnsCache::storeNegative(const std::string& host, std::chrono::seconds ttl) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Clock::time_point now = Clock::now();
+    purge(now);
+    m_stats.misses++;
+    ttl = std::clamp(ttl, std::chrono::seconds(1), std::max(m_maxNegativeTtl, std::chrono::seconds(1)));
+    m_entries[normalizeHost(host)] = {{}, now + ttl};
+}
+
+bool DnsCache::addHostOverride(const std::string& host, const std::string& address) {
+    ResolvedAddress parsed;
+    if (!ResolvedAddress::parse(normalizeHost(address), parsed)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_overrides[normalizeHost(host)].push_back(parsed);
+    return true;
+}
+
+void DnsCache::removeHostOverride(const std::string& host) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_overrides.erase(normalizeHost(host));
+}
+
+void DnsCache::clearHostOverrides() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_overrides.clear();
+}
+
+void DnsCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+void DnsCache::setTtlLimits(std::chrono::seconds maxTtl, std::chrono::seconds maxNegativeTtl) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxTtl = maxTtl;
+    m_maxNegativeTtl = maxNegativeTtl;
+}
+
+DnsCacheStats DnsCache::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    DnsCacheStats stats = m_stats;
+    stats.entries = m_entries.size();
+    return stats;
+}
+
+void DnsCache::loadHostsFile(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string text;
+        ResolvedAddress address;
+        if (!(fields >> text) || !ResolvedAddress::parse(text, address)) {
+            continue;
+        }
+        std::string name;
+        while (fields >> name) {
+            m_systemHosts[normalizeHost(name)].push_back(address);
+        }
+    }
+}
+
+void DnsCache::purge(Clock::time_point now) {
+    if (m_entries.size() < MAX_CACHE_ENTRIES) {
+        return;
+    }
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        it = it->second.expires <= now ? m_entries.erase(it) : std::next(it);
+    }
+    // Si todas siguen vigentes, descartar las que caducan antes
+    while (m_entries.size() >= MAX_CACHE_ENTRIES) {
+        auto oldest = std::min_element(m_entries.begin(), m_entries.end(), [](const auto& a, const auto& b) {
+            return a.second.expires < b.second.expires;
+        });
+        m_entries.erase(oldest);
+    }
+}
+
+DnsResolver::DnsResolver(std::shared_ptr<DnsCache> cache) :
+    m_cache(std::move(cache)),
+    m_ndots(DEFAULT_NDOTS),
+    m_fd(-1),
+    m_pollFd(-1),
+    m_family(AF_UNSPEC),
+    m_random(std::random_device{}()) {
+    loadResolvConf();
+    openSocket();
+}
+
+DnsResolver::~DnsResolver() {
+    for (const auto& entry : m_tcp) {
+        close(entry.first);
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+    if (m_pollFd >= 0) {
+        close(m_pollFd);
+    }
+}
+
+bool DnsResolver::setNameservers(const std::vector<std::string>& servers) {
+    std::vector<std::pair<ResolvedAddress, int>> parsed;
+    for (const auto& server : servers) {
+        ResolvedAddress address;
+        int port;
+        if (parseServer(server, address, port)) {
+            parsed.emplace_back(address, port);
+        }
+    }
+    if (parsed.empty()) {
+        return false;
+    }
+    m_servers = std::move(parsed);
+    return true;
+}
+
+void DnsResolver::setSearchDomains(const std::vector<std::string>& domains, int ndots) {
+    m_searchDomains.clear();
+    for (const auto& domain : domains) {
+        std::string name = normalizeHost(domain);
+        if (!name.empty()) {
+            m_searchDomains.push_back(name);
+        }
+    }
+    m_ndots = std::clamp(ndots, 0, MAX_NDOTS);
+}
+
+void DnsResolver::resolve(const std::string& host, Callback callback) {
+    bool absolute = !host.empty() && host.back() == '.';
+    std::string name = normalizeHost(host);
+
+    std::vector<ResolvedAddress> addresses;
+    switch (m_cache->lookup(name, addresses)) {
+        case DnsCache::Status::FOUND:
+            callback(addresses);
+            return;
+        case DnsCache::Status::NOT_FOUND:
+            callback({});
+            return;
+        case DnsCache::Status::MISS:
+            break;
+    }
+
+    // Agrupar con una consulta ya en curso
+    auto it = m_queries.find(name);
+    if (it != m_queries.end()) {
+        it->second.callbacks.push_back(std::move(callback));
+        return;
+    }
+
+    std::vector<std::string> names = searchNames(name, absolute);
+    if (m_fd < 0 || m_servers.empty() || names.empty()) {
+        Utils::Logging::Logger::error("DnsResolver: No se puede consultar " + name);
+        m_cache->storeNegative(name, FAILURE_TTL);
+        callback({});
+        return;
+    }
+
+    Query& query = m_queries[name];
+    query.host = name;
+    query.names = std::move(names);
+    query.nameIndex = 0;
+    for (Question& question : query.questions) {
+        question = {0, false, false, -1};
+    }
+    query.ttl = UINT32_MAX;
+    query.negativeTtl = 0;
+    query.nameError = false;
+    query.attempts = 1;
+    query.server = 0;
+    query.callbacks.push_back(std::move(callback));
+    send(query);
+}
+
+bool DnsResolver::resolveBlocking(const std::string& host, std::vector<ResolvedAddress>& addresses, int timeoutMs) {
+    bool finished = false;
+    addresses.clear();
+    resolve(host, [&](const std::vector<ResolvedAddress>& result) {
+        addresses = result;
+        finished = true;
+    });
+
+    Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!finished) {
+        Clock::time_point now = Clock::now();
+        if (now >= deadline) {
+            // El callback apunta a variables locales: la consulta no puede quedar viva
+            abandon(normalizeHost(host));
+            break;
+        }
+
+        int wait = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count());
+        pollfd descriptor{};
+        descriptor.fd = m_pollFd;
+        descriptor.events = POLLIN;
+        if (poll(&descriptor, 1, std::min(wait, 100)) > 0) {
+            processEvents();
+        }
+        processTimeouts(Clock::now());
+    }
+    return !addresses.empty();
+}
+
+void DnsResolver::processEvents() {
+    epoll_event events[16];
+    int count = epoll_wait(m_pollFd, events, 16, 0);
+    for (int i = 0; i < count; i++) {
+        if (events[i].data.fd != m_fd) {
+            processTcp(events[i].data.fd);
+            continue;
+        }
+
+        uint8_t buffer[4096];
+        while (true) {
+            sockaddr_storage source{};
+            socklen_t sourceLength = sizeof(source);
+            ssize_t received = recvfrom(m_fd, buffer, sizeof(buffer), 0,
+                                        reinterpret_cast<sockaddr*>(&source), &sourceLength);
+            if (received < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            handleResponse(buffer, static_cast<size_t>(received), source, sourceLength, false);
+        }
+    }
+}
+
+void DnsResolver::processTimeouts(Clock::time_point now) {
+    std::vector<std::string> exhausted;
+    for (auto& entry : m_queries) {
+        Query& query = entry.second;
+        if (query.deadline > now) {
+            continue;
+        }
+        if (query.attempts >= MAX_ATTEMPTS) {
+            exhausted.push_back(entry.first);
+            continue;
+        }
+        // Siguiente intento contra el siguiente servidor
+        query.attempts++;
+        query.server = (query.server + 1) % m_servers.size();
+        send(query);
+    }
+
+    for (const auto& host : exhausted) {
+        Utils::Logging::Logger::warning("DnsResolver: Tiempo de espera agotado resolviendo " + host);
+        abandon(host);
+    }
+}
+
+void DnsResolver::loadResolvConf() {
+    std::ifstream file("/etc/resolv.conf");
+    std::string line;
+    std::vector<std::string> servers;
+    std::vector<std::string> search;
+    int ndots = DEFAULT_NDOTS;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string keyword;
+        std::string value;
+        if (!(fields >> keyword >> value)) {
+            continue;
+        }
+        if (keyword == "nameserver") {
+            // Las direcciones IPv6 con zona (fe80::1%eth0) no se admiten
+            servers.push_back(value.find(':') != std::string::npos ? "[" + value + "]" : value);
+        } else if (keyword == "search" || keyword == "domain") {
+            // La última línea search o domain sustituye a las anteriores
+            search = {value};
+            while (keyword == "search" && fields >> value && value[0] != '#' && value[0] != ';') {
+                search.push_back(value);
+            }
+        } else if (keyword == "options") {
+            do {
+                if (value.rfind("ndots:", 0) == 0) {
+                    ndots = std::atoi(value.c_str() + 6);
+                }
+            } while (fields >> value);
+        }
+    }
+    if (servers.empty() || !setNameservers(servers)) {
+        setNameservers({"127.0.0.1"});
+    }
+    setSearchDomains(search, ndots);
+}
+
+bool DnsResolver::openSocket() {
+    // Un socket IPv6 de doble pila llega también a los servidores IPv4
+    m_fd = socket(AF_INET6, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_fd >= 0) {
+        int off = 0;
+        if (setsockopt(m_fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off)) == 0) {
+            m_family = AF_INET6;
+        } else {
+            close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    if (m_fd < 0) {
+        m_fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (m_fd < 0) {
+            Utils::Logging::Logger::error("DnsResolver: No se pudo crear el socket UDP");
+            return false;
+        }
+        m_family = AF_INET;
+    }
+
+    // El socket UDP y las conexiones TCP se vigilan con un único descriptor
+    m_pollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = m_fd;
+    if (m_pollFd < 0 || epoll_ctl(m_pollFd, EPOLL_CTL_ADD, m_fd, &event) != 0) {
+        Utils::Logging::Logger::error("DnsResolver: No se pudo crear el descriptor epoll");
+        close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+    return true;
+}
+
+socklen_t DnsResolver::serverAddress(size_t index, sockaddr_storage& storage) const {
+    const auto& [address, port] = m_servers[index];
+    if (m_family == AF_INET6 && address.family == AF_INET) {
+        // Dirección IPv4 mapeada (::ffff:a.b.c.d)
+        ResolvedAddress mapped{};
+        mapped.family = AF_INET6;
+        mapped.bytes[10] = 0xFF;
+        mapped.bytes[11] = 0xFF;
+        std::memcpy(mapped.bytes + 12, address.bytes, 4);
+        return mapped.toSockaddr(port, storage);
+    }
+    if (m_family == AF_INET && address.family == AF_INET6) {
+        return 0;
+    }
+    return address.toSockaddr(port, storage);
+}
+
+std::vector<std::string> DnsResolver::searchNames(const std::string& name, bool absolute) const {
+    // Como la libc: con ndots puntos o más se prueba primero el nombre tal cual
+    bool asIsFirst = absolute || std::count(name.begin(), name.end(), '.') >= m_ndots;
+
+    std::vector<std::string> candidates;
+    if (asIsFirst) {
+        candidates.push_back(name);
+    }
+    if (!absolute) {
+        for (const auto& domain : m_searchDomains) {
+            candidates.push_back(name + "." + domain);
+        }
+    }
+    if (!asIsFirst) {
+        candidates.push_back(name);
+    }
+
+    std::vector<std::string> names;
+    std::vector<uint8_t> probe;
+    for (auto& candidate : candidates) {
+        if (buildQuery(0, candidate, TYPE_A, probe)) {
+            names.push_back(std::move(candidate));
+        }
+    }
+    return names;
+}
+
+void DnsResolver::send(Query& query) {
+    sockaddr_storage server;
+    socklen_t serverLength = serverAddress(query.server, server);
+
+    for (int i = 0; i < 2; i++) {
+        Question& question = query.questions[i];
+        if (question.done) {
+            continue;
+        }
+        // Un reintento vuelve a UDP con el siguiente servidor
+        if (question.tcpFd >= 0) {
+            closeTcp(question.tcpFd);
+            question.tcpFd = -1;
+        }
+        // Cada intento usa un ID nuevo: las respuestas tardías al anterior se descartan
+        m_ids.erase(question.id);
+        question.id = nextId();
+        m_ids[question.id] = query.host;
+
+        std::vector<uint8_t> packet;
+        buildQuery(question.id, query.names[query.nameIndex], QUESTION_TYPES[i], packet);
+        if (serverLength > 0) {
+            sendto(m_fd, packet.data(), packet.size(), 0, reinterpret_cast<const sockaddr*>(&server), serverLength);
+        }
+    }
+    query.deadline = Clock::now() + FIRST_TIMEOUT * (1 << (query.attempts - 1));
+}
+
+void DnsResolver::startTcp(Query& query, int index) {
+    Question& question = query.questions[index];
+    sockaddr_storage server;
+    socklen_t serverLength = serverAddress(query.server, server);
+
+    // Mismo servidor y mismo ID que la consulta UDP truncada
+    int fd = serverLength > 0 ? socket(m_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0) : -1;
+    if (fd >= 0 && m_family == AF_INET6) {
+        int off = 0;
+        setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+    }
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLOUT;
+    event.data.fd = fd;
+    if (fd < 0 ||
+        (connect(fd, reinterpret_cast<const sockaddr*>(&server), serverLength) != 0 && errno != EINPROGRESS) ||
+        epoll_ctl(m_pollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        // Sin TCP, el siguiente intento va al siguiente servidor
+        query.deadline = Clock::now();
+        return;
+    }
+
+    std::vector<uint8_t> packet;
+    buildQuery(question.id, query.names[query.nameIndex], QUESTION_TYPES[index], packet);
+    TcpExchange& exchange = m_tcp[fd];
+    exchange = {query.host, index, {}, 0, {}};
+    writeUint16(exchange.output, static_cast<uint16_t>(packet.size()));
+    exchange.output.insert(exchange.output.end(), packet.begin(), packet.end());
+
+    question.tcpFd = fd;
+    query.deadline = Clock::now() + FIRST_TIMEOUT * (1 << (query.attempts - 1));
+}
+
+void DnsResolver::processTcp(int fd) {
+    auto it = m_tcp.find(fd);
+    if (it == m_tcp.end()) {
+        return;
+    }
+    TcpExchange& exchange = it->second;
+    bool failed = false;
+
+    while (exchange.written < exchange.output.size()) {
+        ssize_t sent = ::send(fd, exchange.output.data() + exchange.written,
+                              exchange.output.size() - exchange.written, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            failed = errno != EAGAIN && errno != EWOULDBLOCK;
+            break;
+        }
+        exchange.written += static_cast<size_t>(sent);
+        if (exchange.written == exchange.output.size()) {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            epoll_ctl(m_pollFd, EPOLL_CTL_MOD, fd, &event);
+        }
+    }
+
+    uint8_t buffer[4096];
+    while (!failed && exchange.written == exchange.output.size()) {
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            exchange.input.insert(exchange.input.end(), buffer, buffer + received);
+            continue;
+        }
+        if (received < 0 && errno == EINTR) continue;
+        failed = received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+        break;
+    }
+
+    // Por TCP cada mensaje lleva delante su longitud
+    size_t messageLength = exchange.input.size() >= 2 ? readUint16(exchange.input.data()) : SIZE_MAX;
+    bool complete = exchange.input.size() >= messageLength + 2;
+    if (!complete && !failed) {
+        return;
+    }
+
+    std::string host = exchange.host;
+    int index = exchange.index;
+    std::vector<uint8_t> input = std::move(exchange.input);
+    closeTcp(fd);
+
+    auto queryIt = m_queries.find(host);
+    if (queryIt == m_queries.end() || queryIt->second.questions[index].tcpFd != fd) {
+        return;
+    }
+    Query& query = queryIt->second;
+    query.questions[index].tcpFd = -1;
+    if (!complete) {
+        query.deadline = Clock::now();
+        return;
+    }
+
+    sockaddr_storage server;
+    socklen_t serverLength = serverAddress(query.server, server);
+    handleResponse(input.data() + 2, messageLength, server, serverLength, true);
+}
+
+void DnsResolver::closeTcp(int fd) {
+    epoll_ctl(m_pollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    m_tcp.erase(fd);
+}
+
+void DnsResolver::handleResponse(const uint8_t* data, size_t length, const sockaddr_storage& source,
+                                 socklen_t sourceLength, bool viaTcp) {
+    if (length < 12) {
+        return;
+    }
+    uint16_t id = readUint16(data);
+    auto idIt = m_ids.find(id);
+    if (idIt == m_ids.end()) {
+        return;
+    }
+    auto queryIt = m_queries.find(idIt->second);
+    if (queryIt == m_queries.end()) {
+        return;
+    }
+    Query& query = queryIt->second;
+    int index = query.questions[0].id == id && !query.questions[0].done ? 0 : 1;
+    if (query.questions[index].id != id || query.questions[index].done) {
+        return;
+    }
+
+    // La respuesta debe venir del servidor consultado
+    sockaddr_storage expected;
+    socklen_t expectedLength = serverAddress(query.server, expected);
+    if (sourceLength != expectedLength || std::memcmp(&source, &expected, expectedLength) != 0) {
+        return;
+    }
+
+    uint16_t flags = readUint16(data + 2);
+    uint16_t questionCount = readUint16(data + 4);
+    uint16_t answerCount = readUint16(data + 6);
+    uint16_t authorityCount = readUint16(data + 8);
+    if (!(flags & 0x8000) || questionCount != 1) {
+        return;
+    }
+
+    // La pregunta debe coincidir con la enviada
+    size_t offset = 12;
+    std::string name;
+    uint16_t expectedType = index == 0 ? TYPE_A : TYPE_AAAA;
+    if (!readName(data, length, offset, name) || offset + 4 > length || name != query.names[query.nameIndex] ||
+        readUint16(data + offset) != expectedType) {
+        return;
+    }
+    offset += 4;
+
+    // Respuesta truncada: repetir la pregunta por TCP
+    if ((flags & FLAG_TRUNCATED) && !viaTcp) {
+        if (query.questions[index].tcpFd < 0) {
+            startTcp(query, index);
+        }
+        return;
+    }
+
+    int rcode = flags & 0x000F;
+    if (rcode != RCODE_NOERROR && rcode != RCODE_NXDOMAIN) {
+        // SERVFAIL, REFUSED...: probar enseguida con el siguiente servidor
+        query.deadline = Clock::now();
+        return;
+    }
+
+    struct Record {
+        std::string owner;
+        uint16_t type;
+        uint32_t ttl;
+        size_t dataOffset;
+        uint16_t dataLength;
+    };
+    std::vector<Record> records;
+    for (int i = 0; i < answerCount + authorityCount; i++) {
+        Record record;
+        if (!readName(data, length, offset, record.owner) || offset + 10 > length) {
+            break;
+        }
+        record.type = readUint16(data + offset);
+        record.ttl = readUint32(data + offset + 4) & 0x7FFFFFFF;
+        record.dataLength = readUint16(data + offset + 8);
+        record.dataOffset = offset + 10;
+        offset = record.dataOffset + record.dataLength;
+        if (offset > length) {
+            break;
+        }
+        records.push_back(std::move(record));
+    }
+
+    // Seguir la cadena de CNAME desde el nombre consultado
+    std::string target = query.names[query.nameIndex];
+    uint32_t ttl = UINT32_MAX;
+    for (int depth = 0; depth < 8; depth++) {
+        auto cname = std::find_if(records.begin(), records.end(), [&](const Record& record) {
+            return record.type == TYPE_CNAME && record.owner == target;
+        });
+        size_t cnameOffset = cname == records.end() ? 0 : cname->dataOffset;
+        if (cname == records.end() || !readName(data, length, cnameOffset, target)) {
+            break;
+        }
+        ttl = std::min(ttl, cname->ttl);
+    }
+
+    size_t addressLength = index == 0 ? 4 : 16;
+    for (const Record& record : records) {
+        if (record.type == expectedType && record.owner == target && record.dataLength == addressLength) {
+            ResolvedAddress address{};
+            address.family = index == 0 ? AF_INET : AF_INET6;
+            std::memcpy(address.bytes, data + record.dataOffset, addressLength);
+            query.addresses[index].push_back(address);
+            ttl = std::min(ttl, record.ttl);
+        } else if (record.type == TYPE_SOA && record.dataLength >= 20) {
+            // TTL negativo: el menor entre el TTL del SOA y su campo MINIMUM
+            uint32_t minimum = readUint32(data + record.dataOffset + record.dataLength - 4);
+            query.negativeTtl = std::max(query.negativeTtl, std::min(record.ttl, minimum));
+        }
+    }
+
+    if (!query.addresses[index].empty()) {
+        query.ttl = std::min(query.ttl, ttl);
+    }
+    if (rcode == RCODE_NXDOMAIN) {
+        query.nameError = true;
+    }
+
+    m_ids.erase(id);
+    query.questions[index].done = true;
+    query.questions[index].answered = true;
+
+    // Un NXDOMAIN vale para ambas familias
+    if (!query.nameError && !(query.questions[0].done && query.questions[1].done)) {
+        return;
+    }
+
+    // Sin direcciones, probar el siguiente nombre de la lista search
+    if (query.addresses[0].empty() && query.addresses[1].empty() && query.nameIndex + 1 < query.names.size()) {
+        cancelQuestions(query);
+        query.nameIndex++;
+        for (Question& question : query.questions) {
+            question = {0, false, false, -1};
+        }
+        query.ttl = UINT32_MAX;
+        query.negativeTtl = 0;
+        query.nameError = false;
+        query.attempts = 1;
+        query.server = 0;
+        send(query);
+        return;
+    }
+    abandon(query.host);
+}
+
+void DnsResolver::cancelQuestions(Query& query) {
+    for (Question& question : query.questions) {
+        if (question.tcpFd >= 0) {
+            closeTcp(question.tcpFd);
+            question.tcpFd = -1;
+        }
+        if (!question.done) {
+            m_ids.erase(question.id);
+            question.done = true;
+        }
+    }
+}
+
+void DnsResolver::abandon(const std::string& host) {
+    auto it = m_queries.find(host);
+    if (it == m_queries.end()) {
+        return;
+    }
+    cancelQuestions(it->second);
+    finish(host);
+}
+
+void DnsResolver::finish(const std::string& host) {
+    auto it = m_queries.find(host);
+    if (it == m_queries.end()) {
+        return;
+    }
+    // host puede referenciar la clave que se borra: a partir de aquí se usa query.host
+    Query query = std::move(it->second);
+    m_queries.erase(it);
+
+    std::vector<ResolvedAddress> addresses = query.addresses[0];
+    addresses.insert(addresses.end(), query.addresses[1].begin(), query.addresses[1].end());
+
+    bool answered = query.nameError || (query.questions[0].answered && query.questions[1].answered);
+    if (!addresses.empty()) {
+        m_cache->storePositive(query.host, addresses, std::chrono::seconds(query.ttl));
+    } else if (answered) {
+        m_cache->storeNegative(query.host, query.negativeTtl > 0 ? std::chrono::seconds(query.negativeTtl) :
+                                                             DEFAULT_NEGATIVE_TTL);
+    } else {
+        m_cache->storeNegative(query.host, FAILURE_TTL);
+    }
+
+    // Los callbacks pueden lanzar nuevas consultas
+    for (auto& callback : query.callbacks) {
+        callback(addresses);
+    }
+}
+
+uint16_t DnsResolver::nextId() {
+    uint16_t id;
+    do {
+        id = static_cast<uint16_t>(m_random());
+    } while (m_ids.count(id));
+    return id;
+}
+
+} // namespace Core::Network
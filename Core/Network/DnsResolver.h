@@ -0,0 +1,313 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Resolución DNS asíncrona con caché respetando el TTL
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <cstdint>
+#include <netinet/in.h>
+
+namespace Core::Network {
+
+/**
+ * Dirección IP resuelta
+ */
+struct ResolvedAddress {
+    int family;            // AF_INET o AF_INET6
+    uint8_t bytes[16];     // 4 bytes en IPv4, 16 en IPv6
+
+    /**
+     * Convierte una dirección literal
+     * @param text Dirección IPv4 o IPv6 (sin corchetes)
+     * @param address Dirección convertida (salida)
+     * @return true si text es una dirección válida
+     */
+    static bool parse(const std::string& text, ResolvedAddress& address);
+
+    /**
+     * Construye la dirección de socket para conectarse
+     * @param port Puerto de destino
+     * @param storage Dirección de socket (salida)
+     * @return Tamaño de la dirección de socket
+     */
+    socklen_t toSockaddr(int port, sockaddr_storage& storage) const;
+
+    /**
+     * Obtiene la representación textual
+     * @return Dirección en formato texto
+     */
+    std::string toString() const;
+};
+
+/**
+ * Estadísticas de la caché DNS
+ */
+struct DnsCacheStats {
+    size_t hits;             // Consultas respondidas con una entrada positiva
+    size_t negativeHits;     // Consultas respondidas con una entrada negativa
+    size_t misses;           // Respuestas obtenidas de la red (no estaban en caché)
+    size_t entries;          // Entradas en caché (incluidas las caducadas aún no purgadas)
+};
+
+/**
+ * Caché DNS compartida y tabla estática de hosts
+ * Guarda las respuestas positivas durante su TTL y las negativas (NXDOMAIN o
+ * sin registros) durante el TTL negativo del SOA (RFC 2308). La tabla de
+ * hosts tiene prioridad sobre la caché y sobre la red, de modo que las pruebas
+ * pueden ejecutarse sin conexión. Es segura para usarla desde varios hilos.
+ */
+class DnsCache {
+public:
+    enum class Status {
+        FOUND,       // Direcciones disponibles sin consultar la red
+        NOT_FOUND,   // El nombre no existe o la última resolución falló
+        MISS         // Hay que consultar la red
+    };
+
+    /**
+     * Constructor
+     * Carga /etc/hosts como tabla de hosts del sistema.
+     */
+    DnsCache();
+
+    /**
+     * Busca un nombre en la tabla de hosts y en la caché
+     * Las direcciones IP literales se devuelven tal cual.
+     * @param host Nombre a buscar
+     * @param addresses Direcciones encontradas (salida)
+     * @return Resultado de la búsqueda
+     */
+    Status lookup(const std::string& host, std::vector<ResolvedAddress>& addresses);
+
+    /**
+     * Guarda una respuesta positiva
+     * @param host Nombre resuelto
+     * @param addresses Direcciones obtenidas
+     * @param ttl Tiempo de vida de la respuesta
+     */
+    void storePositive(const std::string& host, const std::vector<ResolvedAddress>& addresses,
+                       std::chrono::seconds ttl);
+
+    /**
+     * Guarda una respuesta negativa
+     * @param host Nombre que no se pudo resolver
+     * @param ttl Tiempo durante el que no se vuelve a consultar
+     */
+    void storeNegative(const std::string& host, std::chrono::seconds ttl);
+
+    /**
+     * Añade una dirección a la tabla de hosts
+     * @param host Nombre del host
+     * @param address Dirección IPv4 o IPv6 literal
+     * @return true si la dirección es válida
+     */
+    bool addHostOverride(const std::string& host, const std::string& address);
+
+    /**
+     * Elimina un host de la tabla de hosts
+     * @param host Nombre del host
+     */
+    void removeHostOverride(const std::string& host);
+
+    /**
+     * Vacía la tabla de hosts añadida con addHostOverride() (no la de /etc/hosts)
+     */
+    void clearHostOverrides();
+
+    /**
+     * Vacía la caché
+     */
+    void clear();
+
+    /**
+     * Limita el TTL de las entradas
+     * @param maxTtl TTL máximo de las respuestas positivas
+     * @param maxNegativeTtl TTL máximo de las respuestas negativas
+     */
+    void setTtlLimits(std::chrono::seconds maxTtl, std::chrono::seconds maxNegativeTtl);
+
+    /**
+     * Obtiene las estadísticas de la caché
+     * @return Estadísticas actuales
+     */
+    DnsCacheStats getStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::vector<ResolvedAddress> addresses;   // Vacío en las entradas negativas
+        Clock::time_point expires;
+    };
+
+    void loadHostsFile(const std::string& path);
+    void purge(Clock::time_point now);
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::vector<ResolvedAddress>> m_overrides;
+    std::unordered_map<std::string, std::vector<ResolvedAddress>> m_systemHosts;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::chrono::seconds m_maxTtl;
+    std::chrono::seconds m_maxNegativeTtl;
+    DnsCacheStats m_stats;
+};
+
+/**
+ * Resolvedor DNS no bloqueante sobre UDP
+ * Envía las consultas A y AAAA en paralelo a los servidores de
+ * /etc/resolv.conf y guarda las respuestas en una DnsCache compartida. Las
+ * respuestas truncadas (bit TC) se repiten por TCP, y los nombres relativos se
+ * completan con la lista search según ndots, como hace la libc.
+ * Está pensado para un bucle de eventos: el descriptor de getDescriptor() se
+ * registra para lectura y se llama a processEvents() cuando es legible y a
+ * processTimeouts() periódicamente. No es seguro usarlo desde varios hilos.
+ */
+class DnsResolver {
+public:
+    using Callback = std::function<void(const std::vector<ResolvedAddress>&)>;
+
+    /**
+     * Constructor
+     * @param cache Caché compartida donde se guardan las respuestas
+     */
+    explicit DnsResolver(std::shared_ptr<DnsCache> cache);
+
+    /**
+     * Destructor
+     */
+    ~DnsResolver();
+
+    DnsResolver(const DnsResolver&) = delete;
+    DnsResolver& operator=(const DnsResolver&) = delete;
+
+    /**
+     * Establece los servidores DNS
+     * @param servers Direcciones de los servidores ("1.1.1.1", "[::1]:5353", "127.0.0.1:5353")
+     * @return true si al menos una dirección es válida
+     */
+    bool setNameservers(const std::vector<std::string>& servers);
+
+    /**
+     * Establece la lista de búsqueda para nombres relativos
+     * Los nombres con menos de ndots puntos prueban primero los dominios de la
+     * lista; el resto se consulta primero tal cual. Un punto final lo evita.
+     * @param domains Dominios de búsqueda, en orden
+     * @param ndots Puntos a partir de los cuales un nombre se considera absoluto
+     */
+    void setSearchDomains(const std::vector<std::string>& domains, int ndots);
+
+    /**
+     * Resuelve un nombre
+     * Si la respuesta está en la caché o en la tabla de hosts, el callback se
+     * invoca antes de volver. Las consultas simultáneas al mismo nombre se agrupan.
+     * @param host Nombre a resolver
+     * @param callback Función que recibe las direcciones (vacío si falló)
+     */
+    void resolve(const std::string& host, Callback callback);
+
+    /**
+     * Resuelve un nombre esperando la respuesta
+     * @param host Nombre a resolver
+     * @param addresses Direcciones obtenidas (salida)
+     * @param timeoutMs Tiempo máximo de espera
+     * @return true si se obtuvo al menos una dirección
+     */
+    bool resolveBlocking(const std::string& host, std::vector<ResolvedAddress>& addresses, int timeoutMs);
+
+    /**
+     * Obtiene el descriptor que hay que vigilar para lectura
+     * Es un descriptor epoll que agrupa el socket UDP y las conexiones TCP.
+     * @return Descriptor a vigilar, o -1 si no se pudo crear
+     */
+    int getDescriptor() const { return m_pollFd; }
+
+    /**
+     * Procesa las respuestas recibidas
+     */
+    void processEvents();
+
+    /**
+     * Reenvía las consultas sin respuesta y falla las agotadas
+     * @param now Instante actual
+     */
+    void processTimeouts(std::chrono::steady_clock::time_point now);
+
+    /**
+     * Obtiene el número de consultas en curso
+     * @return Nombres pendientes de respuesta
+     */
+    size_t getPendingCount() const { return m_queries.size(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Question {
+        uint16_t id;
+        bool done;
+        bool answered;     // El servidor respondió (con o sin registros)
+        int tcpFd;         // Conexión TCP tras una respuesta truncada, o -1
+    };
+
+    struct Query {
+        std::string host;
+        std::vector<std::string> names;         // Nombres a probar según la lista search
+        size_t nameIndex;                       // Nombre consultado ahora
+        Question questions[2];                  // A y AAAA
+        std::vector<ResolvedAddress> addresses[2];
+        uint32_t ttl;                           // Menor TTL de las respuestas
+        uint32_t negativeTtl;                   // TTL negativo del SOA (0 si no hubo)
+        bool nameError;                         // NXDOMAIN
+        int attempts;
+        size_t server;                          // Servidor al que se envió el último intento
+        Clock::time_point deadline;
+        std::vector<Callback> callbacks;
+    };
+
+    // Consulta repetida por TCP: mensaje con su longitud delante y respuesta acumulada
+    struct TcpExchange {
+        std::string host;
+        int index;
+        std::vector<uint8_t> output;
+        size_t written;
+        std::vector<uint8_t> input;
+    };
+
+    void loadResolvConf();
+    bool openSocket();
+    socklen_t serverAddress(size_t index, sockaddr_storage& storage) const;
+    std::vector<std::string> searchNames(const std::string& name, bool absolute) const;
+    void send(Query& query);
+    void startTcp(Query& query, int index);
+    void processTcp(int fd);
+    void closeTcp(int fd);
+    void handleResponse(const uint8_t* data, size_t length, const sockaddr_storage& source, socklen_t sourceLength,
+                        bool viaTcp);
+    void cancelQuestions(Query& query);
+    void abandon(const std::string& host);
+    void finish(const std::string& host);
+    uint16_t nextId();
+
+    std::shared_ptr<DnsCache> m_cache;
+    std::vector<std::pair<ResolvedAddress, int>> m_servers;   // Dirección y puerto
+    std::vector<std::string> m_searchDomains;
+    int m_ndots;
+    int m_fd;
+    int m_pollFd;
+    int m_family;
+    std::unordered_map<int, TcpExchange> m_tcp;        // Descriptor -> consulta TCP
+    std::unordered_map<std::string, Query> m_queries;
+    std::unordered_map<uint16_t, std::string> m_ids;   // ID de consulta -> nombre
+    std::mt19937 m_random;
+};
+
+} // namespace Core::Network
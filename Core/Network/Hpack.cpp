@@ -0,0 +1,515 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación de HPACK (RFC 7541)
+ */
+
+#include "Hpack.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace Core::Network {
+
+namespace {
+
+struct StaticEntry {
+    const char* name;
+    const char* value;
+};
+
+// Tablas del RFC 7541, apéndices A y B
+const uint32_t HUFFMAN_CODES[256] = {
+    0x1ff8, 0x7fffd8, 0xfffffe2, 0xfffffe3, 0xfffffe4, 0xfffffe5, 0xfffffe6, 0xfffffe7,
+    0xfffffe8, 0xffffea, 0x3ffffffc, 0xfffffe9, 0xfffffea, 0x3ffffffd, 0xfffffeb, 0xfffffec,
+    0xfffffed, 0xfffffee, 0xfffffef, 0xffffff0, 0xffffff1, 0xffffff2, 0x3ffffffe, 0xffffff3,
+    0xffffff4, 0xffffff5, 0xffffff6, 0xffffff7, 0xffffff8, 0xffffff9, 0xffffffa, 0xffffffb,
+    0x14, 0x3f8, 0x3f9, 0xffa, 0x1ff9, 0x15, 0xf8, 0x7fa,
+    0x3fa, 0x3fb, 0xf9, 0x7fb, 0xfa, 0x16, 0x17, 0x18,
+    0x0, 0x1, 0x2, 0x19, 0x1a, 0x1b, 0x1c, 0x1d,
+    0x1e, 0x1f, 0x5c, 0xfb, 0x7ffc, 0x20, 0xffb, 0x3fc,
+    0x1ffa, 0x21, 0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62,
+    0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a,
+    0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72,
+    0xfc, 0x73, 0xfd, 0x1ffb, 0x7fff0, 0x1ffc, 0x3ffc, 0x22,
+    0x7ffd, 0x3, 0x23, 0x4, 0x24, 0x5, 0x25, 0x26,
+    0x27, 0x6, 0x74, 0x75, 0x28, 0x29, 0x2a, 0x7,
+    0x2b, 0x76, 0x2c, 0x8, 0x9, 0x2d, 0x77, 0x78,
+    0x79, 0x7a, 0x7b, 0x7ffe, 0x7fc, 0x3ffd, 0x1ffd, 0xffffffc,
+    0xfffe6, 0x3fffd2, 0xfffe7, 0xfffe8, 0x3fffd3, 0x3fffd4, 0x3fffd5, 0x7fffd9,
+    0x3fffd6, 0x7fffda, 0x7fffdb, 0x7fffdc, 0x7fffdd, 0x7fffde, 0xffffeb, 0x7fffdf,
+    0xffffec, 0xffffed, 0x3fffd7, 0x7fffe0, 0xffffee, 0x7fffe1, 0x7fffe2, 0x7fffe3,
+    0x7fffe4, 0x1fffdc, 0x3fffd8, 0x7fffe5, 0x3fffd9, 0x7fffe6, 0x7fffe7, 0xffffef,
+    0x3fffda, 0x1fffdd, 0xfffe9, 0x3fffdb, 0x3fffdc, 0x7fffe8, 0x7fffe9, 0x1fffde,
+    0x7fffea, 0x3fffdd, 0x3fffde, 0xfffff0, 0x1fffdf, 0x3fffdf, 0x7fffeb, 0x7fffec,
+    0x1fffe0, 0x1fffe1, 0x3fffe0, 0x1fffe2, 0x7fffed, 0x3fffe1, 0x7fffee, 0x7fffef,
+    0xfffea, 0x3fffe2, 0x3fffe3, 0x3fffe4, 0x7ffff0, 0x3fffe5, 0x3fffe6, 0x7ffff1,
+    0x3ffffe0, 0x3ffffe1, 0xfffeb, 0x7fff1, 0x3fffe7, 0x7ffff2, 0x3fffe8, 0x1ffffec,
+    0x3ffffe2, 0x3ffffe3, 0x3ffffe4, 0x7ffffde, 0x7ffffdf, 0x3ffffe5, 0xfffff1, 0x1ffffed,
+    0x7fff2, 0x1fffe3, 0x3ffffe6, 0x7ffffe0, 0x7ffffe1, 0x3ffffe7, 0x7ffffe2, 0xfffff2,
+    0x1fffe4, 0x1fffe5, 0x3ffffe8, 0x3ffffe9, 0xffffffd, 0x7ffffe3, 0x7ffffe4, 0x7ffffe5,
+    0xfffec, 0xfffff3, 0xfffed, 0x1fffe6, 0x3fffe9, 0x1fffe7, 0x1fffe8, 0x7ffff3,
+    0x3fffea, 0x3fffeb, 0x1ffffee, 0x1ffffef, 0xfffff4, 0xfffff5, 0x3ffffea, 0x7ffff4,
+    0x3ffffeb, 0x7ffffe6, 0x3ffffec, 0x3ffffed, 0x7ffffe7, 0x7ffffe8, 0x7ffffe9, 0x7ffffea,
+    0x7ffffeb, 0xffffffe, 0x7ffffec, 0x7ffffed, 0x7ffffee, 0x7ffffef, 0x7fffff0, 0x3ffffee,
+};
+
+const uint8_t HUFFMAN_LENGTHS[256] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+    28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+    5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+    13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+    15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+    6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+    20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+    24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+    22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+    21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+    26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+    19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+    20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+    26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+};
+
+const StaticEntry STATIC_TABLE[] = {
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+};
+
+constexpr size_t STATIC_TABLE_SIZE = sizeof(STATIC_TABLE) / sizeof(STATIC_TABLE[0]);
+
+// Sobrecoste por entrada de la tabla dinámica (RFC 7541, sección 4.1)
+constexpr size_t ENTRY_OVERHEAD = 32;
+
+// Longitud máxima de un literal decodificado
+constexpr size_t MAX_STRING_LENGTH = 1 << 20;
+
+const std::vector<std::pair<std::string, std::string>>& staticTable() {
+    static const std::vector<std::pair<std::string, std::string>> table = [] {
+        std::vector<std::pair<std::string, std::string>> entries;
+        for (const auto& entry : STATIC_TABLE) {
+            entries.emplace_back(entry.name, entry.value);
+        }
+        return entries;
+    }();
+    return table;
+}
+
+/**
+ * Árbol de decodificación Huffman: cada nodo tiene dos hijos; los valores
+ * negativos son hojas con el símbolo -(valor + 1)
+ */
+const std::vector<std::array<int32_t, 2>>& huffmanTree() {
+    static const std::vector<std::array<int32_t, 2>> tree = [] {
+        std::vector<std::array<int32_t, 2>> nodes(1, {0, 0});
+        for (int symbol = 0; symbol < 256; symbol++) {
+            uint32_t code = HUFFMAN_CODES[symbol];
+            int length = HUFFMAN_LENGTHS[symbol];
+            size_t node = 0;
+            for (int bit = length - 1; bit >= 0; bit--) {
+                int branch = (code >> bit) & 1;
+                if (bit == 0) {
+                    nodes[node][branch] = -(symbol + 1);
+                } else {
+                    if (nodes[node][branch] == 0) {
+                        nodes[node][branch] = static_cast<int32_t>(nodes.size());
+                        nodes.push_back({0, 0});
+                    }
+                    node = static_cast<size_t>(nodes[node][branch]);
+                }
+            }
+        }
+        return nodes;
+    }();
+    return tree;
+}
+
+void encodeInteger(uint64_t value, int prefixBits, uint8_t firstByte, std::string& output) {
+    uint64_t limit = (1u << prefixBits) - 1;
+    if (value < limit) {
+        output += static_cast<char>(firstByte | value);
+        return;
+    }
+    output += static_cast<char>(firstByte | limit);
+    value -= limit;
+    while (value >= 128) {
+        output += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    output += static_cast<char>(value);
+}
+
+bool decodeInteger(const uint8_t*& cursor, const uint8_t* end, int prefixBits, uint64_t& value) {
+    if (cursor >= end) {
+        return false;
+    }
+    uint64_t limit = (1u << prefixBits) - 1;
+    value = *cursor++ & limit;
+    if (value < limit) {
+        return true;
+    }
+
+    int shift = 0;
+    while (cursor < end) {
+        uint8_t byte = *cursor++;
+        value += static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+        shift += 7;
+        if (shift > 56) {
+            return false;
+        }
+    }
+    return false;
+}
+
+void encodeString(const std::string& text, std::string& output) {
+    size_t huffmanLength = Huffman::encodedLength(text);
+    if (huffmanLength < text.size()) {
+        encodeInteger(huffmanLength, 7, 0x80, output);
+        Huffman::encode(text, output);
+    } else {
+        encodeInteger(text.size(), 7, 0x00, output);
+        output += text;
+    }
+}
+
+bool decodeString(const uint8_t*& cursor, const uint8_t* end, std::string& text) {
+    if (cursor >= end) {
+        return false;
+    }
+    bool huffman = *cursor & 0x80;
+    uint64_t length;
+    if (!decodeInteger(cursor, end, 7, length) || length > static_cast<uint64_t>(end - cursor) ||
+        length > MAX_STRING_LENGTH) {
+        return false;
+    }
+
+    text.clear();
+    if (huffman) {
+        if (!Huffman::decode(cursor, static_cast<size_t>(length), text)) {
+            return false;
+        }
+    } else {
+        text.assign(reinterpret_cast<const char*>(cursor), static_cast<size_t>(length));
+    }
+    cursor += length;
+    return true;
+}
+
+bool isSensitive(const std::string& name) {
+    return name == "authorization" || name == "proxy-authorization";
+}
+
+} // namespace
+
+HpackTable::HpackTable(size_t maxSize) :
+    m_size(0),
+    m_maxSize(maxSize) {
+}
+
+void HpackTable::add(const std::string& name, const std::string& value) {
+    size_t entrySize = name.size() + value.size() + ENTRY_OVERHEAD;
+    if (entrySize > m_maxSize) {
+        // Una entrada mayor que la tabla la vacía (RFC 7541, sección 4.4)
+        m_entries.clear();
+        m_size = 0;
+        return;
+    }
+    m_entries.emplace_front(name, value);
+    m_size += entrySize;
+    evict();
+}
+
+void HpackTable::setMaxSize(size_t maxSize) {
+    m_maxSize = maxSize;
+    evict();
+}
+
+const std::pair<std::string, std::string>* HpackTable::get(size_t index) const {
+    if (index == 0) {
+        return nullptr;
+    }
+    if (index <= STATIC_TABLE_SIZE) {
+        return &staticTable()[index - 1];
+    }
+    index -= STATIC_TABLE_SIZE + 1;
+    return index < m_entries.size() ? &m_entries[index] : nullptr;
+}
+
+size_t HpackTable::find(const std::string& name, const std::string& value, size_t& nameIndex) const {
+    nameIndex = 0;
+    const auto& table = staticTable();
+    for (size_t i = 0; i < table.size(); i++) {
+        if (table[i].first == name) {
+            if (table[i].second == value) {
+                return i + 1;
+            }
+            if (nameIndex == 0) {
+                nameIndex = i + 1;
+            }
+        }
+    }
+    for (size_t i = 0; i < m_entries.size(); i++) {
+        if (m_entries[i].first == name) {
+            if (m_entries[i].second == value) {
+                return STATIC_TABLE_SIZE + 1 + i;
+            }
+            if (nameIndex == 0) {
+                nameIndex = STATIC_TABLE_SIZE + 1 + i;
+            }
+        }
+    }
+    return 0;
+}
+
+void HpackTable::evict() {
+    while (m_size > m_maxSize && !m_entries.empty()) {
+        const auto& oldest = m_entries.back();
+        m_size -= oldest.first.size() + oldest.second.size() + ENTRY_OVERHEAD;
+        m_entries.pop_back();
+    }
+}
+
+HpackEncoder::HpackEncoder(size_t maxTableSize) :
+    m_table(maxTableSize),
+    m_pendingSizeUpdate(SIZE_MAX) {
+}
+
+void HpackEncoder::setMaxTableSize(size_t maxTableSize) {
+    // Nunca usamos más de 4096 bytes aunque el otro extremo permita más
+    size_t size = std::min<size_t>(maxTableSize, 4096);
+    if (size != m_table.maxSize()) {
+        m_table.setMaxSize(size);
+        m_pendingSizeUpdate = size;
+    }
+}
+
+void HpackEncoder::encode(const std::vector<std::pair<std::string, std::string>>& headers, std::string& output) {
+    if (m_pendingSizeUpdate != SIZE_MAX) {
+        encodeInteger(m_pendingSizeUpdate, 5, 0x20, output);
+        m_pendingSizeUpdate = SIZE_MAX;
+    }
+
+    for (const auto& [name, value] : headers) {
+        size_t nameIndex = 0;
+        size_t index = m_table.find(name, value, nameIndex);
+        if (index != 0 && !isSensitive(name)) {
+            encodeInteger(index, 7, 0x80, output);  // Campo indexado
+            continue;
+        }
+
+        if (isSensitive(name)) {
+            encodeInteger(nameIndex, 4, 0x10, output);  // Literal que nunca se indexa
+        } else if (name.size() + value.size() + ENTRY_OVERHEAD <= m_table.maxSize() / 2) {
+            encodeInteger(nameIndex, 6, 0x40, output);  // Literal con indexación incremental
+            m_table.add(name, value);
+        } else {
+            encodeInteger(nameIndex, 4, 0x00, output);  // Literal sin indexación
+        }
+
+        if (nameIndex == 0) {
+            encodeString(name, output);
+        }
+        encodeString(value, output);
+    }
+}
+
+HpackDecoder::HpackDecoder(size_t maxTableSize, size_t maxHeaderListSize) :
+    m_table(maxTableSize),
+    m_maxTableSize(maxTableSize),
+    m_maxHeaderListSize(maxHeaderListSize),
+    m_headerListTooLarge(false) {
+}
+
+bool HpackDecoder::decode(const uint8_t* data, size_t length, std::vector<std::pair<std::string, std::string>>& headers) {
+    const uint8_t* cursor = data;
+    const uint8_t* end = data + length;
+    bool fieldSeen = false;
+    size_t listSize = 0;
+    m_headerListTooLarge = false;
+
+    // Cada campo cuenta su nombre, su valor y 32 bytes de sobrecarga; las
+    // referencias a la tabla dinámica pueden multiplicar el tamaño del bloque
+    auto withinLimit = [&](const std::pair<std::string, std::string>& field) {
+        listSize += field.first.size() + field.second.size() + 32;
+        m_headerListTooLarge = m_maxHeaderListSize > 0 && listSize > m_maxHeaderListSize;
+        return !m_headerListTooLarge;
+    };
+
+    while (cursor < end) {
+        uint8_t first = *cursor;
+
+        if (first & 0x80) {
+            // Campo indexado
+            uint64_t index;
+            if (!decodeInteger(cursor, end, 7, index)) return false;
+            const auto* entry = m_table.get(static_cast<size_t>(index));
+            if (!entry) return false;
+            headers.push_back(*entry);
+            if (!withinLimit(headers.back())) return false;
+            fieldSeen = true;
+            continue;
+        }
+
+        if ((first & 0xE0) == 0x20) {
+            // Actualización del tamaño de la tabla: solo al principio del bloque
+            uint64_t size;
+            if (fieldSeen || !decodeInteger(cursor, end, 5, size) || size > m_maxTableSize) return false;
+            m_table.setMaxSize(static_cast<size_t>(size));
+            continue;
+        }
+
+        // Literales: con indexación (01), sin indexación (0000) o nunca indexado (0001)
+        bool incremental = (first & 0xC0) == 0x40;
+        uint64_t nameIndex;
+        if (!decodeInteger(cursor, end, incremental ? 6 : 4, nameIndex)) return false;
+
+        std::string name;
+        if (nameIndex != 0) {
+            const auto* entry = m_table.get(static_cast<size_t>(nameIndex));
+            if (!entry) return false;
+            name = entry->first;
+        } else if (!decodeString(cursor, end, name)) {
+            return false;
+        }
+
+        std::string value;
+        if (!decodeString(cursor, end, value)) return false;
+
+        if (incremental) {
+            m_table.add(name, value);
+        }
+        headers.emplace_back(std::move(name), std::move(value));
+        if (!withinLimit(headers.back())) return false;
+        fieldSeen = true;
+    }
+
+    return true;
+}
+
+bool HpackDecoder::isHeaderListTooLarge() const {
+    return m_headerListTooLarge;
+}
+
+namespace Huffman {
+
+size_t encodedLength(const std::string& text) {
+    size_t bits = 0;
+    for (unsigned char c : text) {
+        bits += HUFFMAN_LENGTHS[c];
+    }
+    return (bits + 7) / 8;
+}
+
+void encode(const std::string& text, std::string& output) {
+    uint64_t buffer = 0;
+    int bits = 0;
+    for (unsigned char c : text) {
+        buffer = (buffer << HUFFMAN_LENGTHS[c]) | HUFFMAN_CODES[c];
+        bits += HUFFMAN_LENGTHS[c];
+        while (bits >= 8) {
+            bits -= 8;
+            output += static_cast<char>(buffer >> bits);
+        }
+    }
+    if (bits > 0) {
+        // Relleno con el prefijo del símbolo EOS (todo unos)
+        output += static_cast<char>((buffer << (8 - bits)) | (0xFF >> bits));
+    }
+}
+
+bool decode(const uint8_t* data, size_t length, std::string& output) {
+    const auto& tree = huffmanTree();
+    size_t node = 0;
+    int depth = 0;          // Bits leídos desde el último símbolo
+    bool allOnes = true;    // Los bits pendientes son todos unos
+
+    for (size_t i = 0; i < length; i++) {
+        for (int bit = 7; bit >= 0; bit--) {
+            int branch = (data[i] >> bit) & 1;
+            int32_t next = tree[node][branch];
+            if (next < 0) {
+                output += static_cast<char>(-(next + 1));
+                node = 0;
+                depth = 0;
+                allOnes = true;
+            } else if (next == 0) {
+                return false;  // Código no válido (incluye EOS)
+            } else {
+                node = static_cast<size_t>(next);
+                depth++;
+                allOnes = allOnes && branch == 1;
+            }
+        }
+    }
+
+    // El relleno debe ser de menos de 8 bits y todo unos
+    return depth < 8 && allOnes;
+}
+
+} // namespace Huffman
+
+} // namespace Core::Network
@@ -0,0 +1,143 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Compresión de cabeceras HPACK (RFC 7541) para HTTP/2
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstdint>
+
+namespace Core::Network {
+
+/**
+ * Tabla dinámica de HPACK compartida por el codificador y el decodificador
+ */
+class HpackTable {
+public:
+    explicit HpackTable(size_t maxSize);
+
+    /**
+     * Añade una entrada, expulsando las más antiguas si no cabe
+     */
+    void add(const std::string& name, const std::string& value);
+
+    /**
+     * Cambia el tamaño máximo de la tabla
+     */
+    void setMaxSize(size_t maxSize);
+
+    /**
+     * Obtiene una entrada por su índice HPACK (1-61 tabla estática, 62+ dinámica)
+     * @return nullptr si el índice no existe
+     */
+    const std::pair<std::string, std::string>* get(size_t index) const;
+
+    /**
+     * Busca una cabecera en la tabla estática y en la dinámica
+     * @param nameIndex Índice de una entrada con el mismo nombre, o 0 (salida)
+     * @return Índice de la entrada con nombre y valor iguales, o 0
+     */
+    size_t find(const std::string& name, const std::string& value, size_t& nameIndex) const;
+
+    size_t maxSize() const { return m_maxSize; }
+
+private:
+    void evict();
+
+    std::deque<std::pair<std::string, std::string>> m_entries;  // La más reciente al principio
+    size_t m_size;
+    size_t m_maxSize;
+};
+
+/**
+ * Codificador de bloques de cabeceras HPACK
+ * Indexa las cabeceras repetidas y codifica los literales con Huffman cuando
+ * resulta más corto. Las credenciales nunca se indexan.
+ */
+class HpackEncoder {
+public:
+    /**
+     * Constructor
+     * @param maxTableSize Tamaño inicial de la tabla dinámica
+     */
+    explicit HpackEncoder(size_t maxTableSize = 4096);
+
+    /**
+     * Aplica el SETTINGS_HEADER_TABLE_SIZE anunciado por el otro extremo
+     * @param maxTableSize Tamaño máximo permitido
+     */
+    void setMaxTableSize(size_t maxTableSize);
+
+    /**
+     * Codifica una lista de cabeceras
+     * @param headers Cabeceras (los nombres deben estar en minúsculas)
+     * @param output Bloque codificado (se añade al final)
+     */
+    void encode(const std::vector<std::pair<std::string, std::string>>& headers, std::string& output);
+
+private:
+    HpackTable m_table;
+    size_t m_pendingSizeUpdate;   // Tamaño a anunciar en el siguiente bloque, o SIZE_MAX
+};
+
+/**
+ * Decodificador de bloques de cabeceras HPACK
+ */
+class HpackDecoder {
+public:
+    /**
+     * Constructor
+     * @param maxTableSize Tamaño máximo de la tabla dinámica que aceptamos
+     * @param maxHeaderListSize Tamaño máximo de la lista decodificada según RFC 7541 4.1 (0 = sin límite)
+     */
+    explicit HpackDecoder(size_t maxTableSize = 4096, size_t maxHeaderListSize = 0);
+
+    /**
+     * Decodifica un bloque de cabeceras completo
+     * @param data Bloque codificado
+     * @param length Longitud del bloque
+     * @param headers Cabeceras decodificadas (salida)
+     * @return false si el bloque está mal formado o la lista supera el tamaño máximo
+     */
+    bool decode(const uint8_t* data, size_t length, std::vector<std::pair<std::string, std::string>>& headers);
+
+    /**
+     * Indica si el último decode falló por superar el tamaño máximo de la lista
+     */
+    bool isHeaderListTooLarge() const;
+
+private:
+    HpackTable m_table;
+    size_t m_maxTableSize;
+    size_t m_maxHeaderListSize;
+    bool m_headerListTooLarge;
+};
+
+/**
+ * Codificación Huffman de HPACK
+ */
+namespace Huffman {
+
+/**
+ * Calcula la longitud codificada de un texto
+ */
+size_t encodedLength(const std::string& text);
+
+/**
+ * Codifica un texto y lo añade a output
+ */
+void encode(const std::string& text, std::string& output);
+
+/**
+ * Decodifica un texto
+ * @return false si la codificación no es válida
+ */
+bool decode(const uint8_t* data, size_t length, std::string& output);
+
+} // namespace Huffman
+
+} // namespace Core::Network
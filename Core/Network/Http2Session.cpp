@@ -0,0 +1,679 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación de la capa de tramas HTTP/2 del lado del cliente
+ */
+
+#include "Http2Session.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace Core::Network {
+
+namespace {
+
+// Prefacio que abre toda conexión HTTP/2 del cliente
+constexpr char CONNECTION_PREFACE[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+// Ventanas de recepción que se conceden al servidor. Las predeterminadas
+// (64 KiB) limitan mucho las descargas con latencia alta.
+constexpr uint32_t STREAM_WINDOW = 1024 * 1024;
+constexpr uint32_t CONNECTION_WINDOW = 16 * 1024 * 1024;
+constexpr uint32_t DEFAULT_WINDOW = 65535;
+constexpr int64_t MAX_WINDOW = 0x7FFFFFFF;
+
+// Tamaño máximo de trama que aceptamos (el predeterminado, no se anuncia otro)
+constexpr uint32_t MAX_FRAME_SIZE = 16384;
+
+// Tamaño máximo de la lista de cabeceras que aceptamos (se anuncia en SETTINGS);
+// también limita el bloque comprimido acumulado entre HEADERS y CONTINUATION
+constexpr uint32_t MAX_HEADER_LIST_SIZE = 256 * 1024;
+
+// DATA generado como mucho por cada llamada a takeOutput()
+constexpr size_t OUTPUT_BUDGET = 64 * 1024;
+
+// Identificadores de SETTINGS
+constexpr uint16_t SETTINGS_HEADER_TABLE_SIZE = 0x1;
+constexpr uint16_t SETTINGS_ENABLE_PUSH = 0x2;
+constexpr uint16_t SETTINGS_MAX_CONCURRENT_STREAMS = 0x3;
+constexpr uint16_t SETTINGS_INITIAL_WINDOW_SIZE = 0x4;
+constexpr uint16_t SETTINGS_MAX_FRAME_SIZE = 0x5;
+constexpr uint16_t SETTINGS_MAX_HEADER_LIST_SIZE = 0x6;
+
+// Indicadores de las tramas
+constexpr uint8_t FLAG_END_STREAM = 0x1;
+constexpr uint8_t FLAG_ACK = 0x1;
+constexpr uint8_t FLAG_END_HEADERS = 0x4;
+constexpr uint8_t FLAG_PADDED = 0x8;
+constexpr uint8_t FLAG_PRIORITY = 0x20;
+
+uint32_t readUint32(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+void writeUint32(std::vector<uint8_t>& output, uint32_t value) {
+    output.push_back(static_cast<uint8_t>(value >> 24));
+    output.push_back(static_cast<uint8_t>(value >> 16));
+    output.push_back(static_cast<uint8_t>(value >> 8));
+    output.push_back(static_cast<uint8_t>(value));
+}
+
+void writeSetting(std::vector<uint8_t>& output, uint16_t id, uint32_t value) {
+    output.push_back(static_cast<uint8_t>(id >> 8));
+    output.push_back(static_cast<uint8_t>(id));
+    writeUint32(output, value);
+}
+
+} // namespace
+
+Http2Session::Http2Session() :
+    m_decoder(4096, MAX_HEADER_LIST_SIZE),
+    m_nextStreamId(1),
+    m_sendWindow(DEFAULT_WINDOW),
+    m_receiveWindow(DEFAULT_WINDOW),
+    m_unacknowledged(0),
+    m_peerInitialWindow(DEFAULT_WINDOW),
+    m_peerMaxFrameSize(MAX_FRAME_SIZE),
+    m_peerMaxStreams(100),
+    m_passBase(0),
+    m_goAway(false),
+    m_failed(false),
+    m_frameHeaderUsed(0),
+    m_frameLength(0),
+    m_frameType(FrameType::DATA),
+    m_frameFlags(0),
+    m_frameStream(0),
+    m_dataRemaining(0),
+    m_streamingData(false),
+    m_headerStream(0),
+    m_headerEndStream(false),
+    m_expectContinuation(false) {
+}
+
+Http2Session::~Http2Session() = default;
+
+void Http2Session::setCallbacks(Callbacks callbacks) {
+    m_callbacks = std::move(callbacks);
+}
+
+void Http2Session::start() {
+    m_output.insert(m_output.end(), CONNECTION_PREFACE, CONNECTION_PREFACE + sizeof(CONNECTION_PREFACE) - 1);
+
+    // Sin server push, con una ventana por flujo mayor que la predeterminada
+    // y con límite para la lista de cabeceras
+    writeFrameHeader(18, FrameType::SETTINGS, 0, 0);
+    writeSetting(m_output, SETTINGS_ENABLE_PUSH, 0);
+    writeSetting(m_output, SETTINGS_INITIAL_WINDOW_SIZE, STREAM_WINDOW);
+    writeSetting(m_output, SETTINGS_MAX_HEADER_LIST_SIZE, MAX_HEADER_LIST_SIZE);
+
+    // La ventana de la conexión solo se amplía con WINDOW_UPDATE
+    writeWindowUpdate(0, CONNECTION_WINDOW - DEFAULT_WINDOW);
+    m_receiveWindow = CONNECTION_WINDOW;
+}
+
+uint32_t Http2Session::submitRequest(const Headers& headers, const ByteBuffer& body, int weight) {
+    if (!canOpenStream()) {
+        return 0;
+    }
+
+    uint32_t streamId = m_nextStreamId;
+    m_nextStreamId += 2;
+
+    std::string block;
+    m_encoder.encode(headers, block);
+
+    // HEADERS con la prioridad (sin dependencia) y CONTINUATION si el bloque no cabe
+    weight = std::clamp(weight, 1, 256);
+    size_t first = std::min<size_t>(block.size(), m_peerMaxFrameSize - 5);
+    uint8_t flags = FLAG_PRIORITY;
+    if (first == block.size()) flags |= FLAG_END_HEADERS;
+    if (body.empty()) flags |= FLAG_END_STREAM;
+
+    writeFrameHeader(first + 5, FrameType::HEADERS, flags, streamId);
+    writeUint32(m_output, 0);
+    m_output.push_back(static_cast<uint8_t>(weight - 1));
+    m_output.insert(m_output.end(), block.begin(), block.begin() + first);
+
+    for (size_t offset = first; offset < block.size();) {
+        size_t take = std::min<size_t>(block.size() - offset, m_peerMaxFrameSize);
+        bool last = offset + take == block.size();
+        writeFrameHeader(take, FrameType::CONTINUATION, last ? FLAG_END_HEADERS : 0, streamId);
+        m_output.insert(m_output.end(), block.begin() + offset, block.begin() + offset + take);
+        offset += take;
+    }
+
+    Stream& stream = m_streams[streamId];
+    stream.sendWindow = m_peerInitialWindow;
+    stream.receiveWindow = STREAM_WINDOW;
+    stream.unacknowledged = 0;
+    stream.weight = weight;
+    stream.pass = m_passBase;
+    stream.body = body;
+    stream.bodyPending = !body.empty();
+    stream.responseStarted = false;
+    return streamId;
+}
+
+void Http2Session::resetStream(uint32_t streamId, uint32_t errorCode) {
+    if (m_streams.erase(streamId) == 0 || m_failed) {
+        return;
+    }
+    writeFrameHeader(4, FrameType::RST_STREAM, 0, streamId);
+    writeUint32(m_output, errorCode);
+}
+
+bool Http2Session::feed(const std::shared_ptr<const void>& block, const uint8_t* data, size_t length) {
+    size_t offset = 0;
+
+    while (offset < length && !m_failed) {
+        // Cabecera de 9 bytes de la siguiente trama
+        if (m_frameHeaderUsed < sizeof(m_frameHeader)) {
+            size_t take = std::min(sizeof(m_frameHeader) - m_frameHeaderUsed, length - offset);
+            std::memcpy(m_frameHeader + m_frameHeaderUsed, data + offset, take);
+            m_frameHeaderUsed += take;
+            offset += take;
+            if (m_frameHeaderUsed < sizeof(m_frameHeader)) {
+                break;
+            }
+
+            m_frameLength = (static_cast<uint32_t>(m_frameHeader[0]) << 16) |
+                            (static_cast<uint32_t>(m_frameHeader[1]) << 8) | m_frameHeader[2];
+            m_frameType = static_cast<FrameType>(m_frameHeader[3]);
+            m_frameFlags = m_frameHeader[4];
+            m_frameStream = readUint32(m_frameHeader + 5) & 0x7FFFFFFF;
+            m_payload.clear();
+
+            if (m_frameLength > MAX_FRAME_SIZE) {
+                return connectionError(FRAME_SIZE_ERROR, "Trama demasiado grande");
+            }
+            if (m_expectContinuation &&
+                (m_frameType != FrameType::CONTINUATION || m_frameStream != m_headerStream)) {
+                return connectionError(PROTOCOL_ERROR, "Se esperaba CONTINUATION");
+            }
+
+            // DATA sin relleno se entrega a medida que llega, sin acumularlo
+            m_streamingData = m_frameType == FrameType::DATA && !(m_frameFlags & FLAG_PADDED);
+            if (m_streamingData) {
+                if (!beginData()) {
+                    return false;
+                }
+                m_dataRemaining = m_frameLength;
+            }
+        }
+
+        if (m_streamingData) {
+            size_t take = std::min(m_dataRemaining, length - offset);
+            auto it = m_streams.find(m_frameStream);
+            if (take > 0 && it != m_streams.end() && m_callbacks.onData &&
+                !m_callbacks.onData(m_frameStream, ByteBuffer::wrap(block, data + offset, take))) {
+                resetStream(m_frameStream, CANCEL);
+            }
+            m_dataRemaining -= take;
+            offset += take;
+            if (m_dataRemaining > 0) {
+                break;
+            }
+            m_frameHeaderUsed = 0;
+            endData();
+            continue;
+        }
+
+        size_t take = std::min<size_t>(m_frameLength - m_payload.size(), length - offset);
+        m_payload.insert(m_payload.end(), data + offset, data + offset + take);
+        offset += take;
+        if (m_payload.size() < m_frameLength) {
+            break;
+        }
+
+        m_frameHeaderUsed = 0;
+        if (!processFrame(m_payload.data(), m_payload.size())) {
+            return false;
+        }
+    }
+
+    return !m_failed;
+}
+
+void Http2Session::takeOutput(std::vector<uint8_t>& output) {
+    scheduleData(OUTPUT_BUDGET);
+    if (output.empty()) {
+        output.swap(m_output);
+    } else {
+        output.insert(output.end(), m_output.begin(), m_output.end());
+    }
+    m_output.clear();
+}
+
+bool Http2Session::hasOutput() const {
+    if (!m_output.empty()) {
+        return true;
+    }
+    if (m_sendWindow <= 0 || m_failed) {
+        return false;
+    }
+    return std::any_of(m_streams.begin(), m_streams.end(), [](const auto& entry) {
+        return entry.second.bodyPending && entry.second.sendWindow > 0;
+    });
+}
+
+bool Http2Session::canOpenStream() const {
+    return !m_goAway && !m_failed && m_streams.size() < m_peerMaxStreams && m_nextStreamId < MAX_WINDOW;
+}
+
+void Http2Session::writeFrameHeader(size_t length, FrameType type, uint8_t flags, uint32_t streamId) {
+    m_output.push_back(static_cast<uint8_t>(length >> 16));
+    m_output.push_back(static_cast<uint8_t>(length >> 8));
+    m_output.push_back(static_cast<uint8_t>(length));
+    m_output.push_back(static_cast<uint8_t>(type));
+    m_output.push_back(flags);
+    writeUint32(m_output, streamId);
+}
+
+void Http2Session::writeWindowUpdate(uint32_t streamId, uint32_t increment) {
+    writeFrameHeader(4, FrameType::WINDOW_UPDATE, 0, streamId);
+    writeUint32(m_output, increment);
+}
+
+bool Http2Session::processFrame(const uint8_t* payload, size_t length) {
+    switch (m_frameType) {
+        case FrameType::DATA: {
+            // Solo llegan aquí las tramas DATA con relleno
+            if (!beginData()) {
+                return false;
+            }
+            size_t padding = length > 0 ? payload[0] : 0;
+            if (length == 0 || padding >= length) {
+                return connectionError(PROTOCOL_ERROR, "Relleno de DATA no válido");
+            }
+            size_t dataLength = length - 1 - padding;
+            if (dataLength > 0 && m_streams.count(m_frameStream) && m_callbacks.onData &&
+                !m_callbacks.onData(m_frameStream, ByteBuffer::copyOf(payload + 1, dataLength))) {
+                resetStream(m_frameStream, CANCEL);
+            }
+            endData();
+            return true;
+        }
+
+        case FrameType::HEADERS:
+            return processHeaders(payload, length);
+
+        case FrameType::CONTINUATION:
+            if (!m_expectContinuation) {
+                return connectionError(PROTOCOL_ERROR, "CONTINUATION inesperado");
+            }
+            if (m_headerBlock.size() + length > MAX_HEADER_LIST_SIZE) {
+                return connectionError(ENHANCE_YOUR_CALM, "Bloque de cabeceras demasiado grande");
+            }
+            m_headerBlock.append(reinterpret_cast<const char*>(payload), length);
+            if (m_frameFlags & FLAG_END_HEADERS) {
+                m_expectContinuation = false;
+                return processHeaderBlock();
+            }
+            return true;
+
+        case FrameType::RST_STREAM: {
+            if (length != 4) {
+                return connectionError(FRAME_SIZE_ERROR, "RST_STREAM de tamaño no válido");
+            }
+            if (m_frameStream == 0) {
+                return connectionError(PROTOCOL_ERROR, "RST_STREAM en el flujo 0");
+            }
+            if (m_streams.erase(m_frameStream) > 0 && m_callbacks.onStreamReset) {
+                m_callbacks.onStreamReset(m_frameStream, readUint32(payload));
+            }
+            return true;
+        }
+
+        case FrameType::SETTINGS:
+            return processSettings(payload, length);
+
+        case FrameType::PUSH_PROMISE:
+            return connectionError(PROTOCOL_ERROR, "PUSH_PROMISE con server push deshabilitado");
+
+        case FrameType::PING:
+            if (length != 8 || m_frameStream != 0) {
+                return connectionError(FRAME_SIZE_ERROR, "PING no válido");
+            }
+            if (!(m_frameFlags & FLAG_ACK)) {
+                writeFrameHeader(8, FrameType::PING, FLAG_ACK, 0);
+                m_output.insert(m_output.end(), payload, payload + 8);
+            }
+            return true;
+
+        case FrameType::GOAWAY:
+            return processGoAway(payload, length);
+
+        case FrameType::WINDOW_UPDATE:
+            return processWindowUpdate(payload, length);
+
+        case FrameType::PRIORITY:
+        default:
+            // PRIORITY y los tipos desconocidos se ignoran
+            return true;
+    }
+}
+
+bool Http2Session::processHeaders(const uint8_t* payload, size_t length) {
+    if (m_frameStream == 0) {
+        return connectionError(PROTOCOL_ERROR, "HEADERS en el flujo 0");
+    }
+
+    size_t start = 0;
+    size_t padding = 0;
+    if (m_frameFlags & FLAG_PADDED) {
+        if (length < 1) {
+            return connectionError(PROTOCOL_ERROR, "Relleno de HEADERS no válido");
+        }
+        padding = payload[0];
+        start = 1;
+    }
+    if (m_frameFlags & FLAG_PRIORITY) {
+        start += 5;
+    }
+    if (start + padding > length) {
+        return connectionError(PROTOCOL_ERROR, "Relleno de HEADERS no válido");
+    }
+    if (length - start - padding > MAX_HEADER_LIST_SIZE) {
+        return connectionError(ENHANCE_YOUR_CALM, "Bloque de cabeceras demasiado grande");
+    }
+
+    m_headerBlock.assign(reinterpret_cast<const char*>(payload + start), length - start - padding);
+    m_headerStream = m_frameStream;
+    m_headerEndStream = (m_frameFlags & FLAG_END_STREAM) != 0;
+    if (!(m_frameFlags & FLAG_END_HEADERS)) {
+        m_expectContinuation = true;
+        return true;
+    }
+    return processHeaderBlock();
+}
+
+bool Http2Session::processHeaderBlock() {
+    // El bloque se decodifica siempre para mantener sincronizada la tabla dinámica
+    Headers decoded;
+    if (!m_decoder.decode(reinterpret_cast<const uint8_t*>(m_headerBlock.data()), m_headerBlock.size(), decoded)) {
+        if (m_decoder.isHeaderListTooLarge()) {
+            return connectionError(ENHANCE_YOUR_CALM, "Lista de cabeceras demasiado grande");
+        }
+        return connectionError(COMPRESSION_ERROR, "Bloque de cabeceras HPACK no válido");
+    }
+    m_headerBlock.clear();
+
+    uint32_t streamId = m_headerStream;
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end()) {
+        return true;
+    }
+
+    if (!it->second.responseStarted) {
+        int status = 0;
+        Headers headers;
+        headers.reserve(decoded.size());
+        for (auto& header : decoded) {
+            if (header.first == ":status") {
+                status = std::atoi(header.second.c_str());
+            } else if (header.first.empty() || header.first[0] != ':') {
+                headers.push_back(std::move(header));
+            }
+        }
+
+        if (status < 100 || status > 999) {
+            resetStream(streamId, PROTOCOL_ERROR);
+            if (m_callbacks.onStreamReset) {
+                m_callbacks.onStreamReset(streamId, PROTOCOL_ERROR);
+            }
+            return true;
+        }
+
+        // Las respuestas informativas (100 Continue, 103 Early Hints) preceden a la final
+        if (status < 200) {
+            return true;
+        }
+
+        it->second.responseStarted = true;
+        if (m_callbacks.onHeaders) {
+            m_callbacks.onHeaders(streamId, status, headers);
+        }
+    }
+
+    // Tras la respuesta, un segundo bloque son los trailers: se descartan
+    if (m_headerEndStream && m_streams.count(streamId)) {
+        closeStream(streamId);
+    }
+    return true;
+}
+
+bool Http2Session::processSettings(const uint8_t* payload, size_t length) {
+    if (m_frameStream != 0) {
+        return connectionError(PROTOCOL_ERROR, "SETTINGS fuera del flujo 0");
+    }
+    if (m_frameFlags & FLAG_ACK) {
+        return length == 0 || connectionError(FRAME_SIZE_ERROR, "SETTINGS ACK con contenido");
+    }
+    if (length % 6 != 0) {
+        return connectionError(FRAME_SIZE_ERROR, "SETTINGS de tamaño no válido");
+    }
+
+    for (size_t offset = 0; offset < length; offset += 6) {
+        uint16_t id = static_cast<uint16_t>((payload[offset] << 8) | payload[offset + 1]);
+        uint32_t value = readUint32(payload + offset + 2);
+
+        switch (id) {
+            case SETTINGS_HEADER_TABLE_SIZE:
+                m_encoder.setMaxTableSize(value);
+                break;
+            case SETTINGS_MAX_CONCURRENT_STREAMS:
+                m_peerMaxStreams = value;
+                break;
+            case SETTINGS_INITIAL_WINDOW_SIZE: {
+                if (value > MAX_WINDOW) {
+                    return connectionError(FLOW_CONTROL_ERROR, "Ventana inicial no válida");
+                }
+                // El cambio se aplica también a los flujos ya abiertos
+                int64_t delta = static_cast<int64_t>(value) - m_peerInitialWindow;
+                for (auto& entry : m_streams) {
+                    entry.second.sendWindow += delta;
+                }
+                m_peerInitialWindow = value;
+                break;
+            }
+            case SETTINGS_MAX_FRAME_SIZE:
+                if (value < 16384 || value > 16777215) {
+                    return connectionError(PROTOCOL_ERROR, "Tamaño máximo de trama no válido");
+                }
+                m_peerMaxFrameSize = value;
+                break;
+            case SETTINGS_ENABLE_PUSH:
+            default:
+                break;
+        }
+    }
+
+    writeFrameHeader(0, FrameType::SETTINGS, FLAG_ACK, 0);
+    return true;
+}
+
+bool Http2Session::processGoAway(const uint8_t* payload, size_t length) {
+    if (length < 8 || m_frameStream != 0) {
+        return connectionError(FRAME_SIZE_ERROR, "GOAWAY no válido");
+    }
+    m_goAway = true;
+
+    // Los flujos posteriores al último procesado no llegaron a atenderse
+    uint32_t lastStreamId = readUint32(payload) & 0x7FFFFFFF;
+    std::vector<uint32_t> refused;
+    for (auto it = m_streams.upper_bound(lastStreamId); it != m_streams.end(); ++it) {
+        refused.push_back(it->first);
+    }
+    for (uint32_t streamId : refused) {
+        m_streams.erase(streamId);
+        if (m_callbacks.onStreamReset) {
+            m_callbacks.onStreamReset(streamId, REFUSED_STREAM);
+        }
+    }
+    return true;
+}
+
+bool Http2Session::processWindowUpdate(const uint8_t* payload, size_t length) {
+    if (length != 4) {
+        return connectionError(FRAME_SIZE_ERROR, "WINDOW_UPDATE de tamaño no válido");
+    }
+    uint32_t increment = readUint32(payload) & 0x7FFFFFFF;
+
+    if (m_frameStream == 0) {
+        if (increment == 0) {
+            return connectionError(PROTOCOL_ERROR, "WINDOW_UPDATE con incremento 0");
+        }
+        m_sendWindow += increment;
+        if (m_sendWindow > MAX_WINDOW) {
+            return connectionError(FLOW_CONTROL_ERROR, "Ventana de la conexión desbordada");
+        }
+        return true;
+    }
+
+    auto it = m_streams.find(m_frameStream);
+    if (it == m_streams.end()) {
+        return true;
+    }
+    it->second.sendWindow += increment;
+    if (increment == 0 || it->second.sendWindow > MAX_WINDOW) {
+        uint32_t errorCode = increment == 0 ? PROTOCOL_ERROR : FLOW_CONTROL_ERROR;
+        resetStream(m_frameStream, errorCode);
+        if (m_callbacks.onStreamReset) {
+            m_callbacks.onStreamReset(m_frameStream, errorCode);
+        }
+    }
+    return true;
+}
+
+bool Http2Session::beginData() {
+    if (m_frameStream == 0) {
+        return connectionError(PROTOCOL_ERROR, "DATA en el flujo 0");
+    }
+
+    // Todo el contenido de la trama, relleno incluido, cuenta para el control de flujo
+    if (m_frameLength > m_receiveWindow) {
+        return connectionError(FLOW_CONTROL_ERROR, "Ventana de la conexión superada");
+    }
+    m_receiveWindow -= m_frameLength;
+
+    auto it = m_streams.find(m_frameStream);
+    if (it != m_streams.end() && m_frameLength > it->second.receiveWindow) {
+        resetStream(m_frameStream, FLOW_CONTROL_ERROR);
+        if (m_callbacks.onStreamReset) {
+            m_callbacks.onStreamReset(m_frameStream, FLOW_CONTROL_ERROR);
+        }
+    } else if (it != m_streams.end()) {
+        it->second.receiveWindow -= m_frameLength;
+    }
+
+    // Los datos se consumen en cuanto se entregan: el crédito se devuelve ya
+    consumeReceived(m_frameStream, m_frameLength, (m_frameFlags & FLAG_END_STREAM) != 0);
+    return true;
+}
+
+void Http2Session::endData() {
+    if ((m_frameFlags & FLAG_END_STREAM) && m_streams.count(m_frameStream)) {
+        closeStream(m_frameStream);
+    }
+}
+
+void Http2Session::consumeReceived(uint32_t streamId, size_t length, bool streamEnding) {
+    if (length == 0) {
+        return;
+    }
+
+    // WINDOW_UPDATE al consumir la mitad de la ventana, no por cada trama
+    m_unacknowledged += static_cast<uint32_t>(length);
+    if (m_unacknowledged >= CONNECTION_WINDOW / 2) {
+        writeWindowUpdate(0, m_unacknowledged);
+        m_receiveWindow += m_unacknowledged;
+        m_unacknowledged = 0;
+    }
+
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end() || streamEnding) {
+        return;
+    }
+    Stream& stream = it->second;
+    stream.unacknowledged += static_cast<uint32_t>(length);
+    if (stream.unacknowledged >= STREAM_WINDOW / 2) {
+        writeWindowUpdate(streamId, stream.unacknowledged);
+        stream.receiveWindow += stream.unacknowledged;
+        stream.unacknowledged = 0;
+    }
+}
+
+void Http2Session::scheduleData(size_t budget) {
+    // Reparto ponderado: cada trama avanza la posición del flujo en proporción
+    // inversa a su peso y se atiende siempre al flujo más retrasado
+    while (budget > 0 && m_sendWindow > 0 && !m_failed) {
+        uint32_t streamId = 0;
+        Stream* next = nullptr;
+        for (auto& entry : m_streams) {
+            Stream& stream = entry.second;
+            if (stream.bodyPending && stream.sendWindow > 0 && (!next || stream.pass < next->pass)) {
+                streamId = entry.first;
+                next = &stream;
+            }
+        }
+        if (!next) {
+            break;
+        }
+
+        size_t take = std::min<size_t>({next->body.size(), m_peerMaxFrameSize, budget,
+                                        static_cast<size_t>(next->sendWindow),
+                                        static_cast<size_t>(m_sendWindow)});
+        bool last = take == next->body.size();
+
+        writeFrameHeader(take, FrameType::DATA, last ? FLAG_END_STREAM : 0, streamId);
+        size_t position = m_output.size();
+        m_output.resize(position + take);
+        next->body.copyTo(m_output.data() + position, 0, take);
+
+        next->sendWindow -= static_cast<int64_t>(take);
+        m_sendWindow -= static_cast<int64_t>(take);
+        budget -= take;
+        m_passBase = next->pass;
+        next->pass += std::max<uint64_t>(1, take * 256 / static_cast<uint64_t>(next->weight));
+
+        if (last) {
+            next->body.clear();
+            next->bodyPending = false;
+        } else {
+            next->body = next->body.slice(take);
+        }
+    }
+}
+
+void Http2Session::closeStream(uint32_t streamId) {
+    auto it = m_streams.find(streamId);
+    if (it == m_streams.end()) {
+        return;
+    }
+
+    // El servidor puede responder antes de recibir todo el cuerpo: se deja de enviar
+    if (it->second.bodyPending) {
+        resetStream(streamId, NO_ERROR);
+    } else {
+        m_streams.erase(it);
+    }
+
+    if (m_callbacks.onStreamEnd) {
+        m_callbacks.onStreamEnd(streamId);
+    }
+}
+
+bool Http2Session::connectionError(uint32_t errorCode, const std::string& message) {
+    if (!m_failed) {
+        writeFrameHeader(8, FrameType::GOAWAY, 0, 0);
+        writeUint32(m_output, 0);
+        writeUint32(m_output, errorCode);
+    }
+    m_failed = true;
+    m_error = message;
+    return false;
+}
+
+} // namespace Core::Network
@@ -0,0 +1,231 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Capa de tramas HTTP/2 del lado del cliente
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <memory>
+#include <cstdint>
+#include "ByteBuffer.h"
+#include "Hpack.h"
+
+namespace Core::Network {
+
+/**
+ * Sesión HTTP/2 de cliente sobre una única conexión (RFC 9113)
+ * No realiza E/S: los bytes recibidos se pasan a feed() y las tramas a enviar
+ * se obtienen con takeOutput(). Así la misma sesión sirve para h2c con
+ * conocimiento previo y, más adelante, para h2 negociado por ALPN sobre TLS.
+ *
+ * Gestiona el control de flujo en ambos sentidos: los cuerpos de las
+ * solicitudes se envían según las ventanas del servidor, repartiendo la
+ * ventana de la conexión entre los flujos en proporción a su peso, y se
+ * concede crédito al servidor a medida que se consumen los datos recibidos.
+ *
+ * Los callbacks se invocan desde feed(); no deben destruir la sesión.
+ */
+class Http2Session {
+public:
+    using Headers = std::vector<std::pair<std::string, std::string>>;
+
+    // Códigos de error de RST_STREAM y GOAWAY
+    static constexpr uint32_t NO_ERROR = 0x0;
+    static constexpr uint32_t PROTOCOL_ERROR = 0x1;
+    static constexpr uint32_t INTERNAL_ERROR = 0x2;
+    static constexpr uint32_t FLOW_CONTROL_ERROR = 0x3;
+    static constexpr uint32_t STREAM_CLOSED = 0x5;
+    static constexpr uint32_t FRAME_SIZE_ERROR = 0x6;
+    static constexpr uint32_t REFUSED_STREAM = 0x7;
+    static constexpr uint32_t CANCEL = 0x8;
+    static constexpr uint32_t COMPRESSION_ERROR = 0x9;
+    static constexpr uint32_t ENHANCE_YOUR_CALM = 0xb;
+
+    /**
+     * Callbacks de la sesión
+     */
+    struct Callbacks {
+        // Cabeceras finales de la respuesta de un flujo (no las informativas 1xx)
+        std::function<void(uint32_t, int, const Headers&)> onHeaders;
+
+        // Trozo del cuerpo de un flujo; devolver false cancela el flujo
+        std::function<bool(uint32_t, const ByteBuffer&)> onData;
+
+        // Fin de la respuesta de un flujo
+        std::function<void(uint32_t)> onStreamEnd;
+
+        // Flujo cerrado por el servidor o por un GOAWAY (REFUSED_STREAM: no se procesó)
+        std::function<void(uint32_t, uint32_t)> onStreamReset;
+    };
+
+    /**
+     * Constructor
+     */
+    Http2Session();
+
+    /**
+     * Destructor
+     */
+    ~Http2Session();
+
+    Http2Session(const Http2Session&) = delete;
+    Http2Session& operator=(const Http2Session&) = delete;
+
+    /**
+     * Establece los callbacks de la sesión
+     * @param callbacks Callbacks a invocar
+     */
+    void setCallbacks(Callbacks callbacks);
+
+    /**
+     * Prepara el prefacio de la conexión y los ajustes iniciales
+     * Debe llamarse antes de enviar la primera solicitud.
+     */
+    void start();
+
+    /**
+     * Abre un flujo con una solicitud
+     * @param headers Cabeceras, empezando por las pseudocabeceras (:method, :scheme, :authority, :path)
+     * @param body Cuerpo de la solicitud
+     * @param weight Peso del flujo (1-256) para repartir el ancho de banda de subida
+     * @return ID del flujo, o 0 si no se pueden abrir más flujos
+     */
+    uint32_t submitRequest(const Headers& headers, const ByteBuffer& body, int weight);
+
+    /**
+     * Cancela un flujo enviando RST_STREAM
+     * @param streamId ID del flujo
+     * @param errorCode Código de error
+     */
+    void resetStream(uint32_t streamId, uint32_t errorCode = CANCEL);
+
+    /**
+     * Procesa datos recibidos
+     * Los datos de las tramas DATA no se copian: se referencian dentro de block.
+     * @param block Bloque de memoria que contiene los datos
+     * @param data Inicio de los datos
+     * @param length Número de bytes
+     * @return false si hubo un error de conexión (la sesión deja de ser utilizable)
+     */
+    bool feed(const std::shared_ptr<const void>& block, const uint8_t* data, size_t length);
+
+    /**
+     * Añade a output las tramas pendientes de enviar
+     * Los cuerpos de las solicitudes se trocean según las ventanas de control de
+     * flujo; se generan como mucho unos 64 KiB de DATA por llamada.
+     * @param output Búfer de escritura de la conexión
+     */
+    void takeOutput(std::vector<uint8_t>& output);
+
+    /**
+     * Comprueba si hay tramas listas para enviar
+     * @return true si takeOutput() añadiría datos
+     */
+    bool hasOutput() const;
+
+    /**
+     * Comprueba si se puede abrir otro flujo
+     * @return true si no se ha recibido GOAWAY ni se ha alcanzado el límite del servidor
+     */
+    bool canOpenStream() const;
+
+    /**
+     * Obtiene el número de flujos abiertos
+     * @return Flujos en curso
+     */
+    size_t activeStreams() const { return m_streams.size(); }
+
+    /**
+     * Indica si el servidor envió GOAWAY
+     * @return true si la conexión no admite flujos nuevos
+     */
+    bool isGoingAway() const { return m_goAway; }
+
+    /**
+     * Obtiene el mensaje del último error de conexión
+     * @return Descripción del error
+     */
+    const std::string& errorMessage() const { return m_error; }
+
+private:
+    struct Stream {
+        int64_t sendWindow;        // Crédito del servidor para enviar DATA
+        int64_t receiveWindow;     // Crédito concedido al servidor
+        uint32_t unacknowledged;   // Bytes recibidos aún sin WINDOW_UPDATE
+        int weight;
+        uint64_t pass;             // Posición en el reparto ponderado (menor = siguiente)
+        ByteBuffer body;           // Cuerpo pendiente de enviar
+        bool bodyPending;          // Falta enviar el fin del flujo
+        bool responseStarted;      // Cabeceras finales recibidas
+    };
+
+    enum class FrameType : uint8_t {
+        DATA = 0x0,
+        HEADERS = 0x1,
+        PRIORITY = 0x2,
+        RST_STREAM = 0x3,
+        SETTINGS = 0x4,
+        PUSH_PROMISE = 0x5,
+        PING = 0x6,
+        GOAWAY = 0x7,
+        WINDOW_UPDATE = 0x8,
+        CONTINUATION = 0x9
+    };
+
+    void writeFrameHeader(size_t length, FrameType type, uint8_t flags, uint32_t streamId);
+    void writeWindowUpdate(uint32_t streamId, uint32_t increment);
+    bool processFrame(const uint8_t* payload, size_t length);
+    bool processHeaders(const uint8_t* payload, size_t length);
+    bool processHeaderBlock();
+    bool processSettings(const uint8_t* payload, size_t length);
+    bool processGoAway(const uint8_t* payload, size_t length);
+    bool processWindowUpdate(const uint8_t* payload, size_t length);
+    bool beginData();
+    void endData();
+    void consumeReceived(uint32_t streamId, size_t length, bool streamEnding);
+    void scheduleData(size_t budget);
+    void closeStream(uint32_t streamId);
+    bool connectionError(uint32_t errorCode, const std::string& message);
+
+    Callbacks m_callbacks;
+    HpackEncoder m_encoder;
+    HpackDecoder m_decoder;
+    std::map<uint32_t, Stream> m_streams;
+    std::vector<uint8_t> m_output;
+
+    uint32_t m_nextStreamId;
+    int64_t m_sendWindow;              // Ventana de envío de la conexión
+    int64_t m_receiveWindow;           // Ventana de recepción de la conexión
+    uint32_t m_unacknowledged;         // Bytes de la conexión sin WINDOW_UPDATE
+    uint32_t m_peerInitialWindow;
+    uint32_t m_peerMaxFrameSize;
+    uint32_t m_peerMaxStreams;
+    uint64_t m_passBase;               // Posición con la que entran los flujos nuevos al reparto
+    bool m_goAway;
+    bool m_failed;
+    std::string m_error;
+
+    // Estado del analizador de tramas
+    uint8_t m_frameHeader[9];
+    size_t m_frameHeaderUsed;
+    uint32_t m_frameLength;
+    FrameType m_frameType;
+    uint8_t m_frameFlags;
+    uint32_t m_frameStream;
+    std::vector<uint8_t> m_payload;
+    size_t m_dataRemaining;            // Bytes de una trama DATA sin relleno que se entregan al vuelo
+    bool m_streamingData;
+
+    // Bloque de cabeceras repartido en HEADERS y CONTINUATION
+    std::string m_headerBlock;
+    uint32_t m_headerStream;
+    bool m_headerEndStream;
+    bool m_expectContinuation;
+};
+
+} // namespace Core::Network
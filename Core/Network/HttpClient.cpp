@@ -0,0 +1,1474 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación del cliente HTTP sobre un bucle de eventos epoll
+ */
+
+#include "HttpClient.h"
+#include "SocketManager.h"
+#include "ByteBuffer.h"
+#include "HttpResponseParser.h"
+#include "Http2Session.h"
+#include "BodyDecoder.h"
+#include "DnsResolver.h"
+#include "TlsConnection.h"
+#include "../../Utils/Logging/Logger.h"
+#include "../../Utils/Text/StringUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+namespace Core::Network {
+
+namespace {
+
+using Headers = std::vector<std::pair<std::string, std::string>>;
+using ResponseCallback = std::function<void(int, const Headers&, const ByteBuffer&)>;
+using Clock = std::chrono::steady_clock;
+
+// Tamaño de los bloques en los que se reciben los datos del socket. Los cuerpos
+// de las respuestas referencian estos bloques directamente, sin copiarlos.
+constexpr size_t RECEIVE_BLOCK_SIZE = 64 * 1024;
+
+// Espacio libre mínimo para seguir recibiendo en el bloque actual
+constexpr size_t MIN_RECEIVE_SPACE = 4 * 1024;
+
+// Intentos por solicitud cuando la conexión se cierra antes de la respuesta
+constexpr int MAX_ATTEMPTS = 2;
+
+// Tiempo tras el que se cierra una conexión HTTP/2 sin flujos
+constexpr auto HTTP2_IDLE_TIMEOUT = std::chrono::seconds(30);
+
+using Utils::Text::equalsIgnoreCase;
+
+} // namespace
+
+/**
+ * Solicitud en curso dentro del bucle de eventos
+ */
+struct Transaction {
+    std::string originKey;        // host:puerto al que se conecta (origen o proxy)
+    std::string connectHost;
+    int connectPort;
+    bool secure;                      // HTTPS: conexión TLS
+    std::vector<uint8_t> requestData;  // Solicitud HTTP/1.1 completa (también en HTTP/2 sobre TLS, por si no se negocia h2)
+    bool http2;
+    Headers http2Headers;             // Pseudocabeceras y cabeceras HTTP/2
+    ByteBuffer http2Body;
+    int weight;                       // Peso del flujo HTTP/2
+    ResponseCallback callback;
+    ResponseStreamHandler stream;  // Si tiene onComplete, la respuesta se entrega por partes
+    Clock::time_point deadline;
+    bool idempotent;
+    bool headRequest;
+    int attempts;
+};
+
+/**
+ * Resultado de un flujo HTTP/2
+ */
+enum class StreamOutcome {
+    COMPLETE,
+    FAILED,
+    REFUSED     // El servidor no lo procesó: se puede repetir
+};
+
+/**
+ * Flujo HTTP/2 en curso y su respuesta
+ */
+struct Http2Stream {
+    std::unique_ptr<Transaction> transaction;
+    int statusCode;
+    Headers headers;
+    ByteBuffer body;
+    std::unique_ptr<BodyDecoder> decoder;
+};
+
+/**
+ * Conexión TCP gestionada por el bucle de eventos
+ */
+struct Connection {
+    int fd;
+    int socketId;                 // ID del socket en el SocketManager
+    uint64_t serial;              // Distingue conexiones que reutilizan el mismo descriptor
+    std::string originKey;
+    TlsConnection* tls;           // Estado TLS, propiedad del SocketManager (nullptr sin TLS)
+    bool tcpConnected;
+    bool connected;               // Conexión TCP y negociación TLS terminadas
+    bool earlyData;               // Las solicitudes pueden enviarse como datos 0-RTT
+    bool closing;                 // No aceptar más solicitudes (Connection: close)
+    bool writeInterest;           // EPOLLOUT registrado
+    std::vector<uint8_t> writeBuffer;
+    size_t writeOffset;
+    std::deque<std::unique_ptr<Transaction>> inFlight;
+    HttpResponseParser reader;
+    std::shared_ptr<uint8_t[]> receiveBlock;  // Bloque donde se reciben los datos
+    size_t receiveUsed;                       // Bytes ya ocupados del bloque
+    Clock::time_point lastActivity;
+
+    // HTTP/2: sesión, flujos en curso y flujos terminados durante la última lectura
+    std::unique_ptr<Http2Session> http2;
+    std::map<uint32_t, Http2Stream> streams;
+    std::vector<std::pair<uint32_t, StreamOutcome>> finishedStreams;
+};
+
+class HttpClient::HttpClientImpl {
+public:
+    HttpClientImpl() :
+        m_timeoutMs(30000),
+        m_verifySsl(true),
+        m_pipelining(false),
+        m_maxPipelineDepth(8),
+        m_maxConnectionsPerHost(6),
+        m_pendingCount(0),
+        m_decompress(true),
+        m_earlyData(false),
+        m_sockets(std::make_shared<SocketManager>()),
+        m_epollFd(-1),
+        m_wakeFd(-1),
+        m_running(false),
+        m_nextSerial(0) {
+        m_proxy.port = 0;
+        m_proxy.enabled = false;
+    }
+
+    ~HttpClientImpl() {
+        stop();
+    }
+
+    bool start() {
+        std::lock_guard<std::mutex> lock(m_startMutex);
+        if (m_running) {
+            return true;
+        }
+
+        m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+        m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_epollFd < 0 || m_wakeFd < 0) {
+            Utils::Logging::Logger::error("HttpClient: No se pudo crear el bucle de eventos");
+            return false;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = m_wakeFd;
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event);
+
+        // Los nombres se resuelven dentro del propio bucle, sin bloquearlo
+        m_resolver = std::make_unique<DnsResolver>(m_sockets->getDnsCache());
+        if (m_resolver->getDescriptor() >= 0) {
+            event.data.fd = m_resolver->getDescriptor();
+            epoll_ctl(m_epollFd, EPOLL_CTL_ADD, event.data.fd, &event);
+        }
+
+        m_running = true;
+        m_loopThread = std::thread(&HttpClientImpl::run, this);
+        return true;
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_startMutex);
+            if (!m_running) {
+                return;
+            }
+            m_running = false;
+        }
+        wake();
+        if (m_loopThread.joinable()) {
+            m_loopThread.join();
+        }
+
+        for (auto& entry : m_connections) {
+            m_sockets->releaseConnection(entry.second->socketId, false);
+        }
+        m_connections.clear();
+        m_origins.clear();
+        m_resolved.clear();
+        m_resolver.reset();
+        close(m_wakeFd);
+        close(m_epollFd);
+    }
+
+    bool isRunning() const {
+        return m_running;
+    }
+
+    void submit(std::unique_ptr<Transaction> transaction) {
+        m_pendingCount++;
+        {
+            std::lock_guard<std::mutex> lock(m_submitMutex);
+            m_submitted.push_back(std::move(transaction));
+        }
+        wake();
+    }
+
+    void post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(m_submitMutex);
+            m_tasks.push_back(std::move(task));
+        }
+        wake();
+    }
+
+    // Configuración compartida con el hilo que envía las solicitudes
+    std::mutex m_configMutex;
+    struct {
+        std::string host;
+        int port;
+        std::string username;
+        std::string password;
+        bool enabled;
+    } m_proxy;
+    std::atomic<int> m_timeoutMs;
+    std::atomic<bool> m_verifySsl;
+    std::atomic<bool> m_pipelining;
+    std::atomic<int> m_maxPipelineDepth;
+    std::atomic<int> m_maxConnectionsPerHost;
+    std::atomic<size_t> m_pendingCount;
+    std::atomic<bool> m_decompress;
+    std::atomic<bool> m_earlyData;
+
+    // Pool de conexiones; solo se sustituye antes de arrancar el bucle
+    std::shared_ptr<SocketManager> m_sockets;
+
+private:
+    struct Origin {
+        std::deque<std::unique_ptr<Transaction>> pending;
+        std::vector<Connection*> connections;
+        bool http2 = false;
+        bool resolving = false;   // Resolución DNS del host en curso
+    };
+
+    void wake() {
+        uint64_t one = 1;
+        ssize_t ignored = write(m_wakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+
+    void run() {
+        epoll_event events[256];
+        Clock::time_point lastSweep = Clock::now();
+
+        while (m_running) {
+            int count = epoll_wait(m_epollFd, events, 256, 100);
+
+            for (int i = 0; i < count; i++) {
+                if (events[i].data.fd == m_wakeFd) {
+                    uint64_t value;
+                    while (read(m_wakeFd, &value, sizeof(value)) > 0) {
+                    }
+                    takeSubmitted();
+                    continue;
+                }
+                if (events[i].data.fd == m_resolver->getDescriptor()) {
+                    m_resolver->processEvents();
+                    continue;
+                }
+
+                auto it = m_connections.find(events[i].data.fd);
+                if (it != m_connections.end()) {
+                    handleEvent(it->second.get(), events[i].events);
+                }
+            }
+            processResolved();
+
+            // Revisar timeouts y conexiones inactivas como mucho cada 100 ms
+            Clock::time_point now = Clock::now();
+            if (now - lastSweep >= std::chrono::milliseconds(100)) {
+                sweep(now);
+                lastSweep = now;
+            }
+        }
+    }
+
+    void takeSubmitted() {
+        std::vector<std::unique_ptr<Transaction>> submitted;
+        std::vector<std::function<void()>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(m_submitMutex);
+            submitted.swap(m_submitted);
+            tasks.swap(m_tasks);
+        }
+
+        for (auto& task : tasks) {
+            task();
+        }
+
+        std::vector<std::string> touched;
+        for (auto& transaction : submitted) {
+            if (transaction->http2 && m_http1Origins.count(transaction->originKey)) {
+                useHttp1(*transaction);
+            }
+            touched.push_back(transaction->originKey);
+            Origin& origin = m_origins[transaction->originKey];
+            origin.http2 = transaction->http2;
+            origin.pending.push_back(std::move(transaction));
+        }
+
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        for (const auto& originKey : touched) {
+            dispatch(originKey);
+        }
+    }
+
+    void dispatch(const std::string& originKey) {
+        auto originIt = m_origins.find(originKey);
+        if (originIt == m_origins.end()) {
+            return;
+        }
+        Origin& origin = originIt->second;
+        if (origin.http2) {
+            dispatchHttp2(originIt);
+            return;
+        }
+
+        while (!origin.pending.empty()) {
+            Transaction& transaction = *origin.pending.front();
+            Connection* connection = pickConnection(origin, transaction);
+
+            if (!connection) {
+                if (static_cast<int>(origin.connections.size()) >= m_maxConnectionsPerHost ||
+                    !m_sockets->hasCapacity(transaction.connectHost, transaction.connectPort, transaction.secure)) {
+                    break; // Esperar a que quede libre una conexión
+                }
+                if (!ensureResolved(originKey, origin)) {
+                    break;
+                }
+                connection = openConnection(transaction);
+                if (!connection) {
+                    std::unique_ptr<Transaction> failed = std::move(origin.pending.front());
+                    origin.pending.pop_front();
+                    complete(*failed, 0, {}, {});
+                    continue;
+                }
+                origin.connections.push_back(connection);
+            }
+
+            std::unique_ptr<Transaction> next = std::move(origin.pending.front());
+            origin.pending.pop_front();
+            connection->writeBuffer.insert(connection->writeBuffer.end(),
+                                           next->requestData.begin(), next->requestData.end());
+            connection->inFlight.push_back(std::move(next));
+            if (connection->inFlight.size() == 1) {
+                prepareReader(connection);
+            }
+
+            if (connection->connected || (connection->earlyData && connection->tcpConnected)) {
+                flush(connection);
+            }
+        }
+
+        if (origin.pending.empty() && origin.connections.empty()) {
+            m_origins.erase(originIt);
+        }
+    }
+
+    /**
+     * Reparte las solicitudes de un origen HTTP/2 como flujos de sus conexiones
+     * Solo se abre otra conexión cuando la actual deja de aceptar flujos (GOAWAY).
+     */
+    void dispatchHttp2(std::unordered_map<std::string, Origin>::iterator originIt) {
+        Origin& origin = originIt->second;
+        std::vector<std::pair<int, uint64_t>> touched;
+
+        while (!origin.pending.empty()) {
+            Connection* connection = nullptr;
+            bool open = false;
+            for (Connection* candidate : origin.connections) {
+                if (candidate->closing) {
+                    continue;
+                }
+                open = true;
+                if (candidate->http2->canOpenStream()) {
+                    connection = candidate;
+                    break;
+                }
+            }
+
+            if (!connection) {
+                if (open || !ensureResolved(originIt->first, origin)) {
+                    break; // Esperar a que termine algún flujo o a la resolución DNS
+                }
+                connection = openConnection(*origin.pending.front());
+                if (!connection) {
+                    std::unique_ptr<Transaction> failed = std::move(origin.pending.front());
+                    origin.pending.pop_front();
+                    complete(*failed, 0, {}, {});
+                    continue;
+                }
+                origin.connections.push_back(connection);
+            }
+
+            std::unique_ptr<Transaction> next = std::move(origin.pending.front());
+            origin.pending.pop_front();
+            uint32_t streamId = connection->http2->submitRequest(next->http2Headers, next->http2Body, next->weight);
+            Http2Stream& stream = connection->streams[streamId];
+            stream.transaction = std::move(next);
+            stream.statusCode = 0;
+            touched.emplace_back(connection->fd, connection->serial);
+        }
+
+        if (origin.pending.empty() && origin.connections.empty()) {
+            m_origins.erase(originIt);
+        }
+
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        for (const auto& [fd, serial] : touched) {
+            if (isAlive(fd, serial) && m_connections[fd]->connected) {
+                flush(m_connections[fd].get());
+            }
+        }
+    }
+
+    /**
+     * Comprueba que el host al que se conecta un origen está resuelto
+     * Si no está en la caché DNS se lanza la resolución asíncrona y el origen se
+     * vuelve a repartir al terminar; si el host no existe se fallan sus solicitudes.
+     * @return true si se puede abrir una conexión ya
+     */
+    bool ensureResolved(const std::string& originKey, Origin& origin) {
+        const std::string host = origin.pending.front()->connectHost;
+        std::vector<ResolvedAddress> addresses;
+
+        switch (m_sockets->getDnsCache()->lookup(host, addresses)) {
+            case DnsCache::Status::FOUND:
+                return true;
+
+            case DnsCache::Status::MISS:
+                if (!origin.resolving) {
+                    origin.resolving = true;
+                    // El callback puede llegar antes de volver: se atiende al final de la iteración
+                    m_resolver->resolve(host, [this, originKey](const std::vector<ResolvedAddress>& result) {
+                        m_resolved.emplace_back(originKey, !result.empty());
+                    });
+                }
+                return false;
+
+            case DnsCache::Status::NOT_FOUND:
+                break;
+        }
+
+        Utils::Logging::Logger::error("HttpClient: No se pudo resolver " + host);
+        std::deque<std::unique_ptr<Transaction>> failed = std::move(origin.pending);
+        origin.pending.clear();
+        for (auto& transaction : failed) {
+            complete(*transaction, 0, {}, {});
+        }
+        return false;
+    }
+
+    /**
+     * Reparte los orígenes cuya resolución DNS ha terminado
+     */
+    void processResolved() {
+        while (!m_resolved.empty()) {
+            std::vector<std::pair<std::string, bool>> resolved;
+            resolved.swap(m_resolved);
+            for (const auto& entry : resolved) {
+                auto originIt = m_origins.find(entry.first);
+                if (originIt == m_origins.end()) {
+                    continue;
+                }
+                // Un fallo queda en la caché como entrada negativa: el reparto lo detecta
+                originIt->second.resolving = false;
+                dispatch(entry.first);
+            }
+        }
+    }
+
+    Connection* pickConnection(Origin& origin, const Transaction& transaction) {
+        // Preferir una conexión libre; si no, encadenar en una con pipelining
+        for (Connection* connection : origin.connections) {
+            if (!connection->closing && connection->inFlight.empty()) {
+                return connection;
+            }
+        }
+
+        if (!m_pipelining || !transaction.idempotent) {
+            return nullptr;
+        }
+
+        for (Connection* connection : origin.connections) {
+            if (connection->closing ||
+                static_cast<int>(connection->inFlight.size()) >= m_maxPipelineDepth) {
+                continue;
+            }
+            bool allIdempotent = std::all_of(connection->inFlight.begin(), connection->inFlight.end(),
+                                             [](const auto& t) { return t->idempotent; });
+            if (allIdempotent) {
+                return connection;
+            }
+        }
+        return nullptr;
+    }
+
+    Connection* openConnection(const Transaction& transaction) {
+        bool reused = false;
+        const char* protocol = !transaction.http2 ? "http/1.1" : transaction.secure ? "h2" : "h2c";
+        int socketId = m_sockets->acquireConnection(transaction.connectHost, transaction.connectPort, transaction.secure,
+                                                    reused, protocol, m_verifySsl);
+        int fd = socketId < 0 ? -1 : m_sockets->getNativeHandle(socketId);
+        if (fd < 0) {
+            Utils::Logging::Logger::error("HttpClient: No se pudo conectar con " + transaction.originKey);
+            return nullptr;
+        }
+
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->socketId = socketId;
+        connection->serial = m_nextSerial++;
+        connection->originKey = transaction.originKey;
+        connection->tls = m_sockets->getTlsConnection(socketId);
+        connection->tcpConnected = reused;
+        connection->connected = reused;
+        // Solo la primera solicitud HTTP/1.1, si es idempotente, puede ir como datos 0-RTT
+        connection->earlyData = !reused && connection->tls && m_earlyData && !transaction.http2 &&
+                                transaction.idempotent && connection->tls->enableEarlyData();
+        connection->closing = false;
+        connection->writeInterest = !reused;
+        connection->writeOffset = 0;
+        connection->receiveUsed = RECEIVE_BLOCK_SIZE;
+        connection->lastActivity = Clock::now();
+        if (transaction.http2) {
+            startHttp2(connection.get());
+        }
+
+        // Una conexión reutilizada ya está establecida: solo hace falta EPOLLOUT al conectar
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | (reused ? 0u : static_cast<uint32_t>(EPOLLOUT));
+        event.data.fd = fd;
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event);
+
+        Connection* raw = connection.get();
+        m_connections[fd] = std::move(connection);
+        return raw;
+    }
+
+    void handleEvent(Connection* connection, uint32_t events) {
+        if (!connection->tcpConnected) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            getsockopt(connection->fd, SOL_SOCKET, SO_ERROR, &error, &length);
+            if (error != 0 || (events & (EPOLLERR | EPOLLHUP))) {
+                closeConnection(connection, false);
+                return;
+            }
+            if (!(events & EPOLLOUT)) {
+                return;
+            }
+            connection->tcpConnected = true;
+            connection->connected = !connection->tls;
+        }
+
+        if (!connection->connected) {
+            continueHandshake(connection);
+            return;
+        }
+
+        if ((events & EPOLLOUT) && !flush(connection)) {
+            return;
+        }
+
+        if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+            receive(connection);
+        }
+    }
+
+    bool flush(Connection* connection) {
+        while (true) {
+            while (connection->writeOffset < connection->writeBuffer.size()) {
+                const uint8_t* data = connection->writeBuffer.data() + connection->writeOffset;
+                size_t size = connection->writeBuffer.size() - connection->writeOffset;
+                ssize_t sent = connection->tls ? connection->tls->write(data, size) :
+                                                 send(connection->fd, data, size, MSG_NOSIGNAL);
+                if (sent < 0) {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                    closeConnection(connection, false);
+                    return false;
+                }
+                m_sockets->recordTraffic(connection->socketId, true, data, static_cast<size_t>(sent));
+                connection->writeOffset += static_cast<size_t>(sent);
+                connection->lastActivity = Clock::now();
+            }
+
+            if (connection->writeOffset < connection->writeBuffer.size()) {
+                break;
+            }
+            connection->writeBuffer.clear();
+            connection->writeOffset = 0;
+
+            // En HTTP/2 las tramas se generan a medida que se vacía el búfer,
+            // según lo que permitan las ventanas de control de flujo
+            if (!connection->http2 || !connection->http2->hasOutput()) {
+                break;
+            }
+            connection->http2->takeOutput(connection->writeBuffer);
+        }
+
+        // Registrar EPOLLOUT solo mientras queden datos por enviar; durante la
+        // negociación TLS lo decide continueHandshake()
+        if (connection->connected) {
+            setWriteInterest(connection, !connection->writeBuffer.empty());
+        }
+        return true;
+    }
+
+    void setWriteInterest(Connection* connection, bool wantWrite) {
+        if (wantWrite != connection->writeInterest) {
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP | (wantWrite ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+            event.data.fd = connection->fd;
+            epoll_ctl(m_epollFd, EPOLL_CTL_MOD, connection->fd, &event);
+            connection->writeInterest = wantWrite;
+        }
+    }
+
+    /**
+     * Avanza la negociación TLS de una conexión nueva
+     * Con datos 0-RTT, las solicitudes ya asignadas se envían antes de terminarla.
+     */
+    void continueHandshake(Connection* connection) {
+        if (connection->earlyData && !flush(connection)) {
+            return;
+        }
+
+        TlsConnection::HandshakeStatus status = connection->tls->handshake();
+        if (status == TlsConnection::HandshakeStatus::FAILED) {
+            closeConnection(connection, false);
+            return;
+        }
+        if (status != TlsConnection::HandshakeStatus::COMPLETE) {
+            setWriteInterest(connection, status == TlsConnection::HandshakeStatus::WANT_WRITE);
+            return;
+        }
+
+        connection->connected = true;
+        connection->lastActivity = Clock::now();
+        if (connection->earlyData && connection->tls->wasEarlyDataRejected()) {
+            // El servidor descartó los datos 0-RTT: repetir las solicitudes desde el principio
+            connection->writeBuffer.clear();
+            connection->writeOffset = 0;
+            for (const auto& transaction : connection->inFlight) {
+                connection->writeBuffer.insert(connection->writeBuffer.end(),
+                                               transaction->requestData.begin(), transaction->requestData.end());
+            }
+        }
+        if (connection->http2 && connection->tls->getAlpnProtocol() != "h2") {
+            downgradeToHttp1(connection);
+            return;
+        }
+
+        // Enviar lo pendiente y leer lo que el servidor haya mandado con la negociación
+        if (flush(connection)) {
+            receive(connection);
+        }
+    }
+
+    /**
+     * Pasa a HTTP/1.1 las solicitudes de un origen que no aceptó h2 por ALPN
+     * El origen se recuerda para enviar directamente por HTTP/1.1 las solicitudes siguientes.
+     */
+    void downgradeToHttp1(Connection* connection) {
+        std::string originKey = connection->originKey;
+        m_http1Origins.insert(originKey);
+        Utils::Logging::Logger::info("HttpClient: " + originKey + " no admite HTTP/2, se usa HTTP/1.1");
+
+        // Los flujos aún no se han enviado: se conservan en el orden en que se enviaron
+        std::vector<std::unique_ptr<Transaction>> transactions;
+        for (auto& entry : connection->streams) {
+            transactions.push_back(std::move(entry.second.transaction));
+        }
+        connection->streams.clear();
+        auto originIt = m_origins.find(originKey);
+        if (originIt != m_origins.end()) {
+            for (auto& transaction : originIt->second.pending) {
+                transactions.push_back(std::move(transaction));
+            }
+            originIt->second.pending.clear();
+        }
+        closeConnection(connection, false);
+
+        std::string http1Key;
+        for (auto& transaction : transactions) {
+            useHttp1(*transaction);
+            http1Key = transaction->originKey;
+            Origin& origin = m_origins[http1Key];
+            origin.http2 = false;
+            origin.pending.push_back(std::move(transaction));
+        }
+        if (!http1Key.empty()) {
+            dispatch(http1Key);
+        }
+    }
+
+    /**
+     * Prepara una solicitud HTTP/2 sobre TLS para enviarla por HTTP/1.1
+     */
+    static void useHttp1(Transaction& transaction) {
+        transaction.http2 = false;
+        transaction.originKey = "https://" + transaction.connectHost + ":" + std::to_string(transaction.connectPort);
+    }
+
+    void receive(Connection* connection) {
+        while (true) {
+            // Recibir directamente en un bloque compartido; las respuestas
+            // anteriores que lo referencian lo mantienen vivo
+            if (RECEIVE_BLOCK_SIZE - connection->receiveUsed < MIN_RECEIVE_SPACE) {
+                connection->receiveBlock = std::make_shared_for_overwrite<uint8_t[]>(RECEIVE_BLOCK_SIZE);
+                connection->receiveUsed = 0;
+            }
+            std::shared_ptr<const void> block = connection->receiveBlock;
+            uint8_t* buffer = connection->receiveBlock.get() + connection->receiveUsed;
+
+            size_t space = RECEIVE_BLOCK_SIZE - connection->receiveUsed;
+            ssize_t received = connection->tls ? connection->tls->read(buffer, space) : recv(connection->fd, buffer, space, 0);
+            if (received < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+                closeConnection(connection, true);
+                return;
+            }
+            if (received == 0) {
+                closeConnection(connection, true);
+                return;
+            }
+
+            m_sockets->recordTraffic(connection->socketId, false, buffer, static_cast<size_t>(received));
+            connection->receiveUsed += static_cast<size_t>(received);
+            connection->lastActivity = Clock::now();
+            if (connection->http2) {
+                if (!receiveHttp2(connection, block, buffer, static_cast<size_t>(received))) {
+                    return;
+                }
+                continue;
+            }
+
+            size_t offset = 0;
+            while (offset < static_cast<size_t>(received)) {
+                if (connection->inFlight.empty()) {
+                    // Datos sin solicitud asociada: la conexión no es fiable
+                    closeConnection(connection, false);
+                    return;
+                }
+
+                offset += connection->reader.feed(block, buffer + offset, static_cast<size_t>(received) - offset);
+                if (connection->reader.hasError()) {
+                    closeConnection(connection, false);
+                    return;
+                }
+                if (connection->reader.isComplete() && !finishResponse(connection)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * Entrega la respuesta completa de la primera solicitud en curso
+     * Si la conexión queda libre y no hay más solicitudes para el origen se
+     * devuelve al pool del SocketManager.
+     * @return false si la conexión ya no pertenece al bucle
+     */
+    bool finishResponse(Connection* connection) {
+        std::unique_ptr<Transaction> transaction = std::move(connection->inFlight.front());
+        connection->inFlight.pop_front();
+
+        HttpResponseParser& reader = connection->reader;
+        bool keepAlive = reader.keepAlive();
+        Headers headers = reader.headers();
+        ByteBuffer body = reader.takeBody();
+        int statusCode = reader.statusCode();
+
+        if (!connection->inFlight.empty()) {
+            prepareReader(connection);
+        }
+
+        int fd = connection->fd;
+        uint64_t serial = connection->serial;
+        std::string originKey = connection->originKey;
+        if (!keepAlive) {
+            connection->closing = true;
+            closeConnection(connection, false);
+        }
+
+        complete(*transaction, statusCode, headers, body);
+        dispatch(originKey);
+
+        // El callback o el reparto pueden haber cerrado la conexión
+        if (!keepAlive || !isAlive(fd, serial)) {
+            return false;
+        }
+        if (connection->inFlight.empty()) {
+            releaseConnection(connection);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Crea la sesión HTTP/2 de una conexión nueva
+     * Los callbacks solo anotan el estado de los flujos; las respuestas se
+     * entregan al terminar feed(), cuando la sesión ya no está en uso.
+     */
+    void startHttp2(Connection* connection) {
+        connection->http2 = std::make_unique<Http2Session>();
+
+        Http2Session::Callbacks callbacks;
+        callbacks.onHeaders = [this, connection](uint32_t streamId, int statusCode, const Headers& headers) {
+            auto it = connection->streams.find(streamId);
+            if (it == connection->streams.end()) {
+                return;
+            }
+            Http2Stream& stream = it->second;
+            stream.statusCode = statusCode;
+            stream.headers = headers;
+
+            if (m_decompress) {
+                std::string encodings;
+                for (const auto& header : headers) {
+                    if (header.first == "content-encoding") {
+                        encodings += encodings.empty() ? header.second : ", " + header.second;
+                    }
+                }
+                if (!encodings.empty()) {
+                    stream.decoder = BodyDecoder::forContentEncoding(encodings);
+                }
+            }
+
+            if (stream.transaction->stream.onHeaders) {
+                stream.transaction->stream.onHeaders(statusCode, stream.headers);
+            }
+        };
+        callbacks.onData = [connection](uint32_t streamId, const ByteBuffer& chunk) {
+            auto it = connection->streams.find(streamId);
+            if (it == connection->streams.end()) {
+                return false;
+            }
+            Http2Stream& stream = it->second;
+            if (stream.transaction->headRequest) {
+                return true; // Una respuesta a HEAD no tiene cuerpo aunque el servidor lo envíe
+            }
+
+            ByteBuffer decoded;
+            if (stream.decoder && !stream.decoder->decode(chunk.chunk(0).data(), chunk.size(), decoded)) {
+                connection->finishedStreams.emplace_back(streamId, StreamOutcome::FAILED);
+                return false;
+            }
+            const ByteBuffer& data = stream.decoder ? decoded : chunk;
+
+            const ResponseStreamHandler& handler = stream.transaction->stream;
+            if (!handler.onComplete) {
+                stream.body.append(data);
+            } else if (!data.empty() && handler.onData && !handler.onData(data)) {
+                connection->finishedStreams.emplace_back(streamId, StreamOutcome::FAILED);
+                return false;
+            }
+            return true;
+        };
+        callbacks.onStreamEnd = [connection](uint32_t streamId) {
+            connection->finishedStreams.emplace_back(streamId, StreamOutcome::COMPLETE);
+        };
+        callbacks.onStreamReset = [connection](uint32_t streamId, uint32_t errorCode) {
+            connection->finishedStreams.emplace_back(streamId, errorCode == Http2Session::REFUSED_STREAM ?
+                                                     StreamOutcome::REFUSED : StreamOutcome::FAILED);
+        };
+
+        connection->http2->setCallbacks(std::move(callbacks));
+        connection->http2->start();
+    }
+
+    /**
+     * Procesa datos recibidos en una conexión HTTP/2
+     * @return false si la conexión ya no pertenece al bucle
+     */
+    bool receiveHttp2(Connection* connection, const std::shared_ptr<const void>& block, const uint8_t* data, size_t length) {
+        if (!connection->http2->feed(block, data, length)) {
+            Utils::Logging::Logger::warning("HttpClient: Error HTTP/2 en " + connection->originKey + ": " +
+                                            connection->http2->errorMessage());
+            // Enviar el GOAWAY con el código del error antes de cerrar, si el socket lo admite
+            if (flush(connection)) {
+                closeConnection(connection, false);
+            }
+            return false;
+        }
+
+        int fd = connection->fd;
+        uint64_t serial = connection->serial;
+        std::string originKey = connection->originKey;
+        if (connection->http2->isGoingAway()) {
+            connection->closing = true;
+        }
+
+        completeStreams(connection);
+        dispatch(originKey);
+
+        if (!isAlive(fd, serial)) {
+            return false;
+        }
+        if (connection->closing && connection->streams.empty()) {
+            closeConnection(connection, false);
+            return false;
+        }
+        // Confirmaciones, WINDOW_UPDATE y cuerpos que esperaban crédito
+        return flush(connection);
+    }
+
+    /**
+     * Entrega las respuestas de los flujos HTTP/2 que han terminado
+     * Los flujos que el servidor no llegó a procesar vuelven a la cola del origen.
+     */
+    void completeStreams(Connection* connection) {
+        std::vector<std::pair<uint32_t, StreamOutcome>> finished;
+        finished.swap(connection->finishedStreams);
+
+        for (const auto& [streamId, outcome] : finished) {
+            auto it = connection->streams.find(streamId);
+            if (it == connection->streams.end()) {
+                continue;
+            }
+            Http2Stream stream = std::move(it->second);
+            connection->streams.erase(it);
+
+            if (outcome == StreamOutcome::REFUSED && stream.transaction->attempts + 1 < MAX_ATTEMPTS) {
+                // Un flujo rechazado se repite aunque el método no sea idempotente
+                stream.transaction->attempts++;
+                Origin& origin = m_origins[connection->originKey];
+                origin.http2 = true;
+                origin.pending.push_front(std::move(stream.transaction));
+            } else {
+                complete(*stream.transaction, outcome == StreamOutcome::COMPLETE ? stream.statusCode : 0,
+                         stream.headers, stream.body);
+            }
+        }
+    }
+
+    /**
+     * Prepara el analizador para la respuesta de la primera solicitud en curso
+     */
+    void prepareReader(Connection* connection) {
+        Transaction& transaction = *connection->inFlight.front();
+        HttpResponseParser& reader = connection->reader;
+        reader.reset(transaction.headRequest);
+        reader.setDecompression(m_decompress);
+        reader.setHeadersHandler(transaction.stream.onHeaders);
+        reader.setBodyHandler(transaction.stream.onComplete ? transaction.stream.onData : nullptr);
+    }
+
+    bool isAlive(int fd, uint64_t serial) const {
+        auto it = m_connections.find(fd);
+        return it != m_connections.end() && it->second->serial == serial;
+    }
+
+    /**
+     * Devuelve una conexión libre al pool para reutilizarla más tarde
+     */
+    void releaseConnection(Connection* connection) {
+        int fd = connection->fd;
+        std::string originKey = connection->originKey;
+        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        m_sockets->releaseConnection(connection->socketId, true);
+        detach(connection, originKey);
+    }
+
+    void detach(Connection* connection, const std::string& originKey) {
+        auto originIt = m_origins.find(originKey);
+        if (originIt != m_origins.end()) {
+            auto& connections = originIt->second.connections;
+            connections.erase(std::remove(connections.begin(), connections.end(), connection), connections.end());
+            if (connections.empty() && originIt->second.pending.empty()) {
+                m_origins.erase(originIt);
+            }
+        }
+        m_connections.erase(connection->fd);
+    }
+
+    /**
+     * Cierra una conexión y reintenta o falla las solicitudes pendientes
+     * @param eof true si el servidor cerró la conexión (puede completar la respuesta en curso)
+     */
+    void closeConnection(Connection* connection, bool eof) {
+        int fd = connection->fd;
+        std::string originKey = connection->originKey;
+
+        // Solicitudes sin respuesta y si pueden repetirse
+        std::vector<std::pair<std::unique_ptr<Transaction>, bool>> orphaned;
+
+        if (connection->http2) {
+            // Los flujos que ya recibieron la respuesta no se repiten
+            completeStreams(connection);
+            for (auto& entry : connection->streams) {
+                bool started = entry.second.statusCode != 0;
+                orphaned.emplace_back(std::move(entry.second.transaction), !started);
+            }
+            connection->streams.clear();
+        } else {
+            bool firstStarted = connection->reader.hasStarted();
+            if (eof && !connection->inFlight.empty() && connection->reader.finish()) {
+                std::unique_ptr<Transaction> transaction = std::move(connection->inFlight.front());
+                connection->inFlight.pop_front();
+                complete(*transaction, connection->reader.statusCode(), connection->reader.headers(),
+                         connection->reader.takeBody());
+                firstStarted = false;
+            }
+
+            // La primera solicitud puede haber recibido parte de la respuesta: no se repite
+            for (size_t i = 0; i < connection->inFlight.size(); i++) {
+                orphaned.emplace_back(std::move(connection->inFlight[i]), !(i == 0 && firstStarted));
+            }
+            connection->inFlight.clear();
+        }
+
+        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        m_sockets->releaseConnection(connection->socketId, false);
+        detach(connection, originKey);
+
+        for (size_t i = orphaned.size(); i-- > 0;) {
+            std::unique_ptr<Transaction>& transaction = orphaned[i].first;
+            bool retry = transaction->attempts + 1 < MAX_ATTEMPTS && orphaned[i].second && transaction->idempotent;
+            if (retry) {
+                transaction->attempts++;
+                Origin& origin = m_origins[originKey];
+                origin.http2 = transaction->http2;
+                origin.pending.push_front(std::move(transaction));
+            } else {
+                complete(*transaction, 0, {}, {});
+            }
+        }
+
+        dispatch(originKey);
+    }
+
+    void sweep(Clock::time_point now) {
+        m_resolver->processTimeouts(now);
+
+        // Solicitudes en cola que han agotado su tiempo
+        for (auto& entry : m_origins) {
+            auto& pending = entry.second.pending;
+            for (auto it = pending.begin(); it != pending.end();) {
+                if ((*it)->deadline <= now) {
+                    std::unique_ptr<Transaction> expired = std::move(*it);
+                    it = pending.erase(it);
+                    complete(*expired, 0, {}, {});
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        // Conexiones cuya primera solicitud ha caducado
+        std::vector<std::pair<int, uint64_t>> expired;
+        for (auto& entry : m_connections) {
+            Connection* connection = entry.second.get();
+            if (!connection->inFlight.empty() && connection->inFlight.front()->deadline <= now) {
+                expired.emplace_back(connection->fd, connection->serial);
+            }
+        }
+
+        for (const auto& [fd, serial] : expired) {
+            if (!isAlive(fd, serial)) {
+                continue;
+            }
+            Connection* connection = m_connections[fd].get();
+            std::unique_ptr<Transaction> transaction = std::move(connection->inFlight.front());
+            connection->inFlight.pop_front();
+            connection->reader.reset();
+            Utils::Logging::Logger::warning("HttpClient: Tiempo de espera agotado para " + connection->originKey);
+            closeConnection(connection, false);
+            complete(*transaction, 0, {}, {});
+        }
+
+        sweepHttp2(now);
+
+        // Las conexiones inactivas viven en el pool; cerrar las caducadas y
+        // reintentar los orígenes que esperaban a que quedara sitio
+        m_sockets->evictIdleConnections();
+        std::vector<std::string> waiting;
+        for (const auto& entry : m_origins) {
+            if (!entry.second.pending.empty()) {
+                waiting.push_back(entry.first);
+            }
+        }
+        for (const auto& originKey : waiting) {
+            dispatch(originKey);
+        }
+    }
+
+    /**
+     * Cancela los flujos HTTP/2 caducados y cierra las conexiones HTTP/2 sin uso
+     */
+    void sweepHttp2(Clock::time_point now) {
+        std::vector<std::pair<int, uint64_t>> connections;
+        for (auto& entry : m_connections) {
+            if (entry.second->http2) {
+                connections.emplace_back(entry.second->fd, entry.second->serial);
+            }
+        }
+
+        for (const auto& [fd, serial] : connections) {
+            if (!isAlive(fd, serial)) {
+                continue;
+            }
+            Connection* connection = m_connections[fd].get();
+
+            for (auto& entry : connection->streams) {
+                if (entry.second.transaction->deadline <= now) {
+                    Utils::Logging::Logger::warning("HttpClient: Tiempo de espera agotado para " + connection->originKey);
+                    connection->http2->resetStream(entry.first);
+                    connection->finishedStreams.emplace_back(entry.first, StreamOutcome::FAILED);
+                }
+            }
+            completeStreams(connection);
+
+            bool idle = connection->streams.empty() &&
+                        (connection->closing || now - connection->lastActivity >= HTTP2_IDLE_TIMEOUT);
+            if (idle) {
+                closeConnection(connection, false);
+            } else if (connection->connected) {
+                flush(connection);
+            }
+        }
+    }
+
+    void complete(Transaction& transaction, int statusCode, const Headers& headers, const ByteBuffer& body) {
+        m_pendingCount--;
+        if (transaction.stream.onComplete) {
+            transaction.stream.onComplete(statusCode);
+        } else if (transaction.callback) {
+            transaction.callback(statusCode, headers, body);
+        }
+    }
+
+    int m_epollFd;
+    int m_wakeFd;
+    std::atomic<bool> m_running;
+    uint64_t m_nextSerial;
+    std::mutex m_startMutex;
+    std::thread m_loopThread;
+
+    // Solicitudes y funciones enviadas desde otros hilos, pendientes de entrar en el bucle
+    std::mutex m_submitMutex;
+    std::vector<std::unique_ptr<Transaction>> m_submitted;
+    std::vector<std::function<void()>> m_tasks;
+
+    // Estado propio del hilo del bucle
+    std::unordered_map<int, std::unique_ptr<Connection>> m_connections;
+    std::unordered_map<std::string, Origin> m_origins;
+    std::unique_ptr<DnsResolver> m_resolver;
+    std::vector<std::pair<std::string, bool>> m_resolved;   // Orígenes resueltos: (origen, éxito)
+    std::unordered_set<std::string> m_http1Origins;         // Orígenes HTTPS que no negociaron h2
+};
+
+HttpClient::HttpClient() : m_impl(std::make_unique<HttpClientImpl>()) {
+}
+
+HttpClient::~HttpClient() {
+    m_impl->stop();
+}
+
+bool HttpClient::sendRequest(const std::string& url,
+                             const std::string& method,
+                             const std::vector<std::pair<std::string, std::string>>& headers,
+                             const std::vector<uint8_t>& body,
+                             std::function<void(int, const std::vector<std::pair<std::string, std::string>>&, const ByteBuffer&)> callback,
+                             const RequestOptions& options) {
+    return enqueueRequest(url, method, headers, body, std::move(callback), ResponseStreamHandler(), options);
+}
+
+bool HttpClient::sendRequestStreaming(const std::string& url,
+                                      const std::string& method,
+                                      const std::vector<std::pair<std::string, std::string>>& headers,
+                                      const std::vector<uint8_t>& body,
+                                      ResponseStreamHandler handler,
+                                      const RequestOptions& options) {
+    if (!handler.onComplete) {
+        Utils::Logging::Logger::error("HttpClient: La solicitud por partes necesita onComplete");
+        return false;
+    }
+    return enqueueRequest(url, method, headers, body, nullptr, std::move(handler), options);
+}
+
+bool HttpClient::enqueueRequest(const std::string& url,
+                                const std::string& method,
+                                const std::vector<std::pair<std::string, std::string>>& headers,
+                                const std::vector<uint8_t>& body,
+                                std::function<void(int, const std::vector<std::pair<std::string, std::string>>&, const ByteBuffer&)> callback,
+                                ResponseStreamHandler stream,
+                                const RequestOptions& options) {
+    std::string protocol;
+    std::string host;
+    std::string path;
+    int port = 0;
+
+    if (!parseUrl(url, protocol, host, path, port)) {
+        Utils::Logging::Logger::error("HttpClient: URL no válida: " + url);
+        return false;
+    }
+
+    if (protocol != "http" && protocol != "https") {
+        Utils::Logging::Logger::error("HttpClient: Protocolo no soportado todavía: " + protocol);
+        return false;
+    }
+    bool secure = protocol == "https";
+
+    if (!m_impl->start()) {
+        return false;
+    }
+
+    auto transaction = std::make_unique<Transaction>();
+    transaction->callback = std::move(callback);
+    transaction->stream = std::move(stream);
+    transaction->idempotent = method == "GET" || method == "HEAD" || method == "OPTIONS";
+    transaction->headRequest = method == "HEAD";
+    transaction->attempts = 0;
+    transaction->secure = secure;
+    transaction->http2 = options.version == HttpVersion::HTTP_2;
+    transaction->weight = std::clamp(options.priority, 1, 256);
+    transaction->deadline = Clock::now() + std::chrono::milliseconds(m_impl->m_timeoutMs.load());
+
+    std::vector<std::pair<std::string, std::string>> requestHeaders = headers;
+    std::string requestTarget = path;
+
+    // parseUrl quita los corchetes de las direcciones IPv6 para conectar;
+    // en Host, :authority y la URL absoluta del proxy hay que volver a ponerlos
+    std::string uriHost = host.find(':') != std::string::npos ? "[" + host + "]" : host;
+
+    // Anunciar las codificaciones que el analizador sabe descomprimir
+    if (m_impl->m_decompress) {
+        bool hasAcceptEncoding = std::any_of(requestHeaders.begin(), requestHeaders.end(), [](const auto& header) {
+            return equalsIgnoreCase(header.first, "Accept-Encoding");
+        });
+        if (!hasAcceptEncoding) {
+            requestHeaders.emplace_back("Accept-Encoding", "gzip, deflate");
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_configMutex);
+        if (m_impl->m_proxy.enabled && secure) {
+            Utils::Logging::Logger::error("HttpClient: HTTPS a través de proxy no soportado todavía: " + url);
+            return false;
+        }
+        if (m_impl->m_proxy.enabled) {
+            // Con proxy HTTP se envía la URL absoluta al proxy
+            transaction->connectHost = m_impl->m_proxy.host;
+            transaction->connectPort = m_impl->m_proxy.port;
+            requestTarget = protocol + "://" + uriHost + ":" + std::to_string(port) + path;
+            transaction->http2 = false;
+            if (!m_impl->m_proxy.username.empty()) {
+                requestHeaders.emplace_back("Proxy-Authorization", "Basic " +
+                    Utils::Text::base64Encode(m_impl->m_proxy.username + ":" + m_impl->m_proxy.password));
+            }
+        } else {
+            transaction->connectHost = host;
+            transaction->connectPort = port;
+        }
+    }
+    transaction->originKey = transaction->connectHost + ":" + std::to_string(transaction->connectPort);
+
+    std::string hostHeader = (port == (secure ? 443 : 80)) ? uriHost : uriHost + ":" + std::to_string(port);
+    if (transaction->http2) {
+        // Las conexiones HTTP/2 y HTTP/1.1 a un mismo origen se gestionan por separado
+        transaction->originKey = (secure ? "h2://" : "h2c://") + transaction->originKey;
+        transaction->http2Headers = buildHttp2Headers(method, protocol, requestTarget, hostHeader, requestHeaders, body);
+        transaction->http2Body = ByteBuffer::copyOf(body.data(), body.size());
+        if (secure) {
+            // Por si el servidor no acepta h2 en la negociación ALPN
+            transaction->requestData = buildRequestData(method, requestTarget, hostHeader, requestHeaders, body);
+        }
+    } else {
+        if (secure) {
+            transaction->originKey = "https://" + transaction->originKey;
+        }
+        transaction->requestData = buildRequestData(method, requestTarget, hostHeader, requestHeaders, body);
+    }
+
+    m_impl->submit(std::move(transaction));
+    return true;
+}
+
+bool HttpClient::setProxy(const std::string& host, int port, const std::string& username, const std::string& password) {
+    std::lock_guard<std::mutex> lock(m_impl->m_configMutex);
+    m_impl->m_proxy.host = host;
+    m_impl->m_proxy.port = port;
+    m_impl->m_proxy.username = username;
+    m_impl->m_proxy.password = password;
+    m_impl->m_proxy.enabled = !host.empty() && port > 0;
+    return m_impl->m_proxy.enabled;
+}
+
+void HttpClient::setTimeout(int timeout_ms) {
+    m_impl->m_timeoutMs = timeout_ms;
+}
+
+void HttpClient::setVerifySsl(bool verify) {
+    m_impl->m_verifySsl = verify;
+}
+
+void HttpClient::setEarlyData(bool enable) {
+    m_impl->m_earlyData = enable;
+}
+
+void HttpClient::setPipelining(bool enable, int maxDepth) {
+    m_impl->m_pipelining = enable;
+    m_impl->m_maxPipelineDepth = std::max(maxDepth, 1);
+}
+
+void HttpClient::setMaxConnectionsPerHost(int maxConnections) {
+    m_impl->m_maxConnectionsPerHost = std::max(maxConnections, 1);
+}
+
+bool HttpClient::setSocketManager(std::shared_ptr<SocketManager> socketManager) {
+    if (!socketManager || m_impl->isRunning()) {
+        return false;
+    }
+    m_impl->m_sockets = std::move(socketManager);
+    return true;
+}
+
+void HttpClient::setDecompression(bool enable) {
+    m_impl->m_decompress = enable;
+}
+
+bool HttpClient::post(std::function<void()> task) {
+    if (!m_impl->start()) {
+        return false;
+    }
+
+    m_impl->post(std::move(task));
+    return true;
+}
+
+size_t HttpClient::getPendingRequestCount() const {
+    return m_impl->m_pendingCount;
+}
+
+bool HttpClient::parseUrl(const std::string& url, std::string& protocol, std::string& host, std::string& path, int& port) {
+    size_t schemeEnd = url.find("://");
+    if (schemeEnd == std::string::npos) {
+        return false;
+    }
+
+    protocol = url.substr(0, schemeEnd);
+    std::transform(protocol.begin(), protocol.end(), protocol.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    size_t hostStart = schemeEnd + 3;
+    size_t pathStart = url.find_first_of("/?#", hostStart);
+    std::string authority = url.substr(hostStart, pathStart == std::string::npos ? std::string::npos : pathStart - hostStart);
+
+    // Descartar credenciales en la URL (usuario:clave@host)
+    size_t at = authority.rfind('@');
+    if (at != std::string::npos) {
+        authority = authority.substr(at + 1);
+    }
+
+    port = protocol == "https" ? 443 : 80;
+    size_t portSeparator = authority.rfind(':');
+    size_t bracket = authority.rfind(']');
+    if (portSeparator != std::string::npos && (bracket == std::string::npos || portSeparator > bracket)) {
+        port = std::atoi(authority.c_str() + portSeparator + 1);
+        authority = authority.substr(0, portSeparator);
+    }
+
+    // Direcciones IPv6 entre corchetes
+    if (authority.size() > 2 && authority.front() == '[' && authority.back() == ']') {
+        authority = authority.substr(1, authority.size() - 2);
+    }
+
+    host = authority;
+    path = pathStart == std::string::npos ? "/" : url.substr(pathStart);
+    if (path[0] != '/') {
+        path = "/" + path;
+    }
+    size_t fragment = path.find('#');
+    if (fragment != std::string::npos) {
+        path = path.substr(0, fragment);
+    }
+
+    return !host.empty() && port > 0 && port < 65536;
+}
+
+std::vector<uint8_t> HttpClient::buildRequestData(const std::string& method, const std::string& path, const std::string& host,
+                                                  const std::vector<std::pair<std::string, std::string>>& headers,
+                                                  const std::vector<uint8_t>& body) {
+    std::string head = method + " " + path + " HTTP/1.1\r\n";
+
+    bool hasHost = false;
+    bool hasLength = false;
+    for (const auto& header : headers) {
+        if (equalsIgnoreCase(header.first, "Host")) hasHost = true;
+        if (equalsIgnoreCase(header.first, "Content-Length") ||
+            equalsIgnoreCase(header.first, "Transfer-Encoding")) hasLength = true;
+    }
+
+    if (!hasHost) {
+        head += "Host: " + host + "\r\n";
+    }
+    for (const auto& header : headers) {
+        head += header.first + ": " + header.second + "\r\n";
+    }
+    if (!hasLength && (!body.empty() || method == "POST" || method == "PUT" || method == "PATCH")) {
+        head += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    }
+    head += "\r\n";
+
+    std::vector<uint8_t> data;
+    data.reserve(head.size() + body.size());
+    data.insert(data.end(), head.begin(), head.end());
+    data.insert(data.end(), body.begin(), body.end());
+    return data;
+}
+
+std::vector<std::pair<std::string, std::string>> HttpClient::buildHttp2Headers(const std::string& method, const std::string& scheme,
+                                                                               const std::string& path,
+                                                                               const std::string& authority,
+                                                                               const std::vector<std::pair<std::string, std::string>>& headers,
+                                                                               const std::vector<uint8_t>& body) {
+    std::vector<std::pair<std::string, std::string>> result;
+    result.reserve(headers.size() + 5);
+    result.emplace_back(":method", method);
+    result.emplace_back(":scheme", scheme);
+    result.emplace_back(":authority", authority);
+    result.emplace_back(":path", path);
+
+    bool hasLength = false;
+    for (const auto& header : headers) {
+        std::string name = header.first;
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        // Host pasa a :authority y las cabeceras propias de la conexión no existen en HTTP/2
+        if (name == "host") {
+            result[2].second = header.second;
+            continue;
+        }
+        if (name == "connection" || name == "keep-alive" || name == "proxy-connection" ||
+            name == "transfer-encoding" || name == "upgrade" || (name == "te" && header.second != "trailers")) {
+            continue;
+        }
+        if (name == "content-length") hasLength = true;
+        result.emplace_back(std::move(name), header.second);
+    }
+
+    if (!hasLength && (!body.empty() || method == "POST" || method == "PUT" || method == "PATCH")) {
+        result.emplace_back("content-length", std::to_string(body.size()));
+    }
+    return result;
+}
+
+} // namespace Core::Network
@@ -10,12 +10,66 @@
 #include <vector>
 #include <functional>
 #include <memory>
+#include "ByteBuffer.h"
 
 namespace Core::Network {
 
+class SocketManager;
+
+/**
+ * Manejadores para recibir una respuesta por partes
+ */
+struct ResponseStreamHandler {
+    // Código de estado y cabeceras, en cuanto se reciben
+    std::function<void(int, const std::vector<std::pair<std::string, std::string>>&)> onHeaders;
+
+    // Cada trozo del cuerpo ya descomprimido; devolver false cancela la solicitud
+    std::function<bool(const ByteBuffer&)> onData;
+
+    // Fin de la respuesta con su código de estado (0 si la solicitud falló o se canceló)
+    std::function<void(int)> onComplete;
+};
+
+/**
+ * Versión del protocolo HTTP de una solicitud
+ */
+enum class HttpVersion {
+    HTTP_1_1,
+    HTTP_2      // En http:// se usa h2c con conocimiento previo (sin Upgrade)
+};
+
+/**
+ * Opciones de una solicitud
+ */
+struct RequestOptions {
+    HttpVersion version = HttpVersion::HTTP_1_1;
+
+    // Peso HTTP/2 del flujo (1-256): reparto del ancho de banda de subida entre solicitudes
+    int priority = 16;
+
+    // Ir siempre al origen sin consultar la caché de respuestas del NetworkManager
+    // (sondas cuyo resultado depende de enviarlas de verdad, como las de tiempo)
+    bool bypassCache = false;
+};
+
 /**
  * Clase que implementa un cliente HTTP/HTTPS
  * Gestiona las solicitudes y respuestas HTTP/HTTPS
+ *
+ * Las solicitudes se atienden en un único hilo de eventos (epoll) con sockets
+ * no bloqueantes, de modo que miles de solicitudes pueden estar en curso a la vez.
+ * Los callbacks se invocan desde ese hilo.
+ * Las conexiones se obtienen del pool keep-alive de un SocketManager y se le
+ * devuelven en cuanto quedan libres.
+ *
+ * Las solicitudes HTTP/2 de un mismo origen se multiplexan como flujos de una
+ * sola conexión, que se mantiene abierta mientras se use. Con un proxy HTTP
+ * configurado se usa siempre HTTP/1.1.
+ *
+ * En HTTPS la negociación TLS también se hace en el bucle de eventos y las
+ * conexiones nuevas reanudan las sesiones guardadas en el TlsContext del
+ * SocketManager. HTTP/2 se negocia por ALPN; si el servidor no lo acepta, las
+ * solicitudes se envían por HTTP/1.1.
  */
 class HttpClient {
 public:
@@ -35,14 +89,35 @@ public:
      * @param method Método HTTP (GET, POST, etc.)
      * @param headers Cabeceras de la solicitud
      * @param body Cuerpo de la solicitud
-     * @param callback Función de callback para la respuesta
+     * @param callback Función de callback para la respuesta (código 0 si la solicitud falló);
+     *                 el cuerpo referencia los bloques recibidos del socket sin copiarlos
+     * @param options Versión del protocolo y prioridad de la solicitud
      * @return true si la solicitud fue enviada correctamente, false en caso contrario
      */
     bool sendRequest(const std::string& url, 
                     const std::string& method, 
                     const std::vector<std::pair<std::string, std::string>>& headers, 
                     const std::vector<uint8_t>& body,
-                    std::function<void(int, const std::vector<std::pair<std::string, std::string>>&, const std::vector<uint8_t>&)> callback);
+                    std::function<void(int, const std::vector<std::pair<std::string, std::string>>&, const ByteBuffer&)> callback,
+                    const RequestOptions& options = RequestOptions());
+
+    /**
+     * Envía una solicitud HTTP/HTTPS y entrega la respuesta por partes
+     * El cuerpo se entrega a medida que llega, sin esperar a la respuesta completa.
+     * @param url URL de la solicitud
+     * @param method Método HTTP (GET, POST, etc.)
+     * @param headers Cabeceras de la solicitud
+     * @param body Cuerpo de la solicitud
+     * @param handler Manejadores de la respuesta (onComplete es obligatorio)
+     * @param options Versión del protocolo y prioridad de la solicitud
+     * @return true si la solicitud fue enviada correctamente, false en caso contrario
+     */
+    bool sendRequestStreaming(const std::string& url,
+                              const std::string& method,
+                              const std::vector<std::pair<std::string, std::string>>& headers,
+                              const std::vector<uint8_t>& body,
+                              ResponseStreamHandler handler,
+                              const RequestOptions& options = RequestOptions());
 
     /**
      * Configura un proxy para las solicitudes
@@ -62,20 +137,87 @@ public:
 
     /**
      * Habilita o deshabilita la verificación de certificados SSL
+     * Se aplica a las conexiones que abre este cliente, aunque comparta el gestor de sockets
+     * con otros clientes; las conexiones del pool abiertas sin verificar no se reutilizan al verificar.
      * @param verify true para verificar certificados, false para ignorar errores de certificados
      */
     void setVerifySsl(bool verify);
 
+    /**
+     * Habilita o deshabilita el envío de datos 0-RTT (TLS 1.3 early data)
+     * Al reanudar una sesión que lo admite, la primera solicitud HTTP/1.1 de la
+     * conexión se envía junto con la negociación si es idempotente (GET, HEAD,
+     * OPTIONS). El servidor puede recibirla repetida si un atacante la reenvía.
+     * @param enable true para enviar datos 0-RTT
+     */
+    void setEarlyData(bool enable);
+
+    /**
+     * Habilita o deshabilita el pipelining de HTTP/1.1
+     * Solo se encadenan solicitudes idempotentes (GET, HEAD, OPTIONS)
+     * @param enable true para enviar varias solicitudes sin esperar la respuesta anterior
+     * @param maxDepth Número máximo de solicitudes en curso por conexión
+     */
+    void setPipelining(bool enable, int maxDepth = 8);
+
+    /**
+     * Habilita o deshabilita la descompresión de respuestas gzip y deflate
+     * Habilitada por defecto; añade Accept-Encoding si la solicitud no lo incluye.
+     * @param enable true para entregar los cuerpos descomprimidos
+     */
+    void setDecompression(bool enable);
+
+    /**
+     * Establece el número máximo de conexiones simultáneas por origen
+     * @param maxConnections Número máximo de conexiones
+     */
+    void setMaxConnectionsPerHost(int maxConnections);
+
+    /**
+     * Establece el gestor de sockets cuyo pool de conexiones se usará
+     * Debe llamarse antes de enviar la primera solicitud; por defecto el
+     * cliente usa un gestor propio.
+     * @param socketManager Gestor de sockets compartido
+     * @return true si se estableció, false si el cliente ya estaba en marcha
+     */
+    bool setSocketManager(std::shared_ptr<SocketManager> socketManager);
+
+    /**
+     * Ejecuta una función en el hilo de eventos
+     * Permite entregar respuestas obtenidas sin la red (por ejemplo, de una
+     * caché) desde el mismo hilo que el resto de callbacks.
+     * @param task Función a ejecutar
+     * @return true si la función quedó encolada, false si no se pudo arrancar el bucle
+     */
+    bool post(std::function<void()> task);
+
+    /**
+     * Obtiene el número de solicitudes enviadas que aún no han terminado
+     * @return Número de solicitudes en curso
+     */
+    size_t getPendingRequestCount() const;
+
 private:
     // Implementación privada del cliente HTTP
     class HttpClientImpl;
     std::unique_ptr<HttpClientImpl> m_impl;
 
     // Métodos privados para la gestión de solicitudes
+    bool enqueueRequest(const std::string& url, const std::string& method,
+                        const std::vector<std::pair<std::string, std::string>>& headers,
+                        const std::vector<uint8_t>& body,
+                        std::function<void(int, const std::vector<std::pair<std::string, std::string>>&, const ByteBuffer&)> callback,
+                        ResponseStreamHandler stream,
+                        const RequestOptions& options);
     bool parseUrl(const std::string& url, std::string& protocol, std::string& host, std::string& path, int& port);
     std::vector<uint8_t> buildRequestData(const std::string& method, const std::string& path, const std::string& host, 
                                          const std::vector<std::pair<std::string, std::string>>& headers, 
                                          const std::vector<uint8_t>& body);
+    std::vector<std::pair<std::string, std::string>> buildHttp2Headers(const std::string& method, const std::string& scheme,
+                                                                       const std::string& path,
+                                                                       const std::string& authority,
+                                                                       const std::vector<std::pair<std::string, std::string>>& headers,
+                                                                       const std::vector<uint8_t>& body);
 };
 
 } // namespace Core::Network
\ No newline at end of file
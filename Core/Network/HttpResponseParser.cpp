@@ -0,0 +1,330 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación del analizador incremental de respuestas HTTP/1.1
+ */
+
+#include "HttpResponseParser.h"
+#include "BodyDecoder.h"
+#include "../../Utils/Text/StringUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+namespace Core::Network {
+
+namespace {
+
+// Tamaño máximo de la línea de estado más las cabeceras
+constexpr size_t MAX_HEAD_SIZE = 64 * 1024;
+
+using Utils::Text::equalsIgnoreCase;
+using Utils::Text::trim;
+
+/**
+ * Divide una lista separada por comas en elementos sin espacios
+ */
+std::vector<std::string_view> splitList(std::string_view value) {
+    std::vector<std::string_view> items;
+    size_t start = 0;
+    while (start <= value.size()) {
+        size_t end = value.find(',', start);
+        if (end == std::string_view::npos) end = value.size();
+        std::string_view item = trim(value.substr(start, end - start));
+        if (!item.empty()) items.push_back(item);
+        start = end + 1;
+    }
+    return items;
+}
+
+bool containsToken(std::string_view value, std::string_view token) {
+    for (std::string_view item : splitList(value)) {
+        if (equalsIgnoreCase(item, token)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+HttpResponseParser::HttpResponseParser() :
+    m_decompress(true) {
+    reset(false);
+}
+
+HttpResponseParser::~HttpResponseParser() = default;
+
+void HttpResponseParser::reset(bool headRequest) {
+    m_state = State::HEAD;
+    m_headRequest = headRequest;
+    m_headersComplete = false;
+    m_head.clear();
+    m_remaining = 0;
+    m_statusCode = 0;
+    m_headers.clear();
+    m_keepAlive = true;
+    m_body.clear();
+    m_error.clear();
+    m_decoder.reset();
+}
+
+void HttpResponseParser::setHeadersHandler(std::function<void(int, const Headers&)> handler) {
+    m_headersHandler = std::move(handler);
+}
+
+void HttpResponseParser::setBodyHandler(std::function<bool(const ByteBuffer&)> handler) {
+    m_bodyHandler = std::move(handler);
+}
+
+void HttpResponseParser::setDecompression(bool enable) {
+    m_decompress = enable;
+}
+
+ByteBuffer HttpResponseParser::takeBody() {
+    return std::move(m_body);
+}
+
+size_t HttpResponseParser::feed(const std::shared_ptr<const void>& block, const uint8_t* data, size_t length) {
+    size_t consumed = 0;
+
+    while (consumed < length && m_state != State::DONE && m_state != State::ERROR) {
+        const uint8_t* cursor = data + consumed;
+        size_t available = length - consumed;
+
+        switch (m_state) {
+            case State::HEAD:
+            case State::TRAILERS: {
+                // Acumular hasta encontrar una línea vacía
+                size_t previous = m_head.size();
+                m_head.append(reinterpret_cast<const char*>(cursor), available);
+
+                bool noTrailers = m_state == State::TRAILERS && m_head.compare(0, 2, "\r\n") == 0;
+                size_t end = noTrailers ? 0 : m_head.find("\r\n\r\n", previous >= 3 ? previous - 3 : 0);
+                if (end == std::string::npos) {
+                    consumed = length;
+                    if (m_head.size() > MAX_HEAD_SIZE) {
+                        fail("Cabeceras demasiado grandes");
+                    }
+                    break;
+                }
+
+                consumed += (noTrailers ? 2 : end + 4) - previous;
+                if (m_state == State::HEAD) {
+                    m_head.resize(end);
+                    parseHead();
+                } else {
+                    finishBody();
+                }
+                m_head.clear();
+                break;
+            }
+
+            case State::BODY_LENGTH: {
+                size_t take = static_cast<size_t>(std::min<uint64_t>(m_remaining, available));
+                emitBody(block, cursor, take);
+                m_remaining -= take;
+                consumed += take;
+                if (m_remaining == 0 && m_state == State::BODY_LENGTH) {
+                    finishBody();
+                }
+                break;
+            }
+
+            case State::CHUNK_SIZE: {
+                // Línea con el tamaño del bloque en hexadecimal (con posibles extensiones)
+                const uint8_t* newline = static_cast<const uint8_t*>(std::memchr(cursor, '\n', available));
+                size_t take = newline ? static_cast<size_t>(newline - cursor) + 1 : available;
+                m_head.append(reinterpret_cast<const char*>(cursor), take);
+                consumed += take;
+                if (!newline) {
+                    if (m_head.size() > 1024) {
+                        fail("Línea de tamaño de bloque demasiado larga");
+                    }
+                    break;
+                }
+
+                char* end = nullptr;
+                unsigned long long size = std::strtoull(m_head.c_str(), &end, 16);
+                if (end == m_head.c_str()) {
+                    fail("Tamaño de bloque no válido");
+                    break;
+                }
+                m_head.clear();
+                m_remaining = size;
+                m_state = size == 0 ? State::TRAILERS : State::CHUNK_DATA;
+                break;
+            }
+
+            case State::CHUNK_DATA: {
+                size_t take = static_cast<size_t>(std::min<uint64_t>(m_remaining, available));
+                emitBody(block, cursor, take);
+                m_remaining -= take;
+                consumed += take;
+                if (m_remaining == 0 && m_state == State::CHUNK_DATA) {
+                    m_remaining = 2;
+                    m_state = State::CHUNK_END;
+                }
+                break;
+            }
+
+            case State::CHUNK_END: {
+                // CRLF al final de cada bloque
+                size_t take = static_cast<size_t>(std::min<uint64_t>(m_remaining, available));
+                m_remaining -= take;
+                consumed += take;
+                if (m_remaining == 0) {
+                    m_state = State::CHUNK_SIZE;
+                }
+                break;
+            }
+
+            case State::BODY_UNTIL_CLOSE: {
+                emitBody(block, cursor, available);
+                consumed = length;
+                break;
+            }
+
+            case State::DONE:
+            case State::ERROR:
+                break;
+        }
+    }
+
+    return consumed;
+}
+
+bool HttpResponseParser::finish() {
+    if (m_state == State::BODY_UNTIL_CLOSE) {
+        finishBody();
+    }
+    return m_state == State::DONE;
+}
+
+void HttpResponseParser::parseHead() {
+    size_t lineEnd = m_head.find("\r\n");
+    std::string_view statusLine(m_head.data(), lineEnd == std::string::npos ? m_head.size() : lineEnd);
+
+    // HTTP/1.x NNN Texto
+    if (statusLine.size() < 12 || statusLine.compare(0, 7, "HTTP/1.") != 0 || statusLine[8] != ' ') {
+        fail("Línea de estado no válida");
+        return;
+    }
+    bool http10 = statusLine[7] == '0';
+    m_statusCode = std::atoi(std::string(statusLine.substr(9, 3)).c_str());
+    m_keepAlive = !http10;
+
+    bool chunked = false;
+    bool hasLength = false;
+    uint64_t contentLength = 0;
+    std::string encodings;
+
+    m_headers.clear();
+    size_t position = lineEnd == std::string::npos ? m_head.size() : lineEnd + 2;
+    while (position < m_head.size()) {
+        size_t end = m_head.find("\r\n", position);
+        if (end == std::string::npos) end = m_head.size();
+        std::string_view line(m_head.data() + position, end - position);
+        position = end + 2;
+
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos) continue;
+        std::string_view name = trim(line.substr(0, colon));
+        std::string_view value = trim(line.substr(colon + 1));
+        m_headers.emplace_back(std::string(name), std::string(value));
+    }
+
+    // Las vistas apuntan a las cadenas ya guardadas en m_headers
+    for (const auto& header : m_headers) {
+        std::string_view name = header.first;
+        std::string_view value = header.second;
+        if (equalsIgnoreCase(name, "Content-Length")) {
+            hasLength = true;
+            contentLength = std::strtoull(header.second.c_str(), nullptr, 10);
+        } else if (equalsIgnoreCase(name, "Transfer-Encoding")) {
+            chunked = containsToken(value, "chunked");
+        } else if (equalsIgnoreCase(name, "Connection")) {
+            if (containsToken(value, "close")) m_keepAlive = false;
+            if (containsToken(value, "keep-alive")) m_keepAlive = true;
+        } else if (equalsIgnoreCase(name, "Content-Encoding")) {
+            encodings += encodings.empty() ? header.second : ", " + header.second;
+        }
+    }
+
+    // Las respuestas informativas (100 Continue) preceden a la respuesta real
+    if (m_statusCode >= 100 && m_statusCode < 200 && m_statusCode != 101) {
+        bool headRequest = m_headRequest;
+        reset(headRequest);
+        return;
+    }
+
+    if (m_decompress && !encodings.empty()) {
+        m_decoder = BodyDecoder::forContentEncoding(encodings);
+    }
+
+    m_headersComplete = true;
+    if (m_headersHandler) {
+        m_headersHandler(m_statusCode, m_headers);
+    }
+
+    // Respuestas sin cuerpo por definición
+    if (m_headRequest || m_statusCode == 101 || m_statusCode == 204 || m_statusCode == 304) {
+        finishBody();
+    } else if (chunked) {
+        m_state = State::CHUNK_SIZE;
+    } else if (hasLength) {
+        m_remaining = contentLength;
+        m_state = State::BODY_LENGTH;
+        if (contentLength == 0) {
+            finishBody();
+        }
+    } else {
+        m_keepAlive = false;
+        m_state = State::BODY_UNTIL_CLOSE;
+    }
+}
+
+void HttpResponseParser::fail(const std::string& message) {
+    m_error = message;
+    m_state = State::ERROR;
+}
+
+void HttpResponseParser::emitBody(const std::shared_ptr<const void>& block, const uint8_t* data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+
+    if (!m_decoder) {
+        deliver(ByteBuffer::wrap(block, data, length));
+        return;
+    }
+
+    ByteBuffer decoded;
+    if (!m_decoder->decode(data, length, decoded)) {
+        fail(m_decoder->getError());
+        return;
+    }
+    deliver(decoded);
+}
+
+void HttpResponseParser::deliver(const ByteBuffer& chunk) {
+    if (chunk.empty()) {
+        return;
+    }
+
+    if (!m_bodyHandler) {
+        m_body.append(chunk);
+    } else if (!m_bodyHandler(chunk)) {
+        fail("Cancelado por el manejador del cuerpo");
+    }
+}
+
+void HttpResponseParser::finishBody() {
+    if (m_state == State::ERROR) {
+        return;
+    }
+    // Un flujo comprimido truncado no es un error: se entrega lo ya descomprimido
+    m_state = State::DONE;
+}
+
+} // namespace Core::Network
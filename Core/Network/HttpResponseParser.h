@@ -0,0 +1,188 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Analizador incremental de respuestas HTTP/1.1
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <memory>
+#include <cstdint>
+#include "ByteBuffer.h"
+
+namespace Core::Network {
+
+class BodyDecoder;
+
+/**
+ * Analizador de respuestas HTTP/1.1 por empuje
+ * Acepta los datos en trozos arbitrarios tal como llegan del socket y se
+ * detiene al final de cada respuesta, de modo que los bytes sobrantes
+ * pertenecen a la siguiente respuesta encadenada (pipelining).
+ *
+ * Soporta cuerpos delimitados por Content-Length, chunked y hasta el cierre
+ * de la conexión, y descomprime gzip y deflate a medida que llegan los datos.
+ * Si hay un manejador de cuerpo, cada trozo decodificado se le entrega en
+ * cuanto está disponible; si no, el cuerpo se acumula y se obtiene con takeBody().
+ */
+class HttpResponseParser {
+public:
+    using Headers = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * Constructor
+     */
+    HttpResponseParser();
+
+    /**
+     * Destructor
+     */
+    ~HttpResponseParser();
+
+    HttpResponseParser(const HttpResponseParser&) = delete;
+    HttpResponseParser& operator=(const HttpResponseParser&) = delete;
+
+    /**
+     * Prepara el analizador para una nueva respuesta
+     * Los manejadores y la opción de descompresión se conservan.
+     * @param headRequest true si la respuesta corresponde a una solicitud HEAD (sin cuerpo)
+     */
+    void reset(bool headRequest = false);
+
+    /**
+     * Procesa datos recibidos
+     * Los bytes del cuerpo sin comprimir no se copian: se referencian dentro de block.
+     * @param block Bloque de memoria que contiene los datos
+     * @param data Inicio de los datos
+     * @param length Número de bytes
+     * @return Número de bytes consumidos (menos que length si la respuesta terminó antes)
+     */
+    size_t feed(const std::shared_ptr<const void>& block, const uint8_t* data, size_t length);
+
+    /**
+     * Notifica el cierre de la conexión
+     * @return true si la respuesta quedó completa
+     */
+    bool finish();
+
+    /**
+     * Establece el manejador de las cabeceras
+     * @param handler Función llamada una vez con el código de estado y las cabeceras
+     */
+    void setHeadersHandler(std::function<void(int, const Headers&)> handler);
+
+    /**
+     * Establece el manejador del cuerpo
+     * Con un manejador el cuerpo no se acumula.
+     * @param handler Función llamada con cada trozo decodificado; devuelve false para cancelar
+     */
+    void setBodyHandler(std::function<bool(const ByteBuffer&)> handler);
+
+    /**
+     * Habilita o deshabilita la descompresión de gzip y deflate
+     * @param enable true para entregar el cuerpo descomprimido
+     */
+    void setDecompression(bool enable);
+
+    /**
+     * Comprueba si la respuesta está completa
+     * @return true si se recibió la respuesta entera
+     */
+    bool isComplete() const { return m_state == State::DONE; }
+
+    /**
+     * Comprueba si hubo un error (respuesta mal formada, datos comprimidos
+     * corruptos o cancelación desde el manejador del cuerpo)
+     * @return true si el análisis falló
+     */
+    bool hasError() const { return m_state == State::ERROR; }
+
+    /**
+     * Comprueba si ya se recibió algún byte de la respuesta
+     * @return true si la respuesta ha empezado
+     */
+    bool hasStarted() const { return m_state != State::HEAD || !m_head.empty(); }
+
+    /**
+     * Comprueba si ya se recibieron todas las cabeceras
+     * @return true si las cabeceras están disponibles
+     */
+    bool headersComplete() const { return m_headersComplete; }
+
+    /**
+     * Obtiene el código de estado
+     * @return Código de estado HTTP (0 si aún no se conoce)
+     */
+    int statusCode() const { return m_statusCode; }
+
+    /**
+     * Obtiene las cabeceras de la respuesta
+     * @return Cabeceras en el orden recibido
+     */
+    const Headers& headers() const { return m_headers; }
+
+    /**
+     * Indica si la conexión puede reutilizarse tras esta respuesta
+     * @return true si la conexión sigue abierta
+     */
+    bool keepAlive() const { return m_keepAlive; }
+
+    /**
+     * Indica si el cuerpo entregado está descomprimido
+     * @return true si se aplicó gzip o deflate
+     */
+    bool isBodyDecoded() const { return m_decoder != nullptr; }
+
+    /**
+     * Obtiene el mensaje del último error
+     * @return Descripción del error
+     */
+    const std::string& errorMessage() const { return m_error; }
+
+    /**
+     * Obtiene el cuerpo acumulado y lo retira del analizador
+     * @return Cuerpo de la respuesta (vacío si se usa un manejador del cuerpo)
+     */
+    ByteBuffer takeBody();
+
+private:
+    enum class State {
+        HEAD,
+        BODY_LENGTH,
+        CHUNK_SIZE,
+        CHUNK_DATA,
+        CHUNK_END,
+        TRAILERS,
+        BODY_UNTIL_CLOSE,
+        DONE,
+        ERROR
+    };
+
+    void parseHead();
+    void fail(const std::string& message);
+    void emitBody(const std::shared_ptr<const void>& block, const uint8_t* data, size_t length);
+    void deliver(const ByteBuffer& chunk);
+    void finishBody();
+
+    State m_state;
+    bool m_headRequest;
+    bool m_headersComplete;
+    bool m_decompress;
+    std::string m_head;
+    uint64_t m_remaining;
+
+    int m_statusCode;
+    Headers m_headers;
+    bool m_keepAlive;
+    ByteBuffer m_body;
+    std::string m_error;
+
+    std::unique_ptr<BodyDecoder> m_decoder;
+    std::function<void(int, const Headers&)> m_headersHandler;
+    std::function<bool(const ByteBuffer&)> m_bodyHandler;
+};
+
+} // namespace Core::Network
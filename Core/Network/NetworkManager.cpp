@@ -7,14 +7,74 @@
 #include "NetworkManager.h"
 #include "HttpClient.h"
 #include "SocketManager.h"
+#include "DnsResolver.h"
 #include "TrafficAnalyzer.h"
 #include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 
 namespace Core::Network {
 
+namespace {
+
+/**
+ * Promesa de una solicitud de un lote
+ * Si el cliente HTTP descarta el callback sin invocarlo (por ejemplo al
+ * detenerse), la solicitud se da por fallida en lugar de romper el future.
+ */
+struct BatchPromise {
+    std::promise<BatchResponse> promise;
+    bool done = false;
+
+    void complete(BatchResponse response) {
+        if (!done) {
+            done = true;
+            promise.set_value(std::move(response));
+        }
+    }
+
+    ~BatchPromise() {
+        complete(BatchResponse());
+    }
+};
+
+} // namespace
+
+struct NetworkManager::BatchEntry {
+    BatchRequest request;
+    std::string target;
+    std::shared_ptr<BatchPromise> promise;
+};
+
+struct NetworkManager::BatchQueue {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::deque<BatchEntry>> pending;   // Solicitudes por destino
+    std::unordered_map<std::string, size_t> inFlight;                  // Solicitudes en curso por destino
+    std::deque<std::string> turns;                                     // Destinos con solicitudes pendientes
+    size_t active = 0;
+    size_t maxInFlight = 64;
+    size_t maxPerTarget = 6;
+    bool closed = false;
+
+    void release(const std::string& target) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = inFlight.find(target);
+        if (it != inFlight.end() && --it->second == 0) {
+            inFlight.erase(it);
+        }
+        --active;
+    }
+};
+
 NetworkManager::NetworkManager()
     : m_trafficInterceptionEnabled(false)
     , m_vulnerabilityScanningEnabled(false)
+    , m_batchQueue(std::make_unique<BatchQueue>())
+    , m_responseCache(std::make_shared<ResponseCache>())
+    , m_responseCacheEnabled(false)
 {
     m_proxyConfig.enabled = false;
     m_proxyConfig.port = 0;
@@ -22,6 +82,17 @@ NetworkManager::NetworkManager()
 }
 
 NetworkManager::~NetworkManager() {
+    // Las solicitudes de los lotes que no llegaron a enviarse se dan por fallidas
+    std::unordered_map<std::string, std::deque<BatchEntry>> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_batchQueue->mutex);
+        m_batchQueue->closed = true;
+        pending.swap(m_batchQueue->pending);
+    }
+    pending.clear();
+
+    // Detener el cliente antes que el analizador que usan sus callbacks
+    m_httpClient.reset();
     std::cout << "Finalizando gestor de red" << std::endl;
 }
 
@@ -52,8 +123,20 @@ bool NetworkManager::sendHttpRequest(
     const std::string& method, 
     const std::vector<std::pair<std::string, std::string>>& headers, 
     const std::vector<uint8_t>& body,
-    std::function<void(int, const std::vector<std::pair<std::string, std::string>>&, const std::vector<uint8_t>&)> callback) {
+    std::function<void(int, const std::vector<std::pair<std::string, std::string>>&, const ByteBuffer&)> callback,
+    const RequestOptions& options) {
     
+    return submitRequest(url, method, headers, body, options, [callback](BatchResponse response) {
+        if (callback) {
+            callback(response.statusCode, response.headers, response.body);
+        }
+    });
+}
+
+bool NetworkManager::submitRequest(const std::string& url, const std::string& method,
+                                   const std::vector<std::pair<std::string, std::string>>& headers,
+                                   const std::vector<uint8_t>& body, const RequestOptions& options,
+                                   std::function<void(BatchResponse)> completion) {
     if (!m_httpClient) {
         std::cout << "Cliente HTTP no inicializado" << std::endl;
         return false;
@@ -64,9 +147,232 @@ bool NetworkManager::sendHttpRequest(
         m_httpClient->setProxy(m_proxyConfig.host, m_proxyConfig.port, 
                              m_proxyConfig.username, m_proxyConfig.password);
     }
-    
+
+    // Pasar la solicitud por los interceptores; solo se copia si hay alguno
+    if (m_trafficInterceptionEnabled && m_trafficAnalyzer && m_trafficAnalyzer->hasActiveInterceptors()) {
+        std::string interceptedUrl = url;
+        std::string interceptedMethod = method;
+        std::vector<std::pair<std::string, std::string>> interceptedHeaders = headers;
+        ByteBuffer interceptedBody{std::vector<uint8_t>(body)};
+        m_trafficAnalyzer->interceptRequest(interceptedUrl, interceptedMethod, interceptedHeaders, interceptedBody);
+        return dispatchRequest(interceptedUrl, interceptedMethod, interceptedHeaders, interceptedBody.toVector(),
+                               options, std::move(completion));
+    }
+
+    return dispatchRequest(url, method, headers, body, options, std::move(completion));
+}
+
+bool NetworkManager::dispatchRequest(const std::string& url, const std::string& method,
+                                     const std::vector<std::pair<std::string, std::string>>& headers,
+                                     const std::vector<uint8_t>& body, const RequestOptions& options,
+                                     std::function<void(BatchResponse)> completion) {
+    // Con el análisis activo se guarda la solicitud para dejar el intercambio
+    // completo en la cola de análisis cuando llegue la respuesta
+    std::shared_ptr<ExchangeSnapshot> exchange;
+    if (m_vulnerabilityScanningEnabled && m_analysisPipeline) {
+        exchange = std::make_shared<ExchangeSnapshot>();
+        exchange->url = url;
+        exchange->method = method;
+        exchange->requestHeaders = headers;
+        exchange->requestBody = ByteBuffer(std::vector<uint8_t>(body));
+    }
+
+    // Pasar la respuesta por los interceptores y encolarla para el análisis
+    // antes de entregarla; la cola comparte el mismo cuerpo que recibe el
+    // callback, sin copias intermedias. La caché guarda la respuesta original.
+    // Las respuestas frescas de la caché ya se analizaron cuando llegaron de la red.
+    auto analyzed = [this, completion, exchange](BatchResponse response) {
+        if (m_trafficInterceptionEnabled && m_trafficAnalyzer && response.statusCode != 0) {
+            m_trafficAnalyzer->interceptResponse(response.statusCode, response.headers, response.body);
+        }
+        if (!response.fromCache) {
+            submitForAnalysis(exchange, response);
+        }
+        completion(std::move(response));
+    };
+
+    ResponseCache::Lookup cached;
+    bool useCache = m_responseCacheEnabled && !options.bypassCache;
+    if (useCache) {
+        cached = m_responseCache->lookup(method, url, headers);
+    }
+
+    // Respuesta fresca: se entrega desde el hilo de eventos, como las de la red
+    if (cached.status == ResponseCache::Status::FRESH) {
+        BatchResponse response{cached.response.statusCode, std::move(cached.response.headers),
+                               std::move(cached.response.body), true};
+        return m_httpClient->post([analyzed, response]() { analyzed(response); });
+    }
+
+    // Respuesta caducada: se pide solo si ha cambiado
+    std::vector<std::pair<std::string, std::string>> conditional;
+    if (cached.status == ResponseCache::Status::STALE) {
+        conditional = headers;
+        conditional.insert(conditional.end(), cached.conditions.begin(), cached.conditions.end());
+    }
+    bool revalidating = !conditional.empty();
+
+    auto delivered = [this, analyzed, useCache, method, url, headers](
+                         int status, const std::vector<std::pair<std::string, std::string>>& responseHeaders,
+                         const ByteBuffer& responseBody) {
+        if (useCache && status != 0) {
+            m_responseCache->store(method, url, headers, status, responseHeaders, responseBody);
+        }
+        analyzed(BatchResponse{status, responseHeaders, responseBody, false});
+    };
+
+    std::vector<uint8_t> resendBody = revalidating ? body : std::vector<uint8_t>();
+    auto stored = [this, analyzed, delivered, revalidating, method, url, headers, resendBody, options](
+                      int status, const std::vector<std::pair<std::string, std::string>>& responseHeaders,
+                      const ByteBuffer& responseBody) {
+        if (!revalidating || status != 304) {
+            delivered(status, responseHeaders, responseBody);
+            return;
+        }
+
+        CachedResponse current;
+        if (m_responseCache->refresh(method, url, headers, responseHeaders, current)) {
+            analyzed(BatchResponse{current.statusCode, std::move(current.headers), std::move(current.body), false});
+            return;
+        }
+        // La entrada se descartó mientras se revalidaba: el 304 no tiene cuerpo
+        // que entregar, así que se repite la solicitud sin condiciones
+        if (!m_httpClient->sendRequest(url, method, headers, resendBody, delivered, options)) {
+            delivered(0, {}, ByteBuffer());
+        }
+    };
+
     // Enviar la solicitud HTTP
-    return m_httpClient->sendRequest(url, method, headers, body, callback);
+    return m_httpClient->sendRequest(url, method, revalidating ? conditional : headers, body, stored, options);
+}
+
+std::vector<std::future<BatchResponse>> NetworkManager::sendBatch(std::span<const BatchRequest> requests) {
+    std::vector<std::future<BatchResponse>> futures;
+    futures.reserve(requests.size());
+
+    std::vector<BatchEntry> entries;
+    entries.reserve(requests.size());
+    for (const auto& request : requests) {
+        auto promise = std::make_shared<BatchPromise>();
+        futures.push_back(promise->promise.get_future());
+        entries.push_back(BatchEntry{request, getRequestTarget(request.url), std::move(promise)});
+    }
+
+    // Sin cliente, las promesas se resuelven como fallidas al destruir las entradas
+    if (!m_httpClient) {
+        std::cout << "Cliente HTTP no inicializado" << std::endl;
+        return futures;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_batchQueue->mutex);
+        for (auto& entry : entries) {
+            auto& queue = m_batchQueue->pending[entry.target];
+            if (queue.empty()) {
+                m_batchQueue->turns.push_back(entry.target);
+            }
+            queue.push_back(std::move(entry));
+        }
+    }
+
+    dispatchBatch();
+    return futures;
+}
+
+void NetworkManager::setBatchConcurrency(size_t maxInFlight, size_t maxPerTarget) {
+    {
+        std::lock_guard<std::mutex> lock(m_batchQueue->mutex);
+        m_batchQueue->maxInFlight = std::max<size_t>(maxInFlight, 1);
+        m_batchQueue->maxPerTarget = std::max<size_t>(maxPerTarget, 1);
+    }
+
+    // Con límites más altos pueden salir solicitudes que estaban esperando
+    dispatchBatch();
+}
+
+std::string NetworkManager::getRequestTarget(const std::string& url) {
+    size_t start = url.find("://");
+    start = (start == std::string::npos) ? 0 : start + 3;
+    size_t end = url.find_first_of("/?#", start);
+
+    std::string target = (start == 0 ? "http://" : "") + url.substr(0, end);
+    std::transform(target.begin(), target.end(), target.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return target;
+}
+
+void NetworkManager::dispatchBatch() {
+    for (;;) {
+        // Elegir las solicitudes que caben en los límites, una por destino en cada turno
+        std::vector<BatchEntry> ready;
+        {
+            std::lock_guard<std::mutex> lock(m_batchQueue->mutex);
+            BatchQueue& batch = *m_batchQueue;
+            if (batch.closed) {
+                return;
+            }
+
+            size_t saturated = 0;
+            while (!batch.turns.empty() && batch.active < batch.maxInFlight && saturated < batch.turns.size()) {
+                std::string target = std::move(batch.turns.front());
+                batch.turns.pop_front();
+
+                size_t& inFlight = batch.inFlight[target];
+                if (inFlight >= batch.maxPerTarget) {
+                    batch.turns.push_back(std::move(target));
+                    ++saturated;
+                    continue;
+                }
+
+                auto queue = batch.pending.find(target);
+                ready.push_back(std::move(queue->second.front()));
+                queue->second.pop_front();
+                ++inFlight;
+                ++batch.active;
+                saturated = 0;
+
+                if (queue->second.empty()) {
+                    batch.pending.erase(queue);
+                } else {
+                    batch.turns.push_back(std::move(target));
+                }
+            }
+        }
+
+        if (ready.empty()) {
+            return;
+        }
+
+        // Enviar fuera del cerrojo: los callbacks vuelven a llamar a dispatchBatch()
+        for (auto& entry : ready) {
+            auto promise = entry.promise;
+            auto target = entry.target;
+            auto completion = [this, promise, target](BatchResponse response) {
+                promise->complete(std::move(response));
+                m_batchQueue->release(target);
+                dispatchBatch();
+            };
+
+            const BatchRequest& request = entry.request;
+            if (!submitRequest(request.url, request.method, request.headers, request.body,
+                               request.options, completion)) {
+                promise->complete(BatchResponse());
+                m_batchQueue->release(target);
+            }
+        }
+    }
+}
+
+void NetworkManager::submitForAnalysis(const std::shared_ptr<ExchangeSnapshot>& exchange, const BatchResponse& response) {
+    if (!exchange || response.statusCode == 0) {
+        return;
+    }
+
+    ExchangeSnapshot snapshot = *exchange;
+    snapshot.statusCode = response.statusCode;
+    snapshot.responseHeaders = response.headers;
+    snapshot.responseBody = response.body;
+    m_analysisPipeline->submit(std::move(snapshot));
 }
 
 bool NetworkManager::enableTrafficInterception(bool enable) {
@@ -91,6 +397,40 @@ bool NetworkManager::setProxy(const std::string& host, int port, const std::stri
     return true;
 }
 
+bool NetworkManager::addHostOverride(const std::string& host, const std::string& address) {
+    if (!m_socketManager || !m_socketManager->getDnsCache()->addHostOverride(host, address)) {
+        return false;
+    }
+
+    std::cout << "Host fijado: " << host << " -> " << address << std::endl;
+    return true;
+}
+
+bool NetworkManager::startTrafficCapture(const std::string& basePath, size_t fileCount, size_t maxFileBytes) {
+    if (!m_socketManager || !m_socketManager->startCapture(basePath, fileCount, maxFileBytes)) {
+        std::cout << "No se pudo iniciar la captura del tráfico en " << basePath << std::endl;
+        return false;
+    }
+
+    std::cout << "Captura del tráfico iniciada: " << basePath << ".*.pcapng" << std::endl;
+    return true;
+}
+
+void NetworkManager::stopTrafficCapture() {
+    if (m_socketManager) {
+        m_socketManager->stopCapture();
+    }
+}
+
+void NetworkManager::enableResponseCache(bool enable) {
+    m_responseCacheEnabled = enable;
+    if (!enable) {
+        m_responseCache->clear();
+    }
+
+    std::cout << "Caché de respuestas " << (enable ? "habilitada" : "deshabilitada") << std::endl;
+}
+
 bool NetworkManager::enableVulnerabilityScanning(bool enable) {
     m_vulnerabilityScanningEnabled = enable;
     
@@ -114,7 +454,12 @@ bool NetworkManager::initializeHttpClient() {
 
 bool NetworkManager::initializeSocketManager() {
     try {
-        m_socketManager = std::make_unique<SocketManager>();
+        m_socketManager = std::make_shared<SocketManager>();
+
+        // El cliente HTTP reutiliza las conexiones del pool del gestor de sockets
+        if (m_httpClient) {
+            m_httpClient->setSocketManager(m_socketManager);
+        }
         return true;
     } catch (const std::exception& e) {
         std::cout << "Error al inicializar el gestor de sockets: " << e.what() << std::endl;
@@ -125,6 +470,13 @@ bool NetworkManager::initializeSocketManager() {
 bool NetworkManager::initializeTrafficAnalyzer() {
     try {
         m_trafficAnalyzer = std::make_unique<TrafficAnalyzer>();
+        m_analysisPipeline = std::make_unique<AnalysisPipeline>(*m_trafficAnalyzer);
+        m_analysisPipeline->setFindingHandler([](const ExchangeSnapshot& exchange,
+                                                 const std::vector<std::string>& vulnerabilities) {
+            for (const auto& vulnerability : vulnerabilities) {
+                std::cout << "Vulnerabilidad detectada en " << exchange.url << ": " << vulnerability << std::endl;
+            }
+        });
         return true;
     } catch (const std::exception& e) {
         std::cout << "Error al inicializar el analizador de tráfico: " << e.what() << std::endl;
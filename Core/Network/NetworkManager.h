@@ -10,14 +10,41 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <atomic>
+#include <future>
+#include <span>
+#include "ByteBuffer.h"
+#include "HttpClient.h"
+#include "ResponseCache.h"
+#include "AnalysisPipeline.h"
 
 namespace Core::Network {
 
 // Forward declarations
-class HttpClient;
 class SocketManager;
 class TrafficAnalyzer;
 
+/**
+ * Solicitud de un lote
+ */
+struct BatchRequest {
+    std::string url;
+    std::string method = "GET";
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::vector<uint8_t> body;
+    RequestOptions options;
+};
+
+/**
+ * Respuesta a una solicitud de un lote
+ */
+struct BatchResponse {
+    int statusCode = 0;    // 0 si la solicitud falló
+    std::vector<std::pair<std::string, std::string>> headers;
+    ByteBuffer body;       // Comparte los bloques recibidos del socket
+    bool fromCache = false; // Servida por la caché sin contactar con el origen
+};
+
 /**
  * Clase que gestiona todas las conexiones de red del navegador
  * Proporciona una interfaz unificada para realizar solicitudes HTTP/HTTPS,
@@ -48,13 +75,40 @@ public:
      * @param headers Cabeceras de la solicitud
      * @param body Cuerpo de la solicitud
      * @param callback Función de callback para la respuesta
+     * @param options Versión del protocolo y prioridad de la solicitud
      * @return true si la solicitud fue enviada correctamente, false en caso contrario
      */
     bool sendHttpRequest(const std::string& url, 
                         const std::string& method, 
                         const std::vector<std::pair<std::string, std::string>>& headers, 
                         const std::vector<uint8_t>& body,
-                        std::function<void(int, const std::vector<std::pair<std::string, std::string>>&, const std::vector<uint8_t>&)> callback);
+                        std::function<void(int, const std::vector<std::pair<std::string, std::string>>&, const ByteBuffer&)> callback,
+                        const RequestOptions& options = RequestOptions());
+
+    /**
+     * Envía un lote de solicitudes
+     * Las solicitudes se encolan por destino (esquema, host y puerto) y se
+     * envían por turnos entre los destinos, respetando los límites de
+     * setBatchConcurrency(), de modo que un lote grande contra un objetivo no
+     * acapara las conexiones del resto.
+     * @param requests Solicitudes del lote
+     * @return Un future por solicitud, en el mismo orden (código 0 si la solicitud falló)
+     */
+    std::vector<std::future<BatchResponse>> sendBatch(std::span<const BatchRequest> requests);
+
+    /**
+     * Limita las solicitudes de los lotes que están en curso a la vez
+     * @param maxInFlight Máximo de solicitudes en curso en total
+     * @param maxPerTarget Máximo de solicitudes en curso por destino
+     */
+    void setBatchConcurrency(size_t maxInFlight, size_t maxPerTarget);
+
+    /**
+     * Obtiene el destino de una URL, que agrupa sus solicitudes en los repartos por turnos
+     * @param url URL de la solicitud
+     * @return Esquema, host y puerto en minúsculas ("https://ejemplo.com:8443")
+     */
+    static std::string getRequestTarget(const std::string& url);
 
     /**
      * Intercepta y modifica tráfico de red
@@ -80,17 +134,82 @@ public:
      */
     bool enableVulnerabilityScanning(bool enable);
 
+    /**
+     * Fija la dirección de un host sin consultar el DNS
+     * Útil para apuntar a entornos de pruebas locales o ejecutar escaneos sin conexión.
+     * @param host Nombre del host
+     * @param address Dirección IPv4 o IPv6
+     * @return true si la dirección es válida y el gestor está inicializado
+     */
+    bool addHostOverride(const std::string& host, const std::string& address);
+
+    /**
+     * Graba lo que envían y reciben las conexiones en un anillo de ficheros pcapng
+     * Permite reproducir después exactamente lo que el escáner puso en la red.
+     * @param basePath Ruta base de los ficheros (<base>.0.pcapng, <base>.1.pcapng...)
+     * @param fileCount Número de ficheros del anillo
+     * @param maxFileBytes Tamaño de cada fichero
+     * @return true si la captura se inició
+     */
+    bool startTrafficCapture(const std::string& basePath, size_t fileCount = 8,
+                             size_t maxFileBytes = 64 * 1024 * 1024);
+
+    /**
+     * Detiene la grabación del tráfico
+     */
+    void stopTrafficCapture();
+
+    /**
+     * Habilita o deshabilita la caché de respuestas
+     * Con la caché habilitada, las solicitudes GET y HEAD repetidas se sirven
+     * desde memoria mientras sean frescas y se revalidan con ETag o
+     * Last-Modified cuando caducan. RequestOptions::bypassCache la evita en
+     * solicitudes concretas. Está deshabilitada por defecto porque una
+     * herramienta de pruebas debe ver siempre la respuesta real del servidor;
+     * conviene activarla solo para escaneos que repiten las mismas solicitudes.
+     * @param enable true para usar la caché (deshabilitada por defecto)
+     */
+    void enableResponseCache(bool enable);
+
+    /**
+     * Obtiene la caché de respuestas, para configurarla o consultar sus estadísticas
+     * @return Caché compartida por todas las solicitudes del gestor
+     */
+    std::shared_ptr<ResponseCache> getResponseCache() const { return m_responseCache; }
+
+    /**
+     * Obtiene el analizador de tráfico, para registrar interceptores
+     * @return Analizador de tráfico (nullptr si el gestor no está inicializado)
+     */
+    TrafficAnalyzer* getTrafficAnalyzer() const { return m_trafficAnalyzer.get(); }
+
+    /**
+     * Obtiene la cola de análisis pasivo, para elegir su política de
+     * desbordamiento, recibir las vulnerabilidades o consultar los descartes
+     * Con el análisis de vulnerabilidades activo, cada intercambio se deja en
+     * esta cola y se analiza en segundo plano sin retrasar la respuesta.
+     * @return Cola de análisis (nullptr si el gestor no está inicializado)
+     */
+    AnalysisPipeline* getAnalysisPipeline() const { return m_analysisPipeline.get(); }
+
 private:
+    // El planificador de escaneo envía por submitRequest() para distinguir las respuestas de la caché
+    friend class ScanScheduler;
+
+    struct BatchEntry;
+    struct BatchQueue;
+
     // Componentes de red
     std::unique_ptr<HttpClient> m_httpClient;
-    std::unique_ptr<SocketManager> m_socketManager;
+    std::shared_ptr<SocketManager> m_socketManager;
     std::unique_ptr<TrafficAnalyzer> m_trafficAnalyzer;
+    std::unique_ptr<AnalysisPipeline> m_analysisPipeline;   // Se destruye antes que el analizador
 
     // Estado de la interceptación de tráfico
-    bool m_trafficInterceptionEnabled;
+    std::atomic<bool> m_trafficInterceptionEnabled;
 
     // Estado del análisis de vulnerabilidades
-    bool m_vulnerabilityScanningEnabled;
+    std::atomic<bool> m_vulnerabilityScanningEnabled;
 
     // Configuración del proxy
     struct {
@@ -101,10 +220,29 @@ private:
         bool enabled;
     } m_proxyConfig;
 
+    // Solicitudes de los lotes pendientes de enviar
+    std::unique_ptr<BatchQueue> m_batchQueue;
+
+    // Caché de respuestas
+    std::shared_ptr<ResponseCache> m_responseCache;
+    std::atomic<bool> m_responseCacheEnabled;
+
     // Métodos privados para la gestión de conexiones
     bool initializeHttpClient();
     bool initializeSocketManager();
     bool initializeTrafficAnalyzer();
+
+    // Métodos privados para el envío de solicitudes y lotes
+    bool submitRequest(const std::string& url, const std::string& method,
+                       const std::vector<std::pair<std::string, std::string>>& headers,
+                       const std::vector<uint8_t>& body, const RequestOptions& options,
+                       std::function<void(BatchResponse)> completion);
+    bool dispatchRequest(const std::string& url, const std::string& method,
+                         const std::vector<std::pair<std::string, std::string>>& headers,
+                         const std::vector<uint8_t>& body, const RequestOptions& options,
+                         std::function<void(BatchResponse)> completion);
+    void dispatchBatch();
+    void submitForAnalysis(const std::shared_ptr<ExchangeSnapshot>& exchange, const BatchResponse& response);
 };
 
 } // namespace Core::Network
\ No newline at end of file
@@ -0,0 +1,137 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Captura del tráfico de las conexiones en ficheros pcapng
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
+
+namespace Core::Network {
+
+/**
+ * Estadísticas de la captura
+ */
+struct PacketCaptureStats {
+    size_t packets;          // Paquetes escritos o pendientes de escribir
+    size_t bytes;            // Bytes de datos capturados (sin las cabeceras sintéticas)
+    size_t droppedPackets;   // Paquetes descartados porque el escritor no daba abasto o el fichero falló
+    size_t rotations;        // Veces que se pasó al siguiente fichero del anillo
+    size_t currentFile;      // Índice del fichero que se está escribiendo
+};
+
+/**
+ * Grabación en pcapng de los datos enviados y recibidos por las conexiones
+ * Cada conexión se escribe como un flujo TCP sintético (IPv4 o IPv6 con las
+ * direcciones y puertos reales, números de secuencia coherentes y un
+ * establecimiento y cierre simulados) para que Wireshark pueda seguirla. En
+ * las conexiones TLS se guardan los datos en claro, que son los que sirven
+ * para reproducir lo que envió el escáner.
+ *
+ * Los hilos que envían y reciben solo copian los datos a un buffer en
+ * memoria; un hilo propio los escribe en un anillo de ficheros reservados de
+ * antemano (<base>.0.pcapng, <base>.1.pcapng...) que se sobrescriben al dar
+ * la vuelta. Si el disco no da abasto se descartan paquetes en lugar de
+ * frenar el tráfico, y se cuentan en las estadísticas. Si un fichero no se
+ * puede abrir o escribir, la captura se detiene y el resto de paquetes se
+ * cuenta como descartado.
+ */
+class PacketCapture {
+public:
+    /**
+     * Constructor
+     * @param basePath Ruta base de los ficheros del anillo
+     * @param fileCount Número de ficheros del anillo
+     * @param maxFileBytes Tamaño de cada fichero
+     * @param maxPendingBytes Datos en memoria pendientes de escribir antes de empezar a descartar
+     */
+    PacketCapture(const std::string& basePath, size_t fileCount, size_t maxFileBytes,
+                  size_t maxPendingBytes = 32 * 1024 * 1024);
+
+    /**
+     * Destructor
+     * Escribe lo pendiente y cierra el fichero actual.
+     */
+    ~PacketCapture();
+
+    PacketCapture(const PacketCapture&) = delete;
+    PacketCapture& operator=(const PacketCapture&) = delete;
+
+    /**
+     * Indica si se pudo abrir el primer fichero del anillo
+     * @return true si la captura está en marcha
+     */
+    bool isOpen() const;
+
+    /**
+     * Registra datos enviados o recibidos por una conexión
+     * La primera vez que aparece una conexión se toman sus direcciones del socket.
+     * @param flowId Identificador de la conexión (no se reutiliza)
+     * @param fd Descriptor del socket
+     * @param outgoing true para datos enviados, false para recibidos
+     * @param data Datos
+     * @param size Tamaño de los datos
+     */
+    void record(int flowId, int fd, bool outgoing, const uint8_t* data, size_t size);
+
+    /**
+     * Registra el cierre de una conexión
+     * @param flowId Identificador de la conexión
+     */
+    void closeFlow(int flowId);
+
+    /**
+     * Obtiene las estadísticas de la captura
+     * @return Estadísticas actuales
+     */
+    PacketCaptureStats getStats() const;
+
+private:
+    struct Flow {
+        bool ipv6;
+        uint8_t localAddress[16];
+        uint8_t remoteAddress[16];
+        uint16_t localPort;
+        uint16_t remotePort;
+        uint32_t localSequence;
+        uint32_t remoteSequence;
+    };
+
+    bool openFlow(int fd, Flow& flow);
+    void appendPacket(Flow& flow, bool outgoing, uint8_t flags, const uint8_t* data, size_t size);
+    bool openFile(size_t index);
+    void closeFile();
+    void writeBlocks(const std::vector<uint8_t>& blocks);
+    void fail(const std::vector<uint8_t>& blocks, size_t offset);
+    void run();
+
+    std::string m_basePath;
+    size_t m_fileCount;
+    size_t m_maxFileBytes;
+    size_t m_maxPendingBytes;
+    size_t m_flushBytes;   // Datos pendientes a partir de los que se despierta al escritor
+
+    // Estado compartido con los hilos de red
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::unordered_map<int, Flow> m_flows;
+    std::vector<uint8_t> m_pending;     // Bloques pcapng pendientes de escribir
+    bool m_stopping;
+    bool m_failed;      // Sin fichero donde escribir; se descarta todo
+    PacketCaptureStats m_stats;
+
+    // Estado del hilo escritor
+    bool m_open;
+    int m_file;
+    size_t m_fileBytes;
+    std::thread m_writer;
+};
+
+} // namespace Core::Network
@@ -0,0 +1,399 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación de la caché HTTP en memoria
+ */
+
+#include "ResponseCache.h"
+#include "../../Utils/Text/StringUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <ctime>
+#include <optional>
+#include <string_view>
+
+namespace Core::Network {
+
+namespace {
+
+// Límite de la frescura heurística calculada a partir de Last-Modified (RFC 9111, 4.2.2)
+constexpr std::chrono::hours MAX_HEURISTIC_FRESHNESS(24);
+
+using Utils::Text::equalsIgnoreCase;
+using Utils::Text::findHeader;
+using Utils::Text::toLower;
+using Utils::Text::trim;
+
+/**
+ * Directivas de Cache-Control que usa la caché
+ */
+struct CacheControl {
+    bool noStore = false;
+    bool noCache = false;
+    std::optional<long> maxAge;
+};
+
+CacheControl parseCacheControl(const std::vector<std::pair<std::string, std::string>>& headers) {
+    CacheControl control;
+    for (const auto& header : headers) {
+        bool pragma = equalsIgnoreCase(header.first, "Pragma");
+        if (!pragma && !equalsIgnoreCase(header.first, "Cache-Control")) {
+            continue;
+        }
+
+        std::string_view value = header.second;
+        while (!value.empty()) {
+            size_t comma = value.find(',');
+            std::string_view directive = trim(value.substr(0, comma));
+            value = comma == std::string_view::npos ? std::string_view() : value.substr(comma + 1);
+
+            size_t equals = directive.find('=');
+            std::string_view name = trim(directive.substr(0, equals));
+            if (equalsIgnoreCase(name, "no-cache")) {
+                control.noCache = true;
+            } else if (pragma) {
+                continue;
+            } else if (equalsIgnoreCase(name, "no-store")) {
+                control.noStore = true;
+            } else if (equalsIgnoreCase(name, "max-age") && equals != std::string_view::npos) {
+                std::string argument(trim(directive.substr(equals + 1)));
+                argument.erase(std::remove(argument.begin(), argument.end(), '"'), argument.end());
+                control.maxAge = std::max(0L, std::strtol(argument.c_str(), nullptr, 10));
+            }
+        }
+    }
+    return control;
+}
+
+/**
+ * Convierte una fecha HTTP (IMF-fixdate, "Sun, 06 Nov 1994 08:49:37 GMT")
+ * @return Segundos desde la época, o vacío si la fecha no es válida
+ */
+std::optional<time_t> parseHttpDate(const std::string* text) {
+    if (!text) {
+        return std::nullopt;
+    }
+
+    std::tm tm{};
+    const char* end = strptime(text->c_str(), "%a, %d %b %Y %H:%M:%S", &tm);
+    if (!end) {
+        return std::nullopt;
+    }
+    return timegm(&tm);
+}
+
+} // namespace
+
+ResponseCache::ResponseCache(size_t maxBytes)
+    : m_maxBytes(maxBytes)
+    , m_bytes(0)
+    , m_heuristicTtl(0)
+    , m_stats{}
+{
+}
+
+ResponseCache::Lookup ResponseCache::lookup(const std::string& method, const std::string& url,
+                                            const std::vector<std::pair<std::string, std::string>>& headers) {
+    Lookup result;
+    if (method != "GET" && method != "HEAD") {
+        return result;
+    }
+
+    // Las solicitudes condicionales o parciales del llamante van siempre al origen
+    for (const char* name : {"If-None-Match", "If-Modified-Since", "If-Match", "If-Unmodified-Since", "If-Range", "Range"}) {
+        if (findHeader(headers, name)) {
+            return result;
+        }
+    }
+
+    CacheControl control = parseCacheControl(headers);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (control.noStore) {
+        m_stats.misses++;
+        return result;
+    }
+
+    auto it = m_index.find(variantKey(baseKey(method, url, headers), headers));
+    if (it == m_index.end()) {
+        m_stats.misses++;
+        return result;
+    }
+
+    // Marcar la entrada como usada recientemente
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    Entry& entry = *it->second;
+
+    bool fresh = Clock::now() < entry.expires && !entry.mustRevalidate && !control.noCache &&
+                 !(control.maxAge && *control.maxAge == 0);
+    if (fresh) {
+        m_stats.hits++;
+        result.status = Status::FRESH;
+        result.response = entry.response;
+        return result;
+    }
+
+    if (entry.etag.empty() && entry.lastModified.empty()) {
+        m_stats.misses++;
+        return result;
+    }
+
+    result.status = Status::STALE;
+    if (!entry.etag.empty()) {
+        result.conditions.emplace_back("If-None-Match", entry.etag);
+    }
+    if (!entry.lastModified.empty()) {
+        result.conditions.emplace_back("If-Modified-Since", entry.lastModified);
+    }
+    return result;
+}
+
+bool ResponseCache::store(const std::string& method, const std::string& url,
+                          const std::vector<std::pair<std::string, std::string>>& requestHeaders,
+                          int statusCode, const std::vector<std::pair<std::string, std::string>>& headers,
+                          const ByteBuffer& body) {
+    if (method != "GET" && method != "HEAD") {
+        return false;
+    }
+
+    // Códigos cacheables por defecto (RFC 9110, 15.1)
+    static const int cacheable[] = {200, 203, 204, 300, 301, 308, 404, 405, 410, 414, 501};
+    if (std::find(std::begin(cacheable), std::end(cacheable), statusCode) == std::end(cacheable)) {
+        return false;
+    }
+
+    if (parseCacheControl(requestHeaders).noStore || parseCacheControl(headers).noStore) {
+        return false;
+    }
+
+    // Cabeceras Vary: con "*" la respuesta no puede reutilizarse
+    std::vector<std::string> vary;
+    for (const auto& header : headers) {
+        if (!equalsIgnoreCase(header.first, "Vary")) {
+            continue;
+        }
+        std::string_view value = header.second;
+        while (!value.empty()) {
+            size_t comma = value.find(',');
+            std::string_view name = trim(value.substr(0, comma));
+            value = comma == std::string_view::npos ? std::string_view() : value.substr(comma + 1);
+            if (name == "*") {
+                return false;
+            }
+            if (!name.empty()) {
+                vary.push_back(toLower(name));
+            }
+        }
+    }
+
+    Entry entry;
+    entry.response.statusCode = statusCode;
+    entry.response.headers = headers;
+    entry.response.body = body;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::string base = baseKey(method, url, requestHeaders);
+
+    // Si el servidor cambia la lista Vary, las variantes guardadas con la
+    // anterior ya no se encontrarían: se descartan
+    auto record = m_vary.find(base);
+    if (record != m_vary.end() && record->second.headers != vary) {
+        std::vector<std::list<Entry>::iterator> variants = record->second.variants;
+        for (auto variant : variants) {
+            erase(variant);
+        }
+    }
+
+    entry.key = variantKey(base, vary, requestHeaders);
+    entry.baseLength = base.size();
+    entry.bytes = entrySize(entry);
+    updateFreshness(entry, headers);
+
+    auto existing = m_index.find(entry.key);
+    if (existing != m_index.end()) {
+        erase(existing->second);
+    }
+
+    if (entry.bytes > m_maxBytes / 8) {
+        return false;
+    }
+
+    auto [varyRecord, created] = m_vary.try_emplace(base);
+    if (created) {
+        varyRecord->second.bytes = base.size();
+        for (const auto& name : vary) {
+            varyRecord->second.bytes += name.size();
+        }
+        varyRecord->second.headers = std::move(vary);
+        m_bytes += varyRecord->second.bytes;
+    }
+
+    m_bytes += entry.bytes;
+    m_entries.push_front(std::move(entry));
+    m_index[m_entries.front().key] = m_entries.begin();
+    varyRecord->second.variants.push_back(m_entries.begin());
+    m_stats.stores++;
+    evict();
+    return true;
+}
+
+bool ResponseCache::refresh(const std::string& method, const std::string& url,
+                            const std::vector<std::pair<std::string, std::string>>& requestHeaders,
+                            const std::vector<std::pair<std::string, std::string>>& headers,
+                            CachedResponse& response) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(variantKey(baseKey(method, url, requestHeaders), requestHeaders));
+    if (it == m_index.end()) {
+        return false;
+    }
+
+    // Las cabeceras del 304 sustituyen a las guardadas (RFC 9111, 3.2), salvo
+    // las que describen el cuerpo, que el 304 no incluye
+    Entry& entry = *it->second;
+    for (const auto& header : headers) {
+        if (equalsIgnoreCase(header.first, "Content-Length") ||
+            equalsIgnoreCase(header.first, "Transfer-Encoding") ||
+            equalsIgnoreCase(header.first, "Content-Encoding")) {
+            continue;
+        }
+
+        auto& stored = entry.response.headers;
+        stored.erase(std::remove_if(stored.begin(), stored.end(), [&](const auto& old) {
+            return equalsIgnoreCase(old.first, header.first);
+        }), stored.end());
+    }
+    for (const auto& header : headers) {
+        if (!equalsIgnoreCase(header.first, "Content-Length") &&
+            !equalsIgnoreCase(header.first, "Transfer-Encoding") &&
+            !equalsIgnoreCase(header.first, "Content-Encoding")) {
+            entry.response.headers.push_back(header);
+        }
+    }
+    updateFreshness(entry, entry.response.headers);
+
+    size_t bytes = entrySize(entry);
+    m_bytes = m_bytes - entry.bytes + bytes;
+    entry.bytes = bytes;
+
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    m_stats.revalidations++;
+    response = entry.response;
+    evict();
+    return true;
+}
+
+void ResponseCache::setMaxBytes(size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxBytes = maxBytes;
+    evict();
+}
+
+void ResponseCache::setHeuristicTtl(std::chrono::seconds ttl) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_heuristicTtl = std::max(ttl, std::chrono::seconds(0));
+}
+
+void ResponseCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_vary.clear();
+    m_bytes = 0;
+}
+
+ResponseCacheStats ResponseCache::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ResponseCacheStats stats = m_stats;
+    stats.entries = m_entries.size();
+    stats.bytes = m_bytes;
+    return stats;
+}
+
+std::string ResponseCache::baseKey(const std::string& method, const std::string& url,
+                                   const std::vector<std::pair<std::string, std::string>>& headers) const {
+    // Las respuestas dependen de la sesión aunque el servidor no lo declare en Vary
+    const std::string* cookie = findHeader(headers, "Cookie");
+    const std::string* authorization = findHeader(headers, "Authorization");
+    return method + ' ' + url + '\n' + (cookie ? *cookie : "") + '\n' + (authorization ? *authorization : "");
+}
+
+std::string ResponseCache::variantKey(const std::string& base,
+                                      const std::vector<std::pair<std::string, std::string>>& headers) const {
+    auto record = m_vary.find(base);
+    return record == m_vary.end() ? base : variantKey(base, record->second.headers, headers);
+}
+
+std::string ResponseCache::variantKey(const std::string& base, const std::vector<std::string>& vary,
+                                      const std::vector<std::pair<std::string, std::string>>& headers) {
+    std::string key = base;
+    for (const auto& name : vary) {
+        const std::string* value = findHeader(headers, name);
+        key += '\n' + name + ':' + (value ? *value : "");
+    }
+    return key;
+}
+
+size_t ResponseCache::entrySize(const Entry& entry) const {
+    size_t bytes = entry.key.size() + entry.response.body.size();
+    for (const auto& header : entry.response.headers) {
+        bytes += header.first.size() + header.second.size();
+    }
+    return bytes;
+}
+
+void ResponseCache::updateFreshness(Entry& entry, const std::vector<std::pair<std::string, std::string>>& headers) {
+    CacheControl control = parseCacheControl(headers);
+    const std::string* etag = findHeader(headers, "ETag");
+    const std::string* lastModified = findHeader(headers, "Last-Modified");
+    const std::string* ageHeader = findHeader(headers, "Age");
+    entry.etag = etag ? *etag : "";
+    entry.lastModified = lastModified ? *lastModified : "";
+    entry.mustRevalidate = control.noCache;
+
+    // Tiempo de vida: max-age, Expires respecto a Date o heurística sobre Last-Modified
+    std::optional<time_t> date = parseHttpDate(findHeader(headers, "Date"));
+    time_t reference = date ? *date : std::time(nullptr);
+    std::chrono::seconds lifetime = m_heuristicTtl;
+    if (control.maxAge) {
+        lifetime = std::chrono::seconds(*control.maxAge);
+    } else if (const std::string* expires = findHeader(headers, "Expires")) {
+        std::optional<time_t> expiry = parseHttpDate(expires);
+        lifetime = std::chrono::seconds(expiry ? std::max<time_t>(*expiry - reference, 0) : 0);
+    } else if (std::optional<time_t> modified = parseHttpDate(lastModified); modified && *modified < reference) {
+        auto heuristic = std::chrono::seconds((reference - *modified) / 10);
+        lifetime = std::max(m_heuristicTtl, std::min<std::chrono::seconds>(heuristic, MAX_HEURISTIC_FRESHNESS));
+    }
+
+    long age = ageHeader ? std::max(0L, std::strtol(ageHeader->c_str(), nullptr, 10)) : 0;
+    lifetime -= std::chrono::seconds(age);
+    entry.expires = Clock::now() + std::max(lifetime, std::chrono::seconds(0));
+}
+
+void ResponseCache::erase(std::list<Entry>::iterator it) {
+    m_bytes -= it->bytes;
+    m_index.erase(it->key);
+
+    auto record = m_vary.find(it->key.substr(0, it->baseLength));
+    if (record != m_vary.end()) {
+        auto& variants = record->second.variants;
+        auto variant = std::find(variants.begin(), variants.end(), it);
+        if (variant != variants.end()) {
+            *variant = variants.back();
+            variants.pop_back();
+        }
+        if (variants.empty()) {
+            m_bytes -= record->second.bytes;
+            m_vary.erase(record);
+        }
+    }
+    m_entries.erase(it);
+}
+
+void ResponseCache::evict() {
+    while (m_bytes > m_maxBytes && !m_entries.empty()) {
+        erase(std::prev(m_entries.end()));
+        m_stats.evictions++;
+    }
+}
+
+} // namespace Core::Network
@@ -0,0 +1,184 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Caché HTTP en memoria con revalidación condicional
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <chrono>
+#include <unordered_map>
+#include "ByteBuffer.h"
+
+namespace Core::Network {
+
+/**
+ * Respuesta guardada en la caché
+ */
+struct CachedResponse {
+    int statusCode = 0;
+    std::vector<std::pair<std::string, std::string>> headers;
+    ByteBuffer body;       // Comparte los bloques recibidos del socket
+};
+
+/**
+ * Estadísticas de la caché de respuestas
+ */
+struct ResponseCacheStats {
+    size_t hits;             // Respuestas servidas sin contactar con el origen
+    size_t revalidations;    // Respuestas servidas tras un 304 Not Modified
+    size_t misses;           // Solicitudes que hubo que enviar completas
+    size_t stores;           // Respuestas guardadas
+    size_t evictions;        // Entradas expulsadas para respetar el tamaño máximo
+    size_t entries;          // Entradas guardadas
+    size_t bytes;            // Tamaño ocupado por las entradas y sus listas Vary
+};
+
+/**
+ * Caché HTTP privada compartida por los componentes de red
+ * Guarda las respuestas a GET y HEAD indexadas por método, URL y las
+ * cabeceras que identifican al usuario (Cookie, Authorization) o que el
+ * servidor declara en Vary. Las respuestas frescas (max-age, Expires o la
+ * heurística sobre Last-Modified) se sirven sin contactar con el origen; las
+ * caducadas con ETag o Last-Modified se revalidan con una solicitud
+ * condicional. El tamaño se limita en bytes expulsando las entradas usadas
+ * hace más tiempo. Es segura para usarla desde varios hilos.
+ */
+class ResponseCache {
+public:
+    enum class Status {
+        FRESH,    // La respuesta guardada puede usarse tal cual
+        STALE,    // Hay que revalidarla con las cabeceras condicionales
+        MISS      // No hay respuesta utilizable
+    };
+
+    /**
+     * Resultado de una búsqueda en la caché
+     */
+    struct Lookup {
+        Status status = Status::MISS;
+        CachedResponse response;                                      // Solo en FRESH
+        std::vector<std::pair<std::string, std::string>> conditions;  // Cabeceras condicionales (STALE)
+    };
+
+    /**
+     * Constructor
+     * @param maxBytes Tamaño máximo de la caché
+     */
+    explicit ResponseCache(size_t maxBytes = 64 * 1024 * 1024);
+
+    /**
+     * Busca la respuesta a una solicitud
+     * Las solicitudes que ya son condicionales o piden no usar la caché
+     * (Cache-Control: no-store) siempre son MISS.
+     * @param method Método HTTP
+     * @param url URL de la solicitud
+     * @param headers Cabeceras de la solicitud
+     * @return Resultado de la búsqueda
+     */
+    Lookup lookup(const std::string& method, const std::string& url,
+                  const std::vector<std::pair<std::string, std::string>>& headers);
+
+    /**
+     * Guarda una respuesta si es cacheable
+     * @param method Método HTTP
+     * @param url URL de la solicitud
+     * @param requestHeaders Cabeceras de la solicitud
+     * @param statusCode Código de estado
+     * @param headers Cabeceras de la respuesta
+     * @param body Cuerpo de la respuesta
+     * @return true si la respuesta se guardó
+     */
+    bool store(const std::string& method, const std::string& url,
+               const std::vector<std::pair<std::string, std::string>>& requestHeaders,
+               int statusCode, const std::vector<std::pair<std::string, std::string>>& headers,
+               const ByteBuffer& body);
+
+    /**
+     * Actualiza una respuesta revalidada con un 304 Not Modified
+     * @param method Método HTTP
+     * @param url URL de la solicitud
+     * @param requestHeaders Cabeceras de la solicitud (sin las condicionales añadidas)
+     * @param headers Cabeceras de la respuesta 304
+     * @param response Respuesta guardada con las cabeceras actualizadas (salida)
+     * @return true si la entrada seguía en la caché
+     */
+    bool refresh(const std::string& method, const std::string& url,
+                 const std::vector<std::pair<std::string, std::string>>& requestHeaders,
+                 const std::vector<std::pair<std::string, std::string>>& headers,
+                 CachedResponse& response);
+
+    /**
+     * Establece el tamaño máximo de la caché
+     * Las respuestas mayores que una octava parte del tamaño no se guardan.
+     * @param maxBytes Tamaño máximo en bytes
+     */
+    void setMaxBytes(size_t maxBytes);
+
+    /**
+     * Establece la frescura de las respuestas sin información de caducidad
+     * Útil para que un escaneo reutilice las respuestas de referencia durante
+     * unos segundos aunque el servidor no declare max-age ni Expires.
+     * @param ttl Tiempo durante el que se consideran frescas (0 para revalidarlas siempre)
+     */
+    void setHeuristicTtl(std::chrono::seconds ttl);
+
+    /**
+     * Vacía la caché
+     */
+    void clear();
+
+    /**
+     * Obtiene las estadísticas de la caché
+     * @return Estadísticas actuales
+     */
+    ResponseCacheStats getStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string key;
+        CachedResponse response;
+        std::string etag;
+        std::string lastModified;
+        Clock::time_point expires;
+        bool mustRevalidate;   // no-cache: revalidar aunque esté fresca
+        size_t bytes;
+        size_t baseLength;     // La clave empieza por la clave base
+    };
+
+    // Cabeceras Vary de una clave base y las variantes guardadas con ellas;
+    // se descarta con la última variante
+    struct VaryRecord {
+        std::vector<std::string> headers;
+        std::vector<std::list<Entry>::iterator> variants;
+        size_t bytes = 0;
+    };
+
+    std::string baseKey(const std::string& method, const std::string& url,
+                        const std::vector<std::pair<std::string, std::string>>& headers) const;
+    std::string variantKey(const std::string& base,
+                           const std::vector<std::pair<std::string, std::string>>& headers) const;
+    static std::string variantKey(const std::string& base, const std::vector<std::string>& vary,
+                                  const std::vector<std::pair<std::string, std::string>>& headers);
+    size_t entrySize(const Entry& entry) const;
+    void updateFreshness(Entry& entry, const std::vector<std::pair<std::string, std::string>>& headers);
+    void erase(std::list<Entry>::iterator it);
+    void evict();
+
+    mutable std::mutex m_mutex;
+    std::list<Entry> m_entries;                                               // La usada más recientemente al principio
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    std::unordered_map<std::string, VaryRecord> m_vary;                       // Cabeceras Vary por clave base
+    size_t m_maxBytes;
+    size_t m_bytes;
+    std::chrono::seconds m_heuristicTtl;
+    ResponseCacheStats m_stats;
+};
+
+} // namespace Core::Network
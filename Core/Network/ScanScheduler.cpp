@@ -0,0 +1,420 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación del planificador global de escaneo
+ */
+
+#include "ScanScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace Core::Network {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Margen para que el ruido de las latencias muy pequeñas no cuente como congestión
+constexpr double LATENCY_SLACK_MS = 10.0;
+
+// Peso de cada respuesta en la latencia suavizada
+constexpr double LATENCY_SMOOTHING = 0.2;
+
+// Crecimiento de la latencia base por respuesta, para seguir los cambios de ruta
+constexpr double BASE_LATENCY_DRIFT = 1.01;
+
+/**
+ * Promesa de una solicitud planificada
+ * Si el callback se descarta sin invocarlo, la solicitud se da por fallida.
+ */
+struct ScanPromise {
+    std::promise<BatchResponse> promise;
+    bool done = false;
+
+    void complete(BatchResponse response) {
+        if (!done) {
+            done = true;
+            promise.set_value(std::move(response));
+        }
+    }
+
+    ~ScanPromise() {
+        complete(BatchResponse());
+    }
+};
+
+/**
+ * Indica si una respuesta significa que el host no da abasto
+ * @param status Código de estado (0 si la solicitud falló)
+ * @return true si hay que reducir la concurrencia
+ */
+bool isOverloaded(int status) {
+    return status == 0 || status == 429 || status == 503;
+}
+
+} // namespace
+
+struct ScanScheduler::State : std::enable_shared_from_this<ScanScheduler::State> {
+    struct Entry {
+        BatchRequest request;
+        std::string tool;
+        std::string host;
+        std::shared_ptr<ScanPromise> promise;
+    };
+
+    struct Tool {
+        double weight = 1.0;
+        double virtualTime = 0.0;                                     // Servicio recibido dividido por el peso
+        std::unordered_map<std::string, std::deque<Entry>> pending;   // Solicitudes por host
+        std::deque<std::string> turns;                                // Hosts con solicitudes pendientes
+        size_t queued = 0;
+    };
+
+    struct Host {
+        double limit = 1.0;
+        size_t inFlight = 0;
+        size_t queued = 0;
+        double latencyMs = 0.0;
+        double baseLatencyMs = 0.0;
+        size_t completed = 0;
+        size_t errors = 0;
+        Clock::time_point lastDecrease;
+    };
+
+    explicit State(NetworkManager& networkManager) : manager(networkManager) {}
+
+    NetworkManager& manager;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Tool> tools;
+    std::unordered_map<std::string, Host> hosts;
+    std::deque<Entry> interactive;
+    size_t active = 0;                 // Solicitudes BULK en curso
+    size_t maxInFlight = 64;
+    double initialPerHost = 4.0;
+    double maxPerHost = 32.0;
+    double latencyTolerance = 2.0;
+    double virtualClock = 0.0;         // Tiempo virtual del último envío
+    bool closed = false;
+
+    Host& hostState(const std::string& key) {
+        auto it = hosts.find(key);
+        if (it == hosts.end()) {
+            Host host;
+            host.limit = initialPerHost;
+            it = hosts.emplace(key, host).first;
+        }
+        return it->second;
+    }
+
+    void enqueue(Entry entry, ScanPriority priority) {
+        hostState(entry.host).queued++;
+        if (priority == ScanPriority::INTERACTIVE) {
+            interactive.push_back(std::move(entry));
+            return;
+        }
+
+        // Una herramienta que vuelve a tener trabajo no acumula el turno que no usó
+        Tool& tool = tools[entry.tool];
+        if (tool.queued == 0) {
+            tool.virtualTime = std::max(tool.virtualTime, virtualClock);
+        }
+
+        auto& queue = tool.pending[entry.host];
+        if (queue.empty()) {
+            tool.turns.push_back(entry.host);
+        }
+        queue.push_back(std::move(entry));
+        tool.queued++;
+    }
+
+    bool takeFrom(Tool& tool, std::vector<std::pair<Entry, bool>>& ready) {
+        // Primer host de la herramienta que aún tiene presupuesto
+        for (size_t i = 0; i < tool.turns.size(); i++) {
+            std::string key = std::move(tool.turns.front());
+            tool.turns.pop_front();
+
+            Host& host = hostState(key);
+            if (host.inFlight >= static_cast<size_t>(host.limit)) {
+                tool.turns.push_back(std::move(key));
+                continue;
+            }
+
+            auto queue = tool.pending.find(key);
+            ready.emplace_back(std::move(queue->second.front()), true);
+            queue->second.pop_front();
+            if (queue->second.empty()) {
+                tool.pending.erase(queue);
+            } else {
+                tool.turns.push_back(std::move(key));
+            }
+
+            host.inFlight++;
+            host.queued--;
+            tool.queued--;
+            active++;
+
+            virtualClock = tool.virtualTime;
+            tool.virtualTime += 1.0 / tool.weight;
+            return true;
+        }
+        return false;
+    }
+
+    void dispatch() {
+        for (;;) {
+            // Elegir las solicitudes que pueden salir: el carril interactivo
+            // primero y después las herramientas por orden de tiempo virtual
+            std::vector<std::pair<Entry, bool>> ready;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (closed) {
+                    return;
+                }
+
+                while (!interactive.empty()) {
+                    Host& host = hostState(interactive.front().host);
+                    host.inFlight++;
+                    host.queued--;
+                    ready.emplace_back(std::move(interactive.front()), false);
+                    interactive.pop_front();
+                }
+
+                std::vector<std::pair<double, Tool*>> order;
+                for (auto& entry : tools) {
+                    if (entry.second.queued > 0) {
+                        order.emplace_back(entry.second.virtualTime, &entry.second);
+                    }
+                }
+
+                while (active < maxInFlight && !order.empty()) {
+                    std::sort(order.begin(), order.end(),
+                              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+                    bool taken = false;
+                    for (auto it = order.begin(); it != order.end(); ++it) {
+                        if (takeFrom(*it->second, ready)) {
+                            it->first = it->second->virtualTime;
+                            if (it->second->queued == 0) {
+                                order.erase(it);
+                            }
+                            taken = true;
+                            break;
+                        }
+                    }
+                    if (!taken) {
+                        break; // Todos los hosts con trabajo están al límite
+                    }
+                }
+            }
+
+            if (ready.empty()) {
+                return;
+            }
+
+            // Enviar fuera del cerrojo: los callbacks vuelven a llamar a dispatch()
+            for (auto& [entry, bulk] : ready) {
+                auto self = shared_from_this();
+                auto promise = entry.promise;
+                auto host = entry.host;
+                bool isBulk = bulk;
+                auto start = Clock::now();
+                auto completion = [self, promise, host, isBulk, start](BatchResponse response) {
+                    int status = response.statusCode;
+                    bool fromCache = response.fromCache;
+                    promise->complete(std::move(response));
+                    if (fromCache) {
+                        // Las respuestas de la caché no dicen nada de la carga del host
+                        self->release(host, isBulk);
+                    } else {
+                        self->finish(host, isBulk, status, Clock::now() - start);
+                    }
+                    self->dispatch();
+                };
+
+                const BatchRequest& request = entry.request;
+                if (!manager.submitRequest(request.url, request.method, request.headers, request.body,
+                                           request.options, completion)) {
+                    promise->complete(BatchResponse());
+                    release(host, bulk);
+                }
+            }
+        }
+    }
+
+    void release(const std::string& key, bool bulk) {
+        std::lock_guard<std::mutex> lock(mutex);
+        hostState(key).inFlight--;
+        if (bulk) {
+            active--;
+        }
+    }
+
+    void finish(const std::string& key, bool bulk, int status, Clock::duration latency) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Host& host = hostState(key);
+        bool saturated = host.inFlight >= static_cast<size_t>(host.limit);
+        host.inFlight--;
+        host.completed++;
+        if (bulk) {
+            active--;
+        }
+
+        Clock::time_point now = Clock::now();
+        double latencyMs = std::chrono::duration<double, std::milli>(latency).count();
+        bool congested = isOverloaded(status);
+        if (congested) {
+            host.errors++;
+        } else {
+            host.baseLatencyMs = host.baseLatencyMs == 0.0 ? latencyMs :
+                std::min(latencyMs, std::max(host.baseLatencyMs * BASE_LATENCY_DRIFT, host.baseLatencyMs + 0.01));
+            host.latencyMs = host.latencyMs == 0.0 ? latencyMs :
+                host.latencyMs + (latencyMs - host.latencyMs) * LATENCY_SMOOTHING;
+            congested = host.latencyMs > host.baseLatencyMs * latencyTolerance + LATENCY_SLACK_MS;
+        }
+
+        if (congested) {
+            // Reducir como mucho una vez por ida y vuelta: las respuestas que ya
+            // estaban en camino no vuelven a castigar al host
+            auto window = std::chrono::duration<double, std::milli>(host.latencyMs);
+            if (now - host.lastDecrease >= window) {
+                host.limit = std::max(1.0, host.limit / 2.0);
+                host.lastDecrease = now;
+            }
+        } else if (saturated) {
+            // Aumento aditivo: +1 por cada ventana completa de respuestas sanas
+            host.limit = std::min(maxPerHost, host.limit + 1.0 / host.limit);
+        }
+    }
+
+    std::vector<Entry> drain(Tool& tool) {
+        std::vector<Entry> cancelled;
+        for (auto& [key, queue] : tool.pending) {
+            hostState(key).queued -= queue.size();
+            for (auto& entry : queue) {
+                cancelled.push_back(std::move(entry));
+            }
+        }
+        tool.pending.clear();
+        tool.turns.clear();
+        tool.queued = 0;
+        return cancelled;
+    }
+};
+
+ScanScheduler::ScanScheduler(NetworkManager& manager)
+    : m_state(std::make_shared<State>(manager)) {
+}
+
+ScanScheduler::~ScanScheduler() {
+    // Las solicitudes en espera se dan por fallidas al destruir sus promesas
+    std::vector<State::Entry> cancelled;
+    std::deque<State::Entry> interactive;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->closed = true;
+        for (auto& entry : m_state->tools) {
+            auto drained = m_state->drain(entry.second);
+            std::move(drained.begin(), drained.end(), std::back_inserter(cancelled));
+        }
+        interactive.swap(m_state->interactive);
+    }
+}
+
+std::future<BatchResponse> ScanScheduler::submit(const std::string& tool, const BatchRequest& request,
+                                                 ScanPriority priority) {
+    return std::move(submitBatch(tool, std::span<const BatchRequest>(&request, 1), priority).front());
+}
+
+std::vector<std::future<BatchResponse>> ScanScheduler::submitBatch(const std::string& tool,
+                                                                   std::span<const BatchRequest> requests,
+                                                                   ScanPriority priority) {
+    std::vector<std::future<BatchResponse>> futures;
+    futures.reserve(requests.size());
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        for (const auto& request : requests) {
+            auto promise = std::make_shared<ScanPromise>();
+            futures.push_back(promise->promise.get_future());
+            if (!m_state->closed) {
+                m_state->enqueue(State::Entry{request, tool, NetworkManager::getRequestTarget(request.url),
+                                              std::move(promise)}, priority);
+            }
+        }
+    }
+
+    m_state->dispatch();
+    return futures;
+}
+
+void ScanScheduler::setToolWeight(const std::string& tool, double weight) {
+    if (weight <= 0.0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->tools[tool].weight = weight;
+}
+
+size_t ScanScheduler::cancelTool(const std::string& tool) {
+    std::vector<State::Entry> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        auto it = m_state->tools.find(tool);
+        if (it != m_state->tools.end()) {
+            cancelled = m_state->drain(it->second);
+        }
+    }
+    return cancelled.size();
+}
+
+void ScanScheduler::setConcurrencyLimits(size_t maxInFlight, size_t initialPerHost, size_t maxPerHost) {
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->maxInFlight = std::max<size_t>(maxInFlight, 1);
+        m_state->maxPerHost = static_cast<double>(std::max<size_t>(maxPerHost, 1));
+        m_state->initialPerHost = std::min(static_cast<double>(std::max<size_t>(initialPerHost, 1)),
+                                           m_state->maxPerHost);
+        for (auto& entry : m_state->hosts) {
+            entry.second.limit = std::min(entry.second.limit, m_state->maxPerHost);
+        }
+    }
+
+    // Con límites más altos pueden salir solicitudes que estaban esperando
+    m_state->dispatch();
+}
+
+void ScanScheduler::setLatencyTolerance(double factor) {
+    if (factor <= 1.0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->latencyTolerance = factor;
+}
+
+HostBudget ScanScheduler::getHostBudget(const std::string& url) const {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    auto it = m_state->hosts.find(NetworkManager::getRequestTarget(url));
+    if (it == m_state->hosts.end()) {
+        return HostBudget{m_state->initialPerHost, 0, 0, 0.0, 0.0, 0, 0};
+    }
+
+    const State::Host& host = it->second;
+    return HostBudget{host.limit, host.inFlight, host.queued, host.latencyMs, host.baseLatencyMs,
+                      host.completed, host.errors};
+}
+
+size_t ScanScheduler::getQueuedCount() const {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    size_t queued = m_state->interactive.size();
+    for (const auto& entry : m_state->tools) {
+        queued += entry.second.queued;
+    }
+    return queued;
+}
+
+} // namespace Core::Network
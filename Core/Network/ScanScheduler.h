@@ -0,0 +1,146 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Planificador global de las solicitudes de las herramientas de escaneo
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <future>
+#include <span>
+#include "NetworkManager.h"
+
+namespace Core::Network {
+
+/**
+ * Carril de una solicitud planificada
+ */
+enum class ScanPriority {
+    INTERACTIVE,   // Envíos manuales (Repeater): salen antes que cualquier escaneo
+    BULK           // Escaneos y ataques automáticos
+};
+
+/**
+ * Estado del presupuesto de concurrencia de un host
+ */
+struct HostBudget {
+    double concurrencyLimit;   // Solicitudes simultáneas permitidas ahora mismo
+    size_t inFlight;           // Solicitudes en curso
+    size_t queued;             // Solicitudes en espera de todas las herramientas
+    double latencyMs;          // Latencia suavizada de las respuestas
+    double baseLatencyMs;      // Latencia mínima observada (host sin carga)
+    size_t completed;          // Respuestas recibidas
+    size_t errors;             // Fallos de conexión y respuestas 429/503
+};
+
+/**
+ * Planificador que reparte la red entre las herramientas de escaneo
+ * Se coloca delante de un NetworkManager: las herramientas (analizadores,
+ * Intruder, TechDetector, Repeater...) le entregan sus solicitudes y él decide
+ * cuándo enviarlas.
+ *
+ * - Cada herramienta tiene su propia cola y un peso; las colas se atienden por
+ *   turno justo ponderado, de modo que una herramienta con miles de
+ *   solicitudes no deja sin red a las demás.
+ * - Dentro de una herramienta, los hosts se atienden por turnos.
+ * - Cada host tiene un límite de concurrencia común a todas las herramientas
+ *   que se ajusta con AIMD: sube en uno por cada ventana de respuestas sanas y
+ *   se reduce a la mitad ante fallos, respuestas 429/503 o una latencia muy
+ *   por encima de la del host sin carga.
+ * - Las solicitudes INTERACTIVE se envían en cuanto llegan, sin esperar a los
+ *   límites, aunque cuentan como carga del host.
+ *
+ * Es seguro usarlo desde varios hilos. Debe destruirse antes que el
+ * NetworkManager al que envía las solicitudes.
+ */
+class ScanScheduler {
+public:
+    /**
+     * Constructor
+     * @param manager Gestor de red ya inicializado por el que salen las solicitudes
+     */
+    explicit ScanScheduler(NetworkManager& manager);
+
+    /**
+     * Destructor
+     * Las solicitudes que aún no se enviaron se dan por fallidas.
+     */
+    ~ScanScheduler();
+
+    ScanScheduler(const ScanScheduler&) = delete;
+    ScanScheduler& operator=(const ScanScheduler&) = delete;
+
+    /**
+     * Planifica una solicitud
+     * @param tool Herramienta que la envía ("Intruder", "TechDetector"...)
+     * @param request Solicitud
+     * @param priority Carril de la solicitud
+     * @return Respuesta (código 0 si la solicitud falló o se canceló)
+     */
+    std::future<BatchResponse> submit(const std::string& tool, const BatchRequest& request,
+                                      ScanPriority priority = ScanPriority::BULK);
+
+    /**
+     * Planifica un lote de solicitudes de una herramienta
+     * @param tool Herramienta que las envía
+     * @param requests Solicitudes
+     * @param priority Carril de las solicitudes
+     * @return Un future por solicitud, en el mismo orden
+     */
+    std::vector<std::future<BatchResponse>> submitBatch(const std::string& tool, std::span<const BatchRequest> requests,
+                                                        ScanPriority priority = ScanPriority::BULK);
+
+    /**
+     * Establece el peso de una herramienta en el reparto
+     * Una herramienta con peso 2 envía el doble de solicitudes que una con peso 1
+     * mientras ambas tengan solicitudes en espera.
+     * @param tool Herramienta
+     * @param weight Peso relativo (> 0; por defecto 1)
+     */
+    void setToolWeight(const std::string& tool, double weight);
+
+    /**
+     * Cancela las solicitudes en espera de una herramienta
+     * Las que ya están en curso terminan normalmente.
+     * @param tool Herramienta
+     * @return Número de solicitudes canceladas
+     */
+    size_t cancelTool(const std::string& tool);
+
+    /**
+     * Configura los límites de concurrencia
+     * @param maxInFlight Máximo de solicitudes BULK en curso en total
+     * @param initialPerHost Límite inicial de cada host
+     * @param maxPerHost Límite máximo al que puede crecer un host
+     */
+    void setConcurrencyLimits(size_t maxInFlight, size_t initialPerHost, size_t maxPerHost);
+
+    /**
+     * Establece cuánto puede crecer la latencia antes de reducir la concurrencia
+     * @param factor Latencia suavizada máxima respecto a la del host sin carga (> 1; por defecto 2)
+     */
+    void setLatencyTolerance(double factor);
+
+    /**
+     * Obtiene el presupuesto de concurrencia de un host
+     * @param url URL de cualquier recurso del host
+     * @return Estado del host (límite inicial si aún no se le envió nada)
+     */
+    HostBudget getHostBudget(const std::string& url) const;
+
+    /**
+     * Obtiene el número de solicitudes en espera
+     * @return Solicitudes planificadas que aún no se enviaron
+     */
+    size_t getQueuedCount() const;
+
+private:
+    struct State;
+
+    std::shared_ptr<State> m_state;
+};
+
+} // namespace Core::Network
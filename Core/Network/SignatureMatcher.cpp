@@ -0,0 +1,158 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación de la búsqueda simultánea de firmas
+ */
+
+#include "SignatureMatcher.h"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <queue>
+
+namespace Core::Network {
+
+namespace {
+
+constexpr uint32_t NO_STATE = std::numeric_limits<uint32_t>::max();
+
+} // namespace
+
+SignatureMatcher::SignatureMatcher(const std::vector<std::string>& patterns)
+    : m_patterns(patterns)
+    , m_classes{}
+    , m_classCount(1)
+{
+    // Alfabeto reducido: una clase por letra (mayúscula y minúscula juntas) u
+    // otro byte presente en alguna firma; el resto comparte la clase 0
+    for (const std::string& pattern : m_patterns) {
+        for (unsigned char c : pattern) {
+            unsigned char lower = static_cast<unsigned char>(std::tolower(c));
+            if (m_classes[lower] == 0) {
+                m_classes[lower] = static_cast<uint8_t>(m_classCount++);
+                m_classes[std::toupper(lower)] = m_classes[lower];
+            }
+        }
+    }
+
+    // Trie de las firmas
+    std::vector<std::vector<uint32_t>> outputs(1);
+    m_transitions.assign(m_classCount, NO_STATE);
+    for (size_t index = 0; index < m_patterns.size(); index++) {
+        if (m_patterns[index].empty()) {
+            continue;
+        }
+
+        uint32_t state = 0;
+        for (unsigned char c : m_patterns[index]) {
+            uint32_t& next = m_transitions[state * m_classCount + m_classes[c]];
+            if (next == NO_STATE) {
+                next = static_cast<uint32_t>(outputs.size());
+                outputs.emplace_back();
+                m_transitions.resize(m_transitions.size() + m_classCount, NO_STATE);
+            }
+            // resize() puede haber invalidado la referencia
+            state = m_transitions[state * m_classCount + m_classes[c]];
+        }
+        outputs[state].push_back(static_cast<uint32_t>(index));
+    }
+
+    // Enlaces de fallo por niveles, completando cada transición que falta con
+    // la del estado de fallo para que la búsqueda no tenga que retroceder
+    std::vector<uint32_t> fail(outputs.size(), 0);
+    std::queue<uint32_t> pending;
+    for (size_t c = 0; c < m_classCount; c++) {
+        uint32_t& next = m_transitions[c];
+        if (next == NO_STATE) {
+            next = 0;
+        } else {
+            pending.push(next);
+        }
+    }
+    while (!pending.empty()) {
+        uint32_t state = pending.front();
+        pending.pop();
+        for (size_t c = 0; c < m_classCount; c++) {
+            uint32_t& next = m_transitions[state * m_classCount + c];
+            uint32_t fallback = m_transitions[fail[state] * m_classCount + c];
+            if (next == NO_STATE) {
+                next = fallback;
+                continue;
+            }
+
+            // Una firma que termina en el estado de fallo también termina aquí
+            fail[next] = fallback;
+            outputs[next].insert(outputs[next].end(), outputs[fallback].begin(), outputs[fallback].end());
+            pending.push(next);
+        }
+    }
+
+    m_outputStart.reserve(outputs.size() + 1);
+    for (const auto& stateOutputs : outputs) {
+        m_outputStart.push_back(static_cast<uint32_t>(m_outputs.size()));
+        m_outputs.insert(m_outputs.end(), stateOutputs.begin(), stateOutputs.end());
+    }
+    m_outputStart.push_back(static_cast<uint32_t>(m_outputs.size()));
+
+    // Cada transición guarda la fila del estado destino y, en el bit bajo, si
+    // termina alguna firma en él: el bucle de búsqueda no multiplica ni
+    // consulta m_outputStart salvo cuando hay coincidencia
+    for (uint32_t& next : m_transitions) {
+        next = static_cast<uint32_t>(next * m_classCount * 2) | (outputs[next].empty() ? 0 : 1);
+    }
+}
+
+bool SignatureMatcher::scan(std::string_view text, const MatchHandler& onMatch) const {
+    Cursor cursor;
+    return feed(cursor, text, onMatch);
+}
+
+bool SignatureMatcher::scan(const ByteBuffer& data, const MatchHandler& onMatch) const {
+    Cursor cursor;
+    for (size_t i = 0; i < data.chunkCount(); i++) {
+        if (!feed(cursor, data.chunkView(i), onMatch)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SignatureMatcher::feed(Cursor& cursor, std::string_view chunk, const MatchHandler& onMatch) const {
+    const uint32_t* transitions = m_transitions.data();
+    const uint8_t* classes = m_classes;
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(chunk.data());
+    uint32_t row = static_cast<uint32_t>(cursor.state * m_classCount);
+    size_t i = 0;
+
+    while (i < chunk.size()) {
+        // Camino rápido: avanzar hasta el siguiente estado en el que termina
+        // una firma, sin nada más en el bucle que la consulta a la tabla
+        uint32_t next = 0;
+        for (; i < chunk.size(); i++) {
+            next = transitions[row + classes[data[i]]];
+            row = next >> 1;
+            if (next & 1) {
+                break;
+            }
+        }
+        if (i == chunk.size()) {
+            break;
+        }
+
+        i++;
+        uint32_t state = static_cast<uint32_t>(row / m_classCount);
+        for (uint32_t output = m_outputStart[state]; output < m_outputStart[state + 1]; output++) {
+            if (!onMatch(m_outputs[output], cursor.offset + i)) {
+                cursor.state = state;
+                cursor.offset += i;
+                return false;
+            }
+        }
+    }
+
+    cursor.state = static_cast<uint32_t>(row / m_classCount);
+    cursor.offset += chunk.size();
+    return true;
+}
+
+} // namespace Core::Network
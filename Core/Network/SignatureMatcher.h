@@ -0,0 +1,100 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Búsqueda simultánea de varias firmas en una sola pasada (Aho-Corasick)
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include "ByteBuffer.h"
+
+namespace Core::Network {
+
+/**
+ * Autómata que busca un conjunto fijo de firmas a la vez
+ * Se construye una vez con todas las firmas y después recorre cada texto byte
+ * a byte sin retroceder, sea cual sea el número de firmas: el coste depende
+ * solo del tamaño del texto. Las transiciones se compilan en una tabla (DFA)
+ * sobre un alfabeto reducido a los bytes que aparecen en las firmas, de modo
+ * que la tabla cabe en la caché aunque haya cientos de estados.
+ *
+ * Las comparaciones no distinguen mayúsculas de minúsculas (ASCII). Una vez
+ * construido no se modifica, así que puede usarse desde varios hilos.
+ */
+class SignatureMatcher {
+public:
+    /**
+     * Función a la que se notifica cada coincidencia
+     * Recibe el índice de la firma y la posición en la que termina la
+     * coincidencia; devuelve false para detener la búsqueda.
+     */
+    using MatchHandler = std::function<bool(size_t pattern, size_t end)>;
+
+    /**
+     * Estado de una búsqueda repartida en varios fragmentos
+     */
+    struct Cursor {
+        uint32_t state = 0;    // Estado del autómata tras el último byte
+        size_t offset = 0;     // Bytes recorridos hasta ahora
+    };
+
+    /**
+     * Constructor
+     * @param patterns Firmas a buscar (las vacías se ignoran)
+     */
+    explicit SignatureMatcher(const std::vector<std::string>& patterns);
+
+    /**
+     * Busca las firmas en un texto
+     * @param text Texto
+     * @param onMatch Función a la que se notifica cada coincidencia
+     * @return false si la función detuvo la búsqueda
+     */
+    bool scan(std::string_view text, const MatchHandler& onMatch) const;
+
+    /**
+     * Busca las firmas en un buffer, fragmento a fragmento y sin copiarlo
+     * Encuentra también las coincidencias repartidas entre dos fragmentos.
+     * @param data Buffer
+     * @param onMatch Función a la que se notifica cada coincidencia
+     * @return false si la función detuvo la búsqueda
+     */
+    bool scan(const ByteBuffer& data, const MatchHandler& onMatch) const;
+
+    /**
+     * Continúa una búsqueda con el siguiente fragmento de un flujo
+     * @param cursor Estado de la búsqueda (se actualiza)
+     * @param chunk Siguiente fragmento
+     * @param onMatch Función a la que se notifica cada coincidencia
+     * @return false si la función detuvo la búsqueda
+     */
+    bool feed(Cursor& cursor, std::string_view chunk, const MatchHandler& onMatch) const;
+
+    /**
+     * Obtiene una firma
+     * @param index Índice de la firma
+     * @return Firma tal como se registró
+     */
+    const std::string& pattern(size_t index) const { return m_patterns[index]; }
+
+    /**
+     * Obtiene el número de firmas
+     * @return Número de firmas
+     */
+    size_t patternCount() const { return m_patterns.size(); }
+
+private:
+    std::vector<std::string> m_patterns;
+    uint8_t m_classes[256];                  // Clase de cada byte en el alfabeto reducido (0: ningún patrón lo usa)
+    size_t m_classCount;
+    std::vector<uint32_t> m_transitions;     // Fila del siguiente estado (x2, bit bajo: termina una firma) por estado y clase
+    std::vector<uint32_t> m_outputStart;     // Inicio de las firmas que terminan en cada estado
+    std::vector<uint32_t> m_outputs;         // Índices de firmas, agrupados por estado
+};
+
+} // namespace Core::Network
@@ -0,0 +1,723 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación del gestor de sockets y del pool de conexiones keep-alive
+ */
+
+#include "SocketManager.h"
+#include "DnsResolver.h"
+#include "TlsConnection.h"
+#include "../../Utils/Logging/Logger.h"
+#include "../../Utils/Text/StringUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <mutex>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+namespace Core::Network {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Tiempo máximo de espera de las operaciones bloqueantes (connect, send, recv)
+constexpr int BLOCKING_TIMEOUT_MS = 30000;
+
+std::string originKey(const std::string& host, int port, bool secure, const std::string& protocol = "http/1.1") {
+    // Las conexiones de protocolos distintos no son intercambiables en el pool
+    std::string key = (secure ? "https://" : "http://") + host + ":" + std::to_string(port);
+    return protocol == "http/1.1" ? key : key + "#" + protocol;
+}
+
+bool waitFor(int fd, short events, int timeoutMs) {
+    pollfd descriptor{};
+    descriptor.fd = fd;
+    descriptor.events = events;
+    int result;
+    do {
+        result = poll(&descriptor, 1, timeoutMs);
+    } while (result < 0 && errno == EINTR);
+    return result > 0 && !(descriptor.revents & POLLNVAL);
+}
+
+/**
+ * Inicia una conexión TCP no bloqueante
+ * @param addresses Direcciones del host ya resueltas, en orden de preferencia
+ * @return Descriptor del socket con la conexión en curso, o -1 en caso de error
+ */
+int startConnect(const std::vector<ResolvedAddress>& addresses, const std::string& host, int port) {
+    int fd = -1;
+    for (const ResolvedAddress& address : addresses) {
+        sockaddr_storage storage;
+        socklen_t length = address.toSockaddr(port, storage);
+        fd = socket(address.family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) continue;
+
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&storage), length) == 0 || errno == EINPROGRESS) {
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+
+    if (fd < 0) {
+        Utils::Logging::Logger::error("SocketManager: No se pudo conectar con " + host + ":" + std::to_string(port));
+    }
+    return fd;
+}
+
+/**
+ * Espera a que termine una conexión iniciada con startConnect()
+ */
+bool finishConnect(int fd) {
+    if (!waitFor(fd, POLLOUT, BLOCKING_TIMEOUT_MS)) {
+        return false;
+    }
+    int error = 0;
+    socklen_t length = sizeof(error);
+    return getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0;
+}
+
+bool sendAll(int fd, const uint8_t* data, size_t size) {
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t result = send(fd, data + sent, size - sent, MSG_NOSIGNAL);
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            if ((errno == EAGAIN || errno == EWOULDBLOCK) && waitFor(fd, POLLOUT, BLOCKING_TIMEOUT_MS)) continue;
+            return false;
+        }
+        sent += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * Estado interno del gestor de sockets y del pool
+ */
+class SocketManager::SocketManagerImpl {
+public:
+    struct Socket {
+        int fd;
+        std::string originKey;
+        std::string hostKey;                  // Origen sin el protocolo, para el límite por host
+        Clock::time_point lastUsed;
+        std::unique_ptr<TlsConnection> tls;   // Solo en las conexiones seguras
+    };
+
+    struct OriginPool {
+        std::vector<int> idle;    // IDs inactivos, el más reciente al final
+        int openCount = 0;        // Conexiones abiertas, en uso o inactivas
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<int, Socket> sockets;
+    std::unordered_map<std::string, OriginPool> origins;
+
+    // Conexiones abiertas por host, sumando los pools de todos los protocolos
+    std::unordered_map<std::string, int> hostOpenCounts;
+
+    int maxIdlePerHost = 6;
+    int maxPerHost = 0;
+    std::chrono::milliseconds idleTimeout{30000};
+
+    ConnectionPoolStats stats{};
+
+    // Caché DNS y contexto TLS; tienen su propio mutex
+    std::shared_ptr<DnsCache> dnsCache = std::make_shared<DnsCache>();
+    std::shared_ptr<TlsContext> tlsContext = std::make_shared<TlsContext>();
+
+    // Captura pcapng; el indicador evita tomar el mutex cuando no hay ninguna
+    std::shared_ptr<PacketCapture> capture;
+    std::atomic<bool> capturing{false};
+
+    /**
+     * Comprueba que una conexión inactiva sigue abierta y sin datos pendientes
+     * Un EOF o datos sin solicitud indican que el servidor la cerró o que quedó
+     * a medias, así que no se puede reutilizar.
+     */
+    static bool isHealthy(int fd) {
+        uint8_t byte;
+        ssize_t result = recv(fd, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+        return result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+
+    /**
+     * Obtiene las conexiones abiertas a un host en todos los protocolos
+     * Debe llamarse con el mutex tomado
+     */
+    int hostOpenCount(const std::string& hostKey) const {
+        auto it = hostOpenCounts.find(hostKey);
+        return it == hostOpenCounts.end() ? 0 : it->second;
+    }
+
+    /**
+     * Libera la plaza de una conexión en el límite por host
+     * Debe llamarse con el mutex tomado
+     */
+    void releaseHostSlot(const std::string& hostKey) {
+        auto it = hostOpenCounts.find(hostKey);
+        if (it != hostOpenCounts.end() && --it->second <= 0) {
+            hostOpenCounts.erase(it);
+        }
+    }
+
+    /**
+     * Cierra la conexión inactiva más antigua de un host, de cualquier protocolo
+     * Debe llamarse con el mutex tomado
+     * @return true si se cerró alguna
+     */
+    bool evictIdleForHost(const std::string& host, int port, bool secure, std::unordered_map<int, bool>& activeSockets) {
+        for (const char* protocol : {"http/1.1", "h2", "h2c"}) {
+            auto originIt = origins.find(originKey(host, port, secure, protocol));
+            if (originIt != origins.end() && !originIt->second.idle.empty()) {
+                stats.evictedConnections++;
+                destroy(originIt->second.idle.front(), activeSockets);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Cierra un socket y lo quita de todas las estructuras
+     * Debe llamarse con el mutex tomado
+     */
+    void destroy(int socketId, std::unordered_map<int, bool>& activeSockets) {
+        auto it = sockets.find(socketId);
+        if (it == sockets.end()) {
+            return;
+        }
+
+        if (capture) {
+            capture->closeFlow(socketId);
+        }
+        it->second.tls.reset();
+        close(it->second.fd);
+        auto originIt = origins.find(it->second.originKey);
+        if (originIt != origins.end()) {
+            auto& idle = originIt->second.idle;
+            idle.erase(std::remove(idle.begin(), idle.end(), socketId), idle.end());
+            if (--originIt->second.openCount <= 0) {
+                origins.erase(originIt);
+            }
+        }
+        releaseHostSlot(it->second.hostKey);
+
+        auto activeIt = activeSockets.find(socketId);
+        if (activeIt != activeSockets.end()) {
+            if (activeIt->second) {
+                stats.activeConnections--;
+            } else {
+                stats.idleConnections--;
+            }
+            activeSockets.erase(activeIt);
+        }
+        sockets.erase(it);
+    }
+};
+
+SocketManager::SocketManager() :
+    m_impl(std::make_unique<SocketManagerImpl>()),
+    m_nextSocketId(1) {
+    m_proxyConfig.port = 0;
+    m_proxyConfig.enabled = false;
+
+    if (!initializeSocketLibrary()) {
+        Utils::Logging::Logger::error("SocketManager: No se pudo inicializar la biblioteca de sockets");
+    }
+}
+
+SocketManager::~SocketManager() {
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        for (auto& entry : m_impl->sockets) {
+            entry.second.tls.reset();
+            close(entry.second.fd);
+        }
+        m_impl->sockets.clear();
+        m_impl->origins.clear();
+        m_activeSockets.clear();
+    }
+    cleanupSocketLibrary();
+}
+
+int SocketManager::createTcpSocket(const std::string& host, int port, bool secure) {
+    std::string proxyHost;
+    int proxyPort = 0;
+    std::string proxyCredentials;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        if (m_proxyConfig.enabled) {
+            proxyHost = m_proxyConfig.host;
+            proxyPort = m_proxyConfig.port;
+            if (!m_proxyConfig.username.empty()) {
+                proxyCredentials = Utils::Text::base64Encode(m_proxyConfig.username + ":" + m_proxyConfig.password);
+            }
+        }
+    }
+
+    bool tunnel = !proxyHost.empty();
+    std::string connectHost = tunnel ? proxyHost : host;
+    int connectPort = tunnel ? proxyPort : port;
+    std::vector<ResolvedAddress> addresses;
+    int fd = resolveHost(connectHost, addresses) ? startConnect(addresses, connectHost, connectPort) : -1;
+    if (fd < 0) {
+        return -1;
+    }
+    if (!finishConnect(fd)) {
+        Utils::Logging::Logger::error("SocketManager: Tiempo de conexión agotado con " + host);
+        close(fd);
+        return -1;
+    }
+
+    if (tunnel) {
+        // Túnel CONNECT a través del proxy
+        std::string target = host + ":" + std::to_string(port);
+        std::string request = "CONNECT " + target + " HTTP/1.1\r\nHost: " + target + "\r\n";
+        if (!proxyCredentials.empty()) {
+            request += "Proxy-Authorization: Basic " + proxyCredentials + "\r\n";
+        }
+        request += "\r\n";
+
+        std::string reply;
+        bool established = sendAll(fd, reinterpret_cast<const uint8_t*>(request.data()), request.size());
+        while (established && reply.find("\r\n\r\n") == std::string::npos && reply.size() < 8192) {
+            char buffer[1024];
+            if (!waitFor(fd, POLLIN, BLOCKING_TIMEOUT_MS)) {
+                established = false;
+                break;
+            }
+            // Leer solo hasta el final de la respuesta del proxy para no consumir datos del túnel
+            ssize_t received = recv(fd, buffer, sizeof(buffer), MSG_PEEK);
+            if (received <= 0) {
+                established = false;
+                break;
+            }
+            std::string peeked = reply + std::string(buffer, static_cast<size_t>(received));
+            size_t end = peeked.find("\r\n\r\n");
+            size_t take = end == std::string::npos ? static_cast<size_t>(received) : end + 4 - reply.size();
+            received = recv(fd, buffer, take, 0);
+            if (received <= 0) {
+                established = false;
+                break;
+            }
+            reply.append(buffer, static_cast<size_t>(received));
+        }
+
+        bool accepted = established && reply.size() >= 12 && reply.compare(0, 7, "HTTP/1.") == 0 &&
+                        reply.compare(9, 3, "200") == 0;
+        if (!accepted) {
+            Utils::Logging::Logger::error("SocketManager: El proxy rechazó el túnel a " + target);
+            close(fd);
+            return -1;
+        }
+    }
+
+    // La negociación TLS va dentro del túnel, con el host de destino
+    std::unique_ptr<TlsConnection> tls;
+    if (secure) {
+        tls = std::make_unique<TlsConnection>(m_impl->tlsContext, fd, host, port,
+                                              std::vector<std::string>{"http/1.1"},
+                                              m_impl->tlsContext->getVerifyPeer());
+        if (!completeHandshake(fd, *tls)) {
+            tls.reset();
+            close(fd);
+            return -1;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    int socketId = m_nextSocketId++;
+    std::string key = originKey(host, port, secure);
+    m_impl->sockets[socketId] = {fd, key, key, Clock::now(), std::move(tls)};
+    m_impl->origins[key].openCount++;
+    m_impl->hostOpenCounts[key]++;
+    m_activeSockets[socketId] = true;
+    m_impl->stats.activeConnections++;
+    m_impl->stats.createdConnections++;
+    configureSocketOptions(socketId);
+    return socketId;
+}
+
+bool SocketManager::sendData(int socket_id, const std::vector<uint8_t>& data) {
+    int fd = getNativeHandle(socket_id);
+    if (fd < 0) {
+        return false;
+    }
+
+    TlsConnection* tls = getTlsConnection(socket_id);
+    if (!tls) {
+        if (!sendAll(fd, data.data(), data.size())) {
+            return false;
+        }
+        recordTraffic(socket_id, true, data.data(), data.size());
+        return true;
+    }
+
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t result = tls->write(data.data() + sent, data.size() - sent);
+        if (result < 0) {
+            if (errno == EAGAIN && waitFor(fd, POLLOUT, BLOCKING_TIMEOUT_MS)) continue;
+            return false;
+        }
+        recordTraffic(socket_id, true, data.data() + sent, static_cast<size_t>(result));
+        sent += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+bool SocketManager::receiveData(int socket_id, std::function<void(const std::vector<uint8_t>&)> callback) {
+    int fd = getNativeHandle(socket_id);
+    if (fd < 0) {
+        return false;
+    }
+
+    TlsConnection* tls = getTlsConnection(socket_id);
+    std::vector<uint8_t> buffer(65536);
+    ssize_t received;
+    while (true) {
+        // TLS puede tener datos ya descifrados sin que el socket sea legible
+        received = tls ? tls->read(buffer.data(), buffer.size()) : recv(fd, buffer.data(), buffer.size(), MSG_DONTWAIT);
+        if (received >= 0 || (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)) {
+            break;
+        }
+        if (errno != EINTR && !waitFor(fd, POLLIN, BLOCKING_TIMEOUT_MS)) {
+            return false;
+        }
+    }
+
+    if (received <= 0) {
+        return false;
+    }
+
+    buffer.resize(static_cast<size_t>(received));
+    recordTraffic(socket_id, false, buffer.data(), buffer.size());
+    if (callback) {
+        callback(buffer);
+    }
+    return true;
+}
+
+bool SocketManager::closeSocket(int socket_id) {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    if (m_impl->sockets.find(socket_id) == m_impl->sockets.end()) {
+        return false;
+    }
+    m_impl->destroy(socket_id, m_activeSockets);
+    return true;
+}
+
+bool SocketManager::setProxy(const std::string& host, int port, const std::string& username, const std::string& password) {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    m_proxyConfig.host = host;
+    m_proxyConfig.port = port;
+    m_proxyConfig.username = username;
+    m_proxyConfig.password = password;
+    m_proxyConfig.enabled = !host.empty() && port > 0;
+    return m_proxyConfig.enabled;
+}
+
+int SocketManager::acquireConnection(const std::string& host, int port, bool secure, bool& reused,
+                                     const std::string& protocol, bool verifyPeer) {
+    reused = false;
+    std::string key = originKey(host, port, secure, protocol);
+    std::string hostKey = originKey(host, port, secure);
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        auto originIt = m_impl->origins.find(key);
+        if (originIt != m_impl->origins.end()) {
+            // Reutilizar la conexión inactiva más reciente que siga sana
+            while (originIt != m_impl->origins.end() && !originIt->second.idle.empty()) {
+                int socketId = originIt->second.idle.back();
+                auto& socket = m_impl->sockets[socketId];
+                bool expired = Clock::now() - socket.lastUsed > m_impl->idleTimeout;
+                // Una conexión sin verificar no sirve si ahora se exige verificar el certificado
+                bool unverified = socket.tls && !socket.tls->isVerified() && verifyPeer;
+
+                if (expired || unverified || !SocketManagerImpl::isHealthy(socket.fd)) {
+                    m_impl->stats.evictedConnections++;
+                    m_impl->destroy(socketId, m_activeSockets);
+                    originIt = m_impl->origins.find(key);
+                    continue;
+                }
+
+                originIt->second.idle.pop_back();
+                socket.lastUsed = Clock::now();
+                m_activeSockets[socketId] = true;
+                m_impl->stats.idleConnections--;
+                m_impl->stats.activeConnections++;
+                m_impl->stats.reusedConnections++;
+                reused = true;
+                return socketId;
+            }
+        }
+
+        // El límite por host suma los pools de todos los protocolos; una conexión
+        // inactiva de otro protocolo se cierra para dejar sitio a la nueva
+        if (m_impl->maxPerHost > 0 && m_impl->hostOpenCount(hostKey) >= m_impl->maxPerHost &&
+            !m_impl->evictIdleForHost(host, port, secure, m_activeSockets)) {
+            return -1;
+        }
+
+        // Reservar la plaza antes de conectar para respetar el límite por host
+        m_impl->origins[key].openCount++;
+        m_impl->hostOpenCounts[hostKey]++;
+    }
+
+    std::vector<ResolvedAddress> addresses;
+    int fd = resolveHost(host, addresses) ? startConnect(addresses, host, port) : -1;
+
+    std::unique_ptr<TlsConnection> tls;
+    if (fd >= 0 && secure) {
+        std::vector<std::string> alpn = protocol == "h2" ? std::vector<std::string>{"h2", "http/1.1"} :
+                                                           std::vector<std::string>{"http/1.1"};
+        tls = std::make_unique<TlsConnection>(m_impl->tlsContext, fd, host, port, alpn, verifyPeer);
+    }
+
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    if (fd < 0) {
+        auto originIt = m_impl->origins.find(key);
+        if (originIt != m_impl->origins.end() && --originIt->second.openCount <= 0) {
+            m_impl->origins.erase(originIt);
+        }
+        m_impl->releaseHostSlot(hostKey);
+        return -1;
+    }
+
+    int socketId = m_nextSocketId++;
+    m_impl->sockets[socketId] = {fd, key, hostKey, Clock::now(), std::move(tls)};
+    m_activeSockets[socketId] = true;
+    m_impl->stats.activeConnections++;
+    m_impl->stats.createdConnections++;
+    configureSocketOptions(socketId);
+    return socketId;
+}
+
+void SocketManager::releaseConnection(int socket_id, bool reusable) {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    auto it = m_impl->sockets.find(socket_id);
+    auto activeIt = m_activeSockets.find(socket_id);
+    if (it == m_impl->sockets.end() || activeIt == m_activeSockets.end() || !activeIt->second) {
+        return;
+    }
+
+    auto& pool = m_impl->origins[it->second.originKey];
+    if (!reusable || static_cast<int>(pool.idle.size()) >= m_impl->maxIdlePerHost) {
+        m_impl->destroy(socket_id, m_activeSockets);
+        return;
+    }
+
+    it->second.lastUsed = Clock::now();
+    pool.idle.push_back(socket_id);
+    activeIt->second = false;
+    m_impl->stats.activeConnections--;
+    m_impl->stats.idleConnections++;
+}
+
+bool SocketManager::hasCapacity(const std::string& host, int port, bool secure) const {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    if (m_impl->maxPerHost <= 0) {
+        return true;
+    }
+
+    auto originIt = m_impl->origins.find(originKey(host, port, secure));
+    if (originIt != m_impl->origins.end() && !originIt->second.idle.empty()) {
+        return true;
+    }
+    return m_impl->hostOpenCount(originKey(host, port, secure)) < m_impl->maxPerHost;
+}
+
+void SocketManager::setPoolLimits(int maxIdlePerHost, int maxPerHost, int idleTimeoutMs) {
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        m_impl->maxIdlePerHost = std::max(maxIdlePerHost, 0);
+        m_impl->maxPerHost = std::max(maxPerHost, 0);
+        m_impl->idleTimeout = std::chrono::milliseconds(std::max(idleTimeoutMs, 0));
+
+        // Recortar los pools que superen el nuevo límite, empezando por las más antiguas
+        std::vector<int> surplus;
+        for (auto& entry : m_impl->origins) {
+            auto& idle = entry.second.idle;
+            if (static_cast<int>(idle.size()) > m_impl->maxIdlePerHost) {
+                surplus.insert(surplus.end(), idle.begin(), idle.end() - m_impl->maxIdlePerHost);
+            }
+        }
+        for (int socketId : surplus) {
+            m_impl->stats.evictedConnections++;
+            m_impl->destroy(socketId, m_activeSockets);
+        }
+    }
+    evictIdleConnections();
+}
+
+size_t SocketManager::evictIdleConnections() {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    Clock::time_point now = Clock::now();
+
+    std::vector<int> expired;
+    for (const auto& entry : m_impl->origins) {
+        for (int socketId : entry.second.idle) {
+            const auto& socket = m_impl->sockets[socketId];
+            if (now - socket.lastUsed > m_impl->idleTimeout || !SocketManagerImpl::isHealthy(socket.fd)) {
+                expired.push_back(socketId);
+            }
+        }
+    }
+
+    for (int socketId : expired) {
+        m_impl->destroy(socketId, m_activeSockets);
+    }
+    m_impl->stats.evictedConnections += expired.size();
+    return expired.size();
+}
+
+int SocketManager::getNativeHandle(int socket_id) const {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    auto it = m_impl->sockets.find(socket_id);
+    return it == m_impl->sockets.end() ? -1 : it->second.fd;
+}
+
+ConnectionPoolStats SocketManager::getPoolStats() const {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->stats;
+}
+
+std::shared_ptr<DnsCache> SocketManager::getDnsCache() const {
+    return m_impl->dnsCache;
+}
+
+std::shared_ptr<TlsContext> SocketManager::getTlsContext() const {
+    return m_impl->tlsContext;
+}
+
+TlsConnection* SocketManager::getTlsConnection(int socket_id) const {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    auto it = m_impl->sockets.find(socket_id);
+    return it == m_impl->sockets.end() ? nullptr : it->second.tls.get();
+}
+
+bool SocketManager::startCapture(const std::string& basePath, size_t fileCount, size_t maxFileBytes) {
+    auto capture = std::make_shared<PacketCapture>(basePath, fileCount, maxFileBytes);
+    if (!capture->isOpen()) {
+        return false;
+    }
+
+    std::shared_ptr<PacketCapture> previous;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        previous = std::move(m_impl->capture);
+        m_impl->capture = std::move(capture);
+        m_impl->capturing = true;
+    }
+
+    Utils::Logging::Logger::info("SocketManager: Capturando el tráfico en " + basePath + ".*.pcapng");
+    return true;
+}
+
+void SocketManager::stopCapture() {
+    // La captura se cierra fuera del mutex: escribe lo pendiente y espera al escritor
+    std::shared_ptr<PacketCapture> capture;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        capture = std::move(m_impl->capture);
+        m_impl->capturing = false;
+    }
+}
+
+void SocketManager::recordTraffic(int socket_id, bool outgoing, const uint8_t* data, size_t size) {
+    if (!m_impl->capturing.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // Se registra con el mutex tomado: si no, un destroy() intermedio cerraría
+    // el flujo y este registro lo volvería a abrir sin que nadie lo cerrase.
+    // record() solo copia los datos al buffer de la captura.
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    auto it = m_impl->sockets.find(socket_id);
+    if (!m_impl->capture || it == m_impl->sockets.end()) {
+        return;
+    }
+    m_impl->capture->record(socket_id, it->second.fd, outgoing, data, size);
+}
+
+PacketCaptureStats SocketManager::getCaptureStats() const {
+    std::shared_ptr<PacketCapture> capture;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        capture = m_impl->capture;
+    }
+    return capture ? capture->getStats() : PacketCaptureStats{};
+}
+
+bool SocketManager::resolveHost(const std::string& host, std::vector<ResolvedAddress>& addresses) {
+    switch (m_impl->dnsCache->lookup(host, addresses)) {
+        case DnsCache::Status::FOUND:
+            return true;
+        case DnsCache::Status::NOT_FOUND:
+            break;
+        case DnsCache::Status::MISS: {
+            // Sin entrada en la caché: consulta bloqueante con un resolvedor propio
+            DnsResolver resolver(m_impl->dnsCache);
+            if (resolver.resolveBlocking(host, addresses, BLOCKING_TIMEOUT_MS)) {
+                return true;
+            }
+            break;
+        }
+    }
+    Utils::Logging::Logger::error("SocketManager: No se pudo resolver " + host);
+    return false;
+}
+
+bool SocketManager::completeHandshake(int fd, TlsConnection& tls) {
+    while (true) {
+        switch (tls.handshake()) {
+            case TlsConnection::HandshakeStatus::COMPLETE:
+                return true;
+            case TlsConnection::HandshakeStatus::WANT_READ:
+                if (!waitFor(fd, POLLIN, BLOCKING_TIMEOUT_MS)) break;
+                continue;
+            case TlsConnection::HandshakeStatus::WANT_WRITE:
+                if (!waitFor(fd, POLLOUT, BLOCKING_TIMEOUT_MS)) break;
+                continue;
+            case TlsConnection::HandshakeStatus::FAILED:
+                return false;
+        }
+        Utils::Logging::Logger::error("SocketManager: Tiempo de negociación TLS agotado");
+        return false;
+    }
+}
+
+bool SocketManager::initializeSocketLibrary() {
+    // No cambia el tratamiento de SIGPIPE del proceso: los envíos usan
+    // MSG_NOSIGNAL, también los de TLS (ver TlsConnection)
+    return true;
+}
+
+void SocketManager::cleanupSocketLibrary() {
+}
+
+bool SocketManager::configureSocketOptions(int socket_id) {
+    // Se llama con el mutex tomado
+    auto it = m_impl->sockets.find(socket_id);
+    if (it == m_impl->sockets.end()) {
+        return false;
+    }
+
+    int one = 1;
+    bool ok = setsockopt(it->second.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)) == 0;
+    ok = setsockopt(it->second.fd, SOL_SOCKET, SO_KEEPALIVE, &one, sizeof(one)) == 0 && ok;
+    return ok;
+}
+
+} // namespace Core::Network
@@ -11,12 +11,47 @@
 #include <functional>
 #include <memory>
 #include <unordered_map>
+#include <cstdint>
+#include "PacketCapture.h"
 
 namespace Core::Network {
 
+class DnsCache;
+class TlsContext;
+class TlsConnection;
+struct ResolvedAddress;
+
+/**
+ * Estadísticas del pool de conexiones
+ */
+struct ConnectionPoolStats {
+    size_t activeConnections;    // Conexiones entregadas y aún no devueltas
+    size_t idleConnections;      // Conexiones abiertas a la espera de reutilizarse
+    size_t createdConnections;   // Conexiones abiertas desde el inicio
+    size_t reusedConnections;    // Veces que se entregó una conexión del pool
+    size_t evictedConnections;   // Conexiones del pool cerradas por inactividad o por fallar la comprobación
+};
+
 /**
  * Clase que gestiona las conexiones de socket de bajo nivel
  * Proporciona una interfaz para crear, gestionar y monitorizar sockets
+ *
+ * Mantiene además un pool de conexiones keep-alive por origen: las conexiones
+ * devueltas con releaseConnection() se reutilizan en el siguiente
+ * acquireConnection() al mismo origen en lugar de abrir una nueva.
+ * Todos los sockets son no bloqueantes. Es seguro usarla desde varios hilos.
+ *
+ * Los nombres se resuelven con la caché DNS de getDnsCache(); solo si no están
+ * en ella se consulta la red esperando la respuesta. HttpClient los resuelve
+ * antes de forma asíncrona para no bloquear su bucle de eventos.
+ *
+ * Las conexiones seguras comparten un TlsContext que guarda las sesiones TLS
+ * por origen, de modo que las conexiones siguientes reanudan la sesión en
+ * lugar de repetir la negociación completa.
+ *
+ * Con startCapture() los datos que pasan por las conexiones (los del pool y
+ * los de HttpClient, que los notifica con recordTraffic()) se graban además
+ * en ficheros pcapng para poder reproducir después lo que se envió.
  */
 class SocketManager {
 public:
@@ -72,12 +107,126 @@ public:
      */
     bool setProxy(const std::string& host, int port, const std::string& username = "", const std::string& password = "");
 
+    /**
+     * Obtiene una conexión al origen, del pool si hay una disponible
+     * Las conexiones nuevas se devuelven con la conexión TCP aún en curso; el
+     * llamante debe esperar a que el socket sea escribible antes de usarlo.
+     * No pasa por el proxy configurado con setProxy().
+     * En las conexiones seguras nuevas la negociación TLS queda pendiente: el
+     * llamante la completa con getTlsConnection()->handshake().
+     * @param host Host al que conectarse
+     * @param port Puerto al que conectarse
+     * @param secure true para conexión SSL/TLS, false para conexión sin cifrar
+     * @param reused true si la conexión ya estaba establecida (salida)
+     * @param protocol Protocolo de la conexión ("http/1.1", "h2" u "h2c"); cada protocolo tiene su
+     *                 propio pool. Con "h2" se ofrece también http/1.1 por ALPN.
+     * @param verifyPeer true para verificar el certificado del servidor; una conexión del pool
+     *                   establecida sin verificar no se entrega si se pide verificar
+     * @return ID del socket, o -1 en caso de error
+     */
+    int acquireConnection(const std::string& host, int port, bool secure, bool& reused,
+                          const std::string& protocol = "http/1.1", bool verifyPeer = true);
+
+    /**
+     * Devuelve una conexión obtenida con acquireConnection() o createTcpSocket()
+     * @param socket_id ID del socket
+     * @param reusable true si la conexión puede reutilizarse, false para cerrarla
+     */
+    void releaseConnection(int socket_id, bool reusable);
+
+    /**
+     * Comprueba si se puede obtener una conexión al origen sin superar el límite por host
+     * @param host Host del origen
+     * @param port Puerto del origen
+     * @param secure true para conexión SSL/TLS
+     * @return true si hay una conexión libre en el pool o no se ha alcanzado el límite
+     */
+    bool hasCapacity(const std::string& host, int port, bool secure) const;
+
+    /**
+     * Configura los límites del pool de conexiones
+     * @param maxIdlePerHost Conexiones inactivas que se conservan por origen
+     * @param maxPerHost Conexiones abiertas por origen, en uso o no, sumando todos los protocolos (0 = sin límite)
+     * @param idleTimeoutMs Tiempo tras el que se cierra una conexión inactiva
+     */
+    void setPoolLimits(int maxIdlePerHost, int maxPerHost, int idleTimeoutMs);
+
+    /**
+     * Cierra las conexiones del pool que llevan demasiado tiempo inactivas
+     * @return Número de conexiones cerradas
+     */
+    size_t evictIdleConnections();
+
+    /**
+     * Obtiene el descriptor del sistema de un socket, para registrarlo en un bucle de eventos
+     * @param socket_id ID del socket
+     * @return Descriptor del socket, o -1 si no existe
+     */
+    int getNativeHandle(int socket_id) const;
+
+    /**
+     * Obtiene las estadísticas del pool de conexiones
+     * @return Estadísticas actuales
+     */
+    ConnectionPoolStats getPoolStats() const;
+
+    /**
+     * Obtiene la caché DNS y la tabla de hosts usadas para conectar
+     * @return Caché DNS compartida
+     */
+    std::shared_ptr<DnsCache> getDnsCache() const;
+
+    /**
+     * Obtiene la configuración TLS y la caché de sesiones
+     * @return Contexto TLS compartido
+     */
+    std::shared_ptr<TlsContext> getTlsContext() const;
+
+    /**
+     * Obtiene el estado TLS de una conexión segura
+     * El puntero es válido hasta que se devuelve o se cierra la conexión.
+     * @param socket_id ID del socket
+     * @return Conexión TLS, o nullptr si el socket no existe o no es seguro
+     */
+    TlsConnection* getTlsConnection(int socket_id) const;
+
+    /**
+     * Empieza a grabar el tráfico de las conexiones en un anillo de ficheros pcapng
+     * Sustituye a la captura anterior, si la había.
+     * @param basePath Ruta base de los ficheros (<base>.0.pcapng, <base>.1.pcapng...)
+     * @param fileCount Número de ficheros del anillo
+     * @param maxFileBytes Tamaño de cada fichero
+     * @return true si se pudo abrir el primer fichero
+     */
+    bool startCapture(const std::string& basePath, size_t fileCount = 8, size_t maxFileBytes = 64 * 1024 * 1024);
+
+    /**
+     * Detiene la captura, escribiendo antes lo pendiente
+     */
+    void stopCapture();
+
+    /**
+     * Registra los datos enviados o recibidos por una conexión
+     * No hace nada si no hay una captura en marcha.
+     * @param socket_id ID del socket
+     * @param outgoing true para datos enviados, false para recibidos
+     * @param data Datos (en claro en las conexiones TLS)
+     * @param size Tamaño de los datos
+     */
+    void recordTraffic(int socket_id, bool outgoing, const uint8_t* data, size_t size);
+
+    /**
+     * Obtiene las estadísticas de la captura
+     * @return Estadísticas de la captura en marcha (a cero si no hay ninguna)
+     */
+    PacketCaptureStats getCaptureStats() const;
+
 private:
     // Implementación privada del gestor de sockets
     class SocketManagerImpl;
     std::unique_ptr<SocketManagerImpl> m_impl;
 
-    // Mapa de sockets activos
+    // Mapa de sockets abiertos: true si están en uso, false si esperan en el pool
     std::unordered_map<int, bool> m_activeSockets;
 
     // Configuración del proxy
@@ -96,6 +245,8 @@ private:
     bool initializeSocketLibrary();
     void cleanupSocketLibrary();
     bool configureSocketOptions(int socket_id);
+    bool resolveHost(const std::string& host, std::vector<ResolvedAddress>& addresses);
+    bool completeHandshake(int fd, TlsConnection& tls);
 };
 
 } // namespace Core::Network
\ No newline at end of file
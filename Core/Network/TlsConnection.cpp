@@ -0,0 +1,464 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación de las conexiones TLS sobre OpenSSL
+ */
+
+#include "TlsConnection.h"
+#include "../../Utils/Logging/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+namespace Core::Network {
+
+namespace {
+
+// Sesiones que se guardan por origen (cada conexión TLS 1.3 recibe dos tickets)
+constexpr size_t MAX_SESSIONS_PER_ORIGIN = 4;
+
+// Orígenes en la caché antes de descartar el usado hace más tiempo
+constexpr size_t MAX_CACHED_ORIGINS = 1024;
+
+bool isIpAddress(const std::string& host) {
+    uint8_t buffer[16];
+    return inet_pton(AF_INET, host.c_str(), buffer) == 1 || inet_pton(AF_INET6, host.c_str(), buffer) == 1;
+}
+
+/**
+ * Escritura del BIO de socket con MSG_NOSIGNAL
+ * El BIO de socket de OpenSSL usa write(), que envía SIGPIPE al proceso si el
+ * servidor ya cerró la conexión; así la escritura devuelve EPIPE sin cambiar
+ * cómo trata el proceso esa señal.
+ */
+int writeWithoutSignal(BIO* bio, const char* data, int size) {
+    int fd = -1;
+    BIO_get_fd(bio, &fd);
+    BIO_clear_retry_flags(bio);
+
+    int result = static_cast<int>(send(fd, data, static_cast<size_t>(size), MSG_NOSIGNAL));
+    if (result <= 0 && BIO_sock_should_retry(result)) {
+        BIO_set_retry_write(bio);
+    }
+    return result;
+}
+
+/**
+ * Método de BIO de socket que solo cambia la escritura
+ */
+BIO_METHOD* socketMethodWithoutSignal() {
+    static BIO_METHOD* method = []() {
+        const BIO_METHOD* socketMethod = BIO_s_socket();
+        BIO_METHOD* created = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK | BIO_TYPE_DESCRIPTOR,
+                                           "socket sin SIGPIPE");
+        if (created) {
+            BIO_meth_set_write(created, writeWithoutSignal);
+            BIO_meth_set_read(created, BIO_meth_get_read(socketMethod));
+            BIO_meth_set_puts(created, BIO_meth_get_puts(socketMethod));
+            BIO_meth_set_ctrl(created, BIO_meth_get_ctrl(socketMethod));
+            BIO_meth_set_create(created, BIO_meth_get_create(socketMethod));
+            BIO_meth_set_destroy(created, BIO_meth_get_destroy(socketMethod));
+        }
+        return created;
+    }();
+    return method;
+}
+
+bool isExpired(const SSL_SESSION* session) {
+    return SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session) <= std::time(nullptr);
+}
+
+/**
+ * Describe el último error de OpenSSL o de la verificación del certificado
+ */
+std::string describeError(SSL* ssl) {
+    long verifyResult = SSL_get_verify_result(ssl);
+    if (verifyResult != X509_V_OK) {
+        return X509_verify_cert_error_string(verifyResult);
+    }
+    unsigned long error = ERR_peek_last_error();
+    const char* reason = error ? ERR_reason_error_string(error) : nullptr;
+    return reason ? reason : "conexión cerrada por el servidor";
+}
+
+} // namespace
+
+TlsContext::TlsContext() :
+    m_context(SSL_CTX_new(TLS_client_method())),
+    m_verifyPeer(true),
+    m_sessionCache(true),
+    m_stats{},
+    m_fullHandshakeTime(0),
+    m_resumedHandshakeTime(0) {
+    if (!m_context) {
+        Utils::Logging::Logger::error("TlsContext: No se pudo crear el contexto TLS");
+        return;
+    }
+
+    SSL_CTX_set_default_verify_paths(m_context);
+    SSL_CTX_set_mode(m_context, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER |
+                                SSL_MODE_RELEASE_BUFFERS);
+#ifdef SSL_OP_IGNORE_UNEXPECTED_EOF
+    // Muchos servidores cierran sin close_notify; se trata como un cierre normal
+    SSL_CTX_set_options(m_context, SSL_OP_IGNORE_UNEXPECTED_EOF);
+#endif
+
+    // Las sesiones se guardan en m_sessions, por origen, no en la caché interna
+    SSL_CTX_set_session_cache_mode(m_context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(m_context, &TlsContext::onNewSession);
+}
+
+TlsContext::~TlsContext() {
+    clearSessionCache();
+    if (m_context) {
+        SSL_CTX_free(m_context);
+    }
+}
+
+void TlsContext::setVerifyPeer(bool verify) {
+    m_verifyPeer = verify;
+}
+
+bool TlsContext::loadCaFile(const std::string& path) {
+    if (!m_context || SSL_CTX_load_verify_locations(m_context, path.c_str(), nullptr) != 1) {
+        ERR_clear_error();
+        Utils::Logging::Logger::error("TlsContext: No se pudieron cargar los certificados de " + path);
+        return false;
+    }
+    return true;
+}
+
+void TlsContext::setSessionCacheEnabled(bool enable) {
+    m_sessionCache = enable;
+    if (!enable) {
+        clearSessionCache();
+    }
+}
+
+void TlsContext::clearSessionCache() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_sessions) {
+        for (SSL_SESSION* session : entry.second.sessions) {
+            SSL_SESSION_free(session);
+        }
+    }
+    m_sessions.clear();
+}
+
+TlsStats TlsContext::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    TlsStats stats = m_stats;
+    if (stats.fullHandshakes > 0) {
+        stats.averageFullHandshakeMs = m_fullHandshakeTime.count() / 1000.0 / stats.fullHandshakes;
+    }
+    if (stats.resumedHandshakes > 0) {
+        stats.averageResumedHandshakeMs = m_resumedHandshakeTime.count() / 1000.0 / stats.resumedHandshakes;
+    }
+    stats.cachedSessions = 0;
+    for (const auto& entry : m_sessions) {
+        stats.cachedSessions += entry.second.sessions.size();
+    }
+    return stats;
+}
+
+SSL_SESSION* TlsContext::takeSession(const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_sessions.find(key);
+    if (it == m_sessions.end()) {
+        return nullptr;
+    }
+
+    SSL_SESSION* session = nullptr;
+    auto& sessions = it->second.sessions;
+    while (!sessions.empty() && !session) {
+        SSL_SESSION* candidate = sessions.back();
+        if (isExpired(candidate) || !SSL_SESSION_is_resumable(candidate)) {
+            SSL_SESSION_free(candidate);
+            sessions.pop_back();
+            continue;
+        }
+
+        // Los tickets de TLS 1.3 son de un solo uso; las sesiones de TLS 1.2 se comparten
+        if (SSL_SESSION_get_protocol_version(candidate) >= TLS1_3_VERSION) {
+            sessions.pop_back();
+        } else {
+            SSL_SESSION_up_ref(candidate);
+        }
+        session = candidate;
+    }
+
+    it->second.lastUsed = Clock::now();
+    if (sessions.empty()) {
+        m_sessions.erase(it);
+    }
+    return session;
+}
+
+void TlsContext::storeSession(const std::string& key, SSL_SESSION* session) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CachedSessions& entry = m_sessions[key];
+    entry.sessions.push_back(session);
+    entry.lastUsed = Clock::now();
+    if (entry.sessions.size() > MAX_SESSIONS_PER_ORIGIN) {
+        SSL_SESSION_free(entry.sessions.front());
+        entry.sessions.pop_front();
+    }
+
+    if (m_sessions.size() > MAX_CACHED_ORIGINS) {
+        auto oldest = std::min_element(m_sessions.begin(), m_sessions.end(), [](const auto& a, const auto& b) {
+            return a.second.lastUsed < b.second.lastUsed;
+        });
+        for (SSL_SESSION* cached : oldest->second.sessions) {
+            SSL_SESSION_free(cached);
+        }
+        m_sessions.erase(oldest);
+    }
+}
+
+void TlsContext::recordHandshake(bool resumed, std::chrono::microseconds duration, int earlyDataStatus) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (resumed) {
+        m_stats.resumedHandshakes++;
+        m_resumedHandshakeTime += duration;
+    } else {
+        m_stats.fullHandshakes++;
+        m_fullHandshakeTime += duration;
+    }
+    if (earlyDataStatus == SSL_EARLY_DATA_ACCEPTED) {
+        m_stats.earlyDataAccepted++;
+    } else if (earlyDataStatus == SSL_EARLY_DATA_REJECTED) {
+        m_stats.earlyDataRejected++;
+    }
+}
+
+void TlsContext::recordFailure() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.failedHandshakes++;
+}
+
+int TlsContext::onNewSession(SSL* ssl, SSL_SESSION* session) {
+    // Se invoca al terminar la negociación (TLS 1.2) o al recibir un ticket (TLS 1.3)
+    TlsConnection* connection = static_cast<TlsConnection*>(SSL_get_app_data(ssl));
+    if (!connection || !connection->m_context->m_sessionCache || !SSL_SESSION_is_resumable(session)) {
+        return 0;
+    }
+    connection->m_context->storeSession(connection->m_sessionKey, session);
+    return 1; // La caché se queda con la referencia
+}
+
+TlsConnection::TlsConnection(std::shared_ptr<TlsContext> context, int fd, const std::string& host, int port,
+                             const std::vector<std::string>& alpn, bool verifyPeer) :
+    m_context(std::move(context)),
+    m_ssl(nullptr),
+    m_host(host),
+    m_verified(verifyPeer),
+    m_complete(false),
+    m_failed(false),
+    m_started(false),
+    m_handshaking(false),
+    m_earlyData(false),
+    m_earlyDataRejected(false),
+    m_earlyDataBudget(0) {
+    if (!m_context->m_context || !(m_ssl = SSL_new(m_context->m_context))) {
+        Utils::Logging::Logger::error("TlsConnection: No se pudo crear la conexión TLS con " + host);
+        return;
+    }
+
+    SSL_set_app_data(m_ssl, this);
+    BIO* bio = socketMethodWithoutSignal() ? BIO_new(socketMethodWithoutSignal()) : nullptr;
+    if (bio) {
+        BIO_set_fd(bio, fd, BIO_NOCLOSE);
+        SSL_set_bio(m_ssl, bio, bio);
+    } else {
+        SSL_set_fd(m_ssl, fd);
+    }
+    SSL_set_connect_state(m_ssl);
+
+    SSL_set_verify(m_ssl, m_verified ? SSL_VERIFY_PEER : SSL_VERIFY_NONE, nullptr);
+    if (isIpAddress(host)) {
+        // Sin SNI: el certificado debe incluir la IP
+        X509_VERIFY_PARAM_set1_ip_asc(SSL_get0_param(m_ssl), host.c_str());
+    } else {
+        SSL_set_tlsext_host_name(m_ssl, host.c_str());
+        SSL_set1_host(m_ssl, host.c_str());
+    }
+
+    // Lista ALPN en formato de red: longitud y nombre de cada protocolo
+    std::vector<uint8_t> protocols;
+    std::string offered;
+    for (const std::string& protocol : alpn) {
+        protocols.push_back(static_cast<uint8_t>(protocol.size()));
+        protocols.insert(protocols.end(), protocol.begin(), protocol.end());
+        offered += "," + protocol;
+    }
+    if (!protocols.empty()) {
+        SSL_set_alpn_protos(m_ssl, protocols.data(), static_cast<unsigned int>(protocols.size()));
+    }
+
+    // Los datos 0-RTT exigen ofrecer los mismos protocolos que en la sesión original,
+    // y una sesión sin verificar no debe reanudarse en una conexión que verifica
+    m_sessionKey = host + ":" + std::to_string(port) + offered + (m_verified ? "" : "#sin-verificar");
+    if (m_context->m_sessionCache) {
+        SSL_SESSION* session = m_context->takeSession(m_sessionKey);
+        if (session) {
+            SSL_set_session(m_ssl, session);
+            SSL_SESSION_free(session);
+        }
+    }
+}
+
+TlsConnection::~TlsConnection() {
+    if (!m_ssl) {
+        return;
+    }
+    if (m_complete && !m_failed) {
+        // Un solo intento, sin esperar al close_notify del servidor
+        SSL_shutdown(m_ssl);
+    }
+    SSL_free(m_ssl);
+    ERR_clear_error();
+}
+
+bool TlsConnection::enableEarlyData() {
+    SSL_SESSION* session = m_ssl && !m_started ? SSL_get_session(m_ssl) : nullptr;
+    if (!session || SSL_SESSION_get_max_early_data(session) == 0) {
+        return false;
+    }
+    m_earlyData = true;
+    m_earlyDataBudget = SSL_SESSION_get_max_early_data(session);
+    return true;
+}
+
+TlsConnection::HandshakeStatus TlsConnection::handshake() {
+    if (!m_ssl || m_failed) {
+        return HandshakeStatus::FAILED;
+    }
+    if (m_complete) {
+        return HandshakeStatus::COMPLETE;
+    }
+    begin();
+    m_handshaking = true;
+
+    ERR_clear_error();
+    int result = SSL_do_handshake(m_ssl);
+    if (result == 1) {
+        m_complete = true;
+        int earlyDataStatus = m_earlyData ? SSL_get_early_data_status(m_ssl) : SSL_EARLY_DATA_NOT_SENT;
+        m_earlyDataRejected = earlyDataStatus == SSL_EARLY_DATA_REJECTED;
+        m_context->recordHandshake(isResumed(), std::chrono::duration_cast<std::chrono::microseconds>(
+                                       std::chrono::steady_clock::now() - m_startTime), earlyDataStatus);
+        return HandshakeStatus::COMPLETE;
+    }
+
+    switch (SSL_get_error(m_ssl, result)) {
+        case SSL_ERROR_WANT_READ:
+            return HandshakeStatus::WANT_READ;
+        case SSL_ERROR_WANT_WRITE:
+            return HandshakeStatus::WANT_WRITE;
+        default:
+            break;
+    }
+
+    m_failed = true;
+    m_context->recordFailure();
+    Utils::Logging::Logger::error("TlsConnection: Falló la negociación TLS con " + m_host + ": " + describeError(m_ssl));
+    ERR_clear_error();
+    return HandshakeStatus::FAILED;
+}
+
+ssize_t TlsConnection::read(uint8_t* buffer, size_t size) {
+    if (!m_ssl || m_failed) {
+        errno = EIO;
+        return -1;
+    }
+
+    ERR_clear_error();
+    int result = SSL_read(m_ssl, buffer, static_cast<int>(std::min<size_t>(size, INT_MAX)));
+    if (result > 0) {
+        return result;
+    }
+    if (SSL_get_error(m_ssl, result) == SSL_ERROR_ZERO_RETURN) {
+        return 0;
+    }
+    return failure(result);
+}
+
+ssize_t TlsConnection::write(const uint8_t* data, size_t size) {
+    if (!m_ssl || m_failed) {
+        errno = EIO;
+        return -1;
+    }
+
+    ERR_clear_error();
+    if (!m_complete) {
+        // Antes de terminar la negociación solo se admiten datos 0-RTT
+        if (!m_earlyData || m_handshaking || m_earlyDataBudget == 0) {
+            errno = EAGAIN;
+            return -1;
+        }
+        begin();
+        size_t written = 0;
+        int result = SSL_write_early_data(m_ssl, data, std::min(size, m_earlyDataBudget), &written);
+        if (result == 1) {
+            m_earlyDataBudget -= written;
+            return static_cast<ssize_t>(written);
+        }
+        return failure(result);
+    }
+
+    int result = SSL_write(m_ssl, data, static_cast<int>(std::min<size_t>(size, INT_MAX)));
+    if (result > 0) {
+        return result;
+    }
+    return failure(result);
+}
+
+bool TlsConnection::isResumed() const {
+    return m_ssl && SSL_session_reused(m_ssl) == 1;
+}
+
+std::string TlsConnection::getAlpnProtocol() const {
+    const unsigned char* protocol = nullptr;
+    unsigned int length = 0;
+    if (m_ssl) {
+        SSL_get0_alpn_selected(m_ssl, &protocol, &length);
+    }
+    return protocol ? std::string(reinterpret_cast<const char*>(protocol), length) : std::string();
+}
+
+void TlsConnection::begin() {
+    if (!m_started) {
+        m_started = true;
+        m_startTime = std::chrono::steady_clock::now();
+    }
+}
+
+ssize_t TlsConnection::failure(int result) {
+    switch (SSL_get_error(m_ssl, result)) {
+        case SSL_ERROR_WANT_READ:
+        case SSL_ERROR_WANT_WRITE:
+            errno = EAGAIN;
+            return -1;
+        case SSL_ERROR_SYSCALL:
+            // errno conserva el error del socket (ECONNRESET, EPIPE...)
+            if (errno == 0 || errno == EAGAIN) {
+                errno = EIO;
+            }
+            break;
+        default:
+            errno = EIO;
+            break;
+    }
+    m_failed = true;
+    ERR_clear_error();
+    return -1;
+}
+
+} // namespace Core::Network
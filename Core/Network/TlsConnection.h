@@ -0,0 +1,245 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Conexiones TLS no bloqueantes con reanudación de sesiones
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <cstdint>
+#include <sys/types.h>
+
+// Tipos de OpenSSL; se declaran aquí para no incluir sus cabeceras
+typedef struct ssl_ctx_st SSL_CTX;
+typedef struct ssl_st SSL;
+typedef struct ssl_session_st SSL_SESSION;
+
+namespace Core::Network {
+
+/**
+ * Estadísticas de las negociaciones TLS
+ */
+struct TlsStats {
+    size_t fullHandshakes;            // Negociaciones completas
+    size_t resumedHandshakes;         // Negociaciones que reanudaron una sesión
+    size_t failedHandshakes;          // Negociaciones fallidas (certificado, protocolo, conexión)
+    size_t earlyDataAccepted;         // Conexiones cuyos datos 0-RTT aceptó el servidor
+    size_t earlyDataRejected;         // Conexiones cuyos datos 0-RTT hubo que repetir
+    double averageFullHandshakeMs;    // Duración media de una negociación completa
+    double averageResumedHandshakeMs; // Duración media de una negociación reanudada
+    size_t cachedSessions;            // Sesiones guardadas para reanudar
+};
+
+/**
+ * Configuración TLS compartida y caché de sesiones por origen
+ * Guarda los tickets y IDs de sesión que envían los servidores para reanudar
+ * las siguientes conexiones al mismo origen sin una negociación completa. Los
+ * tickets de TLS 1.3 se usan una sola vez. Es segura para usarla desde varios hilos.
+ */
+class TlsContext {
+public:
+    /**
+     * Constructor
+     * Usa los certificados raíz del sistema y verifica los certificados de los servidores.
+     */
+    TlsContext();
+
+    /**
+     * Destructor
+     */
+    ~TlsContext();
+
+    TlsContext(const TlsContext&) = delete;
+    TlsContext& operator=(const TlsContext&) = delete;
+
+    /**
+     * Habilita o deshabilita la verificación de los certificados de los servidores
+     * Es el valor por defecto de las conexiones abiertas con SocketManager::createTcpSocket();
+     * HttpClient lo decide por conexión con setVerifySsl().
+     * Las sesiones y conexiones establecidas sin verificar no se reutilizan al verificar.
+     * @param verify true para verificar el certificado y el nombre del host
+     */
+    void setVerifyPeer(bool verify);
+
+    /**
+     * Indica si se verifican los certificados de los servidores
+     * @return true si se verifican
+     */
+    bool getVerifyPeer() const { return m_verifyPeer; }
+
+    /**
+     * Añade certificados de confianza, por ejemplo el de un servidor de pruebas autofirmado
+     * Debe llamarse antes de abrir conexiones.
+     * @param path Fichero PEM con uno o varios certificados
+     * @return true si se cargaron los certificados
+     */
+    bool loadCaFile(const std::string& path);
+
+    /**
+     * Habilita o deshabilita la reanudación de sesiones
+     * @param enable true para guardar y reutilizar las sesiones
+     */
+    void setSessionCacheEnabled(bool enable);
+
+    /**
+     * Descarta todas las sesiones guardadas
+     */
+    void clearSessionCache();
+
+    /**
+     * Obtiene las estadísticas de las negociaciones
+     * @return Estadísticas actuales
+     */
+    TlsStats getStats() const;
+
+private:
+    friend class TlsConnection;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct CachedSessions {
+        std::deque<SSL_SESSION*> sessions;   // La más reciente al final
+        Clock::time_point lastUsed;
+    };
+
+    SSL_SESSION* takeSession(const std::string& key);
+    void storeSession(const std::string& key, SSL_SESSION* session);
+    void recordHandshake(bool resumed, std::chrono::microseconds duration, int earlyDataStatus);
+    void recordFailure();
+    static int onNewSession(SSL* ssl, SSL_SESSION* session);
+
+    SSL_CTX* m_context;
+    std::atomic<bool> m_verifyPeer;
+    std::atomic<bool> m_sessionCache;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, CachedSessions> m_sessions;
+    TlsStats m_stats;
+    std::chrono::microseconds m_fullHandshakeTime;
+    std::chrono::microseconds m_resumedHandshakeTime;
+};
+
+/**
+ * Conexión TLS de cliente sobre un socket no bloqueante
+ * read() y write() siguen la semántica de recv() y send(): devuelven -1 con
+ * errno a EAGAIN cuando hay que esperar al socket. Si la sesión reanudada lo
+ * admite, se pueden enviar datos 0-RTT antes de terminar la negociación.
+ */
+class TlsConnection {
+public:
+    enum class HandshakeStatus {
+        COMPLETE,
+        WANT_READ,    // Esperar a que el socket sea legible
+        WANT_WRITE,   // Esperar a que el socket sea escribible
+        FAILED
+    };
+
+    /**
+     * Constructor
+     * @param context Configuración y caché de sesiones
+     * @param fd Socket TCP ya conectado o con la conexión en curso
+     * @param host Nombre del servidor (SNI y verificación del certificado)
+     * @param port Puerto del servidor
+     * @param alpn Protocolos que se ofrecen por ALPN, por orden de preferencia
+     * @param verifyPeer true para verificar el certificado y el nombre del host
+     */
+    TlsConnection(std::shared_ptr<TlsContext> context, int fd, const std::string& host, int port,
+                  const std::vector<std::string>& alpn, bool verifyPeer);
+
+    /**
+     * Destructor
+     * Envía close_notify si la negociación terminó; no cierra el socket.
+     */
+    ~TlsConnection();
+
+    TlsConnection(const TlsConnection&) = delete;
+    TlsConnection& operator=(const TlsConnection&) = delete;
+
+    /**
+     * Permite enviar datos 0-RTT con write() antes de terminar la negociación
+     * Solo deben enviarse así solicitudes idempotentes: el servidor puede
+     * recibirlas repetidas o rechazarlas (ver wasEarlyDataRejected()).
+     * @return true si hay una sesión reanudable que admite datos 0-RTT
+     */
+    bool enableEarlyData();
+
+    /**
+     * Avanza la negociación
+     * @return Estado de la negociación
+     */
+    HandshakeStatus handshake();
+
+    /**
+     * Lee datos descifrados
+     * @return Bytes leídos, 0 si el servidor cerró la conexión, o -1 en caso de error
+     */
+    ssize_t read(uint8_t* buffer, size_t size);
+
+    /**
+     * Cifra y envía datos
+     * Antes de terminar la negociación solo acepta datos 0-RTT.
+     * @return Bytes aceptados, o -1 en caso de error
+     */
+    ssize_t write(const uint8_t* data, size_t size);
+
+    /**
+     * Indica si la negociación ha terminado
+     * @return true si la conexión está lista para enviar datos
+     */
+    bool isHandshakeComplete() const { return m_complete; }
+
+    /**
+     * Indica si la negociación reanudó una sesión anterior
+     * @return true si fue una negociación abreviada
+     */
+    bool isResumed() const;
+
+    /**
+     * Indica si el servidor rechazó los datos 0-RTT
+     * Los datos enviados con write() antes de la negociación no llegaron y hay que repetirlos.
+     * @return true si se enviaron datos 0-RTT y fueron rechazados
+     */
+    bool wasEarlyDataRejected() const { return m_earlyDataRejected; }
+
+    /**
+     * Indica si la conexión verificó el certificado del servidor
+     * @return true si se verificó
+     */
+    bool isVerified() const { return m_verified; }
+
+    /**
+     * Obtiene el protocolo negociado por ALPN
+     * @return Protocolo ("h2", "http/1.1"), o vacío si el servidor no usa ALPN
+     */
+    std::string getAlpnProtocol() const;
+
+private:
+    void begin();
+    ssize_t failure(int result);
+
+    std::shared_ptr<TlsContext> m_context;
+    SSL* m_ssl;
+    std::string m_host;
+    std::string m_sessionKey;          // Clave de la caché de sesiones
+    bool m_verified;
+    bool m_complete;
+    bool m_failed;                     // Error fatal: no se puede enviar close_notify
+    bool m_started;                    // La negociación ha empezado
+    bool m_handshaking;                // Se llamó a handshake(): ya no se admiten datos 0-RTT
+    bool m_earlyData;
+    bool m_earlyDataRejected;
+    size_t m_earlyDataBudget;          // Bytes 0-RTT que admite aún la sesión
+    std::chrono::steady_clock::time_point m_startTime;
+
+    friend class TlsContext;
+};
+
+} // namespace Core::Network
@@ -0,0 +1,459 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación del analizador de tráfico de red
+ */
+
+#include "TrafficAnalyzer.h"
+#include "SignatureMatcher.h"
+#include "../../Utils/Logging/Logger.h"
+#include "../../Utils/Text/StringUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+namespace Core::Network {
+
+namespace {
+
+using Utils::Text::equalsIgnoreCase;
+using Utils::Text::findHeader;
+
+bool containsIgnoreCase(std::string_view text, std::string_view needle) {
+    return std::search(text.begin(), text.end(), needle.begin(), needle.end(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+           }) != text.end();
+}
+
+/**
+ * Decodifica el formato application/x-www-form-urlencoded
+ * @param text Texto codificado
+ * @return Texto decodificado
+ */
+std::string urlDecode(std::string_view text) {
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] == '+') {
+            result += ' ';
+        } else if (text[i] == '%' && i + 2 < text.size() &&
+                   std::isxdigit(static_cast<unsigned char>(text[i + 1])) &&
+                   std::isxdigit(static_cast<unsigned char>(text[i + 2]))) {
+            result += static_cast<char>(std::stoi(std::string(text.substr(i + 1, 2)), nullptr, 16));
+            i += 2;
+        } else {
+            result += text[i];
+        }
+    }
+    return result;
+}
+
+/**
+ * Obtiene los parámetros de la query de una URL, ya decodificados
+ * @param url URL de la solicitud
+ * @return Pares nombre-valor
+ */
+std::vector<std::pair<std::string, std::string>> queryParameters(const std::string& url) {
+    std::vector<std::pair<std::string, std::string>> parameters;
+    size_t start = url.find('?');
+    if (start == std::string::npos) {
+        return parameters;
+    }
+
+    size_t end = url.find('#', start);
+    std::string_view query = std::string_view(url).substr(start + 1, end == std::string::npos ? end : end - start - 1);
+    while (!query.empty()) {
+        size_t amp = query.find('&');
+        std::string_view pair = query.substr(0, amp);
+        query = amp == std::string_view::npos ? std::string_view() : query.substr(amp + 1);
+
+        size_t equals = pair.find('=');
+        parameters.emplace_back(urlDecode(pair.substr(0, equals)),
+                                equals == std::string_view::npos ? "" : urlDecode(pair.substr(equals + 1)));
+    }
+    return parameters;
+}
+
+enum class SignatureKind {
+    XSS_PAYLOAD,
+    SQL_PAYLOAD,
+    SQL_ERROR,
+    POST_FORM,
+    CSRF_TOKEN
+};
+
+struct Signature {
+    const char* text;
+    SignatureKind kind;
+};
+
+// Firmas buscadas en los cuerpos y parámetros (sin distinguir mayúsculas)
+const Signature SIGNATURES[] = {
+    // Fragmentos típicos de los payloads XSS
+    {"<script", SignatureKind::XSS_PAYLOAD},
+    {"javascript:", SignatureKind::XSS_PAYLOAD},
+    {"onerror=", SignatureKind::XSS_PAYLOAD},
+    {"onload=", SignatureKind::XSS_PAYLOAD},
+    {"<svg", SignatureKind::XSS_PAYLOAD},
+    {"<iframe", SignatureKind::XSS_PAYLOAD},
+
+    // Fragmentos típicos de los payloads de inyección SQL
+    {"' or '1'='1", SignatureKind::SQL_PAYLOAD},
+    {"' or 1=1", SignatureKind::SQL_PAYLOAD},
+    {"union select", SignatureKind::SQL_PAYLOAD},
+    {"' and sleep(", SignatureKind::SQL_PAYLOAD},
+    {"waitfor delay", SignatureKind::SQL_PAYLOAD},
+    {"'--", SignatureKind::SQL_PAYLOAD},
+
+    // Mensajes de error de los motores de base de datos
+    {"You have an error in your SQL syntax", SignatureKind::SQL_ERROR},   // MySQL
+    {"Warning: mysql_", SignatureKind::SQL_ERROR},                        // PHP + MySQL
+    {"Unclosed quotation mark", SignatureKind::SQL_ERROR},                // MSSQL
+    {"Microsoft OLE DB Provider for SQL Server", SignatureKind::SQL_ERROR},
+    {"ORA-01756", SignatureKind::SQL_ERROR},                              // Oracle
+    {"ORA-00933", SignatureKind::SQL_ERROR},
+    {"PG::SyntaxError", SignatureKind::SQL_ERROR},                        // PostgreSQL
+    {"ERROR:  syntax error at or near", SignatureKind::SQL_ERROR},
+    {"SQLSTATE[", SignatureKind::SQL_ERROR},                              // PDO
+    {"SQLite3::", SignatureKind::SQL_ERROR},                              // SQLite
+    {"sqlite3.OperationalError", SignatureKind::SQL_ERROR},
+
+    // Formularios que cambian estado y los tokens que los protegen
+    {"method=\"post\"", SignatureKind::POST_FORM},
+    {"method='post'", SignatureKind::POST_FORM},
+    {"method=post", SignatureKind::POST_FORM},
+    {"csrf", SignatureKind::CSRF_TOKEN},                                  // csrf_token, _csrf, csrfmiddlewaretoken...
+    {"xsrf", SignatureKind::CSRF_TOKEN},
+    {"authenticity_token", SignatureKind::CSRF_TOKEN},                    // Rails
+    {"__RequestVerificationToken", SignatureKind::CSRF_TOKEN}             // ASP.NET
+};
+
+/**
+ * Obtiene el autómata con todas las firmas, construido la primera vez
+ * @return Autómata compartido por todos los analizadores
+ */
+const SignatureMatcher& signatureMatcher() {
+    static const SignatureMatcher matcher([] {
+        std::vector<std::string> patterns;
+        for (const Signature& signature : SIGNATURES) {
+            patterns.emplace_back(signature.text);
+        }
+        return patterns;
+    }());
+    return matcher;
+}
+
+} // namespace
+
+/**
+ * Lectura de la cadena vigente mientras dura un mensaje
+ * Registra al lector antes de cargar la cadena: una cadena sustituida solo se
+ * libera cuando el contador llega a cero después de sustituirla, ya lo vea el
+ * publicador o el último lector en salir.
+ */
+class TrafficAnalyzer::ChainReader {
+public:
+    explicit ChainReader(const TrafficAnalyzer& analyzer) : m_analyzer(analyzer) {
+        m_analyzer.m_activeReaders.fetch_add(1);
+        m_chain = m_analyzer.m_chain.load();
+    }
+
+    ~ChainReader() {
+        if (m_analyzer.m_activeReaders.fetch_sub(1) == 1 && m_analyzer.m_hasRetired.load()) {
+            m_analyzer.reclaimRetired();
+        }
+    }
+
+    ChainReader(const ChainReader&) = delete;
+    ChainReader& operator=(const ChainReader&) = delete;
+
+    const InterceptorChain& chain() const { return *m_chain; }
+
+private:
+    const TrafficAnalyzer& m_analyzer;
+    const InterceptorChain* m_chain;
+};
+
+TrafficAnalyzer::TrafficAnalyzer()
+    : m_interceptionEnabled(false)
+    , m_vulnerabilityScanningEnabled(false)
+    , m_chain(nullptr)
+    , m_activeReaders(0)
+    , m_hasRetired(false)
+    , m_published(std::make_unique<const InterceptorChain>())
+    , m_nextInterceptorId(1)
+{
+    m_chain = m_published.get();
+}
+
+TrafficAnalyzer::~TrafficAnalyzer() {
+}
+
+bool TrafficAnalyzer::enableInterception(bool enable) {
+    m_interceptionEnabled = enable;
+    Utils::Logging::Logger::info(std::string("TrafficAnalyzer: Interceptación ") + (enable ? "activada" : "desactivada"));
+    return true;
+}
+
+bool TrafficAnalyzer::enableVulnerabilityScanning(bool enable) {
+    m_vulnerabilityScanningEnabled = enable;
+    Utils::Logging::Logger::info(std::string("TrafficAnalyzer: Análisis de vulnerabilidades ") +
+                                 (enable ? "activado" : "desactivado"));
+    return true;
+}
+
+int TrafficAnalyzer::registerRequestInterceptor(RequestInterceptor callback) {
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    auto chain = std::make_unique<InterceptorChain>(*m_published);
+    int id = m_nextInterceptorId++;
+    chain->requestInterceptors.emplace_back(id, std::move(callback));
+    publish(std::move(chain));
+    return id;
+}
+
+int TrafficAnalyzer::registerResponseInterceptor(ResponseInterceptor callback) {
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    auto chain = std::make_unique<InterceptorChain>(*m_published);
+    int id = m_nextInterceptorId++;
+    chain->responseInterceptors.emplace_back(id, std::move(callback));
+    publish(std::move(chain));
+    return id;
+}
+
+bool TrafficAnalyzer::removeInterceptor(int interceptor_id) {
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    auto chain = std::make_unique<InterceptorChain>(*m_published);
+    auto matches = [interceptor_id](const auto& entry) { return entry.first == interceptor_id; };
+
+    size_t before = chain->requestInterceptors.size() + chain->responseInterceptors.size();
+    std::erase_if(chain->requestInterceptors, matches);
+    std::erase_if(chain->responseInterceptors, matches);
+    if (chain->requestInterceptors.size() + chain->responseInterceptors.size() == before) {
+        return false;
+    }
+
+    publish(std::move(chain));
+    return true;
+}
+
+bool TrafficAnalyzer::interceptRequest(std::string& url, std::string& method,
+                                       std::vector<std::pair<std::string, std::string>>& headers, ByteBuffer& body) {
+    if (!m_interceptionEnabled) {
+        return false;
+    }
+
+    ChainReader reader(*this);
+    for (const auto& entry : reader.chain().requestInterceptors) {
+        entry.second(url, method, headers, body);
+    }
+    return !reader.chain().requestInterceptors.empty();
+}
+
+bool TrafficAnalyzer::interceptResponse(int& status_code, std::vector<std::pair<std::string, std::string>>& headers,
+                                        ByteBuffer& body) {
+    if (!m_interceptionEnabled) {
+        return false;
+    }
+
+    ChainReader reader(*this);
+    for (const auto& entry : reader.chain().responseInterceptors) {
+        entry.second(status_code, headers, body);
+    }
+    return !reader.chain().responseInterceptors.empty();
+}
+
+bool TrafficAnalyzer::hasActiveInterceptors() const {
+    if (!m_interceptionEnabled) {
+        return false;
+    }
+
+    ChainReader reader(*this);
+    return !reader.chain().requestInterceptors.empty() || !reader.chain().responseInterceptors.empty();
+}
+
+std::vector<std::string> TrafficAnalyzer::analyzeRequest(const std::string& url, const std::string& method,
+                                                         const std::vector<std::pair<std::string, std::string>>& headers,
+                                                         const ByteBuffer& body) {
+    std::vector<std::string> vulnerabilities;
+    if (!m_vulnerabilityScanningEnabled) {
+        return vulnerabilities;
+    }
+
+    (void)method;
+    (void)headers;
+    ParameterHits parameters;
+    for (auto& parameter : queryParameters(url)) {
+        SignatureHits hits = scanSignatures(ByteBuffer(std::move(parameter.second)));
+        parameters.emplace_back(std::move(parameter.first), hits);
+    }
+
+    SignatureHits bodyHits = scanSignatures(body);
+    detectXssVulnerabilities(parameters, bodyHits, vulnerabilities);
+    detectSqlInjectionVulnerabilities(parameters, bodyHits, vulnerabilities);
+    return vulnerabilities;
+}
+
+std::vector<std::string> TrafficAnalyzer::analyzeResponse(int status_code,
+                                                          const std::vector<std::pair<std::string, std::string>>& headers,
+                                                          const ByteBuffer& body) {
+    std::vector<std::string> vulnerabilities;
+    if (!m_vulnerabilityScanningEnabled) {
+        return vulnerabilities;
+    }
+
+    (void)status_code;
+    SignatureHits bodyHits = scanSignatures(body);
+    detectSqlInjectionVulnerabilities({}, bodyHits, vulnerabilities);
+    detectCsrfVulnerabilities(headers, bodyHits, vulnerabilities);
+    detectInsecureHeaders(headers, vulnerabilities);
+    return vulnerabilities;
+}
+
+TrafficAnalyzer::SignatureHits TrafficAnalyzer::scanSignatures(const ByteBuffer& data) {
+    SignatureHits hits;
+    signatureMatcher().scan(data, [&hits](size_t pattern, size_t) {
+        const Signature& signature = SIGNATURES[pattern];
+        switch (signature.kind) {
+            case SignatureKind::XSS_PAYLOAD:
+                hits.xssPayload = hits.xssPayload ? hits.xssPayload : signature.text;
+                break;
+            case SignatureKind::SQL_PAYLOAD:
+                hits.sqlPayload = hits.sqlPayload ? hits.sqlPayload : signature.text;
+                break;
+            case SignatureKind::SQL_ERROR:
+                hits.sqlError = hits.sqlError ? hits.sqlError : signature.text;
+                break;
+            case SignatureKind::POST_FORM:
+                hits.postForm = true;
+                break;
+            case SignatureKind::CSRF_TOKEN:
+                hits.csrfToken = true;
+                break;
+        }
+
+        // Con todo encontrado no hace falta seguir recorriendo el cuerpo
+        return !(hits.xssPayload && hits.sqlPayload && hits.sqlError && hits.postForm && hits.csrfToken);
+    });
+    return hits;
+}
+
+bool TrafficAnalyzer::detectXssVulnerabilities(const ParameterHits& parameters, const SignatureHits& body,
+                                               std::vector<std::string>& vulnerabilities) {
+    bool found = false;
+
+    // Payloads XSS en los parámetros de la URL
+    for (const auto& parameter : parameters) {
+        if (parameter.second.xssPayload) {
+            vulnerabilities.push_back("Posible payload XSS en el parámetro '" + parameter.first + "'");
+            found = true;
+        }
+    }
+
+    // Payloads XSS en el cuerpo
+    if (body.xssPayload) {
+        vulnerabilities.push_back(std::string("Posible payload XSS en el cuerpo: ") + body.xssPayload);
+        found = true;
+    }
+    return found;
+}
+
+bool TrafficAnalyzer::detectSqlInjectionVulnerabilities(const ParameterHits& parameters, const SignatureHits& body,
+                                                        std::vector<std::string>& vulnerabilities) {
+    bool found = false;
+
+    // Payloads de inyección SQL en los parámetros de la URL
+    for (const auto& parameter : parameters) {
+        if (parameter.second.sqlPayload) {
+            vulnerabilities.push_back("Posible payload de inyección SQL en el parámetro '" + parameter.first + "'");
+            found = true;
+        }
+    }
+
+    // Mensajes de error de la base de datos en el cuerpo
+    if (body.sqlError) {
+        vulnerabilities.push_back(std::string("Error de base de datos expuesto: ") + body.sqlError);
+        found = true;
+    }
+    return found;
+}
+
+bool TrafficAnalyzer::detectCsrfVulnerabilities(const std::vector<std::pair<std::string, std::string>>& headers,
+                                                const SignatureHits& body, std::vector<std::string>& vulnerabilities) {
+    bool found = false;
+
+    // Cookies que el navegador enviaría en solicitudes de otros sitios
+    for (const auto& header : headers) {
+        if (!equalsIgnoreCase(header.first, "Set-Cookie") || containsIgnoreCase(header.second, "SameSite=Strict") ||
+            containsIgnoreCase(header.second, "SameSite=Lax")) {
+            continue;
+        }
+
+        std::string name = header.second.substr(0, header.second.find('='));
+        vulnerabilities.push_back("Cookie sin SameSite=Strict/Lax (riesgo de CSRF): " + name);
+        found = true;
+    }
+
+    // Formularios POST sin ningún campo con nombre de token anti-CSRF
+    if (body.postForm && !body.csrfToken) {
+        vulnerabilities.push_back("Formulario POST sin token anti-CSRF");
+        found = true;
+    }
+    return found;
+}
+
+bool TrafficAnalyzer::detectInsecureHeaders(const std::vector<std::pair<std::string, std::string>>& headers,
+                                            std::vector<std::string>& vulnerabilities) {
+    bool found = false;
+    const std::string* csp = findHeader(headers, "Content-Security-Policy");
+
+    if (!csp) {
+        vulnerabilities.push_back("Falta la cabecera Content-Security-Policy");
+        found = true;
+    }
+    if (!findHeader(headers, "X-Frame-Options") && !(csp && containsIgnoreCase(*csp, "frame-ancestors"))) {
+        vulnerabilities.push_back("Falta protección contra clickjacking (X-Frame-Options o frame-ancestors)");
+        found = true;
+    }
+
+    const std::string* contentTypeOptions = findHeader(headers, "X-Content-Type-Options");
+    if (!contentTypeOptions || !equalsIgnoreCase(*contentTypeOptions, "nosniff")) {
+        vulnerabilities.push_back("Falta la cabecera X-Content-Type-Options: nosniff");
+        found = true;
+    }
+
+    // Versiones del software del servidor
+    for (const char* name : {"Server", "X-Powered-By", "X-AspNet-Version"}) {
+        const std::string* value = findHeader(headers, name);
+        if (value && std::any_of(value->begin(), value->end(), [](unsigned char c) { return std::isdigit(c); })) {
+            vulnerabilities.push_back(std::string("Versión del servidor expuesta en ") + name + ": " + *value);
+            found = true;
+        }
+    }
+    return found;
+}
+
+void TrafficAnalyzer::publish(std::unique_ptr<const InterceptorChain> chain) {
+    m_chain.store(chain.get());
+    m_retired.push_back(std::move(m_published));
+    m_published = std::move(chain);
+    m_hasRetired = true;
+
+    // Un lector que aún recorra una cadena sustituida se registró antes de
+    // la sustitución, así que con el contador a cero ya no queda ninguno.
+    // Si quedan lectores, el último en salir libera la lista.
+    if (m_activeReaders.load() == 0) {
+        m_retired.clear();
+        m_hasRetired = false;
+    }
+}
+
+void TrafficAnalyzer::reclaimRetired() const {
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    // Otro lector pudo registrarse entre tanto; entonces liberará él al salir
+    if (m_activeReaders.load() == 0) {
+        m_retired.clear();
+        m_hasRetired = false;
+    }
+}
+
+} // namespace Core::Network
@@ -10,16 +10,35 @@
 #include <vector>
 #include <functional>
 #include <memory>
-#include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include "ByteBuffer.h"
 
 namespace Core::Network {
 
 /**
  * Clase que analiza el tráfico de red en busca de vulnerabilidades
  * Permite interceptar, modificar y analizar solicitudes y respuestas HTTP/HTTPS
+ *
+ * Los cuerpos se manejan como ByteBuffer: el analizador recibe los mismos
+ * bloques que leyó el cliente HTTP y un interceptor que quiera modificar un
+ * cuerpo lo sustituye por otro ByteBuffer en lugar de editarlo en su sitio.
+ *
+ * Los interceptores forman una cadena inmutable que se publica entera al
+ * registrar o eliminar uno (estilo RCU): cada mensaje recorre la cadena
+ * vigente al empezar sin tomar cerrojos, y las cadenas sustituidas se
+ * liberan cuando ningún mensaje las está recorriendo. Los métodos pueden
+ * llamarse desde varios hilos a la vez.
+ *
+ * El análisis recorre cada cuerpo una sola vez con un autómata que contiene
+ * todas las firmas (payloads, errores de base de datos, tokens anti-CSRF) y
+ * reparte lo encontrado entre los detectores.
  */
 class TrafficAnalyzer {
 public:
+    using RequestInterceptor = std::function<void(std::string&, std::string&, std::vector<std::pair<std::string, std::string>>&, ByteBuffer&)>;
+    using ResponseInterceptor = std::function<void(int&, std::vector<std::pair<std::string, std::string>>&, ByteBuffer&)>;
+
     /**
      * Constructor
      */
@@ -49,14 +68,14 @@ public:
      * @param callback Función que recibe y puede modificar una solicitud
      * @return ID del interceptor registrado
      */
-    int registerRequestInterceptor(std::function<void(std::string&, std::string&, std::vector<std::pair<std::string, std::string>>&, std::vector<uint8_t>&)> callback);
+    int registerRequestInterceptor(RequestInterceptor callback);
 
     /**
      * Registra un callback para interceptar respuestas HTTP/HTTPS
      * @param callback Función que recibe y puede modificar una respuesta
      * @return ID del interceptor registrado
      */
-    int registerResponseInterceptor(std::function<void(int&, std::vector<std::pair<std::string, std::string>>&, std::vector<uint8_t>&)> callback);
+    int registerResponseInterceptor(ResponseInterceptor callback);
 
     /**
      * Elimina un interceptor registrado
@@ -65,6 +84,32 @@ public:
      */
     bool removeInterceptor(int interceptor_id);
 
+    /**
+     * Aplica los interceptores de solicitudes en orden de registro
+     * @param url URL de la solicitud (entrada y salida)
+     * @param method Método HTTP (entrada y salida)
+     * @param headers Cabeceras de la solicitud (entrada y salida)
+     * @param body Cuerpo de la solicitud (entrada y salida)
+     * @return true si la interceptación está activa y algún interceptor procesó la solicitud
+     */
+    bool interceptRequest(std::string& url, std::string& method,
+                          std::vector<std::pair<std::string, std::string>>& headers, ByteBuffer& body);
+
+    /**
+     * Aplica los interceptores de respuestas en orden de registro
+     * @param status_code Código de estado (entrada y salida)
+     * @param headers Cabeceras de la respuesta (entrada y salida)
+     * @param body Cuerpo de la respuesta (entrada y salida)
+     * @return true si la interceptación está activa y algún interceptor procesó la respuesta
+     */
+    bool interceptResponse(int& status_code, std::vector<std::pair<std::string, std::string>>& headers, ByteBuffer& body);
+
+    /**
+     * Indica si hay que pasar el tráfico por los interceptores
+     * @return true si la interceptación está activa y hay interceptores registrados
+     */
+    bool hasActiveInterceptors() const;
+
     /**
      * Analiza una solicitud en busca de vulnerabilidades
      * @param url URL de la solicitud
@@ -75,7 +120,7 @@ public:
      */
     std::vector<std::string> analyzeRequest(const std::string& url, const std::string& method, 
                                           const std::vector<std::pair<std::string, std::string>>& headers, 
-                                          const std::vector<uint8_t>& body);
+                                          const ByteBuffer& body);
 
     /**
      * Analiza una respuesta en busca de vulnerabilidades
@@ -86,29 +131,67 @@ public:
      */
     std::vector<std::string> analyzeResponse(int status_code, 
                                            const std::vector<std::pair<std::string, std::string>>& headers, 
-                                           const std::vector<uint8_t>& body);
+                                           const ByteBuffer& body);
 
 private:
+    /**
+     * Cadena de interceptores publicada; nunca se modifica una vez publicada
+     */
+    struct InterceptorChain {
+        std::vector<std::pair<int, RequestInterceptor>> requestInterceptors;
+        std::vector<std::pair<int, ResponseInterceptor>> responseInterceptors;
+    };
+
     // Estado de la interceptación
-    bool m_interceptionEnabled;
+    std::atomic<bool> m_interceptionEnabled;
 
     // Estado del análisis de vulnerabilidades
-    bool m_vulnerabilityScanningEnabled;
+    std::atomic<bool> m_vulnerabilityScanningEnabled;
+
+    // Cadena vigente, leída sin cerrojos por los mensajes en curso
+    std::atomic<const InterceptorChain*> m_chain;
+
+    // Mensajes recorriendo alguna cadena; las sustituidas se liberan al verlo a cero
+    mutable std::atomic<size_t> m_activeReaders;
 
-    // Interceptores de solicitudes registrados
-    std::unordered_map<int, std::function<void(std::string&, std::string&, std::vector<std::pair<std::string, std::string>>&, std::vector<uint8_t>&)>> m_requestInterceptors;
+    // Hay cadenas sustituidas pendientes de liberar
+    mutable std::atomic<bool> m_hasRetired;
 
-    // Interceptores de respuestas registrados
-    std::unordered_map<int, std::function<void(int&, std::vector<std::pair<std::string, std::string>>&, std::vector<uint8_t>&)>> m_responseInterceptors;
+    // Publicación de cadenas nuevas (registro y eliminación de interceptores);
+    // el último lector en salir también libera las cadenas sustituidas
+    mutable std::mutex m_publishMutex;
+    std::unique_ptr<const InterceptorChain> m_published;
+    mutable std::vector<std::unique_ptr<const InterceptorChain>> m_retired;
 
     // Contador para generar IDs de interceptores
     int m_nextInterceptorId;
 
+    /**
+     * Firmas encontradas al recorrer un texto una sola vez
+     */
+    struct SignatureHits {
+        const char* xssPayload = nullptr;    // Primer fragmento de payload XSS
+        const char* sqlPayload = nullptr;    // Primer fragmento de payload de inyección SQL
+        const char* sqlError = nullptr;      // Primer mensaje de error de base de datos
+        bool postForm = false;               // Formulario que se envía por POST
+        bool csrfToken = false;              // Nombre de un token anti-CSRF
+    };
+
+    // Parámetros de la query con las firmas encontradas en su valor
+    using ParameterHits = std::vector<std::pair<std::string, SignatureHits>>;
+
     // Métodos privados para el análisis de tráfico
-    bool detectXssVulnerabilities(const std::string& url, const std::vector<uint8_t>& body, std::vector<std::string>& vulnerabilities);
-    bool detectSqlInjectionVulnerabilities(const std::string& url, const std::vector<uint8_t>& body, std::vector<std::string>& vulnerabilities);
-    bool detectCsrfVulnerabilities(const std::vector<std::pair<std::string, std::string>>& headers, std::vector<std::string>& vulnerabilities);
+    static SignatureHits scanSignatures(const ByteBuffer& data);
+    bool detectXssVulnerabilities(const ParameterHits& parameters, const SignatureHits& body, std::vector<std::string>& vulnerabilities);
+    bool detectSqlInjectionVulnerabilities(const ParameterHits& parameters, const SignatureHits& body, std::vector<std::string>& vulnerabilities);
+    bool detectCsrfVulnerabilities(const std::vector<std::pair<std::string, std::string>>& headers, const SignatureHits& body,
+                                   std::vector<std::string>& vulnerabilities);
     bool detectInsecureHeaders(const std::vector<std::pair<std::string, std::string>>& headers, std::vector<std::string>& vulnerabilities);
+    void publish(std::unique_ptr<const InterceptorChain> chain);
+    void reclaimRetired() const;
+
+    // Lectura de la cadena vigente mientras dura un mensaje
+    class ChainReader;
 };
 
 } // namespace Core::Network
\ No newline at end of file
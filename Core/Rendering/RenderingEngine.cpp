@@ -134,7 +134,10 @@ std::string RenderingEngine::executeJavaScript(const std::string& pageId, const
 void RenderingEngine::processHTML(const std::string& html, RenderPage* page) {
     if (!page) return;
     
-    // Parsear el HTML y construir el árbol DOM
+    // Parsear el HTML y construir el árbol DOM; el anterior se destruye
+    if (page->domTree) {
+        m_cssParser->releaseTree(page->domTree.get());
+    }
     page->domTree = m_htmlParser->parse(html, page->baseUrl);
     
     // Extraer las hojas de estilo del documento
@@ -0,0 +1,102 @@
+#include "../Core/HTML/HTMLScanner.h"
+#include "../Core/HTML/HTMLTokenizer.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+
+using namespace BlackWidow;
+
+namespace {
+
+// Tamaño mínimo del corpus para que las mediciones sean estables
+constexpr size_t MIN_CORPUS_BYTES = 8 * 1024 * 1024;
+constexpr int REPETITIONS = 5;
+
+const char* implementationName(Core::HTMLScanner::Implementation implementation) {
+    switch (implementation) {
+        case Core::HTMLScanner::Implementation::SCALAR: return "escalar";
+        case Core::HTMLScanner::Implementation::SSE2: return "SSE2";
+        case Core::HTMLScanner::Implementation::AVX2: return "AVX2";
+    }
+    return "?";
+}
+
+// Mejor tiempo de varias repeticiones, en MB/s
+double measure(const std::string& corpus, const std::function<void()>& function) {
+    double best = 0;
+    for (int i = 0; i < REPETITIONS; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::max(best, corpus.size() / 1e6 / elapsed.count());
+    }
+    return best;
+}
+
+} // namespace
+
+// Compara la búsqueda escalar de delimitadores con las vectorizadas sobre un corpus HTML
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : "Examples/test_page.html";
+    std::ifstream htmlFile(path);
+    if (!htmlFile.is_open()) {
+        std::cerr << "Error: No se pudo abrir el corpus " << path << std::endl;
+        return 1;
+    }
+    std::string page((std::istreambuf_iterator<char>(htmlFile)), std::istreambuf_iterator<char>());
+    if (page.empty()) {
+        std::cerr << "Error: El corpus está vacío" << std::endl;
+        return 1;
+    }
+
+    // Repetir la página hasta tener un corpus de varios megas
+    std::string corpus;
+    while (corpus.size() < MIN_CORPUS_BYTES) {
+        corpus += page;
+    }
+    std::cout << "Corpus: " << path << " (" << corpus.size() << " bytes)" << std::endl;
+
+    Core::HTMLScanner textEnd("<");
+    Core::HTMLScanner attributeNameEnd("/=>", true);
+    size_t tokens = 0;
+    Core::HTMLTokenizer tokenizer([&tokens](const Core::HTMLToken&) { tokens++; });
+
+    auto detected = Core::HTMLScanner::implementation();
+    for (auto implementation : {Core::HTMLScanner::Implementation::SCALAR,
+                                Core::HTMLScanner::Implementation::SSE2,
+                                Core::HTMLScanner::Implementation::AVX2}) {
+        if (!Core::HTMLScanner::setImplementation(implementation)) {
+            std::cout << implementationName(implementation) << ": no disponible en este procesador" << std::endl;
+            continue;
+        }
+
+        // Recorrer el corpus saltando de delimitador en delimitador
+        size_t found = 0;
+        double text = measure(corpus, [&]() {
+            found = 0;
+            for (size_t i = textEnd.find(corpus, 0); i < corpus.size(); i = textEnd.find(corpus, i + 1)) found++;
+        });
+        double names = measure(corpus, [&]() {
+            found = 0;
+            for (size_t i = attributeNameEnd.find(corpus, 0); i < corpus.size(); i = attributeNameEnd.find(corpus, i + 1)) found++;
+        });
+
+        // Tokenizar el corpus completo por trozos como los que llegan de la red
+        double tokenize = measure(corpus, [&]() {
+            tokens = 0;
+            for (size_t offset = 0; offset < corpus.size(); offset += 16384) {
+                tokenizer.feed(std::string_view(corpus).substr(offset, 16384));
+            }
+            tokenizer.finish();
+        });
+
+        std::cout << implementationName(implementation) << ": texto " << text << " MB/s, nombres "
+                  << names << " MB/s, tokenizador " << tokenize << " MB/s (" << tokens << " tokens)" << std::endl;
+    }
+
+    Core::HTMLScanner::setImplementation(detected);
+    return 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Tests de los índices de DOMTree: las búsquedas indexadas se comparan con
+ * recorridos completos del árbol tras mutaciones aleatorias
+ */
+
+#include "TestSupport.h"
+#include "DOM/DOMTree.h"
+#include "HTML/HTMLParser.h"
+#include <random>
+#include <sstream>
+
+using BlackWidow::Core::DOMTree;
+using BlackWidow::Core::HTMLParser;
+using NodeHandle = DOMTree::NodeHandle;
+
+namespace {
+
+constexpr const char* TAGS[] = {"div", "span", "p", "x-foo"};
+constexpr const char* VALUES[] = {"a", "b", "c", "a b", "b  c a", ""};
+constexpr const char* NAMES[] = {"a", "b", "c"};
+
+// Elementos del documento en orden, sin usar los índices
+std::vector<NodeHandle> walkElements(const DOMTree& tree) {
+    std::vector<NodeHandle> result;
+    std::vector<NodeHandle> pending{tree.getDocumentElement()};
+    while (!pending.empty()) {
+        NodeHandle node = pending.back();
+        pending.pop_back();
+        if (node != tree.getDocumentElement() && tree.getNodeType(node) == DOMTree::NodeType::ELEMENT_NODE) {
+            result.push_back(node);
+        }
+        // Los hijos se apilan al revés para visitarlos en orden
+        std::vector<NodeHandle> children;
+        for (NodeHandle child = tree.getFirstChild(node); child != DOMTree::INVALID_NODE;
+             child = tree.getNextSibling(child)) {
+            children.push_back(child);
+        }
+        pending.insert(pending.end(), children.rbegin(), children.rend());
+    }
+    return result;
+}
+
+bool hasClass(const DOMTree& tree, NodeHandle element, const std::string& className) {
+    std::istringstream classes(tree.getAttribute(element, "class"));
+    std::string name;
+    while (classes >> name) {
+        if (name == className) return true;
+    }
+    return false;
+}
+
+// Compara cada búsqueda indexada con el recorrido completo
+bool indexesMatchWalk(const DOMTree& tree) {
+    std::vector<NodeHandle> elements = walkElements(tree);
+    for (const char* tag : TAGS) {
+        std::vector<NodeHandle> expected;
+        for (NodeHandle element : elements) {
+            if (tree.getTagName(element) == tag) expected.push_back(element);
+        }
+        if (tree.getElementsByTagName(tag) != expected) return false;
+    }
+    for (const char* name : NAMES) {
+        std::vector<NodeHandle> expected;
+        NodeHandle firstWithId = DOMTree::INVALID_NODE;
+        for (NodeHandle element : elements) {
+            if (hasClass(tree, element, name)) expected.push_back(element);
+            if (firstWithId == DOMTree::INVALID_NODE && tree.getAttribute(element, "id") == name) firstWithId = element;
+        }
+        if (tree.getElementsByClassName(name) != expected || tree.getElementById(name) != firstWithId) return false;
+    }
+    return tree.getElementById("") == DOMTree::INVALID_NODE;
+}
+
+void testRandomMutations() {
+    std::mt19937 random(1);
+    int mismatches = 0;
+    for (int round = 0; round < 300; round++) {
+        DOMTree tree;
+        std::vector<NodeHandle> nodes{tree.getDocumentElement()};
+        auto anyNode = [&]() { return nodes[random() % nodes.size()]; };
+
+        for (int operation = 0; operation < 300; operation++) {
+            int kind = static_cast<int>(random() % 10);
+            if (kind < 4) {
+                NodeHandle element = tree.createElement(TAGS[random() % 4]);
+                if (random() % 2) tree.setAttribute(element, random() % 2 ? "id" : "class", VALUES[random() % 6]);
+                tree.appendChild(anyNode(), element);
+                nodes.push_back(element);
+            } else if (kind < 5) {
+                tree.appendChild(anyNode(), tree.createTextNode("t"));
+            } else if (kind < 7) {
+                // Mover un nodo (se ignora si crearía un ciclo)
+                NodeHandle parent = anyNode();
+                tree.appendChild(parent, anyNode());
+            } else if (kind < 9) {
+                tree.setAttribute(anyNode(), random() % 2 ? "id" : "class", VALUES[random() % 6]);
+            } else if (random() % 4 == 0) {
+                tree.setTextContent(anyNode(), "z");
+            }
+
+            // Las rondas pares no consultan hasta la mitad, para probar
+            // tanto la construcción tardía como el mantenimiento
+            if ((round % 2 || operation >= 150) && (operation % 7 == 0 || operation == 299) && !indexesMatchWalk(tree)) {
+                mismatches++;
+            }
+        }
+    }
+    Tests::check(mismatches == 0, "las búsquedas indexadas coinciden con el recorrido tras mutaciones aleatorias");
+}
+
+void testParsedDocument() {
+    HTMLParser parser;
+    auto tree = parser.parse("<div id=a class='x y'><p class=y>1</p></div><p id=a class=x>2</p>", "");
+    Tests::check(tree->getElementById("a") == tree->getElementsByTagName("div")[0],
+                 "con ids repetidos se devuelve el primero del documento");
+    Tests::check(tree->getElementsByClassName("x").size() == 2 && tree->getElementsByClassName("y").size() == 2,
+                 "se indexa cada clase del atributo class");
+}
+
+void testConcurrentLookups() {
+    // Las búsquedas const construyen los índices: varios hilos a la vez sobre
+    // un árbol sin consultar no deben pisarse
+    HTMLParser parser;
+    std::string html;
+    for (int i = 0; i < 2000; i++) {
+        html += "<div id=d" + std::to_string(i) + " class='c" + std::to_string(i % 10) + "'><span>x</span></div>";
+    }
+    auto tree = parser.parse(html, "");
+    std::vector<NodeHandle> expected = walkElements(*tree);
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&tree, &failures, t]() {
+            for (int i = 0; i < 200; i++) {
+                int n = (t * 200 + i) % 2000;
+                if (tree->getElementById("d" + std::to_string(n)) == DOMTree::INVALID_NODE ||
+                    tree->getElementsByClassName("c" + std::to_string(n % 10)).size() != 200 ||
+                    tree->getElementsByTagName("span").size() != 2000) {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Tests::check(failures == 0, "las búsquedas desde varios hilos a la vez dan el resultado correcto");
+    Tests::check(indexesMatchWalk(*tree) && walkElements(*tree) == expected, "las búsquedas no modifican el árbol");
+}
+
+} // namespace
+
+int main() {
+    testRandomMutations();
+    testParsedDocument();
+    testConcurrentLookups();
+    return Tests::finish("DOMTreeTest");
+}
@@ -0,0 +1,162 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Tests de HTMLScanner: cada implementación vectorizada debe encontrar lo
+ * mismo que una búsqueda byte a byte, con cualquier alineación y longitud
+ */
+
+#include "TestSupport.h"
+#include "HTML/HTMLScanner.h"
+#include <random>
+
+using BlackWidow::Core::HTMLScanner;
+using Implementation = HTMLScanner::Implementation;
+
+namespace {
+
+/**
+ * Configuración de un escáner y la búsqueda de referencia equivalente
+ */
+struct ScannerCase {
+    std::string delimiters;
+    bool controlChars;
+
+    bool matches(unsigned char c) const {
+        return delimiters.find(static_cast<char>(c)) != std::string::npos || (controlChars && c <= 0x20);
+    }
+};
+
+const std::vector<ScannerCase> CASES = {
+    {"<", false},
+    {"/>", true},
+    {"/=>", true},
+    {">", true},
+    {"\"", false},
+    {"'", false},
+    {"", true},
+    {"", false},               // Sin delimitadores no se detiene nunca
+    {"abcd", false},
+    {"\x80\xff", false},       // Delimitadores con el bit alto
+    {"\x7f=", true},
+};
+
+const char* implementationName(Implementation implementation) {
+    switch (implementation) {
+        case Implementation::SCALAR: return "SCALAR";
+        case Implementation::SSE2: return "SSE2";
+        case Implementation::AVX2: break;
+    }
+    return "AVX2";
+}
+
+size_t findReference(const ScannerCase& scannerCase, std::string_view input, size_t from) {
+    for (size_t i = from; i < input.size(); i++) {
+        if (scannerCase.matches(static_cast<unsigned char>(input[i]))) return i;
+    }
+    return input.size();
+}
+
+// Bytes que detienen la búsqueda y bytes que no; la mitad de los segundos son >= 0x80
+struct ByteClasses {
+    std::vector<char> stoppers;
+    std::vector<char> fillers;
+    size_t highBegin = 0;   // Primer filler >= 0x80
+
+    explicit ByteClasses(const ScannerCase& scannerCase) {
+        for (unsigned c = 0; c < 0x100; c++) {
+            (scannerCase.matches(static_cast<unsigned char>(c)) ? stoppers : fillers).push_back(static_cast<char>(c));
+            if (c < 0x80) highBegin = fillers.size();
+        }
+    }
+
+    char filler(std::mt19937& random) const {
+        if (random() % 2 && highBegin < fillers.size()) {
+            return fillers[highBegin + random() % (fillers.size() - highBegin)];
+        }
+        return fillers[random() % fillers.size()];
+    }
+
+    char stopper(std::mt19937& random) const {
+        return stoppers[random() % stoppers.size()];
+    }
+};
+
+/**
+ * Compara find() con la referencia en todas las alineaciones (0-31) y
+ * longitudes que cubren el tramo escalar inicial, un bloque de 32 y una
+ * cola de 0-31 bytes, con el delimitador en cada posición o sin delimitador
+ */
+int countMismatches(const ScannerCase& scannerCase) {
+    HTMLScanner scanner(scannerCase.delimiters, scannerCase.controlChars);
+    std::mt19937 random(3);
+    alignas(64) char storage[160];
+    int mismatches = 0;
+    ByteClasses bytes(scannerCase);
+
+    for (size_t alignment = 0; alignment < 32; alignment++) {
+        for (size_t length = 0; length < 80; length++) {
+            char* data = storage + alignment;
+            for (size_t i = 0; i < length; i++) {
+                data[i] = bytes.filler(random);
+            }
+            std::string_view input(data, length);
+
+            // Sin delimitador y con uno en cada posición posible
+            for (size_t position = 0; position <= length; position++) {
+                bool placed = !bytes.stoppers.empty() && position < length;
+                char saved = placed ? data[position] : 0;
+                if (placed) {
+                    data[position] = bytes.stopper(random);
+                }
+                for (size_t from : {size_t(0), position}) {
+                    if (scanner.find(input, from) != findReference(scannerCase, input, from)) {
+                        mismatches++;
+                    }
+                }
+                if (placed) {
+                    data[position] = saved;
+                }
+            }
+
+            // Entradas totalmente al azar, con varios delimitadores
+            for (size_t i = 0; i < length; i++) {
+                data[i] = static_cast<char>(random() % 0x100);
+            }
+            if (scanner.find(input, 0) != findReference(scannerCase, input, 0)) {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+void testImplementations() {
+    Implementation original = HTMLScanner::implementation();
+    Tests::check(HTMLScanner::isSupported(Implementation::SCALAR), "la implementación escalar siempre está disponible");
+
+    for (Implementation implementation : {Implementation::SCALAR, Implementation::SSE2, Implementation::AVX2}) {
+        if (!HTMLScanner::isSupported(implementation)) {
+            Tests::check(!HTMLScanner::setImplementation(implementation),
+                         std::string(implementationName(implementation)) + ": no se puede forzar si no está disponible");
+            continue;
+        }
+        Tests::check(HTMLScanner::setImplementation(implementation) && HTMLScanner::implementation() == implementation,
+                     std::string(implementationName(implementation)) + ": se puede forzar");
+
+        int mismatches = 0;
+        for (const auto& scannerCase : CASES) {
+            mismatches += countMismatches(scannerCase);
+        }
+        Tests::check(mismatches == 0, std::string(implementationName(implementation)) +
+                                      ": coincide con la búsqueda byte a byte en todas las alineaciones y colas");
+    }
+
+    HTMLScanner::setImplementation(original);
+}
+
+} // namespace
+
+int main() {
+    testImplementations();
+    return Tests::finish("HTMLScannerTest");
+}
@@ -0,0 +1,170 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Tests de HTMLTokenizer: el mismo documento entregado entero, byte a byte
+ * o partido al azar debe producir los mismos tokens
+ */
+
+#include "TestSupport.h"
+#include "HTML/HTMLTokenizer.h"
+#include <random>
+
+using BlackWidow::Core::HTMLToken;
+using BlackWidow::Core::HTMLTokenizer;
+
+namespace {
+
+// Documentos que ejercitan cada estado del tokenizador
+const std::vector<std::string> CORPUS = {
+    "<!DOCTYPE html><html lang=es><head><title>a < b</title></head><body>texto</body></html>",
+    "<p class=\"x y\" id='z' hidden data-v=sin/comillas>uno<br/>dos<img src=a.png />tres</p>",
+    "<!-- comentario -- con guiones --><!----><!-->tras vacío<!--->tras vacío 2<!-- a > b -->fin",
+    "<script>if (a < b && c > d) { s = \"</scr\" + \"ipt>\"; }</script><p>después</p>",
+    "<SCRIPT type=text/javascript>x = 1</Script ><style>p > a { color: red }</STYLE>hecho",
+    "<textarea><b>no es etiqueta</b></textarea><title>t</titles></title>",
+    "a < b, 3 <4, </> vacío, <?xml version=\"1.0\"?> y <!ELEMENT x> y </ 5>",
+    "<a href=\"x\"title='y'/><div\tclass=a\nid=b\r\n>saltos</div><input value=\"\" disabled>",
+    "<ul><li>1<li>2</ul>ñandú <b>€</b>",
+};
+
+// Documentos que terminan a medias; finish() debe entregar lo mismo con cualquier partición
+const std::vector<std::string> UNTERMINATED = {
+    "texto y <div class=\"sin cerrar",
+    "antes<!-- comentario sin cerrar",
+    "antes<!-",
+    "antes<!",
+    "texto <",
+    "texto </",
+    "<script>var x = '</scr",
+    "<script>nunca se cierra",
+    "<!DOCTYPE html",
+    "<a href=x",
+    "<br/",
+};
+
+std::string tokenToString(const HTMLToken& token) {
+    std::string text;
+    switch (token.type) {
+        case HTMLToken::Type::START_TAG: text = "S"; break;
+        case HTMLToken::Type::END_TAG: text = "E"; break;
+        case HTMLToken::Type::TEXT: text = "T"; break;
+        case HTMLToken::Type::COMMENT: text = "C"; break;
+        case HTMLToken::Type::DOCTYPE: text = "D"; break;
+    }
+    text += "[" + std::string(token.name) + "][" + std::string(token.data) + "]";
+    for (const auto& attribute : token.attributes) {
+        text += " " + std::string(attribute.name) + "=" + std::string(attribute.value);
+    }
+    return text + (token.selfClosing ? " /" : "");
+}
+
+/**
+ * Tokeniza un documento partido en los puntos dados
+ * Los textos consecutivos se unen: el tokenizador puede entregar un texto
+ * en varios trozos según por dónde se corte la entrada.
+ */
+std::vector<std::string> tokenize(const std::string& document, const std::vector<size_t>& splits) {
+    std::vector<std::string> tokens;
+    bool lastWasText = false;
+    HTMLTokenizer tokenizer([&](const HTMLToken& token) {
+        bool text = token.type == HTMLToken::Type::TEXT;
+        if (text && lastWasText) {
+            tokens.back().insert(tokens.back().size() - 1, token.data);
+        } else {
+            tokens.push_back(tokenToString(token));
+        }
+        lastWasText = text;
+    });
+
+    size_t position = 0;
+    for (size_t split : splits) {
+        tokenizer.feed(std::string_view(document).substr(position, split - position));
+        position = split;
+    }
+    tokenizer.feed(std::string_view(document).substr(position));
+    tokenizer.finish();
+    return tokens;
+}
+
+std::vector<size_t> everyByte(size_t size) {
+    std::vector<size_t> splits;
+    for (size_t i = 1; i < size; i++) {
+        splits.push_back(i);
+    }
+    return splits;
+}
+
+std::vector<size_t> randomSplits(size_t size, std::mt19937& random) {
+    std::vector<size_t> splits;
+    size_t position = 0;
+    while (size > 1) {
+        position += 1 + random() % 12;
+        if (position >= size) break;
+        splits.push_back(position);
+    }
+    return splits;
+}
+
+// Cuenta los documentos cuyos tokens cambian con alguna partición
+int countMismatches(const std::vector<std::string>& documents) {
+    std::mt19937 random(7);
+    int mismatches = 0;
+    for (const auto& document : documents) {
+        std::vector<std::string> whole = tokenize(document, {});
+        bool same = tokenize(document, everyByte(document.size())) == whole;
+        for (int round = 0; round < 50 && same; round++) {
+            same = tokenize(document, randomSplits(document.size(), random)) == whole;
+        }
+        for (size_t split = 1; split < document.size() && same; split++) {
+            same = tokenize(document, {split}) == whole;
+        }
+        if (!same) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+void testSplitInvariance() {
+    Tests::check(countMismatches(CORPUS) == 0, "cualquier partición de la entrada da los mismos tokens");
+
+    std::string all;
+    for (const auto& document : CORPUS) {
+        all += document;
+    }
+    Tests::check(countMismatches({all}) == 0, "el corpus concatenado da los mismos tokens con cualquier partición");
+    Tests::check(countMismatches(UNTERMINATED) == 0, "los documentos sin terminar dan los mismos tokens con cualquier partición");
+}
+
+void testExpectedTokens() {
+    std::vector<std::string> comments = tokenize("<!-- a -- b --><!----><!-->x<!--->y<!-- p > q -->", {});
+    Tests::check(comments == std::vector<std::string>{"C[][ a -- b ]", "C[][]", "C[][]", "T[][x]", "C[][]",
+                                                      "T[][y]", "C[][ p > q ]"},
+                 "los comentarios vacíos y abruptos se reconocen");
+
+    std::string script = "<script>a = '</scr' + 'ipt>';</script>";
+    std::vector<std::string> expected{"S[script][]", "T[][a = '</scr' + 'ipt>';]", "E[script][]"};
+    bool allSplits = true;
+    size_t close = script.rfind("</script>");
+    for (size_t split = close; split <= script.size(); split++) {
+        allSplits = allSplits && tokenize(script, {split}) == expected;
+    }
+    Tests::check(allSplits, "el cierre de script partido entre trozos termina el texto");
+
+    Tests::check(tokenize("a<div class=\"b", {}) == std::vector<std::string>{"T[][a]"},
+                 "una etiqueta sin terminar se descarta en finish");
+    Tests::check(tokenize("a<!-- b", {3}) == std::vector<std::string>{"T[][a]", "C[][ b]"},
+                 "un comentario sin terminar se entrega en finish");
+    Tests::check(tokenize("a <", {}) == std::vector<std::string>{"T[][a <]"},
+                 "un '<' al final es texto");
+    Tests::check(tokenize("<title>x</title", {}) == std::vector<std::string>{"S[title][]", "T[][x</title]"},
+                 "un cierre de texto sin terminar es texto en finish");
+}
+
+} // namespace
+
+int main() {
+    testSplitInvariance();
+    testExpectedTokens();
+    return Tests::finish("HTMLTokenizerTest");
+}
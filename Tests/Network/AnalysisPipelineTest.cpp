@@ -0,0 +1,214 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Tests de AnalysisPipeline: contabilidad de la cola circular con varios
+ * productores y cada política de desbordamiento
+ */
+
+#include "TestSupport.h"
+#include "Network/AnalysisPipeline.h"
+#include "Network/TrafficAnalyzer.h"
+#include <algorithm>
+#include <future>
+#include <map>
+#include <set>
+
+using Core::Network::AnalysisPipeline;
+using Core::Network::AnalysisPipelineStats;
+using Core::Network::ExchangeSnapshot;
+using Core::Network::OverflowPolicy;
+using Core::Network::TrafficAnalyzer;
+
+namespace {
+
+// Sin cabeceras de seguridad cada respuesta tiene hallazgos, así que el
+// manejador recibe todos los intercambios analizados
+ExchangeSnapshot makeExchange(const std::string& url) {
+    ExchangeSnapshot snapshot;
+    snapshot.url = url;
+    snapshot.method = "GET";
+    snapshot.statusCode = 200;
+    return snapshot;
+}
+
+// URLs que llegan al manejador y cuántas veces
+class Recorder {
+public:
+    void record(const std::string& url) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_order.push_back(url);
+        m_seen[url]++;
+    }
+
+    std::map<std::string, int> seen() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_seen;
+    }
+
+    std::vector<std::string> order() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_order;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::string> m_order;
+    std::map<std::string, int> m_seen;
+};
+
+const char* policyName(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::DROP_NEWEST: return "DROP_NEWEST";
+        case OverflowPolicy::DROP_OLDEST: return "DROP_OLDEST";
+        case OverflowPolicy::BLOCK: break;
+    }
+    return "BLOCK";
+}
+
+void testProducers(OverflowPolicy policy) {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 3000;
+    const std::string name = policyName(policy);
+
+    TrafficAnalyzer analyzer;
+    analyzer.enableVulnerabilityScanning(true);
+    Recorder recorder;
+    std::set<std::string> rejected;
+    std::mutex rejectedMutex;
+    {
+        // Cola pequeña y análisis lento para que se llene a menudo
+        AnalysisPipeline pipeline(analyzer, 8, 2);
+        pipeline.setOverflowPolicy(policy);
+        pipeline.setFindingHandler([&recorder](const ExchangeSnapshot& snapshot, const std::vector<std::string>&) {
+            recorder.record(snapshot.url);
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        });
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < PRODUCERS; p++) {
+            producers.emplace_back([&, p]() {
+                for (int i = 0; i < PER_PRODUCER; i++) {
+                    std::string url = "http://t/" + std::to_string(p) + "/" + std::to_string(i);
+                    if (!pipeline.submit(makeExchange(url))) {
+                        std::lock_guard<std::mutex> lock(rejectedMutex);
+                        rejected.insert(url);
+                    }
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        bool drained = Tests::waitFor([&]() {
+            AnalysisPipelineStats stats = pipeline.getStats();
+            return stats.queued == 0 && stats.analyzed + stats.dropped == stats.submitted;
+        });
+        AnalysisPipelineStats stats = pipeline.getStats();
+        Tests::check(drained, name + ": la cola se vacía");
+        Tests::check(stats.submitted == PRODUCERS * PER_PRODUCER, name + ": se cuentan todos los intercambios entregados");
+        Tests::check(stats.analyzed + stats.dropped == stats.submitted, name + ": entregados = analizados + descartados");
+        Tests::check(stats.capacity == 8 && stats.queued == 0, name + ": la cola vacía no tiene intercambios en espera");
+
+        // El manejador se llama tras contar el análisis: esperar a que acabe el último
+        Tests::waitFor([&]() { return recorder.order().size() == stats.analyzed; });
+        std::map<std::string, int> seen = recorder.seen();
+        bool once = std::all_of(seen.begin(), seen.end(), [](const auto& entry) { return entry.second == 1; });
+        Tests::check(once, name + ": ningún intercambio se analiza dos veces");
+        Tests::check(seen.size() == stats.analyzed, name + ": cada intercambio analizado llega al manejador");
+
+        bool rejectedNeverSeen = std::none_of(rejected.begin(), rejected.end(), [&seen](const std::string& url) {
+            return seen.count(url) > 0;
+        });
+        Tests::check(rejectedNeverSeen, name + ": los intercambios rechazados no se analizan");
+
+        switch (policy) {
+            case OverflowPolicy::DROP_NEWEST:
+                Tests::check(stats.dropped > 0 && stats.dropped == rejected.size(),
+                             name + ": solo se descartan los intercambios que submit rechaza");
+                break;
+            case OverflowPolicy::DROP_OLDEST:
+                Tests::check(stats.dropped > 0 && stats.dropped >= rejected.size(),
+                             name + ": se descartan intercambios ya encolados");
+                break;
+            case OverflowPolicy::BLOCK:
+                Tests::check(stats.dropped == 0 && rejected.empty(), name + ": no se descarta nada");
+                break;
+        }
+    }
+}
+
+void testQueuedAndOverflow() {
+    TrafficAnalyzer analyzer;
+    analyzer.enableVulnerabilityScanning(true);
+    Recorder recorder;
+
+    // El único hilo de análisis se queda parado en el primer intercambio
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    AnalysisPipeline pipeline(analyzer, 3, 1);
+    pipeline.setFindingHandler([&recorder, opened](const ExchangeSnapshot& snapshot, const std::vector<std::string>&) {
+        recorder.record(snapshot.url);
+        opened.wait();
+    });
+
+    Tests::check(pipeline.getStats().capacity == 4, "la capacidad se redondea a potencia de dos");
+    pipeline.submit(makeExchange("e0"));
+    Tests::check(Tests::waitFor([&]() { return recorder.order().size() == 1; }), "el hilo de análisis toma el primero");
+
+    for (int i = 1; i <= 4; i++) {
+        pipeline.submit(makeExchange("e" + std::to_string(i)));
+    }
+    AnalysisPipelineStats stats = pipeline.getStats();
+    Tests::check(stats.queued == 4, "la cola cuenta los intercambios en espera");
+
+    Tests::check(!pipeline.submit(makeExchange("e5")), "con DROP_NEWEST la cola llena rechaza el nuevo");
+    pipeline.setOverflowPolicy(OverflowPolicy::DROP_OLDEST);
+    Tests::check(pipeline.submit(makeExchange("e6")), "con DROP_OLDEST la cola llena acepta el nuevo");
+    stats = pipeline.getStats();
+    Tests::check(stats.queued == 4 && stats.dropped == 2 && stats.submitted == 7,
+                 "los descartes no cambian los intercambios en espera");
+
+    gate.set_value();
+    Tests::waitFor([&]() { return recorder.order().size() == 5; });
+    Tests::check(recorder.order() == std::vector<std::string>{"e0", "e2", "e3", "e4", "e6"},
+                 "DROP_OLDEST descarta el más antiguo y se conserva el orden");
+}
+
+void testWraparound() {
+    // Muchas vueltas al buffer con un solo hilo de análisis: el orden de
+    // llegada se conserva aunque las posiciones reutilicen las celdas
+    TrafficAnalyzer analyzer;
+    analyzer.enableVulnerabilityScanning(true);
+    Recorder recorder;
+    constexpr int COUNT = 5000;
+    {
+        AnalysisPipeline pipeline(analyzer, 2, 1);
+        pipeline.setOverflowPolicy(OverflowPolicy::BLOCK);
+        pipeline.setFindingHandler([&recorder](const ExchangeSnapshot& snapshot, const std::vector<std::string>&) {
+            recorder.record(snapshot.url);
+        });
+        for (int i = 0; i < COUNT; i++) {
+            pipeline.submit(makeExchange(std::to_string(i)));
+        }
+        Tests::waitFor([&]() { return recorder.order().size() == COUNT; });
+    }
+
+    std::vector<std::string> order = recorder.order();
+    bool inOrder = order.size() == COUNT;
+    for (int i = 0; inOrder && i < COUNT; i++) {
+        inOrder = order[i] == std::to_string(i);
+    }
+    Tests::check(inOrder, "tras muchas vueltas al buffer los intercambios salen en orden");
+}
+
+} // namespace
+
+int main() {
+    testProducers(OverflowPolicy::DROP_NEWEST);
+    testProducers(OverflowPolicy::DROP_OLDEST);
+    testProducers(OverflowPolicy::BLOCK);
+    testQueuedAndOverflow();
+    testWraparound();
+    return Tests::finish("AnalysisPipelineTest");
+}
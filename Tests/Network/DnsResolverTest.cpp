@@ -0,0 +1,278 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Tests de DnsResolver y DnsCache contra un servidor DNS local (UDP y TCP)
+ */
+
+#include "TestSupport.h"
+#include "Network/DnsResolver.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+using Core::Network::DnsCache;
+using Core::Network::DnsResolver;
+using Core::Network::ResolvedAddress;
+
+namespace {
+
+/**
+ * Servidor DNS mínimo en 127.0.0.1 que responde registros A desde una tabla
+ * Los nombres que no están en la tabla reciben NXDOMAIN y las consultas AAAA
+ * una respuesta vacía. Por UDP, las respuestas con más de maxUdpAnswers
+ * registros se envían truncadas (bit TC, sin registros).
+ */
+class FakeDnsServer {
+public:
+    FakeDnsServer(std::map<std::string, std::vector<std::string>> records, size_t maxUdpAnswers) :
+        m_records(std::move(records)),
+        m_maxUdpAnswers(maxUdpAnswers),
+        m_running(true) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        m_udp = socket(AF_INET, SOCK_DGRAM, 0);
+        bind(m_udp, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        socklen_t length = sizeof(address);
+        getsockname(m_udp, reinterpret_cast<sockaddr*>(&address), &length);
+        m_port = ntohs(address.sin_port);
+
+        // TCP en el mismo puerto, como un servidor DNS real
+        m_tcp = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(m_tcp, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        bind(m_tcp, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        listen(m_tcp, 16);
+
+        m_thread = std::thread(&FakeDnsServer::serve, this);
+    }
+
+    ~FakeDnsServer() {
+        m_running = false;
+        m_thread.join();
+        close(m_udp);
+        close(m_tcp);
+    }
+
+    FakeDnsServer(const FakeDnsServer&) = delete;
+    FakeDnsServer& operator=(const FakeDnsServer&) = delete;
+
+    std::string getAddress() const { return "127.0.0.1:" + std::to_string(m_port); }
+    size_t getUdpQueries() const { return m_udpQueries; }
+    size_t getTcpQueries() const { return m_tcpQueries; }
+
+    // Nombres preguntados, en orden
+    std::vector<std::string> getQuestions() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_questions;
+    }
+
+private:
+    void serve() {
+        while (m_running) {
+            pollfd descriptors[2] = {{m_udp, POLLIN, 0}, {m_tcp, POLLIN, 0}};
+            if (poll(descriptors, 2, 50) <= 0) {
+                continue;
+            }
+            if (descriptors[0].revents & POLLIN) {
+                uint8_t query[512];
+                sockaddr_storage client{};
+                socklen_t clientLength = sizeof(client);
+                ssize_t received = recvfrom(m_udp, query, sizeof(query), 0,
+                                            reinterpret_cast<sockaddr*>(&client), &clientLength);
+                std::string reply;
+                if (received > 0 && answer(query, static_cast<size_t>(received), false, reply)) {
+                    m_udpQueries++;
+                    sendto(m_udp, reply.data(), reply.size(), 0, reinterpret_cast<sockaddr*>(&client), clientLength);
+                }
+            }
+            if (descriptors[1].revents & POLLIN) {
+                int fd = accept(m_tcp, nullptr, nullptr);
+                if (fd >= 0) {
+                    serveTcp(fd);
+                    close(fd);
+                }
+            }
+        }
+    }
+
+    void serveTcp(int fd) {
+        uint8_t prefix[2];
+        if (recv(fd, prefix, 2, MSG_WAITALL) != 2) {
+            return;
+        }
+        size_t length = (static_cast<size_t>(prefix[0]) << 8) | prefix[1];
+        std::vector<uint8_t> query(length);
+        std::string reply;
+        if (recv(fd, query.data(), length, MSG_WAITALL) != static_cast<ssize_t>(length) ||
+            !answer(query.data(), length, true, reply)) {
+            return;
+        }
+        m_tcpQueries++;
+        std::string framed{static_cast<char>(reply.size() >> 8), static_cast<char>(reply.size())};
+        Tests::sendAll(fd, framed + reply);
+    }
+
+    bool answer(const uint8_t* query, size_t length, bool viaTcp, std::string& reply) {
+        // Pregunta: nombre en etiquetas, tipo y clase
+        std::string name;
+        size_t offset = 12;
+        while (offset < length && query[offset] != 0) {
+            size_t labelLength = query[offset];
+            if (offset + 1 + labelLength > length) {
+                return false;
+            }
+            name += (name.empty() ? "" : ".") + std::string(reinterpret_cast<const char*>(query) + offset + 1, labelLength);
+            offset += 1 + labelLength;
+        }
+        if (offset + 5 > length) {
+            return false;
+        }
+        uint16_t type = static_cast<uint16_t>((query[offset + 1] << 8) | query[offset + 2]);
+        size_t questionEnd = offset + 5;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_questions.push_back(name);
+        }
+
+        auto it = m_records.find(name);
+        std::vector<std::string> addresses = it != m_records.end() && type == 1 ? it->second : std::vector<std::string>();
+        bool truncated = !viaTcp && addresses.size() > m_maxUdpAnswers;
+        if (truncated) {
+            addresses.clear();
+        }
+
+        uint16_t flags = 0x8180 | (truncated ? 0x0200 : 0) | (it == m_records.end() ? 3 : 0);
+        reply.assign(reinterpret_cast<const char*>(query), 2);
+        reply += {static_cast<char>(flags >> 8), static_cast<char>(flags), 0, 1,
+                  0, static_cast<char>(addresses.size()), 0, 0, 0, 0};
+        reply.append(reinterpret_cast<const char*>(query) + 12, questionEnd - 12);
+        for (const auto& text : addresses) {
+            uint8_t bytes[4];
+            inet_pton(AF_INET, text.c_str(), bytes);
+            // Puntero al nombre de la pregunta, tipo A, clase IN, TTL 300 y 4 bytes de datos
+            reply += {static_cast<char>(0xC0), 12, 0, 1, 0, 1, 0, 0, 1, 44, 0, 4};
+            reply.append(reinterpret_cast<const char*>(bytes), 4);
+        }
+        return true;
+    }
+
+    std::map<std::string, std::vector<std::string>> m_records;
+    size_t m_maxUdpAnswers;
+    std::atomic<bool> m_running;
+    std::atomic<size_t> m_udpQueries{0};
+    std::atomic<size_t> m_tcpQueries{0};
+    std::mutex m_mutex;
+    std::vector<std::string> m_questions;
+    int m_udp;
+    int m_tcp;
+    int m_port;
+    std::thread m_thread;
+};
+
+std::vector<std::string> toStrings(const std::vector<ResolvedAddress>& addresses) {
+    std::vector<std::string> result;
+    for (const auto& address : addresses) {
+        result.push_back(address.toString());
+    }
+    return result;
+}
+
+void testHostOverrides() {
+    auto cache = std::make_shared<DnsCache>();
+    Tests::check(cache->addHostOverride("Target.Example", "10.1.2.3"), "se añade un host a la tabla");
+    Tests::check(!cache->addHostOverride("bad.example", "no-es-una-ip"), "se rechaza una dirección no válida");
+
+    // Sin servidores alcanzables: la tabla de hosts basta
+    DnsResolver resolver(cache);
+    resolver.setNameservers({"127.0.0.1:1"});
+    std::vector<ResolvedAddress> addresses;
+    Tests::check(resolver.resolveBlocking("target.example.", addresses, 1000) &&
+                 toStrings(addresses) == std::vector<std::string>{"10.1.2.3"},
+                 "la tabla de hosts responde sin consultar la red");
+    Tests::check(resolver.resolveBlocking("[::1]", addresses, 1000) && addresses[0].family == AF_INET6,
+                 "las direcciones literales se devuelven tal cual");
+}
+
+void testResolutionAndCache() {
+    FakeDnsServer server({{"www.example.test", {"192.0.2.10"}}}, 8);
+    auto cache = std::make_shared<DnsCache>();
+    DnsResolver resolver(cache);
+    resolver.setNameservers({server.getAddress()});
+    resolver.setSearchDomains({}, 1);
+
+    std::vector<ResolvedAddress> addresses;
+    Tests::check(resolver.resolveBlocking("www.example.test", addresses, 3000) &&
+                 toStrings(addresses) == std::vector<std::string>{"192.0.2.10"},
+                 "se resuelve un nombre por UDP");
+    size_t queries = server.getUdpQueries();
+    Tests::check(resolver.resolveBlocking("WWW.Example.Test", addresses, 3000) && server.getUdpQueries() == queries,
+                 "la segunda resolución sale de la caché");
+    Tests::check(cache->getStats().hits == 1, "la caché cuenta el acierto");
+
+    Tests::check(!resolver.resolveBlocking("missing.example.test", addresses, 3000), "NXDOMAIN no da direcciones");
+    queries = server.getUdpQueries();
+    Tests::check(!resolver.resolveBlocking("missing.example.test", addresses, 3000) && server.getUdpQueries() == queries &&
+                 cache->getStats().negativeHits == 1, "NXDOMAIN se guarda como respuesta negativa");
+}
+
+void testTruncatedAnswerUsesTcp() {
+    std::vector<std::string> many;
+    for (int i = 1; i <= 20; i++) {
+        many.push_back("198.51.100." + std::to_string(i));
+    }
+    FakeDnsServer server({{"big.example.test", many}}, 8);
+    DnsResolver resolver(std::make_shared<DnsCache>());
+    resolver.setNameservers({server.getAddress()});
+    resolver.setSearchDomains({}, 1);
+
+    std::vector<ResolvedAddress> addresses;
+    Tests::check(resolver.resolveBlocking("big.example.test", addresses, 3000) && toStrings(addresses) == many,
+                 "una respuesta truncada se repite por TCP");
+    Tests::check(server.getTcpQueries() == 1, "solo la pregunta truncada va por TCP");
+}
+
+void testSearchDomains() {
+    FakeDnsServer server({{"intranet.corp.test", {"10.0.0.7"}}, {"api.svc", {"10.0.0.8"}}}, 8);
+    DnsResolver resolver(std::make_shared<DnsCache>());
+    resolver.setNameservers({server.getAddress()});
+    resolver.setSearchDomains({"other.test", "corp.test"}, 1);
+
+    std::vector<ResolvedAddress> addresses;
+    Tests::check(resolver.resolveBlocking("intranet", addresses, 3000) &&
+                 toStrings(addresses) == std::vector<std::string>{"10.0.0.7"},
+                 "un nombre relativo se completa con la lista search");
+    auto questions = server.getQuestions();
+    Tests::check(!questions.empty() && questions.front() == "intranet.other.test",
+                 "con menos de ndots puntos se prueba primero la lista search");
+
+    Tests::check(std::find(questions.begin(), questions.end(), "intranet") == questions.end(),
+                 "el nombre tal cual no se consulta si la lista search lo resuelve");
+
+    Tests::check(resolver.resolveBlocking("api.svc", addresses, 3000) &&
+                 toStrings(addresses) == std::vector<std::string>{"10.0.0.8"}, "se resuelve un nombre con puntos");
+    questions = server.getQuestions();
+    Tests::check(std::find(questions.begin(), questions.end(), "api.svc.other.test") == questions.end(),
+                 "con ndots puntos se prueba primero el nombre tal cual");
+
+    Tests::check(!resolver.resolveBlocking("absolute.", addresses, 3000), "un nombre inexistente no se resuelve");
+    questions = server.getQuestions();
+    Tests::check(std::find(questions.begin(), questions.end(), "absolute.other.test") == questions.end(),
+                 "un nombre con punto final no usa la lista search");
+}
+
+} // namespace
+
+int main() {
+    testHostOverrides();
+    testResolutionAndCache();
+    testTruncatedAnswerUsesTcp();
+    testSearchDomains();
+    return Tests::finish("DnsResolverTest");
+}
@@ -0,0 +1,238 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Tests de HttpClient contra un servidor h2c (HTTP/2 sin TLS) local
+ */
+
+#include "TestSupport.h"
+#include "Network/HttpClient.h"
+#include "Network/Hpack.h"
+#include <sys/socket.h>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+
+using Core::Network::ByteBuffer;
+using Core::Network::HpackDecoder;
+using Core::Network::HpackEncoder;
+using Core::Network::HttpClient;
+using Core::Network::HttpVersion;
+using Core::Network::RequestOptions;
+using Headers = std::vector<std::pair<std::string, std::string>>;
+
+namespace {
+
+constexpr uint8_t FRAME_DATA = 0x0;
+constexpr uint8_t FRAME_HEADERS = 0x1;
+constexpr uint8_t FRAME_SETTINGS = 0x4;
+constexpr uint8_t FRAME_GOAWAY = 0x7;
+constexpr uint8_t FRAME_CONTINUATION = 0x9;
+
+constexpr uint8_t FLAG_END_STREAM = 0x1;
+constexpr uint8_t FLAG_ACK = 0x1;
+constexpr uint8_t FLAG_END_HEADERS = 0x4;
+constexpr uint8_t FLAG_PADDED = 0x8;
+constexpr uint8_t FLAG_PRIORITY = 0x20;
+
+struct Outcome {
+    std::atomic<bool> done{false};
+    int status = -1;
+    std::string body;
+};
+
+struct Frame {
+    uint8_t type = 0;
+    uint8_t flags = 0;
+    uint32_t streamId = 0;
+    std::string payload;
+};
+
+// Lo que el servidor ha visto del cliente
+struct ServerLog {
+    std::mutex mutex;
+    std::map<uint16_t, uint32_t> settings;
+    std::atomic<uint32_t> goAwayCode{UINT32_MAX};
+};
+
+bool readExact(int fd, char* data, size_t length) {
+    size_t received = 0;
+    while (received < length) {
+        ssize_t result = recv(fd, data + received, length - received, 0);
+        if (result <= 0) {
+            return false;
+        }
+        received += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+bool readFrame(int fd, Frame& frame) {
+    uint8_t header[9];
+    if (!readExact(fd, reinterpret_cast<char*>(header), sizeof(header))) {
+        return false;
+    }
+    size_t length = (static_cast<size_t>(header[0]) << 16) | (static_cast<size_t>(header[1]) << 8) | header[2];
+    frame.type = header[3];
+    frame.flags = header[4];
+    frame.streamId = ((static_cast<uint32_t>(header[5]) << 24) | (static_cast<uint32_t>(header[6]) << 16) |
+                      (static_cast<uint32_t>(header[7]) << 8) | header[8]) & 0x7FFFFFFF;
+    frame.payload.assign(length, '\0');
+    return readExact(fd, frame.payload.data(), length);
+}
+
+void appendFrame(std::string& output, uint8_t type, uint8_t flags, uint32_t streamId, const std::string& payload) {
+    size_t length = payload.size();
+    const char header[9] = {
+        static_cast<char>(length >> 16), static_cast<char>(length >> 8), static_cast<char>(length),
+        static_cast<char>(type), static_cast<char>(flags),
+        static_cast<char>(streamId >> 24), static_cast<char>(streamId >> 16),
+        static_cast<char>(streamId >> 8), static_cast<char>(streamId)
+    };
+    output.append(header, sizeof(header));
+    output += payload;
+}
+
+uint32_t readUint32(const std::string& data, size_t offset) {
+    return (static_cast<uint32_t>(static_cast<uint8_t>(data[offset])) << 24) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(data[offset + 1])) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(data[offset + 2])) << 8) |
+           static_cast<uint32_t>(static_cast<uint8_t>(data[offset + 3]));
+}
+
+/**
+ * Servidor h2c mínimo: responde cada flujo con su :path como cuerpo; en /huge
+ * envía un bloque de cabeceras repartido en CONTINUATION que supera el límite
+ */
+void serveH2c(int fd, ServerLog& log) {
+    char preface[24];
+    if (!readExact(fd, preface, sizeof(preface)) ||
+        std::memcmp(preface, "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n", sizeof(preface)) != 0) {
+        return;
+    }
+
+    std::string output;
+    appendFrame(output, FRAME_SETTINGS, 0, 0, "");
+    if (!Tests::sendAll(fd, output)) {
+        return;
+    }
+
+    HpackEncoder encoder;
+    HpackDecoder decoder;
+    Frame frame;
+    while (readFrame(fd, frame)) {
+        output.clear();
+        if (frame.type == FRAME_SETTINGS && !(frame.flags & FLAG_ACK)) {
+            {
+                std::lock_guard<std::mutex> lock(log.mutex);
+                for (size_t offset = 0; offset + 6 <= frame.payload.size(); offset += 6) {
+                    uint16_t id = static_cast<uint16_t>((static_cast<uint8_t>(frame.payload[offset]) << 8) |
+                                                        static_cast<uint8_t>(frame.payload[offset + 1]));
+                    log.settings[id] = readUint32(frame.payload, offset + 2);
+                }
+            }
+            appendFrame(output, FRAME_SETTINGS, FLAG_ACK, 0, "");
+        } else if (frame.type == FRAME_GOAWAY && frame.payload.size() >= 8) {
+            log.goAwayCode = readUint32(frame.payload, 4);
+        } else if (frame.type == FRAME_HEADERS && (frame.flags & FLAG_END_HEADERS)) {
+            // El cliente envía la prioridad del flujo en la propia trama HEADERS
+            size_t start = 0;
+            size_t padding = 0;
+            if (frame.flags & FLAG_PADDED) {
+                padding = static_cast<uint8_t>(frame.payload[0]);
+                start = 1;
+            }
+            if (frame.flags & FLAG_PRIORITY) {
+                start += 5;
+            }
+            Headers request;
+            if (start + padding > frame.payload.size() ||
+                !decoder.decode(reinterpret_cast<const uint8_t*>(frame.payload.data()) + start,
+                                frame.payload.size() - start - padding, request)) {
+                return;
+            }
+            std::string path;
+            for (const auto& header : request) {
+                if (header.first == ":path") {
+                    path = header.second;
+                }
+            }
+
+            std::string block;
+            if (path == "/huge") {
+                // 17 tramas de 16 KiB: más que los 256 KiB anunciados
+                encoder.encode({{":status", "200"}}, block);
+                appendFrame(output, FRAME_HEADERS, 0, frame.streamId, block);
+                for (int i = 0; i < 17; i++) {
+                    appendFrame(output, FRAME_CONTINUATION, 0, frame.streamId, std::string(16384, 'x'));
+                }
+            } else {
+                encoder.encode({{":status", "200"}, {"content-length", std::to_string(path.size())}}, block);
+                appendFrame(output, FRAME_HEADERS, FLAG_END_HEADERS, frame.streamId, block);
+                appendFrame(output, FRAME_DATA, FLAG_END_STREAM, frame.streamId, path);
+            }
+        }
+        if (!output.empty() && !Tests::sendAll(fd, output)) {
+            return;
+        }
+    }
+}
+
+void sendH2c(HttpClient& client, const std::string& url, Outcome& outcome) {
+    RequestOptions options;
+    options.version = HttpVersion::HTTP_2;
+    client.sendRequest(url, "GET", {}, {}, [&outcome](int status, const Headers&, const ByteBuffer& body) {
+        outcome.status = status;
+        outcome.body = body.toString();
+        outcome.done = true;
+    }, options);
+}
+
+void testMultiplexedRequests() {
+    ServerLog log;
+    Tests::LoopbackServer server([&log](int fd) { serveH2c(fd, log); });
+    std::string base = "http://127.0.0.1:" + std::to_string(server.getPort());
+
+    HttpClient client;
+    const int count = 20;
+    std::vector<Outcome> outcomes(count);
+    for (int i = 0; i < count; i++) {
+        sendH2c(client, base + "/s/" + std::to_string(i), outcomes[i]);
+    }
+    Tests::check(Tests::waitFor([&]() { return client.getPendingRequestCount() == 0; }),
+                 "las solicitudes h2c terminan");
+
+    int matched = 0;
+    for (int i = 0; i < count; i++) {
+        matched += outcomes[i].status == 200 && outcomes[i].body == "/s/" + std::to_string(i) ? 1 : 0;
+    }
+    Tests::check(matched == count, "cada flujo h2c recibe su respuesta");
+    Tests::check(server.getAcceptedConnections() == 1, "los flujos h2c se multiplexan en una conexión");
+
+    std::lock_guard<std::mutex> lock(log.mutex);
+    auto setting = log.settings.find(0x6);
+    Tests::check(setting != log.settings.end() && setting->second == 256 * 1024,
+                 "el cliente anuncia SETTINGS_MAX_HEADER_LIST_SIZE");
+}
+
+void testOversizedHeaderBlock() {
+    ServerLog log;
+    Tests::LoopbackServer server([&log](int fd) { serveH2c(fd, log); });
+    std::string base = "http://127.0.0.1:" + std::to_string(server.getPort());
+
+    HttpClient client;
+    Outcome huge;
+    sendH2c(client, base + "/huge", huge);
+    Tests::check(Tests::waitFor([&]() { return huge.done.load(); }), "la respuesta con cabeceras enormes termina");
+    Tests::check(huge.status == 0, "un bloque de cabeceras demasiado grande hace fallar la solicitud");
+    Tests::check(Tests::waitFor([&]() { return log.goAwayCode != UINT32_MAX; }) && log.goAwayCode == 0xb,
+                 "la conexión se cierra con GOAWAY ENHANCE_YOUR_CALM");
+}
+
+} // namespace
+
+int main() {
+    testMultiplexedRequests();
+    testOversizedHeaderBlock();
+    return Tests::finish("Http2Test");
+}
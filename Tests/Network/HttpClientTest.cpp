@@ -0,0 +1,281 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Tests de HttpClient contra un servidor HTTP/1.1 local
+ */
+
+#include "TestSupport.h"
+#include "Network/HttpClient.h"
+#include <zlib.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+
+using Core::Network::ByteBuffer;
+using Core::Network::HttpClient;
+using Headers = std::vector<std::pair<std::string, std::string>>;
+
+namespace {
+
+// Resultado de una solicitud, escrito desde el hilo de eventos del cliente
+struct Outcome {
+    std::atomic<bool> done{false};
+    int status = -1;
+    Headers headers;
+    std::string body;
+};
+
+void sendGet(HttpClient& client, const std::string& url, Outcome& outcome) {
+    client.sendRequest(url, "GET", {}, {}, [&outcome](int status, const Headers& headers, const ByteBuffer& body) {
+        outcome.status = status;
+        outcome.headers = headers;
+        outcome.body = body.toString();
+        outcome.done = true;
+    });
+}
+
+std::string findHeader(const Headers& headers, const std::string& name) {
+    for (const auto& header : headers) {
+        if (header.first == name) {
+            return header.second;
+        }
+    }
+    return "";
+}
+
+// Comprime un cuerpo en formato gzip con zlib
+std::string gzipCompress(const std::string& plain) {
+    std::string compressed(compressBound(plain.size()) + 32, '\0');
+    z_stream stream{};
+    deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(plain.data()));
+    stream.avail_in = static_cast<uInt>(plain.size());
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = static_cast<uInt>(compressed.size());
+    deflate(&stream, Z_FINISH);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    return compressed;
+}
+
+// Responde cada solicitud con su destino como cuerpo, en orden y por la misma conexión
+void echoTargets(int fd) {
+    std::string pending;
+    Tests::ReceivedRequest request;
+    while (Tests::readHttpRequest(fd, pending, request)) {
+        std::string body = request.method + " " + request.target + (request.body.empty() ? "" : " " + request.body);
+        if (!Tests::sendAll(fd, "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size()) +
+                                "\r\nX-Test: eco\r\n\r\n" + body)) {
+            return;
+        }
+    }
+}
+
+void testSimpleRequests() {
+    Tests::LoopbackServer server(echoTargets);
+    Tests::check(server.getPort() > 0, "el servidor local escucha");
+    std::string base = "http://127.0.0.1:" + std::to_string(server.getPort());
+
+    HttpClient client;
+    Outcome get;
+    sendGet(client, base + "/hola?x=1", get);
+    Tests::check(Tests::waitFor([&]() { return get.done.load(); }), "GET termina");
+    Tests::check(get.status == 200, "GET devuelve 200");
+    Tests::check(get.body == "GET /hola?x=1", "GET recibe el cuerpo completo");
+    Tests::check(findHeader(get.headers, "X-Test") == "eco", "GET recibe las cabeceras");
+
+    Outcome post;
+    std::string payload = "a=1&b=2";
+    client.sendRequest(base + "/form", "POST", {{"Content-Type", "application/x-www-form-urlencoded"}},
+                       std::vector<uint8_t>(payload.begin(), payload.end()),
+                       [&post](int status, const Headers&, const ByteBuffer& body) {
+                           post.status = status;
+                           post.body = body.toString();
+                           post.done = true;
+                       });
+    Tests::check(Tests::waitFor([&]() { return post.done.load(); }), "POST termina");
+    Tests::check(post.body == "POST /form a=1&b=2", "POST envía el cuerpo");
+
+    // La segunda y la tercera solicitud reutilizan la conexión keep-alive
+    Tests::check(server.getAcceptedConnections() == 1, "las solicitudes consecutivas reutilizan la conexión");
+}
+
+void testManyConcurrentRequests() {
+    Tests::LoopbackServer server(echoTargets);
+    std::string base = "http://127.0.0.1:" + std::to_string(server.getPort());
+
+    HttpClient client;
+    client.setMaxConnectionsPerHost(32);
+
+    const int count = 500;
+    std::vector<Outcome> outcomes(count);
+    for (int i = 0; i < count; i++) {
+        sendGet(client, base + "/item/" + std::to_string(i), outcomes[i]);
+    }
+
+    bool finished = Tests::waitFor([&]() { return client.getPendingRequestCount() == 0; });
+    Tests::check(finished, "todas las solicitudes concurrentes terminan");
+
+    int matched = 0;
+    for (int i = 0; i < count; i++) {
+        if (outcomes[i].done && outcomes[i].status == 200 && outcomes[i].body == "GET /item/" + std::to_string(i)) {
+            matched++;
+        }
+    }
+    Tests::check(matched == count, "cada respuesta corresponde a su solicitud");
+    Tests::check(server.getAcceptedConnections() <= 32, "se respeta el límite de conexiones por origen");
+}
+
+void testPipelining() {
+    // El servidor lee todas las solicitudes disponibles antes de responder,
+    // de modo que solo una conexión encadenada recibe varias a la vez
+    std::atomic<size_t> maxBatch{0};
+    Tests::LoopbackServer server([&maxBatch](int fd) {
+        std::string pending;
+        Tests::ReceivedRequest request;
+        while (Tests::readHttpRequest(fd, pending, request)) {
+            std::vector<std::string> targets{request.target};
+            // Dar tiempo a que lleguen las solicitudes encadenadas y recoger las disponibles
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            char buffer[16 * 1024];
+            ssize_t received;
+            while ((received = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+                pending.append(buffer, static_cast<size_t>(received));
+            }
+            while (pending.find("\r\n\r\n") != std::string::npos && Tests::readHttpRequest(fd, pending, request)) {
+                targets.push_back(request.target);
+            }
+            if (targets.size() > maxBatch) {
+                maxBatch = targets.size();
+            }
+
+            std::string replies;
+            for (const auto& target : targets) {
+                replies += "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(target.size()) + "\r\n\r\n" + target;
+            }
+            if (!Tests::sendAll(fd, replies)) {
+                return;
+            }
+        }
+    });
+    std::string base = "http://127.0.0.1:" + std::to_string(server.getPort());
+
+    HttpClient client;
+    client.setPipelining(true, 8);
+    client.setMaxConnectionsPerHost(1);
+
+    const int count = 64;
+    std::vector<Outcome> outcomes(count);
+    for (int i = 0; i < count; i++) {
+        sendGet(client, base + "/p/" + std::to_string(i), outcomes[i]);
+    }
+    Tests::check(Tests::waitFor([&]() { return client.getPendingRequestCount() == 0; }),
+                 "las solicitudes encadenadas terminan");
+
+    int matched = 0;
+    for (int i = 0; i < count; i++) {
+        matched += outcomes[i].body == "/p/" + std::to_string(i) ? 1 : 0;
+    }
+    Tests::check(matched == count, "las respuestas encadenadas llegan en orden a su solicitud");
+    Tests::check(server.getAcceptedConnections() == 1, "el pipelining usa una sola conexión");
+    Tests::check(maxBatch > 1 && maxBatch <= 8, "se encadenan varias solicitudes sin superar la profundidad");
+}
+
+void testChunkedAndCompressedBodies() {
+    Tests::LoopbackServer server([](int fd) {
+        std::string pending;
+        Tests::ReceivedRequest request;
+        while (Tests::readHttpRequest(fd, pending, request)) {
+            std::string reply;
+            if (request.target == "/chunked") {
+                reply = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+                        "5\r\nHola,\r\n6\r\n mundo\r\n0\r\n\r\n";
+            } else {
+                // /bomb: 64 MiB de ceros que ocupan unos 64 KiB comprimidos
+                std::string compressed = request.target == "/bomb" ? gzipCompress(std::string(64 * 1024 * 1024, '\0'))
+                                                                   : gzipCompress(std::string(10000, 'z'));
+                reply = "HTTP/1.1 200 OK\r\nContent-Encoding: gzip\r\nContent-Length: " +
+                        std::to_string(compressed.size()) + "\r\n\r\n" + compressed;
+            }
+            if (!Tests::sendAll(fd, reply)) {
+                return;
+            }
+        }
+    });
+    std::string base = "http://127.0.0.1:" + std::to_string(server.getPort());
+
+    HttpClient client;
+    Outcome chunked;
+    Outcome compressed;
+    sendGet(client, base + "/chunked", chunked);
+    sendGet(client, base + "/gzip", compressed);
+    Tests::check(Tests::waitFor([&]() { return chunked.done && compressed.done; }), "las respuestas codificadas terminan");
+    Tests::check(chunked.body == "Hola, mundo", "el cuerpo chunked se reensambla");
+    Tests::check(compressed.body == std::string(10000, 'z'), "el cuerpo gzip se descomprime");
+
+    Outcome bomb;
+    sendGet(client, base + "/bomb", bomb);
+    Tests::check(Tests::waitFor([&]() { return bomb.done.load(); }), "la bomba de compresión termina");
+    Tests::check(bomb.status == 0 && bomb.body.size() < 2 * 1024 * 1024, "la bomba de compresión hace fallar la respuesta");
+}
+
+void testConnectionFailure() {
+    // Obtener un puerto libre cerrando un servidor recién abierto
+    int port;
+    {
+        Tests::LoopbackServer server([](int) {});
+        port = server.getPort();
+    }
+
+    HttpClient client;
+    client.setTimeout(2000);
+    Outcome failed;
+    sendGet(client, "http://127.0.0.1:" + std::to_string(port) + "/", failed);
+    Tests::check(Tests::waitFor([&]() { return failed.done.load(); }), "la conexión rechazada termina");
+    Tests::check(failed.status == 0, "la conexión rechazada se notifica con código 0");
+}
+
+void testIpv6Literal() {
+    // El servidor devuelve la cabecera Host que recibe
+    Tests::LoopbackServer server([](int fd) {
+        std::string pending;
+        Tests::ReceivedRequest request;
+        while (Tests::readHttpRequest(fd, pending, request)) {
+            std::string host;
+            size_t start = request.headers.find("Host: ");
+            if (start != std::string::npos) {
+                start += 6;
+                host = request.headers.substr(start, request.headers.find("\r\n", start) - start);
+            }
+            if (!Tests::sendAll(fd, "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(host.size()) +
+                                    "\r\n\r\n" + host)) {
+                return;
+            }
+        }
+    }, true);
+    if (!Tests::check(server.getPort() > 0, "el servidor local escucha en ::1")) {
+        return;
+    }
+    std::string authority = "[::1]:" + std::to_string(server.getPort());
+
+    HttpClient client;
+    Outcome get;
+    sendGet(client, "http://" + authority + "/", get);
+    Tests::check(Tests::waitFor([&]() { return get.done.load(); }), "GET a una dirección IPv6 termina");
+    Tests::check(get.status == 200, "GET a una dirección IPv6 devuelve 200");
+    Tests::check(get.body == authority, "la cabecera Host conserva los corchetes de la dirección IPv6");
+}
+
+} // namespace
+
+int main() {
+    testSimpleRequests();
+    testManyConcurrentRequests();
+    testPipelining();
+    testChunkedAndCompressedBodies();
+    testConnectionFailure();
+    testIpv6Literal();
+    return Tests::finish("HttpClientTest");
+}
@@ -0,0 +1,185 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Tests de SignatureMatcher: coincidencias solapadas, mayúsculas, firmas
+ * repartidas entre fragmentos y comparación con una búsqueda ingenua
+ */
+
+#include "TestSupport.h"
+#include "Network/SignatureMatcher.h"
+#include <algorithm>
+#include <random>
+
+using Core::Network::ByteBuffer;
+using Core::Network::SignatureMatcher;
+
+namespace {
+
+// Coincidencia: posición en la que termina y firma
+using Match = std::pair<size_t, size_t>;
+
+std::vector<Match> collect(const SignatureMatcher& matcher, std::string_view text) {
+    std::vector<Match> matches;
+    matcher.scan(text, [&matches](size_t pattern, size_t end) {
+        matches.emplace_back(end, pattern);
+        return true;
+    });
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+std::vector<Match> collect(const SignatureMatcher& matcher, const ByteBuffer& data) {
+    std::vector<Match> matches;
+    matcher.scan(data, [&matches](size_t pattern, size_t end) {
+        matches.emplace_back(end, pattern);
+        return true;
+    });
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+char lower(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Búsqueda de referencia: cada firma en cada posición, sin distinguir mayúsculas ASCII
+std::vector<Match> naive(const std::vector<std::string>& patterns, std::string_view text) {
+    std::vector<Match> matches;
+    for (size_t p = 0; p < patterns.size(); p++) {
+        const std::string& pattern = patterns[p];
+        if (pattern.empty()) continue;
+        for (size_t start = 0; start + pattern.size() <= text.size(); start++) {
+            bool equal = true;
+            for (size_t i = 0; i < pattern.size() && equal; i++) {
+                equal = lower(text[start + i]) == lower(pattern[i]);
+            }
+            if (equal) matches.emplace_back(start + pattern.size(), p);
+        }
+    }
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+// Buffer con un fragmento distinto entre cada par de cortes
+ByteBuffer chunked(std::string_view text, const std::vector<size_t>& splits) {
+    ByteBuffer data;
+    size_t position = 0;
+    for (size_t split : splits) {
+        data.append(ByteBuffer::copyOf(text.data() + position, split - position));
+        position = split;
+    }
+    data.append(ByteBuffer::copyOf(text.data() + position, text.size() - position));
+    return data;
+}
+
+void testOverlappingPatterns() {
+    SignatureMatcher matcher({"he", "she", "hers", "his"});
+    Tests::check(collect(matcher, "ushers") == std::vector<Match>{{4, 0}, {4, 1}, {6, 2}},
+                 "se encuentran las firmas solapadas y contenidas en otras");
+    Tests::check(collect(matcher, "hishehers") == naive({"he", "she", "hers", "his"}, "hishehers"),
+                 "las firmas consecutivas comparten caracteres");
+    Tests::check(collect(matcher, "").empty() && collect(matcher, "xyz").empty(), "sin firmas no hay coincidencias");
+
+    SignatureMatcher withEmpty({"", "a", ""});
+    Tests::check(collect(withEmpty, "aa") == std::vector<Match>{{1, 1}, {2, 1}}, "las firmas vacías se ignoran");
+}
+
+void testCaseFolding() {
+    std::vector<std::string> patterns{"UNION select", "<Script", "\xC3\xA9"};
+    SignatureMatcher matcher(patterns);
+    Tests::check(collect(matcher, "1 uNiOn SeLeCt 2") == std::vector<Match>{{14, 0}},
+                 "las letras ASCII no distinguen mayúsculas");
+    Tests::check(collect(matcher, "<SCRIPT>") == std::vector<Match>{{7, 1}}, "la firma en mayúsculas se encuentra en minúsculas");
+    Tests::check(collect(matcher, "\xC3\x89 \xC3\xA9") == std::vector<Match>{{5, 2}},
+                 "los bytes no ASCII se comparan tal cual");
+}
+
+void testChunkBoundaries() {
+    std::vector<std::string> patterns{"union select", "sleep(", "ORA-00933", "s"};
+    SignatureMatcher matcher(patterns);
+    std::string text = "id=1 UNION SELECT sleep(5) -- ORA-00933 union  select";
+    std::vector<Match> whole = collect(matcher, text);
+    Tests::check(whole == naive(patterns, text), "el texto entero coincide con la búsqueda ingenua");
+
+    bool everySplit = true;
+    for (size_t split = 1; split < text.size(); split++) {
+        everySplit = everySplit && collect(matcher, chunked(text, {split})) == whole;
+    }
+    Tests::check(everySplit, "una firma partida entre dos fragmentos se encuentra");
+
+    std::vector<size_t> bytes;
+    for (size_t i = 1; i < text.size(); i++) {
+        bytes.push_back(i);
+    }
+    ByteBuffer byteChunks = chunked(text, bytes);
+    Tests::check(byteChunks.chunkCount() == text.size() && collect(matcher, byteChunks) == whole,
+                 "con fragmentos de un byte se encuentran las mismas firmas");
+
+    // El cursor continúa la búsqueda de un flujo fragmento a fragmento
+    SignatureMatcher::Cursor cursor;
+    std::vector<Match> streamed;
+    for (size_t i = 0; i < text.size(); i += 7) {
+        matcher.feed(cursor, std::string_view(text).substr(i, 7), [&streamed](size_t pattern, size_t end) {
+            streamed.emplace_back(end, pattern);
+            return true;
+        });
+    }
+    std::sort(streamed.begin(), streamed.end());
+    Tests::check(streamed == whole && cursor.offset == text.size(), "feed mantiene el estado entre fragmentos");
+}
+
+void testEarlyStop() {
+    SignatureMatcher matcher({"a", "b"});
+    int calls = 0;
+    bool completed = matcher.scan("xxaxbxa", [&calls](size_t, size_t) {
+        calls++;
+        return false;
+    });
+    Tests::check(!completed && calls == 1, "devolver false detiene la búsqueda en la primera coincidencia");
+
+    calls = 0;
+    completed = matcher.scan(chunked("xxaxbxa", {1, 3, 5}), [&calls](size_t pattern, size_t) {
+        calls++;
+        return pattern != 1;
+    });
+    Tests::check(!completed && calls == 2, "la búsqueda en un buffer se detiene en el fragmento de la coincidencia");
+}
+
+void testRandomAgainstNaive() {
+    // Alfabeto pequeño para que haya muchos solapamientos y prefijos comunes
+    std::mt19937 random(11);
+    const char alphabet[] = "abAB-";
+    int mismatches = 0;
+    for (int round = 0; round < 300; round++) {
+        std::vector<std::string> patterns(1 + random() % 8);
+        for (auto& pattern : patterns) {
+            pattern.resize(random() % 5);
+            for (char& c : pattern) c = alphabet[random() % 5];
+        }
+        SignatureMatcher matcher(patterns);
+
+        std::string text(random() % 200, ' ');
+        for (char& c : text) c = alphabet[random() % 5];
+
+        std::vector<Match> expected = naive(patterns, text);
+        std::vector<size_t> splits;
+        for (size_t position = random() % 9 + 1; position < text.size(); position += random() % 9 + 1) {
+            splits.push_back(position);
+        }
+        if (collect(matcher, text) != expected || collect(matcher, chunked(text, splits)) != expected) {
+            mismatches++;
+        }
+    }
+    Tests::check(mismatches == 0, "las firmas al azar coinciden con la búsqueda ingenua, entera y por fragmentos");
+}
+
+} // namespace
+
+int main() {
+    testOverlappingPatterns();
+    testCaseFolding();
+    testChunkBoundaries();
+    testEarlyStop();
+    testRandomAgainstNaive();
+    return Tests::finish("SignatureMatcherTest");
+}
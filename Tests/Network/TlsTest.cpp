@@ -0,0 +1,182 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Tests de HttpClient contra un servidor HTTPS local con certificado autofirmado
+ */
+
+#include "TestSupport.h"
+#include "Network/DnsResolver.h"
+#include "Network/HttpClient.h"
+#include "Network/SocketManager.h"
+#include "Network/TlsConnection.h"
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+using Core::Network::ByteBuffer;
+using Core::Network::HttpClient;
+using Core::Network::SocketManager;
+using Headers = std::vector<std::pair<std::string, std::string>>;
+
+namespace {
+
+struct Outcome {
+    std::atomic<bool> done{false};
+    int status = -1;
+    std::string body;
+};
+
+/**
+ * Certificado autofirmado para 127.0.0.1 y localhost, generado al arrancar
+ */
+class SelfSignedCertificate {
+public:
+    SelfSignedCertificate() {
+        m_key = EVP_EC_gen("P-256");
+        m_certificate = X509_new();
+        X509_set_version(m_certificate, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(m_certificate), 1);
+        X509_gmtime_adj(X509_getm_notBefore(m_certificate), -3600);
+        X509_gmtime_adj(X509_getm_notAfter(m_certificate), 24 * 3600);
+        X509_set_pubkey(m_certificate, m_key);
+
+        X509_NAME* name = X509_get_subject_name(m_certificate);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                   reinterpret_cast<const unsigned char*>("BlackWidow test"), -1, -1, 0);
+        X509_set_issuer_name(m_certificate, name);
+
+        X509V3_CTX context;
+        X509V3_set_ctx_nodb(&context);
+        X509V3_set_ctx(&context, m_certificate, m_certificate, nullptr, nullptr, 0);
+        X509_EXTENSION* altNames = X509V3_EXT_conf_nid(nullptr, &context, NID_subject_alt_name,
+                                                       "IP:127.0.0.1,DNS:localhost");
+        X509_add_ext(m_certificate, altNames, -1);
+        X509_EXTENSION_free(altNames);
+        X509_sign(m_certificate, m_key, EVP_sha256());
+
+        // Fichero PEM para TlsContext::loadCaFile
+        char path[] = "/tmp/blackwidow-tls-test-XXXXXX";
+        int fd = mkstemp(path);
+        m_path = path;
+        FILE* file = fdopen(fd, "w");
+        PEM_write_X509(file, m_certificate);
+        fclose(file);
+    }
+
+    ~SelfSignedCertificate() {
+        unlink(m_path.c_str());
+        X509_free(m_certificate);
+        EVP_PKEY_free(m_key);
+    }
+
+    SelfSignedCertificate(const SelfSignedCertificate&) = delete;
+    SelfSignedCertificate& operator=(const SelfSignedCertificate&) = delete;
+
+    EVP_PKEY* getKey() const { return m_key; }
+    X509* getCertificate() const { return m_certificate; }
+    const std::string& getPath() const { return m_path; }
+
+private:
+    EVP_PKEY* m_key;
+    X509* m_certificate;
+    std::string m_path;
+};
+
+/**
+ * Responde una única solicitud por conexión y la cierra, de modo que cada
+ * solicitud necesita una negociación nueva
+ */
+void serveTls(SSL_CTX* context, int fd) {
+    SSL* ssl = SSL_new(context);
+    SSL_set_fd(ssl, fd);
+    if (SSL_accept(ssl) == 1) {
+        std::string request;
+        char buffer[4096];
+        int received = 0;
+        while (request.find("\r\n\r\n") == std::string::npos &&
+               (received = SSL_read(ssl, buffer, sizeof(buffer))) > 0) {
+            request.append(buffer, static_cast<size_t>(received));
+        }
+        if (request.find("\r\n\r\n") != std::string::npos) {
+            std::string reply = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nConnection: close\r\n\r\nok";
+            SSL_write(ssl, reply.data(), static_cast<int>(reply.size()));
+            SSL_shutdown(ssl);
+        }
+    }
+    SSL_free(ssl);
+}
+
+void sendGet(HttpClient& client, const std::string& url, Outcome& outcome) {
+    client.sendRequest(url, "GET", {}, {}, [&outcome](int status, const Headers&, const ByteBuffer& body) {
+        outcome.status = status;
+        outcome.body = body.toString();
+        outcome.done = true;
+    });
+}
+
+int fetch(HttpClient& client, const std::string& url) {
+    Outcome outcome;
+    sendGet(client, url, outcome);
+    Tests::waitFor([&]() { return outcome.done.load(); });
+    return outcome.status;
+}
+
+void testSelfSignedServer() {
+    SelfSignedCertificate certificate;
+    SSL_CTX* serverContext = SSL_CTX_new(TLS_server_method());
+    SSL_CTX_use_certificate(serverContext, certificate.getCertificate());
+    SSL_CTX_use_PrivateKey(serverContext, certificate.getKey());
+    SSL_CTX_set_session_id_context(serverContext, reinterpret_cast<const unsigned char*>("tls-test"), 8);
+
+    {
+        Tests::LoopbackServer server([serverContext](int fd) { serveTls(serverContext, fd); });
+        std::string url = "https://127.0.0.1:" + std::to_string(server.getPort()) + "/";
+
+        // Por defecto se verifica el certificado: el autofirmado se rechaza
+        auto defaultSockets = std::make_shared<SocketManager>();
+        HttpClient verifying;
+        verifying.setSocketManager(defaultSockets);
+        Tests::check(fetch(verifying, url) == 0, "un certificado autofirmado se rechaza por defecto");
+        Tests::check(defaultSockets->getTlsContext()->getStats().failedHandshakes >= 1,
+                     "la negociación rechazada se cuenta como fallida");
+
+        HttpClient insecure;
+        insecure.setVerifySsl(false);
+        Tests::check(fetch(insecure, url) == 200, "sin verificación se acepta el certificado autofirmado");
+
+        // Confiando en el certificado, la verificación pasa y las conexiones
+        // siguientes reanudan la sesión
+        auto trustedSockets = std::make_shared<SocketManager>();
+        Tests::check(trustedSockets->getTlsContext()->loadCaFile(certificate.getPath()),
+                     "se carga el certificado como CA de confianza");
+        HttpClient trusted;
+        trusted.setSocketManager(trustedSockets);
+        Tests::check(fetch(trusted, url) == 200, "el certificado de confianza se verifica");
+        Tests::check(fetch(trusted, url) == 200 && fetch(trusted, url) == 200,
+                     "las conexiones siguientes también se verifican");
+
+        Core::Network::TlsStats stats = trustedSockets->getTlsContext()->getStats();
+        Tests::check(stats.fullHandshakes == 1 && stats.resumedHandshakes == 2,
+                     "las conexiones nuevas reanudan la sesión TLS");
+
+        // El nombre del certificado no cubre otro host aunque la CA sea de confianza
+        HttpClient wrongName;
+        auto wrongNameSockets = std::make_shared<SocketManager>();
+        wrongNameSockets->getTlsContext()->loadCaFile(certificate.getPath());
+        wrongNameSockets->getDnsCache()->addHostOverride("other.test", "127.0.0.1");
+        wrongName.setSocketManager(wrongNameSockets);
+        Tests::check(fetch(wrongName, "https://other.test:" + std::to_string(server.getPort()) + "/") == 0,
+                     "se rechaza un certificado emitido para otro nombre");
+    }
+
+    SSL_CTX_free(serverContext);
+}
+
+} // namespace
+
+int main() {
+    testSelfSignedServer();
+    return Tests::finish("TlsTest");
+}
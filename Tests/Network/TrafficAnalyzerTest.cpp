@@ -0,0 +1,176 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Tests de la cadena de interceptores de TrafficAnalyzer: registro y
+ * eliminación concurrentes con el tráfico y liberación de las cadenas sustituidas
+ */
+
+#include "TestSupport.h"
+#include "Network/TrafficAnalyzer.h"
+#include <cstdlib>
+#include <set>
+
+using Core::Network::ByteBuffer;
+using Core::Network::TrafficAnalyzer;
+using Headers = std::vector<std::pair<std::string, std::string>>;
+
+namespace {
+
+/**
+ * Estado capturado por los interceptores
+ * Cuenta las copias vivas: cada cadena publicada guarda su propia copia de
+ * cada interceptor, así que el contador dice cuántas cadenas siguen en memoria.
+ */
+struct Tracker {
+    static std::atomic<int> s_live;
+    static constexpr unsigned CANARY = 0xC0FFEE;
+
+    std::string value;
+    unsigned canary;
+
+    explicit Tracker(std::string text) : value(std::move(text)), canary(CANARY) { s_live++; }
+    Tracker(const Tracker& other) : value(other.value), canary(other.canary) { s_live++; }
+    Tracker(Tracker&& other) noexcept : value(std::move(other.value)), canary(other.canary) { s_live++; }
+    ~Tracker() {
+        canary = 0;
+        s_live--;
+    }
+};
+
+std::atomic<int> Tracker::s_live{0};
+
+TrafficAnalyzer::RequestInterceptor requestInterceptor(const std::string& name, const std::string& value) {
+    return [name, tracker = Tracker(value)](std::string&, std::string&, Headers& headers, ByteBuffer&) {
+        if (tracker.canary != Tracker::CANARY) {
+            std::abort();
+        }
+        headers.emplace_back(name, tracker.value);
+    };
+}
+
+TrafficAnalyzer::ResponseInterceptor responseInterceptor(const std::string& name, const std::string& value) {
+    return [name, tracker = Tracker(value)](int&, Headers& headers, ByteBuffer&) {
+        if (tracker.canary != Tracker::CANARY) {
+            std::abort();
+        }
+        headers.emplace_back(name, tracker.value);
+    };
+}
+
+/**
+ * Comprueba que un mensaje recorrió una cadena completa: los interceptores
+ * fijos en orden y después los temporales vigentes, cada uno una vez
+ */
+bool completeChain(const Headers& headers, const std::string& first, const std::string& second) {
+    if (headers.size() < 2 || headers[0] != Headers::value_type("X-Chain", first) ||
+        headers[1] != Headers::value_type("X-Chain", second)) {
+        return false;
+    }
+    std::set<std::string> temporary;
+    for (size_t i = 2; i < headers.size(); i++) {
+        if (headers[i].first != "X-Temp" || !temporary.insert(headers[i].second).second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testConcurrentRegistration() {
+    constexpr int TRAFFIC_THREADS = 4;
+    constexpr int CHURN_THREADS = 2;
+    constexpr int CHURN_ROUNDS = 2000;
+
+    {
+        TrafficAnalyzer analyzer;
+        analyzer.enableInterception(true);
+        analyzer.registerRequestInterceptor(requestInterceptor("X-Chain", "A"));
+        analyzer.registerRequestInterceptor(requestInterceptor("X-Chain", "B"));
+        analyzer.registerResponseInterceptor(responseInterceptor("X-Chain", "R1"));
+        analyzer.registerResponseInterceptor(responseInterceptor("X-Chain", "R2"));
+        int persistent = Tracker::s_live.load();
+
+        std::atomic<bool> stop{false};
+        std::atomic<size_t> messages{0};
+        std::atomic<size_t> incomplete{0};
+        std::vector<std::thread> traffic;
+        for (int t = 0; t < TRAFFIC_THREADS; t++) {
+            traffic.emplace_back([&]() {
+                while (!stop) {
+                    std::string url = "http://t/";
+                    std::string method = "GET";
+                    Headers requestHeaders;
+                    ByteBuffer body;
+                    analyzer.interceptRequest(url, method, requestHeaders, body);
+
+                    int status = 200;
+                    Headers responseHeaders;
+                    analyzer.interceptResponse(status, responseHeaders, body);
+
+                    if (!completeChain(requestHeaders, "A", "B") || !completeChain(responseHeaders, "R1", "R2")) {
+                        incomplete++;
+                    }
+                    messages++;
+                }
+            });
+        }
+
+        std::atomic<int> nextTemp{0};
+        std::atomic<int> failedRemovals{0};
+        std::vector<std::thread> churn;
+        for (int t = 0; t < CHURN_THREADS; t++) {
+            churn.emplace_back([&]() {
+                for (int round = 0; round < CHURN_ROUNDS; round++) {
+                    std::vector<int> ids;
+                    for (int i = 0; i < 2; i++) {
+                        ids.push_back(analyzer.registerRequestInterceptor(
+                            requestInterceptor("X-Temp", std::to_string(nextTemp++))));
+                    }
+                    ids.push_back(analyzer.registerResponseInterceptor(
+                        responseInterceptor("X-Temp", std::to_string(nextTemp++))));
+                    for (int id : ids) {
+                        if (!analyzer.removeInterceptor(id)) {
+                            failedRemovals++;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& thread : churn) {
+            thread.join();
+        }
+        stop = true;
+        for (auto& thread : traffic) {
+            thread.join();
+        }
+
+        Tests::check(messages > 0, "el tráfico avanza mientras se registran interceptores");
+        Tests::check(incomplete == 0, "cada mensaje recorre una cadena completa y ordenada");
+        Tests::check(failedRemovals == 0, "cada interceptor temporal se elimina una vez");
+
+        // Sin tráfico en curso solo queda la cadena publicada, con los interceptores fijos
+        Tests::check(Tracker::s_live == persistent, "las cadenas sustituidas se liberan al terminar el tráfico");
+        Tests::check(!analyzer.removeInterceptor(-1) && Tracker::s_live == persistent,
+                     "eliminar un interceptor inexistente no publica otra cadena");
+    }
+    Tests::check(Tracker::s_live == 0, "el destructor libera la cadena publicada");
+}
+
+void testPublishWithoutReaders() {
+    // Sin mensajes en curso cada cadena sustituida se libera al publicar la nueva
+    TrafficAnalyzer analyzer;
+    analyzer.enableInterception(true);
+    for (int i = 0; i < 100; i++) {
+        int id = analyzer.registerRequestInterceptor(requestInterceptor("X-Temp", std::to_string(i)));
+        analyzer.removeInterceptor(id);
+    }
+    Tests::check(Tracker::s_live == 0, "sin lectores las cadenas sustituidas se liberan al publicar");
+    Tests::check(!analyzer.hasActiveInterceptors(), "la cadena final no tiene interceptores");
+}
+
+} // namespace
+
+int main() {
+    testConcurrentRegistration();
+    testPublishWithoutReaders();
+    return Tests::finish("TrafficAnalyzerTest");
+}
@@ -0,0 +1,196 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación de las utilidades comunes de los tests
+ */
+
+#include "TestSupport.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace Tests {
+
+namespace {
+
+std::atomic<int> s_failures{0};
+std::atomic<int> s_checks{0};
+
+} // namespace
+
+bool check(bool condition, const std::string& description) {
+    s_checks++;
+    if (!condition) {
+        s_failures++;
+        std::fprintf(stderr, "FALLO: %s\n", description.c_str());
+    }
+    return condition;
+}
+
+int finish(const std::string& testName) {
+    std::printf("%s: %d comprobaciones, %d fallos\n", testName.c_str(), s_checks.load(), s_failures.load());
+    return s_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+bool waitFor(const std::function<bool()>& condition, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return true;
+}
+
+bool readHttpRequest(int fd, std::string& pending, ReceivedRequest& request) {
+    char buffer[16384];
+
+    size_t headerEnd;
+    while ((headerEnd = pending.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            return false;
+        }
+        pending.append(buffer, static_cast<size_t>(received));
+    }
+
+    size_t lineEnd = pending.find("\r\n");
+    std::string requestLine = pending.substr(0, lineEnd);
+    size_t firstSpace = requestLine.find(' ');
+    size_t secondSpace = requestLine.find(' ', firstSpace + 1);
+    request.method = requestLine.substr(0, firstSpace);
+    request.target = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+    request.headers = pending.substr(lineEnd + 2, headerEnd + 2 - (lineEnd + 2));
+
+    // Content-Length sin distinguir mayúsculas
+    size_t contentLength = 0;
+    size_t position = 0;
+    while (position < request.headers.size()) {
+        size_t end = request.headers.find("\r\n", position);
+        std::string line = request.headers.substr(position, end - position);
+        if (line.size() > 15 && strncasecmp(line.c_str(), "content-length:", 15) == 0) {
+            contentLength = std::strtoul(line.c_str() + 15, nullptr, 10);
+        }
+        position = end + 2;
+    }
+
+    size_t bodyStart = headerEnd + 4;
+    while (pending.size() < bodyStart + contentLength) {
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            return false;
+        }
+        pending.append(buffer, static_cast<size_t>(received));
+    }
+
+    request.body = pending.substr(bodyStart, contentLength);
+    pending.erase(0, bodyStart + contentLength);
+    return true;
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t result = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (result <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+LoopbackServer::LoopbackServer(ConnectionHandler handler, bool ipv6) :
+    m_handler(std::move(handler)),
+    m_listenFd(-1),
+    m_port(0),
+    m_running(false),
+    m_accepted(0) {
+
+    m_listenFd = socket(ipv6 ? AF_INET6 : AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0) {
+        return;
+    }
+
+    sockaddr_storage address{};
+    socklen_t length;
+    if (ipv6) {
+        auto* ipv6Address = reinterpret_cast<sockaddr_in6*>(&address);
+        ipv6Address->sin6_family = AF_INET6;
+        ipv6Address->sin6_addr = in6addr_loopback;
+        length = sizeof(sockaddr_in6);
+    } else {
+        auto* ipv4Address = reinterpret_cast<sockaddr_in*>(&address);
+        ipv4Address->sin_family = AF_INET;
+        ipv4Address->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        length = sizeof(sockaddr_in);
+    }
+    if (bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+        listen(m_listenFd, 1024) != 0 ||
+        getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        close(m_listenFd);
+        m_listenFd = -1;
+        return;
+    }
+
+    m_port = ntohs(ipv6 ? reinterpret_cast<sockaddr_in6*>(&address)->sin6_port
+                        : reinterpret_cast<sockaddr_in*>(&address)->sin_port);
+    m_running = true;
+    m_acceptThread = std::thread(&LoopbackServer::acceptLoop, this);
+}
+
+LoopbackServer::~LoopbackServer() {
+    m_running = false;
+    if (m_acceptThread.joinable()) {
+        m_acceptThread.join();
+    }
+
+    // Desbloquear los manejadores que sigan esperando datos
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (int fd : m_connectionFds) {
+            shutdown(fd, SHUT_RDWR);
+        }
+    }
+    for (auto& thread : m_connectionThreads) {
+        thread.join();
+    }
+    for (int fd : m_connectionFds) {
+        close(fd);
+    }
+    if (m_listenFd >= 0) {
+        close(m_listenFd);
+    }
+}
+
+void LoopbackServer::acceptLoop() {
+    while (m_running) {
+        pollfd descriptor{m_listenFd, POLLIN, 0};
+        if (poll(&descriptor, 1, 20) <= 0) {
+            continue;
+        }
+
+        int fd = accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        m_accepted++;
+
+        // El socket se cierra en el destructor, después de que termine el hilo
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_connectionFds.push_back(fd);
+        m_connectionThreads.emplace_back([this, fd]() {
+            m_handler(fd);
+            shutdown(fd, SHUT_RDWR);
+        });
+    }
+}
+
+} // namespace Tests
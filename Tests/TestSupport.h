@@ -0,0 +1,121 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Utilidades comunes de los tests: comprobaciones y servidor TCP local
+ */
+
+#pragma once
+
+#include <string>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+namespace Tests {
+
+/**
+ * Comprueba una condición y registra el fallo si no se cumple
+ * @param condition Condición a comprobar
+ * @param description Descripción de lo que se comprueba
+ * @return El valor de la condición
+ */
+bool check(bool condition, const std::string& description);
+
+/**
+ * Termina el test mostrando el resultado
+ * @param testName Nombre del test
+ * @return Código de salida del proceso (0 si no hubo fallos)
+ */
+int finish(const std::string& testName);
+
+/**
+ * Espera a que se cumpla una condición
+ * @param condition Condición a comprobar periódicamente
+ * @param timeout Tiempo máximo de espera
+ * @return true si la condición se cumplió antes del tiempo máximo
+ */
+bool waitFor(const std::function<bool()>& condition,
+             std::chrono::milliseconds timeout = std::chrono::milliseconds(10000));
+
+/**
+ * Solicitud HTTP/1.1 leída por el servidor local
+ */
+struct ReceivedRequest {
+    std::string method;
+    std::string target;
+    std::string headers;     // Cabeceras tal como llegaron, sin la línea de solicitud
+    std::string body;
+};
+
+/**
+ * Lee una solicitud HTTP/1.1 completa (con Content-Length o sin cuerpo)
+ * @param fd Socket conectado
+ * @param pending Datos recibidos y aún no consumidos; se conservan entre llamadas
+ * @param request Solicitud leída
+ * @return true si se leyó una solicitud, false si se cerró la conexión
+ */
+bool readHttpRequest(int fd, std::string& pending, ReceivedRequest& request);
+
+/**
+ * Envía todos los datos por un socket bloqueante
+ * @param fd Socket conectado
+ * @param data Datos a enviar
+ * @return true si se enviaron todos
+ */
+bool sendAll(int fd, const std::string& data);
+
+/**
+ * Servidor TCP en 127.0.0.1 (o ::1) con un puerto efímero
+ * Cada conexión aceptada se atiende en su propio hilo con el manejador dado,
+ * que es responsable de leer y escribir; el servidor cierra el socket al volver.
+ */
+class LoopbackServer {
+public:
+    using ConnectionHandler = std::function<void(int)>;
+
+    /**
+     * Constructor
+     * @param handler Manejador de cada conexión
+     * @param ipv6 true para escuchar en ::1 en lugar de 127.0.0.1
+     */
+    explicit LoopbackServer(ConnectionHandler handler, bool ipv6 = false);
+
+    /**
+     * Destructor
+     * Detiene el servidor y espera a los hilos de las conexiones
+     */
+    ~LoopbackServer();
+
+    LoopbackServer(const LoopbackServer&) = delete;
+    LoopbackServer& operator=(const LoopbackServer&) = delete;
+
+    /**
+     * Obtiene el puerto en el que escucha el servidor
+     * @return Puerto, o 0 si no se pudo abrir
+     */
+    int getPort() const { return m_port; }
+
+    /**
+     * Obtiene el número de conexiones aceptadas
+     * @return Conexiones aceptadas desde el inicio
+     */
+    size_t getAcceptedConnections() const { return m_accepted; }
+
+private:
+    void acceptLoop();
+
+    ConnectionHandler m_handler;
+    int m_listenFd;
+    int m_port;
+    std::atomic<bool> m_running;
+    std::atomic<size_t> m_accepted;
+    std::thread m_acceptThread;
+    std::mutex m_mutex;
+    std::vector<std::thread> m_connectionThreads;
+    std::vector<int> m_connectionFds;
+};
+
+} // namespace Tests
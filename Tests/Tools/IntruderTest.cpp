@@ -0,0 +1,174 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Tests de Intruder contra un servidor HTTP/1.1 local
+ */
+
+#include "TestSupport.h"
+#include "BurpLike/Intruder.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using Tools::BurpLike::AttackStats;
+using Tools::BurpLike::HttpRequest;
+using Tools::BurpLike::HttpResponse;
+using Tools::BurpLike::InsertionPoint;
+using Tools::BurpLike::Intruder;
+
+namespace {
+
+// Servidor que responde cada solicitud con su destino tras un retardo fijo
+// y cuenta cuántas veces recibe cada destino
+class DelayedEchoServer {
+public:
+    explicit DelayedEchoServer(std::chrono::milliseconds delay) :
+        m_server([this, delay](int fd) {
+            std::string pending;
+            Tests::ReceivedRequest request;
+            while (Tests::readHttpRequest(fd, pending, request)) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_targets[request.target]++;
+                }
+                std::this_thread::sleep_for(delay);
+                std::string body = request.method + " " + request.target;
+                if (!Tests::sendAll(fd, "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size()) +
+                                        "\r\n\r\n" + body)) {
+                    return;
+                }
+            }
+        }) {}
+
+    std::string url(const std::string& path) const {
+        return "http://127.0.0.1:" + std::to_string(m_server.getPort()) + path;
+    }
+
+    std::map<std::string, int> targets() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_targets;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::map<std::string, int> m_targets;
+    Tests::LoopbackServer m_server;
+};
+
+std::vector<std::string> numbers(int count) {
+    std::vector<std::string> result;
+    for (int i = 0; i < count; i++) {
+        result.push_back(std::to_string(i));
+    }
+    return result;
+}
+
+// Comprueba que cada payload llegó exactamente una vez al servidor
+bool eachTargetOnce(const std::map<std::string, int>& targets, int count) {
+    if (targets.size() != static_cast<size_t>(count)) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        auto it = targets.find("/item?id=" + std::to_string(i));
+        if (it == targets.end() || it->second != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testRealRequests() {
+    DelayedEchoServer server(std::chrono::milliseconds(20));
+
+    Intruder intruder;
+    intruder.setBaseRequest(HttpRequest("GET", server.url("/item?id=x")));
+    intruder.addInsertionPoint(InsertionPoint(InsertionPoint::Type::URL_PARAMETER, "id", 0, 0));
+    intruder.addPayloadList(0, numbers(20));
+    intruder.setRequestInterval(0);
+    intruder.setThreadCount(4);
+
+    int echoed = 0;
+    bool started = intruder.startAttack([&echoed](const HttpRequest& request, const HttpResponse& response,
+                                                  const AttackStats&) {
+        if (response.statusCode == 200 && response.body == "GET " + request.url.substr(request.url.find("/item"))) {
+            echoed++;
+        }
+    });
+    Tests::check(started, "el ataque se inicia");
+    Tests::check(echoed == 20, "cada respuesta es la del servidor para su solicitud");
+    Tests::check(eachTargetOnce(server.targets(), 20), "el servidor recibe cada payload una vez");
+
+    AttackStats stats = intruder.getAttackStats();
+    Tests::check(stats.completedRequests == 20 && intruder.getResults().size() == 20,
+                 "se registran todos los resultados");
+    Tests::check(stats.p50LatencyMs >= 20, "la latencia medida incluye el retardo del servidor");
+}
+
+void testResumeKeepsResults() {
+    DelayedEchoServer server(std::chrono::milliseconds(2));
+
+    Intruder intruder;
+    intruder.setBaseRequest(HttpRequest("GET", server.url("/item?id=x")));
+    intruder.addInsertionPoint(InsertionPoint(InsertionPoint::Type::URL_PARAMETER, "id", 0, 0));
+    intruder.addPayloadList(0, numbers(40));
+    intruder.setRequestInterval(0);
+    intruder.setThreadCount(2);
+
+    // Detener el ataque a mitad y reanudarlo desde donde quedó
+    int received = 0;
+    intruder.startAttack([&](const HttpRequest&, const HttpResponse&, const AttackStats&) {
+        if (++received == 10) {
+            intruder.stopAttack();
+        }
+    });
+    size_t firstPart = intruder.getResults().size();
+    size_t resumeIndex = intruder.getResumeIndex();
+    Tests::check(firstPart >= 10 && firstPart < 40 && resumeIndex == firstPart,
+                 "el ataque detenido se puede reanudar tras la última solicitud enviada");
+
+    bool resumed = intruder.resumeAttack(Tools::BurpLike::AttackCallback(), resumeIndex);
+    AttackStats stats = intruder.getAttackStats();
+    Tests::check(resumed, "el ataque se reanuda");
+    Tests::check(intruder.getResults().size() == 40, "la reanudación conserva los resultados anteriores");
+    Tests::check(stats.completedRequests == 40 && stats.totalRequests == 40,
+                 "las estadísticas cuentan el ataque completo");
+    Tests::check(eachTargetOnce(server.targets(), 40), "ningún payload se envía dos veces al reanudar");
+
+    // Empezar de nuevo descarta el ataque anterior
+    intruder.startAttack(Tools::BurpLike::AttackCallback());
+    Tests::check(intruder.getResults().size() == 40 && intruder.getAttackStats().completedRequests == 40,
+                 "un ataque nuevo empieza sin resultados anteriores");
+}
+
+void testFailedRequests() {
+    // Puerto sin servidor: las solicitudes fallan con código 0
+    int port;
+    {
+        Tests::LoopbackServer closed([](int) {});
+        port = closed.getPort();
+    }
+
+    Intruder intruder;
+    intruder.setBaseRequest(HttpRequest("GET", "http://127.0.0.1:" + std::to_string(port) + "/?id=x"));
+    intruder.addInsertionPoint(InsertionPoint(InsertionPoint::Type::URL_PARAMETER, "id", 0, 0));
+    intruder.addPayloadList(0, numbers(3));
+    intruder.setRequestInterval(0);
+
+    int failed = 0;
+    intruder.startAttack([&failed](const HttpRequest&, const HttpResponse& response, const AttackStats&) {
+        if (response.statusCode == 0) {
+            failed++;
+        }
+    });
+    Tests::check(failed == 3, "las solicitudes que no llegan al servidor devuelven código 0");
+}
+
+} // namespace
+
+int main() {
+    testRealRequests();
+    testResumeKeepsResults();
+    testFailedRequests();
+    return Tests::finish("IntruderTest");
+}
@@ -5,19 +5,58 @@
  */
 
 #include "Intruder.h"
+#include "RequestGenerator.h"
+#include "../../Core/Network/HttpClient.h"
 #include "../../Utils/Logging/Logger.h"
-#include <fstream>
-#include <sstream>
+#include "../../Utils/Text/StringUtils.h"
 #include <thread>
 #include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <future>
 
 namespace Tools::BurpLike {
 
+namespace {
+
+/**
+ * Separa las cabeceras en texto ("Nombre: valor" por línea) en pares
+ */
+std::vector<std::pair<std::string, std::string>> parseHeaders(const std::string& headers) {
+    std::vector<std::pair<std::string, std::string>> result;
+    size_t start = 0;
+    while (start < headers.size()) {
+        size_t end = headers.find('\n', start);
+        if (end == std::string::npos) {
+            end = headers.size();
+        }
+        std::string_view line = Utils::Text::trim(std::string_view(headers).substr(start, end - start));
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        size_t colon = line.find(':');
+        if (colon != std::string_view::npos && colon > 0) {
+            result.emplace_back(std::string(Utils::Text::trim(line.substr(0, colon))),
+                                std::string(Utils::Text::trim(line.substr(colon + 1))));
+        }
+        start = end + 1;
+    }
+    return result;
+}
+
+} // namespace
+
 Intruder::Intruder() : 
     m_attackType(AttackType::SNIPER),
     m_attackRunning(false),
     m_requestInterval(500),
-    m_threadCount(1) {
+    m_threadCount(1),
+    m_rateLimiter(2.0, 1),
+    m_nextRequest(0),
+    m_firstAbandoned(SIZE_MAX),
+    m_resumeIndex(0),
+    m_previousElapsedSeconds(0.0),
+    m_httpClient(std::make_shared<Core::Network::HttpClient>()) {
     Utils::Logging::Logger::info("Inicializando herramienta Intruder");
 }
 
@@ -72,47 +111,60 @@ void Intruder::clearInsertionPoints() {
 
 void Intruder::addPayloadList(int position, const std::vector<std::string>& payloads) {
     if (position >= 0 && position < static_cast<int>(m_insertionPoints.size())) {
-        m_payloads[position] = payloads;
+        m_payloads[position] = PayloadWordlist::fromPayloads(payloads);
         Utils::Logging::Logger::info("Intruder: Lista de payloads añadida para la posición " + std::to_string(position));
     } else {
         Utils::Logging::Logger::error("Intruder: Posición de inserción inválida: " + std::to_string(position));
     }
 }
 
+void Intruder::setPayloadWordlist(int position, std::shared_ptr<const PayloadWordlist> wordlist) {
+    if (position >= 0 && position < static_cast<int>(m_insertionPoints.size())) {
+        m_payloads[position] = std::move(wordlist);
+        Utils::Logging::Logger::info("Intruder: Lista de payloads compartida asignada a la posición " + std::to_string(position));
+    } else {
+        Utils::Logging::Logger::error("Intruder: Posición de inserción inválida: " + std::to_string(position));
+    }
+}
+
 bool Intruder::loadPayloadFile(int position, const std::string& filePath) {
     if (position < 0 || position >= static_cast<int>(m_insertionPoints.size())) {
         Utils::Logging::Logger::error("Intruder: Posición de inserción inválida: " + std::to_string(position));
         return false;
     }
     
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
+    std::shared_ptr<const PayloadWordlist> payloads = PayloadWordlist::fromFile(filePath);
+    if (!payloads) {
         Utils::Logging::Logger::error("Intruder: No se pudo abrir el archivo de payloads: " + filePath);
         return false;
     }
     
-    std::vector<std::string> payloads;
-    std::string line;
-    while (std::getline(file, line)) {
-        if (!line.empty()) {
-            payloads.push_back(line);
-        }
-    }
-    
-    file.close();
-    
-    if (payloads.empty()) {
+    if (payloads->empty()) {
         Utils::Logging::Logger::warning("Intruder: El archivo de payloads está vacío: " + filePath);
         return false;
     }
     
     m_payloads[position] = payloads;
-    Utils::Logging::Logger::info("Intruder: Cargados " + std::to_string(payloads.size()) + 
+    Utils::Logging::Logger::info("Intruder: Cargados " + std::to_string(payloads->size()) + 
                                " payloads desde " + filePath);
     return true;
 }
 
 bool Intruder::startAttack(std::function<void(const HttpRequest&, const HttpResponse&)> callback) {
+    if (!callback) {
+        return startAttack(AttackCallback());
+    }
+    
+    return startAttack([callback](const HttpRequest& request, const HttpResponse& response, const AttackStats&) {
+        callback(request, response);
+    });
+}
+
+bool Intruder::startAttack(AttackCallback callback) {
+    return resumeAttack(std::move(callback), 0);
+}
+
+bool Intruder::resumeAttack(AttackCallback callback, size_t startIndex) {
     if (m_attackRunning) {
         Utils::Logging::Logger::warning("Intruder: Ya hay un ataque en curso");
         return false;
@@ -125,59 +177,76 @@ bool Intruder::startAttack(std::function<void(const HttpRequest&, const HttpResp
     
     // Verificar que hay payloads para todos los puntos de inserción necesarios
     for (size_t i = 0; i < m_insertionPoints.size(); i++) {
-        if (m_payloads.find(i) == m_payloads.end() || m_payloads[i].empty()) {
+        auto it = m_payloads.find(static_cast<int>(i));
+        if (it == m_payloads.end() || !it->second || it->second->empty()) {
             Utils::Logging::Logger::error("Intruder: No hay payloads definidos para el punto de inserción " + 
                                         std::to_string(i));
             return false;
         }
     }
     
-    // Generar las solicitudes para el ataque
-    std::vector<HttpRequest> requests = generateRequests();
+    // Las solicitudes se generan bajo demanda a partir de su índice
+    RequestGenerator generator(m_attackType, m_baseRequest, m_insertionPoints, m_payloads);
     
-    if (requests.empty()) {
+    if (generator.size() == 0) {
         Utils::Logging::Logger::error("Intruder: No se generaron solicitudes para el ataque");
         return false;
     }
     
-    Utils::Logging::Logger::info("Intruder: Iniciando ataque con " + std::to_string(requests.size()) + 
-                               " solicitudes");
+    if (startIndex >= generator.size()) {
+        Utils::Logging::Logger::error("Intruder: Índice de reanudación fuera de rango: " + 
+                                    std::to_string(startIndex));
+        return false;
+    }
+    
+    size_t pending = generator.size() - startIndex;
+    size_t workerCount = std::min(static_cast<size_t>(std::max(m_threadCount, 1)), pending);
+    Utils::Logging::Logger::info("Intruder: Iniciando ataque con " + std::to_string(pending) + 
+                               " solicitudes desde el índice " + std::to_string(startIndex) + 
+                               " y " + std::to_string(workerCount) + " hilos");
     
+    {
+        std::lock_guard<std::mutex> lock(m_resultsMutex);
+        if (startIndex == 0) {
+            // Ataque nuevo: se descartan los resultados del anterior
+            m_results.clear();
+            m_classifier.clear();
+            m_latencyCounts.clear();
+            m_stats = AttackStats();
+            m_previousElapsedSeconds = 0.0;
+        } else {
+            // Reanudación: se conservan los resultados, los grupos y las
+            // estadísticas de la parte ya enviada
+            m_previousElapsedSeconds = m_stats.elapsedSeconds;
+        }
+        m_stats.totalRequests = generator.size();
+        m_attackStart = std::chrono::steady_clock::now();
+        m_lastPercentileUpdate = m_attackStart;
+    }
+    
+    m_nextRequest = startIndex;
+    m_firstAbandoned = SIZE_MAX;
     m_attackRunning = true;
-    m_results.clear();
     
-    // Aquí se implementaría el código para ejecutar el ataque en hilos separados
-    // Por ahora, simulamos el envío de solicitudes
+    // Los hilos de trabajo toman solicitudes de la cola compartida hasta agotarla
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.emplace_back(&Intruder::workerLoop, this, std::cref(generator), std::cref(callback));
+    }
     
-    // Simulación de envío de solicitudes
-    for (const auto& request : requests) {
-        if (!m_attackRunning) {
-            break; // El ataque fue detenido
-        }
-        
-        // Simular envío de solicitud
-        HttpResponse response;
-        response.statusCode = 200;
-        response.statusText = "OK";
-        response.headers = "Content-Type: text/html\r\nServer: BlackWidow/1.0";
-        response.body = "<html><body><h1>Respuesta de prueba</h1></body></html>";
-        response.timeMs = 150; // Tiempo simulado
-        
-        // Guardar resultado
-        m_results.push_back(std::make_pair(request, response));
-        
-        // Llamar al callback
-        if (callback) {
-            callback(request, response);
-        }
-        
-        // Esperar el intervalo configurado
-        std::this_thread::sleep_for(std::chrono::milliseconds(m_requestInterval));
+    for (auto& worker : workers) {
+        worker.join();
     }
     
     m_attackRunning = false;
-    Utils::Logging::Logger::info("Intruder: Ataque completado con " + std::to_string(m_results.size()) + 
-                               " resultados");
+    m_resumeIndex = std::min({m_nextRequest.load(), m_firstAbandoned.load(), generator.size()});
+    
+    AttackStats stats = getAttackStats();
+    Utils::Logging::Logger::info("Intruder: Ataque completado con " + std::to_string(stats.completedRequests) + 
+                               " resultados (" + std::to_string(static_cast<int>(stats.requestsPerSecond)) + 
+                               " req/s, p50 " + std::to_string(stats.p50LatencyMs) + 
+                               " ms, p99 " + std::to_string(stats.p99LatencyMs) + " ms)");
     
     return true;
 }
@@ -193,14 +262,36 @@ bool Intruder::isAttackRunning() const {
     return m_attackRunning;
 }
 
-std::vector<std::pair<HttpRequest, HttpResponse>> Intruder::getResults() const {
+const ResultStore& Intruder::getResults() const {
     return m_results;
 }
 
+const ResponseClassifier& Intruder::getResponseClassifier() const {
+    return m_classifier;
+}
+
+size_t Intruder::getResumeIndex() const {
+    return m_resumeIndex;
+}
+
+AttackStats Intruder::getAttackStats() const {
+    std::lock_guard<std::mutex> lock(m_resultsMutex);
+    return m_stats;
+}
+
 void Intruder::setRequestInterval(int interval) {
     m_requestInterval = interval;
+    m_rateLimiter.configure(interval > 0 ? 1000.0 / interval : 0.0, 1);
     Utils::Logging::Logger::info("Intruder: Intervalo entre solicitudes establecido a " + 
-                               std::to_string(interval) + " ms");
+                               std::to_string(interval) + " ms por host");
+}
+
+void Intruder::setRateLimit(double requestsPerSecond, int burst) {
+    m_requestInterval = requestsPerSecond > 0.0 ? static_cast<int>(1000.0 / requestsPerSecond) : 0;
+    m_rateLimiter.configure(requestsPerSecond, burst);
+    Utils::Logging::Logger::info("Intruder: Límite de tasa establecido a " + 
+                               std::to_string(requestsPerSecond) + " req/s por host (ráfaga " + 
+                               std::to_string(burst) + ")");
 }
 
 void Intruder::setThreadCount(int threads) {
@@ -208,252 +299,146 @@ void Intruder::setThreadCount(int threads) {
     Utils::Logging::Logger::info("Intruder: Número de hilos establecido a " + std::to_string(threads));
 }
 
-std::vector<HttpRequest> Intruder::generateRequests() {
-    std::vector<HttpRequest> requests;
-    
-    switch (m_attackType) {
-        case AttackType::SNIPER: {
-            // En modo Sniper, se ataca un solo punto de inserción a la vez
-            for (size_t pointIndex = 0; pointIndex < m_insertionPoints.size(); pointIndex++) {
-                const auto& point = m_insertionPoints[pointIndex];
-                const auto& payloads = m_payloads[pointIndex];
-                
-                for (const auto& payload : payloads) {
-                    HttpRequest req = applyPayload(m_baseRequest, point, payload);
-                    requests.push_back(req);
-                }
-            }
-            break;
+void Intruder::workerLoop(const RequestGenerator& generator, const AttackCallback& callback) {
+    while (m_attackRunning) {
+        size_t index = m_nextRequest.fetch_add(1);
+        if (index >= generator.size()) {
+            break; // Cola agotada
         }
         
-        case AttackType::BATTERING_RAM: {
-            // En modo Battering Ram, se usa el mismo payload en todos los puntos de inserción
-            const auto& payloads = m_payloads[0]; // Usamos la primera lista de payloads
-            
-            for (const auto& payload : payloads) {
-                HttpRequest req = m_baseRequest;
-                
-                // Aplicar el mismo payload a todos los puntos de inserción
-                for (const auto& point : m_insertionPoints) {
-                    req = applyPayload(req, point, payload);
-                }
-                
-                requests.push_back(req);
+        HttpRequest request = generator.generate(index);
+        if (!waitForRateLimit(extractHost(request.url))) {
+            // El ataque fue detenido: recordar el índice para poder reanudarlo
+            size_t abandoned = m_firstAbandoned.load();
+            while (index < abandoned && !m_firstAbandoned.compare_exchange_weak(abandoned, index)) {
             }
             break;
         }
         
-        case AttackType::PITCHFORK: {
-            // En modo Pitchfork, se usan payloads sincronizados
-            // Necesitamos determinar cuántas iteraciones hacer (el mínimo de todas las listas)
-            size_t minPayloads = SIZE_MAX;
-            for (size_t i = 0; i < m_insertionPoints.size(); i++) {
-                minPayloads = std::min(minPayloads, m_payloads[i].size());
-            }
-            
-            for (size_t i = 0; i < minPayloads; i++) {
-                HttpRequest req = m_baseRequest;
-                
-                for (size_t pointIndex = 0; pointIndex < m_insertionPoints.size(); pointIndex++) {
-                    req = applyPayload(req, m_insertionPoints[pointIndex], m_payloads[pointIndex][i]);
-                }
-                
-                requests.push_back(req);
-            }
-            break;
-        }
+        HttpResponse response = sendAttackRequest(request);
+        AttackStats stats = recordResult(request, response);
         
-        case AttackType::CLUSTER_BOMB: {
-            // En modo Cluster Bomb, se prueban todas las combinaciones posibles
-            // Implementación recursiva para generar todas las combinaciones
-            std::vector<size_t> indices(m_insertionPoints.size(), 0);
-            bool done = false;
-            
-            while (!done) {
-                HttpRequest req = m_baseRequest;
-                
-                // Aplicar los payloads actuales a cada punto de inserción
-                for (size_t pointIndex = 0; pointIndex < m_insertionPoints.size(); pointIndex++) {
-                    req = applyPayload(req, m_insertionPoints[pointIndex], 
-                                      m_payloads[pointIndex][indices[pointIndex]]);
-                }
-                
-                requests.push_back(req);
-                
-                // Incrementar los índices para la siguiente combinación
-                done = true;
-                for (int i = static_cast<int>(indices.size()) - 1; i >= 0; i--) {
-                    indices[i]++;
-                    if (indices[i] < m_payloads[i].size()) {
-                        done = false;
-                        break;
-                    }
-                    indices[i] = 0;
-                }
-            }
-            break;
+        if (callback) {
+            std::lock_guard<std::mutex> lock(m_callbackMutex);
+            callback(request, response, stats);
         }
     }
-    
-    return requests;
 }
 
-HttpRequest Intruder::applyPayload(const HttpRequest& request, const InsertionPoint& point, const std::string& payload) {
-    HttpRequest modifiedRequest = request;
+bool Intruder::waitForRateLimit(const std::string& host) {
+    auto deadline = std::chrono::steady_clock::now() + m_rateLimiter.reserve(host);
     
-    // Aplicar el payload según el tipo de punto de inserción
-    switch (point.type) {
-        case InsertionPoint::Type::URL_PATH: {
-            // Modificar la ruta de la URL
-            size_t pathStart = modifiedRequest.url.find('/', 8); // Buscar después de http://
-            if (pathStart != std::string::npos) {
-                std::string baseUrl = modifiedRequest.url.substr(0, pathStart);
-                std::string path = modifiedRequest.url.substr(pathStart);
-                
-                // Reemplazar en la ruta
-                size_t replaceStart = point.startPosition - pathStart;
-                size_t replaceLength = point.endPosition - point.startPosition;
-                
-                if (replaceStart < path.length()) {
-                    path = path.substr(0, replaceStart) + payload + 
-                           path.substr(replaceStart + replaceLength);
-                    modifiedRequest.url = baseUrl + path;
-                }
-            }
-            break;
-        }
-        
-        case InsertionPoint::Type::URL_PARAMETER: {
-            // Modificar un parámetro en la URL
-            size_t queryStart = modifiedRequest.url.find('?');
-            if (queryStart != std::string::npos) {
-                std::string baseUrl = modifiedRequest.url.substr(0, queryStart + 1);
-                std::string query = modifiedRequest.url.substr(queryStart + 1);
-                
-                // Buscar el parámetro
-                std::string paramPrefix = point.name + "=";
-                size_t paramPos = query.find(paramPrefix);
-                
-                if (paramPos != std::string::npos) {
-                    size_t valueStart = paramPos + paramPrefix.length();
-                    size_t valueEnd = query.find('&', valueStart);
-                    if (valueEnd == std::string::npos) valueEnd = query.length();
-                    
-                    // Reemplazar el valor
-                    query = query.substr(0, valueStart) + payload + 
-                            (valueEnd < query.length() ? query.substr(valueEnd) : "");
-                    
-                    modifiedRequest.url = baseUrl + query;
-                }
-            }
-            break;
-        }
-        
-        case InsertionPoint::Type::BODY_PARAMETER: {
-            // Modificar un parámetro en el cuerpo
-            std::string paramPrefix = point.name + "=";
-            size_t paramPos = modifiedRequest.body.find(paramPrefix);
-            
-            if (paramPos != std::string::npos) {
-                size_t valueStart = paramPos + paramPrefix.length();
-                size_t valueEnd = modifiedRequest.body.find('&', valueStart);
-                if (valueEnd == std::string::npos) valueEnd = modifiedRequest.body.length();
-                
-                // Reemplazar el valor
-                modifiedRequest.body = modifiedRequest.body.substr(0, valueStart) + payload + 
-                                      (valueEnd < modifiedRequest.body.length() ? 
-                                       modifiedRequest.body.substr(valueEnd) : "");
-            }
-            break;
-        }
-        
-        case InsertionPoint::Type::COOKIE: {
-            // Modificar una cookie en las cabeceras
-            std::string cookieHeader = "Cookie: ";
-            size_t cookiePos = modifiedRequest.headers.find(cookieHeader);
-            
-            if (cookiePos != std::string::npos) {
-                size_t cookieStart = cookiePos + cookieHeader.length();
-                size_t cookieEnd = modifiedRequest.headers.find("\r\n", cookieStart);
-                if (cookieEnd == std::string::npos) cookieEnd = modifiedRequest.headers.length();
-                
-                std::string cookies = modifiedRequest.headers.substr(cookieStart, cookieEnd - cookieStart);
-                
-                // Buscar la cookie específica
-                std::string cookiePrefix = point.name + "=";
-                size_t cookieValuePos = cookies.find(cookiePrefix);
-                
-                if (cookieValuePos != std::string::npos) {
-                    size_t valueStart = cookieValuePos + cookiePrefix.length();
-                    size_t valueEnd = cookies.find(';', valueStart);
-                    if (valueEnd == std::string::npos) valueEnd = cookies.length();
-                    
-                    // Reemplazar el valor
-                    cookies = cookies.substr(0, valueStart) + payload + 
-                             (valueEnd < cookies.length() ? cookies.substr(valueEnd) : "");
-                    
-                    // Reconstruir las cabeceras
-                    modifiedRequest.headers = modifiedRequest.headers.substr(0, cookieStart) + 
-                                             cookies + 
-                                             modifiedRequest.headers.substr(cookieEnd);
-                }
-            }
-            break;
+    // Dormir en tramos cortos para reaccionar rápido a stopAttack()
+    auto now = std::chrono::steady_clock::now();
+    while (now < deadline) {
+        if (!m_attackRunning) {
+            return false;
         }
-        
-        case InsertionPoint::Type::HEADER: {
-            // Modificar una cabecera específica
-            std::string headerPrefix = point.name + ": ";
-            size_t headerPos = modifiedRequest.headers.find(headerPrefix);
-            
-            if (headerPos != std::string::npos) {
-                size_t valueStart = headerPos + headerPrefix.length();
-                size_t valueEnd = modifiedRequest.headers.find("\r\n", valueStart);
-                if (valueEnd == std::string::npos) valueEnd = modifiedRequest.headers.length();
-                
-                // Reemplazar el valor
-                modifiedRequest.headers = modifiedRequest.headers.substr(0, valueStart) + 
-                                         payload + 
-                                         modifiedRequest.headers.substr(valueEnd);
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+            deadline - now, std::chrono::milliseconds(50)));
+        now = std::chrono::steady_clock::now();
+    }
+    
+    return true;
+}
+
+HttpResponse Intruder::sendAttackRequest(const HttpRequest& request) {
+    // Todos los hilos comparten el cliente: las solicitudes se multiplexan en
+    // su bucle de eventos y cada hilo solo espera la suya
+    std::shared_ptr<Core::Network::HttpClient> client = getHttpClient();
+    auto response = std::make_shared<std::promise<HttpResponse>>();
+    std::future<HttpResponse> result = response->get_future();
+    
+    auto start = std::chrono::steady_clock::now();
+    bool sent = client->sendRequest(request.url, request.method, parseHeaders(request.headers),
+                                    std::vector<uint8_t>(request.body.begin(), request.body.end()),
+        [response](int status, const std::vector<std::pair<std::string, std::string>>& headers,
+                   const Core::Network::ByteBuffer& body) {
+            HttpResponse received;
+            received.statusCode = status;
+            for (const auto& header : headers) {
+                received.headers += header.first + ": " + header.second + "\r\n";
             }
-            break;
-        }
+            received.body = body.toString();
+            response->set_value(std::move(received));
+        });
+    
+    HttpResponse received;
+    if (sent) {
+        received = result.get();
+    } else {
+        // Código 0, como el cliente cuando la solicitud falla
+        received.statusCode = 0;
+    }
+    
+    received.timeMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    return received;
+}
+
+void Intruder::setHttpClient(std::shared_ptr<Core::Network::HttpClient> client) {
+    if (!client) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_clientMutex);
+    m_httpClient = std::move(client);
+}
+
+std::shared_ptr<Core::Network::HttpClient> Intruder::getHttpClient() const {
+    std::lock_guard<std::mutex> lock(m_clientMutex);
+    return m_httpClient;
+}
+
+AttackStats Intruder::recordResult(const HttpRequest& request, const HttpResponse& response) {
+    long long resultIndex = m_results.append(request, response);
+    size_t cluster = m_classifier.classify(response, resultIndex < 0 ? 0 : static_cast<size_t>(resultIndex));
+    
+    std::lock_guard<std::mutex> lock(m_resultsMutex);
+    m_stats.clusterCount = m_classifier.clusterCount();
+    m_latencyCounts[response.timeMs]++;
+    
+    auto now = std::chrono::steady_clock::now();
+    m_stats.completedRequests++;
+    m_stats.elapsedSeconds = m_previousElapsedSeconds + std::chrono::duration<double>(now - m_attackStart).count();
+    m_stats.requestsPerSecond = m_stats.elapsedSeconds > 0.0 ?
+        m_stats.completedRequests / m_stats.elapsedSeconds : 0.0;
+    
+    // Los percentiles recorren el histograma, así que se recalculan como mucho cada 250 ms
+    bool lastRequest = m_stats.completedRequests >= m_stats.totalRequests;
+    if (m_stats.completedRequests == 1 || lastRequest ||
+        now - m_lastPercentileUpdate >= std::chrono::milliseconds(250)) {
+        size_t p50Rank = static_cast<size_t>(std::ceil(m_stats.completedRequests * 0.50));
+        size_t p99Rank = static_cast<size_t>(std::ceil(m_stats.completedRequests * 0.99));
+        size_t seen = 0;
         
-        case InsertionPoint::Type::CUSTOM: {
-            // Punto de inserción personalizado, usar las posiciones directamente
-            // Primero determinar si está en la URL, cabeceras o cuerpo
-            
-            // Comprobar si está en la URL
-            if (point.startPosition < modifiedRequest.url.length()) {
-                modifiedRequest.url = modifiedRequest.url.substr(0, point.startPosition) + 
-                                     payload + 
-                                     modifiedRequest.url.substr(point.endPosition);
-            }
-            // Comprobar si está en las cabeceras
-            else if (point.startPosition < modifiedRequest.url.length() + modifiedRequest.headers.length()) {
-                size_t headerOffset = point.startPosition - modifiedRequest.url.length();
-                size_t headerEndOffset = point.endPosition - modifiedRequest.url.length();
-                
-                modifiedRequest.headers = modifiedRequest.headers.substr(0, headerOffset) + 
-                                         payload + 
-                                         modifiedRequest.headers.substr(headerEndOffset);
+        for (const auto& [latency, count] : m_latencyCounts) {
+            if (seen < p50Rank && seen + count >= p50Rank) {
+                m_stats.p50LatencyMs = latency;
             }
-            // Debe estar en el cuerpo
-            else {
-                size_t bodyOffset = point.startPosition - 
-                                   (modifiedRequest.url.length() + modifiedRequest.headers.length());
-                size_t bodyEndOffset = point.endPosition - 
-                                     (modifiedRequest.url.length() + modifiedRequest.headers.length());
-                
-                modifiedRequest.body = modifiedRequest.body.substr(0, bodyOffset) + 
-                                     payload + 
-                                     modifiedRequest.body.substr(bodyEndOffset);
+            seen += count;
+            if (seen >= p99Rank) {
+                m_stats.p99LatencyMs = latency;
+                break;
             }
-            break;
         }
+        m_lastPercentileUpdate = now;
+    }
+    
+    AttackStats stats = m_stats;
+    stats.responseCluster = cluster;
+    return stats;
+}
+
+std::string Intruder::extractHost(const std::string& url) {
+    size_t hostStart = url.find("://");
+    hostStart = (hostStart == std::string::npos) ? 0 : hostStart + 3;
+    
+    size_t hostEnd = url.find_first_of("/?#", hostStart);
+    if (hostEnd == std::string::npos) {
+        hostEnd = url.length();
     }
     
-    return modifiedRequest;
+    return url.substr(hostStart, hostEnd - hostStart);
 }
 
 } // namespace Tools::BurpLike
\ No newline at end of file
@@ -12,10 +12,23 @@
 #include <vector>
 #include <map>
 #include <functional>
+#include <atomic>
+#include <mutex>
+#include <chrono>
 #include "Repeater.h" // Reutilizamos las estructuras HttpRequest y HttpResponse
+#include "RateLimiter.h"
+#include "PayloadWordlist.h"
+#include "ResultStore.h"
+#include "ResponseClassifier.h"
+
+namespace Core::Network {
+class HttpClient;
+}
 
 namespace Tools::BurpLike {
 
+class RequestGenerator;
+
 /**
  * Enumeración que define los tipos de ataques disponibles
  */
@@ -48,6 +61,30 @@ struct InsertionPoint {
         type(t), name(n), startPosition(start), endPosition(end) {}
 };
 
+/**
+ * Estadísticas de rendimiento de un ataque en curso
+ */
+struct AttackStats {
+    size_t totalRequests;       // Solicitudes previstas para el ataque
+    size_t completedRequests;   // Solicitudes completadas hasta el momento
+    double elapsedSeconds;      // Tiempo transcurrido desde el inicio del ataque
+    double requestsPerSecond;   // Rendimiento medio desde el inicio
+    int p50LatencyMs;           // Mediana de la latencia de respuesta
+    int p99LatencyMs;           // Percentil 99 de la latencia de respuesta
+    size_t clusterCount;        // Grupos de respuestas distintos encontrados hasta el momento
+    size_t responseCluster;     // Grupo asignado a la respuesta notificada en el callback
+    
+    AttackStats() : totalRequests(0), completedRequests(0), elapsedSeconds(0.0),
+                    requestsPerSecond(0.0), p50LatencyMs(0), p99LatencyMs(0),
+                    clusterCount(0), responseCluster(0) {}
+};
+
+/**
+ * Callback invocado por cada respuesta recibida durante un ataque
+ * Las llamadas se serializan, aunque provengan de distintos hilos de trabajo
+ */
+using AttackCallback = std::function<void(const HttpRequest&, const HttpResponse&, const AttackStats&)>;
+
 /**
  * Clase que implementa la funcionalidad de Intruder
  * Permite realizar ataques automatizados de fuerza bruta y fuzzing
@@ -100,8 +137,17 @@ public:
      */
     void addPayloadList(int position, const std::vector<std::string>& payloads);
     
+    /**
+     * Asigna una lista de payloads compartida a un punto de inserción
+     * La misma lista puede usarse en varios puntos y en varias instancias sin copiarse
+     * @param position Índice del punto de inserción
+     * @param wordlist Lista de payloads a utilizar
+     */
+    void setPayloadWordlist(int position, std::shared_ptr<const PayloadWordlist> wordlist);
+    
     /**
      * Carga una lista de payloads desde un archivo
+     * El archivo se proyecta en memoria y se comparte con otros usos del mismo archivo
      * @param position Índice del punto de inserción
      * @param filePath Ruta al archivo con los payloads
      * @return true si se cargó correctamente, false en caso contrario
@@ -115,6 +161,33 @@ public:
      */
     bool startAttack(std::function<void(const HttpRequest&, const HttpResponse&)> callback);
     
+    /**
+     * Inicia el ataque con la configuración actual, informando del rendimiento
+     * Las solicitudes se reparten entre los hilos configurados con setThreadCount
+     * y la llamada bloquea hasta que el ataque termina o se detiene
+     * @param callback Función a llamar por cada respuesta recibida, con las estadísticas actuales
+     * @return true si el ataque se inició correctamente, false en caso contrario
+     */
+    bool startAttack(AttackCallback callback);
+    
+    /**
+     * Reanuda un ataque a partir de un índice de solicitud
+     * Las solicitudes se generan bajo demanda, así que no hay coste por saltar las anteriores.
+     * Con un índice mayor que 0 se conservan los resultados, los grupos de respuestas
+     * y las estadísticas de la parte ya enviada; con 0 empieza un ataque nuevo.
+     * @param callback Función a llamar por cada respuesta recibida, con las estadísticas actuales
+     * @param startIndex Índice de la primera solicitud a enviar (ver getResumeIndex)
+     * @return true si el ataque se inició correctamente, false en caso contrario
+     */
+    bool resumeAttack(AttackCallback callback, size_t startIndex);
+    
+    /**
+     * Obtiene el índice desde el que reanudar el último ataque
+     * Todas las solicitudes anteriores a este índice se enviaron
+     * @return Índice de la primera solicitud pendiente
+     */
+    size_t getResumeIndex() const;
+    
     /**
      * Detiene el ataque en curso
      */
@@ -128,22 +201,58 @@ public:
     
     /**
      * Obtiene los resultados del ataque
-     * @return Vector con los resultados (solicitud, respuesta)
+     * Los cuerpos se guardan en disco y se cargan bajo demanda con loadResult()
+     * @return Registro con los resultados (solicitud, respuesta)
      */
-    std::vector<std::pair<HttpRequest, HttpResponse>> getResults() const;
+    const ResultStore& getResults() const;
+    
+    /**
+     * Obtiene el clasificador que agrupa las respuestas del ataque
+     * Se actualiza a medida que llegan las respuestas y puede consultarse durante el ataque
+     * @return Clasificador de respuestas
+     */
+    const ResponseClassifier& getResponseClassifier() const;
+    
+    /**
+     * Obtiene las estadísticas de rendimiento del último ataque
+     * @return Estadísticas de rendimiento
+     */
+    AttackStats getAttackStats() const;
     
     /**
      * Establece el intervalo entre solicitudes (en milisegundos)
-     * @param interval Intervalo en milisegundos
+     * Se aplica por host de destino: equivale a setRateLimit(1000 / interval, 1)
+     * @param interval Intervalo en milisegundos (0 para no limitar)
      */
     void setRequestInterval(int interval);
     
+    /**
+     * Establece el límite de tasa por host de destino
+     * @param requestsPerSecond Solicitudes por segundo permitidas por host (<= 0 sin límite)
+     * @param burst Número máximo de solicitudes que se pueden enviar de golpe a un host
+     */
+    void setRateLimit(double requestsPerSecond, int burst = 1);
+    
     /**
      * Establece el número máximo de hilos concurrentes
      * @param threads Número de hilos
      */
     void setThreadCount(int threads);
 
+    /**
+     * Establece el cliente HTTP con el que se envían las solicitudes del ataque
+     * Por defecto se usa un cliente propio; compartirlo permite reutilizar sus
+     * conexiones y su configuración (proxy, TLS, timeout...)
+     * @param client Cliente HTTP compartido por todos los hilos de trabajo
+     */
+    void setHttpClient(std::shared_ptr<Core::Network::HttpClient> client);
+
+    /**
+     * Obtiene el cliente HTTP con el que se envían las solicitudes del ataque
+     * @return Cliente HTTP
+     */
+    std::shared_ptr<Core::Network::HttpClient> getHttpClient() const;
+
 private:
     // Solicitud base para el ataque
     HttpRequest m_baseRequest;
@@ -155,13 +264,16 @@ private:
     std::vector<InsertionPoint> m_insertionPoints;
     
     // Listas de payloads para cada punto de inserción
-    std::map<int, std::vector<std::string>> m_payloads;
+    std::map<int, std::shared_ptr<const PayloadWordlist>> m_payloads;
     
     // Resultados del ataque
-    std::vector<std::pair<HttpRequest, HttpResponse>> m_results;
+    ResultStore m_results;
+    
+    // Agrupación incremental de las respuestas del ataque
+    ResponseClassifier m_classifier;
     
     // Estado del ataque
-    bool m_attackRunning;
+    std::atomic<bool> m_attackRunning;
     
     // Intervalo entre solicitudes (ms)
     int m_requestInterval;
@@ -169,20 +281,72 @@ private:
     // Número de hilos concurrentes
     int m_threadCount;
     
+    // Limitador de tasa por host
+    HostRateLimiter m_rateLimiter;
+    
+    // Siguiente solicitud pendiente de la cola compartida por los hilos
+    std::atomic<size_t> m_nextRequest;
+    
+    // Menor índice tomado por un hilo pero no enviado al detener el ataque
+    std::atomic<size_t> m_firstAbandoned;
+    
+    // Índice desde el que reanudar el último ataque
+    size_t m_resumeIndex;
+    
+    // Protege las estadísticas del ataque
+    mutable std::mutex m_resultsMutex;
+    
+    // Serializa las llamadas al callback del usuario
+    std::mutex m_callbackMutex;
+    
+    // Estadísticas del ataque: histograma de latencias (ms -> número de respuestas)
+    std::map<int, size_t> m_latencyCounts;
+    AttackStats m_stats;
+    double m_previousElapsedSeconds;   // Tiempo de las partes anteriores de un ataque reanudado
+    std::chrono::steady_clock::time_point m_attackStart;
+    std::chrono::steady_clock::time_point m_lastPercentileUpdate;
+    
+    // Cliente HTTP compartido por los hilos de trabajo
+    std::shared_ptr<Core::Network::HttpClient> m_httpClient;
+    mutable std::mutex m_clientMutex;
+    
+    /**
+     * Bucle de cada hilo de trabajo: toma índices de la cola compartida hasta agotarla
+     * y genera cada solicitud bajo demanda
+     * @param generator Generador de las solicitudes del ataque
+     * @param callback Función a llamar por cada respuesta recibida
+     */
+    void workerLoop(const RequestGenerator& generator, const AttackCallback& callback);
+    
+    /**
+     * Espera el turno del limitador de tasa para un host
+     * @param host Host de destino
+     * @return false si el ataque se detuvo durante la espera
+     */
+    bool waitForRateLimit(const std::string& host);
+    
+    /**
+     * Envía una solicitud del ataque y mide su latencia
+     * Bloquea el hilo de trabajo hasta que llega la respuesta o vence el timeout del cliente
+     * @param request Solicitud a enviar
+     * @return Respuesta recibida (código 0 si la solicitud falló)
+     */
+    HttpResponse sendAttackRequest(const HttpRequest& request);
+    
     /**
-     * Genera las solicitudes para el ataque según el tipo seleccionado
-     * @return Vector con las solicitudes generadas
+     * Guarda un resultado y actualiza las estadísticas del ataque
+     * @param request Solicitud enviada
+     * @param response Respuesta recibida
+     * @return Copia de las estadísticas actualizadas
      */
-    std::vector<HttpRequest> generateRequests();
+    AttackStats recordResult(const HttpRequest& request, const HttpResponse& response);
     
     /**
-     * Aplica un payload a una solicitud en un punto de inserción específico
-     * @param request Solicitud base
-     * @param point Punto de inserción
-     * @param payload Payload a insertar
-     * @return Solicitud modificada con el payload
+     * Extrae el host (y puerto) de una URL para el limitador de tasa
+     * @param url URL de la solicitud
+     * @return Host de la URL
      */
-    HttpRequest applyPayload(const HttpRequest& request, const InsertionPoint& point, const std::string& payload);
+    static std::string extractHost(const std::string& url);
 };
 
 } // namespace Tools::BurpLike
\ No newline at end of file
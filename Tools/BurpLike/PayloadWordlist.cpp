@@ -0,0 +1,171 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación de las listas de payloads proyectadas en memoria
+ */
+
+#include "PayloadWordlist.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Tools::BurpLike {
+
+namespace {
+
+// Listas abiertas desde archivo, para compartir la proyección entre instancias
+std::mutex s_registryMutex;
+std::unordered_map<std::string, std::weak_ptr<const PayloadWordlist>> s_registry;
+
+} // namespace
+
+PayloadWordlist::PayloadWordlist() :
+    m_data(nullptr),
+    m_length(0),
+    m_mapping(nullptr),
+    m_fileDevice(0),
+    m_fileInode(0),
+    m_fileSize(0),
+    m_fileModifiedSeconds(0),
+    m_fileModifiedNanoseconds(0) {
+}
+
+PayloadWordlist::~PayloadWordlist() {
+    if (m_mapping) {
+        munmap(m_mapping, m_length);
+    }
+}
+
+std::shared_ptr<const PayloadWordlist> PayloadWordlist::fromFile(const std::string& filePath) {
+    int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        close(fd);
+        return nullptr;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(info.st_size);
+
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+
+    // Reutilizar la proyección solo si es el mismo archivo (dispositivo e
+    // inodo, no solo la ruta) y no ha cambiado desde que se abrió; la fecha
+    // se compara con nanosegundos para detectar reescrituras en el mismo segundo
+    auto it = s_registry.find(filePath);
+    if (it != s_registry.end()) {
+        auto existing = it->second.lock();
+        if (existing &&
+            existing->m_fileDevice == static_cast<uint64_t>(info.st_dev) &&
+            existing->m_fileInode == static_cast<uint64_t>(info.st_ino) &&
+            existing->m_fileSize == fileSize &&
+            existing->m_fileModifiedSeconds == static_cast<int64_t>(info.st_mtim.tv_sec) &&
+            existing->m_fileModifiedNanoseconds == static_cast<int64_t>(info.st_mtim.tv_nsec)) {
+            close(fd);
+            return existing;
+        }
+    }
+
+    std::shared_ptr<PayloadWordlist> wordlist(new PayloadWordlist());
+    wordlist->m_source = filePath;
+    wordlist->m_fileDevice = static_cast<uint64_t>(info.st_dev);
+    wordlist->m_fileInode = static_cast<uint64_t>(info.st_ino);
+    wordlist->m_fileSize = fileSize;
+    wordlist->m_fileModifiedSeconds = static_cast<int64_t>(info.st_mtim.tv_sec);
+    wordlist->m_fileModifiedNanoseconds = static_cast<int64_t>(info.st_mtim.tv_nsec);
+
+    if (fileSize > 0) {
+        void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            wordlist->m_mapping = mapping;
+            wordlist->m_data = static_cast<const char*>(mapping);
+            wordlist->m_length = fileSize;
+        }
+    }
+    close(fd);
+
+    // Si no se pudo proyectar, leer el archivo completo en un único bloque
+    if (!wordlist->m_mapping) {
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file.is_open()) {
+            return nullptr;
+        }
+        wordlist->m_ownedData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        wordlist->m_data = wordlist->m_ownedData.data();
+        wordlist->m_length = wordlist->m_ownedData.size();
+    }
+
+    wordlist->buildIndex();
+    s_registry[filePath] = wordlist;
+    return wordlist;
+}
+
+std::shared_ptr<const PayloadWordlist> PayloadWordlist::fromPayloads(const std::vector<std::string>& payloads) {
+    std::shared_ptr<PayloadWordlist> wordlist(new PayloadWordlist());
+
+    size_t totalLength = 0;
+    for (const auto& payload : payloads) {
+        totalLength += payload.size();
+    }
+    wordlist->m_ownedData.reserve(totalLength);
+    wordlist->m_offsets.reserve(payloads.size());
+    wordlist->m_lengths.reserve(payloads.size());
+
+    // Los payloads en memoria se conservan tal cual, incluidos los vacíos
+    for (const auto& payload : payloads) {
+        wordlist->m_offsets.push_back(wordlist->m_ownedData.size());
+        wordlist->m_lengths.push_back(static_cast<uint32_t>(payload.size()));
+        wordlist->m_ownedData += payload;
+    }
+
+    wordlist->m_data = wordlist->m_ownedData.data();
+    wordlist->m_length = wordlist->m_ownedData.size();
+    return wordlist;
+}
+
+size_t PayloadWordlist::size() const {
+    return m_offsets.size();
+}
+
+bool PayloadWordlist::empty() const {
+    return m_offsets.empty();
+}
+
+std::string_view PayloadWordlist::operator[](size_t index) const {
+    return std::string_view(m_data + m_offsets[index], m_lengths[index]);
+}
+
+const std::string& PayloadWordlist::source() const {
+    return m_source;
+}
+
+void PayloadWordlist::buildIndex() {
+    size_t position = 0;
+
+    while (position < m_length) {
+        const void* newline = std::memchr(m_data + position, '\n', m_length - position);
+        size_t lineEnd = newline ? static_cast<size_t>(static_cast<const char*>(newline) - m_data) : m_length;
+
+        size_t contentEnd = lineEnd;
+        if (contentEnd > position && m_data[contentEnd - 1] == '\r') {
+            contentEnd--;
+        }
+
+        if (contentEnd > position) {
+            m_offsets.push_back(position);
+            m_lengths.push_back(static_cast<uint32_t>(contentEnd - position));
+        }
+
+        position = lineEnd + 1;
+    }
+}
+
+} // namespace Tools::BurpLike
@@ -0,0 +1,104 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Lista de payloads de solo lectura para Intruder
+ * Los archivos se proyectan en memoria (mmap) y se indexan por líneas,
+ * sin copiar su contenido
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+namespace Tools::BurpLike {
+
+/**
+ * Lista inmutable de payloads accesibles como std::string_view
+ * Se comparte mediante std::shared_ptr entre puntos de inserción e instancias
+ * de Intruder; abrir dos veces el mismo archivo devuelve la misma proyección.
+ * Es segura para lectura desde varios hilos.
+ */
+class PayloadWordlist {
+public:
+    /**
+     * Proyecta en memoria un archivo de payloads (una línea por payload)
+     * Las líneas vacías se ignoran y se elimina el '\r' final de las líneas CRLF
+     * @param filePath Ruta al archivo con los payloads
+     * @return Lista de payloads, o nullptr si no se pudo abrir el archivo
+     */
+    static std::shared_ptr<const PayloadWordlist> fromFile(const std::string& filePath);
+
+    /**
+     * Crea una lista a partir de payloads en memoria
+     * @param payloads Payloads a copiar en la lista
+     * @return Lista de payloads
+     */
+    static std::shared_ptr<const PayloadWordlist> fromPayloads(const std::vector<std::string>& payloads);
+
+    ~PayloadWordlist();
+
+    PayloadWordlist(const PayloadWordlist&) = delete;
+    PayloadWordlist& operator=(const PayloadWordlist&) = delete;
+
+    /**
+     * Obtiene el número de payloads
+     * @return Número de payloads de la lista
+     */
+    size_t size() const;
+
+    /**
+     * Comprueba si la lista está vacía
+     * @return true si no hay payloads
+     */
+    bool empty() const;
+
+    /**
+     * Obtiene un payload
+     * La vista es válida mientras exista la lista
+     * @param index Índice del payload, en [0, size())
+     * @return Vista del payload
+     */
+    std::string_view operator[](size_t index) const;
+
+    /**
+     * Obtiene el origen de la lista
+     * @return Ruta del archivo, o cadena vacía si la lista se creó en memoria
+     */
+    const std::string& source() const;
+
+private:
+    PayloadWordlist();
+
+    // Construye el índice de líneas sobre m_data
+    void buildIndex();
+
+    // Contenido de la lista: proyección del archivo o m_ownedData
+    const char* m_data;
+    size_t m_length;
+
+    // Proyección en memoria (nullptr si el contenido está en m_ownedData)
+    void* m_mapping;
+
+    // Contenido propio para listas en memoria o si no se pudo usar mmap
+    std::string m_ownedData;
+
+    // Índice de líneas: desplazamiento y longitud de cada payload
+    std::vector<uint64_t> m_offsets;
+    std::vector<uint32_t> m_lengths;
+
+    // Ruta del archivo de origen
+    std::string m_source;
+
+    // Identificación del archivo para reutilizar la proyección
+    uint64_t m_fileDevice;
+    uint64_t m_fileInode;
+    uint64_t m_fileSize;
+    int64_t m_fileModifiedSeconds;
+    int64_t m_fileModifiedNanoseconds;
+};
+
+} // namespace Tools::BurpLike
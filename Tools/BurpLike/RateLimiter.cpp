@@ -0,0 +1,58 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación del limitador de tasa por host
+ */
+
+#include "RateLimiter.h"
+#include <algorithm>
+
+namespace Tools::BurpLike {
+
+HostRateLimiter::HostRateLimiter(double requestsPerSecond, int burst) :
+    m_rate(requestsPerSecond),
+    m_burst(std::max(burst, 1)) {
+}
+
+void HostRateLimiter::configure(double requestsPerSecond, int burst) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rate = requestsPerSecond;
+    m_burst = std::max(burst, 1);
+    m_buckets.clear();
+}
+
+HostRateLimiter::Clock::duration HostRateLimiter::reserve(const std::string& host) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_rate <= 0.0) {
+        return Clock::duration::zero();
+    }
+
+    Clock::time_point now = Clock::now();
+    auto it = m_buckets.find(host);
+    if (it == m_buckets.end()) {
+        it = m_buckets.emplace(host, Bucket{m_burst, now}).first;
+    }
+
+    // Rellenar el bucket según el tiempo transcurrido
+    Bucket& bucket = it->second;
+    std::chrono::duration<double> elapsed = now - bucket.lastRefill;
+    bucket.tokens = std::min(m_burst, bucket.tokens + elapsed.count() * m_rate);
+    bucket.lastRefill = now;
+
+    // Consumir el token; si el saldo queda negativo el llamante espera la deuda
+    bucket.tokens -= 1.0;
+    if (bucket.tokens >= 0.0) {
+        return Clock::duration::zero();
+    }
+
+    std::chrono::duration<double> wait(-bucket.tokens / m_rate);
+    return std::chrono::duration_cast<Clock::duration>(wait);
+}
+
+bool HostRateLimiter::isEnabled() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_rate > 0.0;
+}
+
+} // namespace Tools::BurpLike
@@ -0,0 +1,65 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Limitador de tasa por host basado en token bucket
+ * Usado por Intruder para no saturar los objetivos durante un ataque
+ */
+
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+namespace Tools::BurpLike {
+
+/**
+ * Limitador de tasa con un token bucket independiente por host
+ * Es seguro llamarlo desde varios hilos a la vez
+ */
+class HostRateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Constructor
+     * @param requestsPerSecond Solicitudes por segundo permitidas por host (<= 0 sin límite)
+     * @param burst Número máximo de solicitudes que se pueden enviar de golpe
+     */
+    HostRateLimiter(double requestsPerSecond = 0.0, int burst = 1);
+
+    /**
+     * Cambia la configuración del limitador y reinicia los buckets existentes
+     * @param requestsPerSecond Solicitudes por segundo permitidas por host (<= 0 sin límite)
+     * @param burst Número máximo de solicitudes que se pueden enviar de golpe
+     */
+    void configure(double requestsPerSecond, int burst);
+
+    /**
+     * Reserva un token para el host indicado
+     * El token queda consumido aunque haya que esperar para usarlo
+     * @param host Host (y puerto) de destino
+     * @return Tiempo que hay que esperar antes de enviar la solicitud
+     */
+    Clock::duration reserve(const std::string& host);
+
+    /**
+     * Comprueba si el limitador está activo
+     * @return true si hay un límite de tasa configurado
+     */
+    bool isEnabled() const;
+
+private:
+    struct Bucket {
+        double tokens;
+        Clock::time_point lastRefill;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Bucket> m_buckets;
+    double m_rate;
+    double m_burst;
+};
+
+} // namespace Tools::BurpLike
@@ -41,7 +41,7 @@ HttpResponse Repeater::sendRequest() {
     response.timeMs = 150; // Tiempo simulado
     
     // Guardar en el historial
-    m_history.push_back(std::make_pair(m_currentRequest, response));
+    m_history.append(m_currentRequest, response);
     
     // Llamar al callback si está definido
     if (m_responseCallback) {
@@ -51,7 +51,7 @@ HttpResponse Repeater::sendRequest() {
     return response;
 }
 
-std::vector<std::pair<HttpRequest, HttpResponse>> Repeater::getHistory() const {
+const ResultStore& Repeater::getHistory() const {
     return m_history;
 }
 
@@ -11,6 +11,7 @@
 #include <memory>
 #include <vector>
 #include <functional>
+#include "ResultStore.h"
 
 namespace Tools::BurpLike {
 
@@ -79,9 +80,10 @@ public:
     
     /**
      * Obtiene el historial de solicitudes enviadas
-     * @return Vector con el historial de solicitudes
+     * Los cuerpos se guardan en disco y se cargan bajo demanda con loadResult()
+     * @return Registro con el historial de solicitudes
      */
-    std::vector<std::pair<HttpRequest, HttpResponse>> getHistory() const;
+    const ResultStore& getHistory() const;
     
     /**
      * Establece una función de callback para cuando se recibe una respuesta
@@ -99,7 +101,7 @@ private:
     HttpRequest m_currentRequest;
     
     // Historial de solicitudes y respuestas
-    std::vector<std::pair<HttpRequest, HttpResponse>> m_history;
+    ResultStore m_history;
     
     // Callback para cuando se recibe una respuesta
     std::function<void(const HttpResponse&)> m_responseCallback;
@@ -0,0 +1,132 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación del generador perezoso de solicitudes de Intruder
+ */
+
+#include "RequestGenerator.h"
+#include <algorithm>
+#include <limits>
+
+namespace Tools::BurpLike {
+
+RequestGenerator::RequestGenerator(AttackType type,
+                                   const HttpRequest& baseRequest,
+                                   const std::vector<InsertionPoint>& points,
+                                   const std::map<int, std::shared_ptr<const PayloadWordlist>>& payloads) :
+    m_type(type),
+    m_template(baseRequest, points),
+    m_size(0) {
+    
+    for (size_t i = 0; i < points.size(); i++) {
+        auto it = payloads.find(static_cast<int>(i));
+        m_lists.push_back(it != payloads.end() ? it->second.get() : nullptr);
+    }
+    
+    if (m_lists.empty()) {
+        return;
+    }
+    
+    switch (m_type) {
+        case AttackType::SNIPER: {
+            // Cada punto de inserción ocupa un tramo consecutivo de índices
+            for (const auto* list : m_lists) {
+                m_sniperOffsets.push_back(m_size);
+                m_size += list ? list->size() : 0;
+            }
+            break;
+        }
+        
+        case AttackType::BATTERING_RAM: {
+            // Se usa la primera lista de payloads en todos los puntos
+            m_size = m_lists[0] ? m_lists[0]->size() : 0;
+            break;
+        }
+        
+        case AttackType::PITCHFORK: {
+            // Tantas solicitudes como payloads tenga la lista más corta
+            m_size = std::numeric_limits<size_t>::max();
+            for (const auto* list : m_lists) {
+                m_size = std::min(m_size, list ? list->size() : 0);
+            }
+            break;
+        }
+        
+        case AttackType::CLUSTER_BOMB: {
+            // Producto de los tamaños de todas las listas, comprobando desbordamiento
+            m_size = 1;
+            for (const auto* list : m_lists) {
+                size_t radix = list ? list->size() : 0;
+                if (radix == 0) {
+                    m_size = 0;
+                    break;
+                }
+                if (m_size > std::numeric_limits<size_t>::max() / radix) {
+                    m_size = 0;
+                    break;
+                }
+                m_size *= radix;
+            }
+            break;
+        }
+    }
+}
+
+size_t RequestGenerator::size() const {
+    return m_size;
+}
+
+std::vector<std::string_view> RequestGenerator::payloadValues(size_t index) const {
+    // Los puntos sin payload en esta solicitud conservan su valor original
+    std::vector<std::string_view> values = m_template.originalValues();
+    if (index >= m_size) {
+        return values;
+    }
+    
+    switch (m_type) {
+        case AttackType::SNIPER: {
+            // Buscar el tramo del punto de inserción al que pertenece el índice
+            auto it = std::upper_bound(m_sniperOffsets.begin(), m_sniperOffsets.end(), index);
+            size_t pointIndex = static_cast<size_t>(it - m_sniperOffsets.begin()) - 1;
+            values[pointIndex] = (*m_lists[pointIndex])[index - m_sniperOffsets[pointIndex]];
+            break;
+        }
+        
+        case AttackType::BATTERING_RAM: {
+            std::string_view payload = (*m_lists[0])[index];
+            std::fill(values.begin(), values.end(), payload);
+            break;
+        }
+        
+        case AttackType::PITCHFORK: {
+            for (size_t pointIndex = 0; pointIndex < values.size(); pointIndex++) {
+                values[pointIndex] = (*m_lists[pointIndex])[index];
+            }
+            break;
+        }
+        
+        case AttackType::CLUSTER_BOMB: {
+            // Descomponer el índice en base mixta; el último punto de inserción
+            // es el dígito que varía más rápido
+            size_t remaining = index;
+            for (size_t pointIndex = values.size(); pointIndex-- > 0;) {
+                size_t radix = m_lists[pointIndex]->size();
+                values[pointIndex] = (*m_lists[pointIndex])[remaining % radix];
+                remaining /= radix;
+            }
+            break;
+        }
+    }
+    
+    return values;
+}
+
+HttpRequest RequestGenerator::generate(size_t index) const {
+    return m_template.build(payloadValues(index));
+}
+
+const RequestTemplate& RequestGenerator::requestTemplate() const {
+    return m_template;
+}
+
+} // namespace Tools::BurpLike
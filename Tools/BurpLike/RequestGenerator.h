@@ -0,0 +1,85 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Generador perezoso de solicitudes para Intruder
+ * Construye cada solicitud del ataque bajo demanda a partir de su índice
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <memory>
+#include "Intruder.h"
+#include "RequestTemplate.h"
+
+namespace Tools::BurpLike {
+
+/**
+ * Generador de las solicitudes de un ataque de Intruder
+ * Cada solicitud se identifica por un índice en [0, size()) que se descompone
+ * en los índices de payload de cada punto de inserción (base mixta en CLUSTER_BOMB).
+ * No materializa ninguna lista, por lo que la memoria usada es constante y un
+ * ataque puede reanudarse en cualquier índice. Es seguro usarlo desde varios hilos.
+ */
+class RequestGenerator {
+public:
+    /**
+     * Constructor
+     * Las referencias deben seguir siendo válidas mientras se use el generador
+     * @param type Tipo de ataque
+     * @param baseRequest Solicitud base
+     * @param points Puntos de inserción
+     * @param payloads Listas de payloads por punto de inserción
+     */
+    RequestGenerator(AttackType type,
+                     const HttpRequest& baseRequest,
+                     const std::vector<InsertionPoint>& points,
+                     const std::map<int, std::shared_ptr<const PayloadWordlist>>& payloads);
+
+    /**
+     * Obtiene el número total de solicitudes del ataque
+     * @return Número de solicitudes, o 0 si la configuración no es válida o desborda
+     */
+    size_t size() const;
+
+    /**
+     * Construye la solicitud correspondiente a un índice
+     * @param index Índice de la solicitud, en [0, size())
+     * @return Solicitud con los payloads aplicados
+     */
+    HttpRequest generate(size_t index) const;
+
+    /**
+     * Obtiene el valor de cada punto de inserción para un índice, sin construir la solicitud
+     * Junto con requestTemplate().gatherField() permite un envío scatter-gather sin copias
+     * @param index Índice de la solicitud, en [0, size())
+     * @return Vector con un valor por punto de inserción
+     */
+    std::vector<std::string_view> payloadValues(size_t index) const;
+
+    /**
+     * Obtiene la plantilla compilada de la solicitud base
+     * @return Plantilla de la solicitud
+     */
+    const RequestTemplate& requestTemplate() const;
+
+private:
+    AttackType m_type;
+
+    // Solicitud base compilada una sola vez en fragmentos y huecos
+    RequestTemplate m_template;
+
+    // Lista de payloads de cada punto de inserción (nullptr si no tiene)
+    std::vector<const PayloadWordlist*> m_lists;
+
+    // Índice de inicio de cada punto de inserción en modo SNIPER
+    std::vector<size_t> m_sniperOffsets;
+
+    // Número total de solicitudes
+    size_t m_size;
+};
+
+} // namespace Tools::BurpLike
@@ -0,0 +1,248 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación de la plantilla precompilada de solicitudes de Intruder
+ */
+
+#include "RequestTemplate.h"
+#include <algorithm>
+
+namespace Tools::BurpLike {
+
+RequestTemplate::RequestTemplate(const HttpRequest& baseRequest, const std::vector<InsertionPoint>& points) :
+    m_baseRequest(baseRequest),
+    m_originalValues(points.size()) {
+
+    // Localizar todos los puntos en la solicitud base y agruparlos por campo
+    struct Slot {
+        size_t start;
+        size_t end;
+        int pointIndex;
+    };
+    std::vector<Slot> slots[3];
+
+    for (size_t i = 0; i < points.size(); i++) {
+        Location location = locate(points[i]);
+        if (location.found) {
+            slots[static_cast<int>(location.field)].push_back({location.start, location.end, static_cast<int>(i)});
+        }
+    }
+
+    // Partir cada campo en fragmentos literales y huecos
+    for (int f = 0; f < 3; f++) {
+        Field field = static_cast<Field>(f);
+        std::string_view text = fieldText(field);
+        auto& fieldSlots = slots[f];
+
+        std::stable_sort(fieldSlots.begin(), fieldSlots.end(),
+                         [](const Slot& a, const Slot& b) { return a.start < b.start; });
+
+        size_t position = 0;
+        for (const auto& slot : fieldSlots) {
+            if (slot.start < position) {
+                continue; // Se solapa con un punto anterior
+            }
+            if (slot.start > position) {
+                m_segments[f].push_back({text.substr(position, slot.start - position), -1});
+            }
+            m_segments[f].push_back({std::string_view(), slot.pointIndex});
+            m_originalValues[slot.pointIndex] = text.substr(slot.start, slot.end - slot.start);
+            position = slot.end;
+        }
+        if (position < text.size()) {
+            m_segments[f].push_back({text.substr(position), -1});
+        }
+    }
+}
+
+std::string_view RequestTemplate::originalValue(size_t pointIndex) const {
+    return pointIndex < m_originalValues.size() ? m_originalValues[pointIndex] : std::string_view();
+}
+
+std::vector<std::string_view> RequestTemplate::originalValues() const {
+    return m_originalValues;
+}
+
+HttpRequest RequestTemplate::build(const std::vector<std::string_view>& values) const {
+    HttpRequest request;
+    request.method = m_baseRequest.method;
+
+    request.url.reserve(fieldSize(Field::URL, values));
+    appendField(Field::URL, values, request.url);
+
+    request.headers.reserve(fieldSize(Field::HEADERS, values));
+    appendField(Field::HEADERS, values, request.headers);
+
+    request.body.reserve(fieldSize(Field::BODY, values));
+    appendField(Field::BODY, values, request.body);
+
+    return request;
+}
+
+size_t RequestTemplate::fieldSize(Field field, const std::vector<std::string_view>& values) const {
+    size_t size = 0;
+    for (const auto& segment : segments(field)) {
+        size += segment.pointIndex < 0 ? segment.literal.size() : values[segment.pointIndex].size();
+    }
+    return size;
+}
+
+void RequestTemplate::appendField(Field field, const std::vector<std::string_view>& values, std::string& output) const {
+    for (const auto& segment : segments(field)) {
+        output.append(segment.pointIndex < 0 ? segment.literal : values[segment.pointIndex]);
+    }
+}
+
+void RequestTemplate::gatherField(Field field, const std::vector<std::string_view>& values,
+                                  std::vector<std::string_view>& output) const {
+    for (const auto& segment : segments(field)) {
+        std::string_view slice = segment.pointIndex < 0 ? segment.literal : values[segment.pointIndex];
+        if (!slice.empty()) {
+            output.push_back(slice);
+        }
+    }
+}
+
+RequestTemplate::Location RequestTemplate::locate(const InsertionPoint& point) const {
+    const std::string& url = m_baseRequest.url;
+    const std::string& headers = m_baseRequest.headers;
+    const std::string& body = m_baseRequest.body;
+    Location notFound{Field::URL, 0, 0, false};
+
+    switch (point.type) {
+        case InsertionPoint::Type::URL_PATH: {
+            // Las posiciones son absolutas en la URL y deben caer en la ruta
+            size_t pathStart = url.find('/', 8); // Buscar después de http://
+            if (pathStart == std::string::npos || point.startPosition < 0) {
+                return notFound;
+            }
+
+            size_t start = static_cast<size_t>(point.startPosition);
+            if (start < pathStart || start >= url.length()) {
+                return notFound;
+            }
+            size_t end = std::clamp(static_cast<size_t>(std::max(point.endPosition, point.startPosition)),
+                                    start, url.length());
+            return {Field::URL, start, end, true};
+        }
+
+        case InsertionPoint::Type::URL_PARAMETER: {
+            // Valor de un parámetro en la query de la URL
+            size_t queryStart = url.find('?');
+            if (queryStart == std::string::npos) {
+                return notFound;
+            }
+
+            std::string paramPrefix = point.name + "=";
+            size_t paramPos = url.find(paramPrefix, queryStart + 1);
+            if (paramPos == std::string::npos) {
+                return notFound;
+            }
+
+            size_t valueStart = paramPos + paramPrefix.length();
+            size_t valueEnd = url.find('&', valueStart);
+            if (valueEnd == std::string::npos) valueEnd = url.length();
+            return {Field::URL, valueStart, valueEnd, true};
+        }
+
+        case InsertionPoint::Type::BODY_PARAMETER: {
+            // Valor de un parámetro en el cuerpo
+            std::string paramPrefix = point.name + "=";
+            size_t paramPos = body.find(paramPrefix);
+            if (paramPos == std::string::npos) {
+                return notFound;
+            }
+
+            size_t valueStart = paramPos + paramPrefix.length();
+            size_t valueEnd = body.find('&', valueStart);
+            if (valueEnd == std::string::npos) valueEnd = body.length();
+            return {Field::BODY, valueStart, valueEnd, true};
+        }
+
+        case InsertionPoint::Type::COOKIE: {
+            // Valor de una cookie dentro de la cabecera Cookie
+            std::string cookieHeader = "Cookie: ";
+            size_t cookiePos = headers.find(cookieHeader);
+            if (cookiePos == std::string::npos) {
+                return notFound;
+            }
+
+            size_t cookieStart = cookiePos + cookieHeader.length();
+            size_t cookieEnd = headers.find("\r\n", cookieStart);
+            if (cookieEnd == std::string::npos) cookieEnd = headers.length();
+
+            std::string_view cookies(headers.data() + cookieStart, cookieEnd - cookieStart);
+            std::string cookiePrefix = point.name + "=";
+            size_t cookieValuePos = cookies.find(cookiePrefix);
+            if (cookieValuePos == std::string_view::npos) {
+                return notFound;
+            }
+
+            size_t valueStart = cookieValuePos + cookiePrefix.length();
+            size_t valueEnd = cookies.find(';', valueStart);
+            if (valueEnd == std::string_view::npos) valueEnd = cookies.length();
+            return {Field::HEADERS, cookieStart + valueStart, cookieStart + valueEnd, true};
+        }
+
+        case InsertionPoint::Type::HEADER: {
+            // Valor de una cabecera específica
+            std::string headerPrefix = point.name + ": ";
+            size_t headerPos = headers.find(headerPrefix);
+            if (headerPos == std::string::npos) {
+                return notFound;
+            }
+
+            size_t valueStart = headerPos + headerPrefix.length();
+            size_t valueEnd = headers.find("\r\n", valueStart);
+            if (valueEnd == std::string::npos) valueEnd = headers.length();
+            return {Field::HEADERS, valueStart, valueEnd, true};
+        }
+
+        case InsertionPoint::Type::CUSTOM: {
+            // Posiciones absolutas sobre URL + cabeceras + cuerpo concatenados
+            if (point.startPosition < 0) {
+                return notFound;
+            }
+
+            size_t start = static_cast<size_t>(point.startPosition);
+            size_t end = static_cast<size_t>(std::max(point.endPosition, point.startPosition));
+
+            if (start < url.length()) {
+                return {Field::URL, start, std::min(end, url.length()), true};
+            }
+
+            start -= url.length();
+            end -= url.length();
+            if (start < headers.length()) {
+                return {Field::HEADERS, start, std::min(end, headers.length()), true};
+            }
+
+            start -= headers.length();
+            end -= headers.length();
+            if (start <= body.length()) {
+                return {Field::BODY, start, std::min(end, body.length()), true};
+            }
+            return notFound;
+        }
+    }
+
+    return notFound;
+}
+
+const std::string& RequestTemplate::fieldText(Field field) const {
+    switch (field) {
+        case Field::URL:
+            return m_baseRequest.url;
+        case Field::HEADERS:
+            return m_baseRequest.headers;
+        case Field::BODY:
+            break;
+    }
+    return m_baseRequest.body;
+}
+
+const std::vector<RequestTemplate::Segment>& RequestTemplate::segments(Field field) const {
+    return m_segments[static_cast<int>(field)];
+}
+
+} // namespace Tools::BurpLike
@@ -0,0 +1,124 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Plantilla precompilada de la solicitud base de Intruder
+ * Divide la solicitud en fragmentos literales y huecos para los payloads
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Intruder.h"
+
+namespace Tools::BurpLike {
+
+/**
+ * Plantilla de solicitud compilada a partir de la solicitud base y sus puntos de inserción
+ * Los puntos se localizan una única vez; después cada solicitud del ataque se ensambla
+ * copiando los fragmentos literales y los payloads en cadenas del tamaño exacto,
+ * o se describe como una lista de vistas para un envío scatter-gather.
+ * Las vistas apuntan a la solicitud base, que debe seguir siendo válida.
+ */
+class RequestTemplate {
+public:
+    /**
+     * Campos de la solicitud en los que puede haber puntos de inserción
+     */
+    enum class Field {
+        URL,
+        HEADERS,
+        BODY
+    };
+
+    /**
+     * Constructor: localiza los puntos de inserción en la solicitud base
+     * Los puntos que no se encuentran o que se solapan con uno anterior se ignoran
+     * @param baseRequest Solicitud base
+     * @param points Puntos de inserción
+     */
+    RequestTemplate(const HttpRequest& baseRequest, const std::vector<InsertionPoint>& points);
+
+    /**
+     * Obtiene el valor original de un punto de inserción en la solicitud base
+     * @param pointIndex Índice del punto de inserción
+     * @return Valor original (vacío si el punto no se localizó)
+     */
+    std::string_view originalValue(size_t pointIndex) const;
+
+    /**
+     * Obtiene los valores originales de todos los puntos de inserción
+     * Sirve de punto de partida para el vector de valores de build()
+     * @return Vector con un valor por punto de inserción
+     */
+    std::vector<std::string_view> originalValues() const;
+
+    /**
+     * Ensambla una solicitud
+     * @param values Valor de cada punto de inserción, indexado como los puntos
+     * @return Solicitud con los valores insertados
+     */
+    HttpRequest build(const std::vector<std::string_view>& values) const;
+
+    /**
+     * Calcula el tamaño de un campo ensamblado
+     * @param field Campo de la solicitud
+     * @param values Valor de cada punto de inserción
+     * @return Tamaño en bytes del campo
+     */
+    size_t fieldSize(Field field, const std::vector<std::string_view>& values) const;
+
+    /**
+     * Añade un campo ensamblado al final de una cadena
+     * @param field Campo de la solicitud
+     * @param values Valor de cada punto de inserción
+     * @param output Cadena de destino
+     */
+    void appendField(Field field, const std::vector<std::string_view>& values, std::string& output) const;
+
+    /**
+     * Añade las vistas que forman un campo, sin copiar ningún byte
+     * El resultado puede convertirse directamente en un iovec para writev()
+     * @param field Campo de la solicitud
+     * @param values Valor de cada punto de inserción
+     * @param output Vector de vistas de destino
+     */
+    void gatherField(Field field, const std::vector<std::string_view>& values,
+                     std::vector<std::string_view>& output) const;
+
+private:
+    // Fragmento de un campo: literal de la solicitud base o hueco de un punto de inserción
+    struct Segment {
+        std::string_view literal;
+        int pointIndex; // -1 para los fragmentos literales
+    };
+
+    // Posición de un punto de inserción dentro de un campo
+    struct Location {
+        Field field;
+        size_t start;
+        size_t end;
+        bool found;
+    };
+
+    const HttpRequest& m_baseRequest;
+
+    // Fragmentos de cada campo (URL, cabeceras, cuerpo)
+    std::vector<Segment> m_segments[3];
+
+    // Valor original de cada punto de inserción
+    std::vector<std::string_view> m_originalValues;
+
+    /**
+     * Localiza un punto de inserción en la solicitud base
+     * @param point Punto de inserción
+     * @return Campo y rango del valor a sustituir
+     */
+    Location locate(const InsertionPoint& point) const;
+
+    const std::string& fieldText(Field field) const;
+    const std::vector<Segment>& segments(Field field) const;
+};
+
+} // namespace Tools::BurpLike
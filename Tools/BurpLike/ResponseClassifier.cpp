@@ -0,0 +1,135 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación del clasificador incremental de respuestas
+ */
+
+#include "ResponseClassifier.h"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+
+namespace Tools::BurpLike {
+
+ResponseClassifier::ResponseClassifier(int maxHammingDistance) :
+    m_maxHammingDistance(maxHammingDistance) {
+}
+
+size_t ResponseClassifier::classify(const HttpResponse& response, size_t resultIndex) {
+    // El SimHash se calcula fuera del bloqueo
+    size_t wordCount = 0;
+    uint64_t hash = simHash(response.body, wordCount);
+    size_t length = response.body.size();
+    BucketKey key(response.statusCode, band(length), band(wordCount));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Buscar un grupo cercano entre los que comparten clave
+    auto& candidates = m_buckets[key];
+    for (size_t id : candidates) {
+        ResponseCluster& cluster = m_clusters[id];
+        if (std::popcount(cluster.simHash ^ hash) <= m_maxHammingDistance) {
+            cluster.count++;
+            cluster.minLength = std::min(cluster.minLength, length);
+            cluster.maxLength = std::max(cluster.maxLength, length);
+            return id;
+        }
+    }
+
+    // Ninguno es suficientemente parecido: crear un grupo nuevo
+    ResponseCluster cluster;
+    cluster.id = m_clusters.size();
+    cluster.statusCode = response.statusCode;
+    cluster.simHash = hash;
+    cluster.count = 1;
+    cluster.firstResult = resultIndex;
+    cluster.minLength = length;
+    cluster.maxLength = length;
+    cluster.wordCount = wordCount;
+
+    m_clusters.push_back(cluster);
+    candidates.push_back(cluster.id);
+    return cluster.id;
+}
+
+size_t ResponseClassifier::clusterCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_clusters.size();
+}
+
+std::vector<ResponseCluster> ResponseClassifier::clusters() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_clusters;
+}
+
+std::vector<ResponseCluster> ResponseClassifier::outliers(size_t maxCount) const {
+    std::vector<ResponseCluster> result;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& cluster : m_clusters) {
+            if (cluster.count <= maxCount) {
+                result.push_back(cluster);
+            }
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(),
+                     [](const ResponseCluster& a, const ResponseCluster& b) { return a.count < b.count; });
+    return result;
+}
+
+void ResponseClassifier::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_clusters.clear();
+    m_buckets.clear();
+}
+
+uint64_t ResponseClassifier::simHash(const std::string& text, size_t& wordCount) {
+    int weights[64] = {0};
+    wordCount = 0;
+
+    size_t position = 0;
+    while (position < text.size()) {
+        // Saltar hasta el inicio de la siguiente palabra
+        while (position < text.size() && !std::isalnum(static_cast<unsigned char>(text[position]))) {
+            position++;
+        }
+        if (position >= text.size()) {
+            break;
+        }
+
+        // Hash FNV-1a de la palabra
+        uint64_t wordHash = 14695981039346656037ULL;
+        while (position < text.size() && std::isalnum(static_cast<unsigned char>(text[position]))) {
+            wordHash ^= static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(text[position])));
+            wordHash *= 1099511628211ULL;
+            position++;
+        }
+        wordCount++;
+
+        for (int bit = 0; bit < 64; bit++) {
+            weights[bit] += ((wordHash >> bit) & 1) ? 1 : -1;
+        }
+    }
+
+    uint64_t hash = 0;
+    for (int bit = 0; bit < 64; bit++) {
+        if (weights[bit] > 0) {
+            hash |= (1ULL << bit);
+        }
+    }
+    return hash;
+}
+
+int ResponseClassifier::band(size_t value) {
+    // Valores pequeños exactos; a partir de 16, 8 bandas por potencia de dos
+    if (value < 16) {
+        return static_cast<int>(value);
+    }
+
+    int msb = static_cast<int>(std::bit_width(value)) - 1;
+    int mantissa = static_cast<int>((value >> (msb - 3)) & 7);
+    return 16 + (msb - 4) * 8 + mantissa;
+}
+
+} // namespace Tools::BurpLike
@@ -0,0 +1,111 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Clasificador incremental de respuestas de Intruder
+ * Agrupa las respuestas parecidas a medida que llegan para que las anómalas destaquen
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <cstdint>
+#include "Repeater.h"
+
+namespace Tools::BurpLike {
+
+/**
+ * Grupo de respuestas parecidas
+ */
+struct ResponseCluster {
+    size_t id;                  // Identificador del grupo
+    int statusCode;             // Código de estado común
+    uint64_t simHash;           // SimHash de la primera respuesta del grupo
+    size_t count;               // Número de respuestas del grupo
+    size_t firstResult;         // Índice del primer resultado del grupo en el ResultStore
+    size_t minLength;           // Longitud mínima del cuerpo en el grupo
+    size_t maxLength;           // Longitud máxima del cuerpo en el grupo
+    size_t wordCount;           // Número de palabras de la primera respuesta
+};
+
+/**
+ * Clasificador incremental de respuestas
+ * Cada respuesta se asigna a un grupo según su código de estado, su banda de
+ * longitud, su banda de número de palabras y el SimHash de su cuerpo. Solo se
+ * compara con los grupos que comparten las tres primeras claves, así que el
+ * coste por respuesta no depende del número de respuestas ya vistas.
+ * Es seguro usarlo desde varios hilos.
+ */
+class ResponseClassifier {
+public:
+    /**
+     * Constructor
+     * @param maxHammingDistance Bits de SimHash en los que pueden diferir dos respuestas del mismo grupo
+     */
+    explicit ResponseClassifier(int maxHammingDistance = 10);
+
+    /**
+     * Clasifica una respuesta
+     * @param response Respuesta a clasificar
+     * @param resultIndex Índice del resultado en el ResultStore
+     * @return Identificador del grupo asignado
+     */
+    size_t classify(const HttpResponse& response, size_t resultIndex);
+
+    /**
+     * Obtiene el número de grupos
+     * @return Número de grupos
+     */
+    size_t clusterCount() const;
+
+    /**
+     * Obtiene todos los grupos
+     * @return Copia de los grupos, ordenados por identificador
+     */
+    std::vector<ResponseCluster> clusters() const;
+
+    /**
+     * Obtiene los grupos con pocas respuestas, candidatos a ser anómalos
+     * @param maxCount Número máximo de respuestas de un grupo para considerarlo anómalo
+     * @return Grupos anómalos, de menor a mayor número de respuestas
+     */
+    std::vector<ResponseCluster> outliers(size_t maxCount = 1) const;
+
+    /**
+     * Elimina todos los grupos
+     */
+    void clear();
+
+    /**
+     * Calcula el SimHash de 64 bits de un texto a partir de sus palabras
+     * @param text Texto a resumir
+     * @param wordCount Número de palabras encontradas (salida)
+     * @return SimHash del texto
+     */
+    static uint64_t simHash(const std::string& text, size_t& wordCount);
+
+private:
+    // Clave de búsqueda: código de estado, banda de longitud y banda de palabras
+    using BucketKey = std::tuple<int, int, int>;
+
+    mutable std::mutex m_mutex;
+    int m_maxHammingDistance;
+
+    // Grupos indexados por identificador
+    std::vector<ResponseCluster> m_clusters;
+
+    // Identificadores de los grupos de cada clave
+    std::map<BucketKey, std::vector<size_t>> m_buckets;
+
+    /**
+     * Calcula la banda logarítmica de un valor (aprox. 12,5% de anchura)
+     * @param value Valor a clasificar
+     * @return Índice de la banda
+     */
+    static int band(size_t value);
+};
+
+} // namespace Tools::BurpLike
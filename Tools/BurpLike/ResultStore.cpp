@@ -0,0 +1,343 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación del almacén de resultados en disco
+ */
+
+#include "ResultStore.h"
+#include "Repeater.h"
+#include "../../Utils/Logging/Logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Tools::BurpLike {
+
+namespace {
+
+// Campos de texto de cada registro, en orden de escritura
+constexpr int RECORD_STRINGS = 7;
+
+void appendUint32(std::string& buffer, uint32_t value) {
+    char bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+    buffer.append(bytes, sizeof(value));
+}
+
+void appendUint64(std::string& buffer, uint64_t value) {
+    char bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+    buffer.append(bytes, sizeof(value));
+}
+
+uint32_t readUint32(const char*& cursor) {
+    uint32_t value;
+    std::memcpy(&value, cursor, sizeof(value));
+    cursor += sizeof(value);
+    return value;
+}
+
+uint64_t readUint64(const char*& cursor) {
+    uint64_t value;
+    std::memcpy(&value, cursor, sizeof(value));
+    cursor += sizeof(value);
+    return value;
+}
+
+// Crea un archivo temporal anónimo: se desvincula en cuanto se crea
+int createTemporaryFile(const char* prefix) {
+    const char* tmpDir = std::getenv("TMPDIR");
+    std::string pattern = std::string(tmpDir ? tmpDir : "/tmp") + "/" + prefix + "-XXXXXX";
+    int fd = mkstemp(pattern.data());
+    if (fd >= 0) {
+        unlink(pattern.c_str());
+    }
+    return fd;
+}
+
+bool writeAll(int fd, const char* data, size_t size, uint64_t offset) {
+    size_t written = 0;
+    while (written < size) {
+        ssize_t result = pwrite(fd, data + written, size - written, static_cast<off_t>(offset + written));
+        if (result <= 0) {
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+bool readAll(int fd, char* data, size_t size, uint64_t offset) {
+    size_t readBytes = 0;
+    while (readBytes < size) {
+        ssize_t result = pread(fd, data + readBytes, size - readBytes, static_cast<off_t>(offset + readBytes));
+        if (result <= 0) {
+            return false;
+        }
+        readBytes += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+} // namespace
+
+ResultStore::ResultStore(const std::string& logPath) :
+    m_fd(-1),
+    m_indexFd(-1),
+    m_fileSize(0),
+    m_count(0) {
+
+    if (logPath.empty()) {
+        m_fd = createTemporaryFile("blackwidow-results");
+    } else {
+        m_fd = open(logPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    }
+
+    if (m_fd < 0) {
+        Utils::Logging::Logger::error("ResultStore: No se pudo crear el archivo de resultados" +
+                                    (logPath.empty() ? std::string() : ": " + logPath));
+        return;
+    }
+
+    // El índice solo tiene sentido junto al registro abierto, así que
+    // siempre es temporal
+    m_indexFd = createTemporaryFile("blackwidow-index");
+    if (m_indexFd < 0) {
+        Utils::Logging::Logger::error("ResultStore: No se pudo crear el índice de resultados");
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+ResultStore::~ResultStore() {
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+    if (m_indexFd >= 0) {
+        close(m_indexFd);
+    }
+}
+
+long long ResultStore::append(const HttpRequest& request, const HttpResponse& response) {
+    const std::string* fields[RECORD_STRINGS] = {
+        &request.method, &request.url, &request.headers, &request.body,
+        &response.statusText, &response.headers, &response.body
+    };
+
+    // Serializar el registro completo antes de tomar el bloqueo
+    size_t recordSize = sizeof(uint32_t) * 2 + sizeof(uint64_t) * RECORD_STRINGS;
+    for (const auto* field : fields) {
+        recordSize += field->size();
+    }
+
+    std::string record;
+    record.reserve(recordSize);
+    appendUint32(record, static_cast<uint32_t>(response.statusCode));
+    appendUint32(record, static_cast<uint32_t>(response.timeMs));
+    for (const auto* field : fields) {
+        appendUint64(record, field->size());
+    }
+    for (const auto* field : fields) {
+        record += *field;
+    }
+
+    ResultSummary summary;
+    summary.statusCode = response.statusCode;
+    summary.timeMs = response.timeMs;
+    summary.length = response.body.size();
+    summary.bodyHash = hashBody(response.body);
+    summary.recordSize = record.size();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fd < 0) {
+        return -1;
+    }
+
+    // La última página llena se escribe en el índice antes de empezar otra
+    if (m_tail.size() == PAGE_SIZE && !flushTail()) {
+        Utils::Logging::Logger::error("ResultStore: Error al escribir en el índice de resultados");
+        return -1;
+    }
+
+    summary.offset = m_fileSize;
+    if (!writeAll(m_fd, record.data(), record.size(), m_fileSize)) {
+        Utils::Logging::Logger::error("ResultStore: Error al escribir en el archivo de resultados");
+        return -1;
+    }
+
+    m_fileSize += record.size();
+    m_tail.push_back(summary);
+    return static_cast<long long>(m_count++);
+}
+
+size_t ResultStore::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_count;
+}
+
+ResultSummary ResultStore::summary(size_t index) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const ResultSummary* found = findSummary(index);
+    if (!found) {
+        throw std::out_of_range("ResultStore: resultado no disponible");
+    }
+    return *found;
+}
+
+std::vector<ResultSummary> ResultStore::page(size_t offset, size_t count) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (offset >= m_count) {
+        return {};
+    }
+
+    size_t end = offset + std::min(count, m_count - offset);
+    std::vector<ResultSummary> result;
+    result.reserve(end - offset);
+    for (size_t i = offset; i < end; i++) {
+        const ResultSummary* found = findSummary(i);
+        if (!found) {
+            break;
+        }
+        result.push_back(*found);
+    }
+    return result;
+}
+
+void ResultStore::forEach(const std::function<bool(size_t, const ResultSummary&)>& visitor) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Las páginas del índice se leen en un búfer propio para no vaciar la caché
+    size_t firstTail = m_count - m_tail.size();
+    std::vector<ResultSummary> buffer;
+    for (size_t page = 0; page * PAGE_SIZE < firstTail; page++) {
+        if (!readPage(page, buffer)) {
+            return;
+        }
+        for (size_t i = 0; i < buffer.size(); i++) {
+            if (!visitor(page * PAGE_SIZE + i, buffer[i])) {
+                return;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < m_tail.size(); i++) {
+        if (!visitor(firstTail + i, m_tail[i])) {
+            return;
+        }
+    }
+}
+
+bool ResultStore::loadResult(size_t index, HttpRequest& request, HttpResponse& response) const {
+    // El bloqueo compartido impide que clear() vacíe el registro durante la
+    // lectura; las escrituras de append() no tocan los registros existentes
+    std::shared_lock<std::shared_mutex> fileLock(m_fileMutex);
+
+    ResultSummary summary;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const ResultSummary* found = m_fd >= 0 ? findSummary(index) : nullptr;
+        if (!found) {
+            return false;
+        }
+        summary = *found;
+    }
+
+    std::string record(summary.recordSize, '\0');
+    if (record.size() < sizeof(uint32_t) * 2 + sizeof(uint64_t) * RECORD_STRINGS ||
+        !readAll(m_fd, record.data(), record.size(), summary.offset)) {
+        return false;
+    }
+
+    const char* cursor = record.data();
+    response.statusCode = static_cast<int>(readUint32(cursor));
+    response.timeMs = static_cast<int>(readUint32(cursor));
+
+    uint64_t lengths[RECORD_STRINGS];
+    for (auto& length : lengths) {
+        length = readUint64(cursor);
+    }
+
+    std::string* fields[RECORD_STRINGS] = {
+        &request.method, &request.url, &request.headers, &request.body,
+        &response.statusText, &response.headers, &response.body
+    };
+    for (int i = 0; i < RECORD_STRINGS; i++) {
+        fields[i]->assign(cursor, lengths[i]);
+        cursor += lengths[i];
+    }
+
+    return true;
+}
+
+void ResultStore::clear() {
+    std::unique_lock<std::shared_mutex> fileLock(m_fileMutex);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tail.clear();
+    m_tail.shrink_to_fit();
+    m_pageCache.clear();
+    m_count = 0;
+    m_fileSize = 0;
+    if ((m_fd >= 0 && ftruncate(m_fd, 0) != 0) || (m_indexFd >= 0 && ftruncate(m_indexFd, 0) != 0)) {
+        Utils::Logging::Logger::warning("ResultStore: No se pudo vaciar el archivo de resultados");
+    }
+}
+
+const ResultSummary* ResultStore::findSummary(size_t index) const {
+    if (index >= m_count) {
+        return nullptr;
+    }
+
+    size_t firstTail = m_count - m_tail.size();
+    if (index >= firstTail) {
+        return &m_tail[index - firstTail];
+    }
+
+    size_t page = index / PAGE_SIZE;
+    for (const auto& cached : m_pageCache) {
+        if (cached.page == page) {
+            return &cached.summaries[index % PAGE_SIZE];
+        }
+    }
+
+    // Cargar la página descartando la más antigua si la caché está llena
+    CachedPage cached{page, {}};
+    if (!readPage(page, cached.summaries)) {
+        return nullptr;
+    }
+    if (m_pageCache.size() == MAX_CACHED_PAGES) {
+        m_pageCache.pop_front();
+    }
+    m_pageCache.push_back(std::move(cached));
+    return &m_pageCache.back().summaries[index % PAGE_SIZE];
+}
+
+bool ResultStore::readPage(size_t page, std::vector<ResultSummary>& summaries) const {
+    // Solo se escriben páginas completas en el índice
+    summaries.resize(PAGE_SIZE);
+    return readAll(m_indexFd, reinterpret_cast<char*>(summaries.data()), PAGE_SIZE * sizeof(ResultSummary),
+                   static_cast<uint64_t>(page) * PAGE_SIZE * sizeof(ResultSummary));
+}
+
+bool ResultStore::flushTail() {
+    size_t page = (m_count - m_tail.size()) / PAGE_SIZE;
+    if (!writeAll(m_indexFd, reinterpret_cast<const char*>(m_tail.data()), m_tail.size() * sizeof(ResultSummary),
+                  static_cast<uint64_t>(page) * PAGE_SIZE * sizeof(ResultSummary))) {
+        return false;
+    }
+    m_tail.clear();
+    return true;
+}
+
+uint64_t ResultStore::hashBody(const std::string& data) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace Tools::BurpLike
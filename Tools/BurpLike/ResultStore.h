@@ -0,0 +1,166 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Almacén de resultados de Intruder y Repeater
+ * Guarda las solicitudes y respuestas completas en un registro en disco y
+ * sus resúmenes compactos en un índice en disco, del que solo se mantienen
+ * en memoria unas pocas páginas
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <deque>
+#include <cstdint>
+
+namespace Tools::BurpLike {
+
+struct HttpRequest;
+struct HttpResponse;
+
+/**
+ * Resumen en memoria de un resultado almacenado
+ */
+struct ResultSummary {
+    int statusCode;          // Código de estado HTTP
+    int timeMs;              // Tiempo de respuesta en milisegundos
+    uint64_t length;         // Longitud del cuerpo de la respuesta
+    uint64_t bodyHash;       // Hash FNV-1a del cuerpo de la respuesta
+    uint64_t offset;         // Posición del registro completo en el archivo
+    uint64_t recordSize;     // Tamaño del registro completo en el archivo
+};
+
+/**
+ * Registro de resultados de solo escritura al final, respaldado por un archivo
+ * Los cuerpos se leen del disco solo cuando se piden con loadResult().
+ * Los resúmenes se escriben por páginas en un índice en disco; la memoria
+ * usada está acotada por MAX_CACHED_PAGES independientemente del número
+ * de resultados. Es seguro usarlo desde varios hilos.
+ */
+class ResultStore {
+public:
+    /**
+     * Constructor
+     * @param logPath Ruta del archivo de registro; si está vacía se usa un
+     *                archivo temporal anónimo que se borra al cerrar
+     */
+    explicit ResultStore(const std::string& logPath = "");
+
+    /**
+     * Destructor
+     */
+    ~ResultStore();
+
+    ResultStore(const ResultStore&) = delete;
+    ResultStore& operator=(const ResultStore&) = delete;
+
+    /**
+     * Añade un resultado al registro
+     * @param request Solicitud enviada
+     * @param response Respuesta recibida
+     * @return Índice del resultado, o -1 si no se pudo escribir
+     */
+    long long append(const HttpRequest& request, const HttpResponse& response);
+
+    /**
+     * Obtiene el número de resultados almacenados
+     * @return Número de resultados
+     */
+    size_t size() const;
+
+    /**
+     * Obtiene el resumen de un resultado
+     * @param index Índice del resultado
+     * @return Resumen del resultado
+     * @throws std::out_of_range si el índice no existe o no se pudo leer
+     */
+    ResultSummary summary(size_t index) const;
+
+    /**
+     * Obtiene una página de resúmenes
+     * @param offset Índice del primer resultado
+     * @param count Número máximo de resultados
+     * @return Resúmenes de la página
+     */
+    std::vector<ResultSummary> page(size_t offset, size_t count) const;
+
+    /**
+     * Recorre los resúmenes sin copiarlos
+     * El registro permanece bloqueado durante el recorrido
+     * @param visitor Función a llamar por cada resultado; devuelve false para parar
+     */
+    void forEach(const std::function<bool(size_t, const ResultSummary&)>& visitor) const;
+
+    /**
+     * Carga del disco la solicitud y la respuesta completas de un resultado
+     * @param index Índice del resultado
+     * @param request Solicitud almacenada
+     * @param response Respuesta almacenada
+     * @return true si se cargó correctamente, false en caso contrario
+     */
+    bool loadResult(size_t index, HttpRequest& request, HttpResponse& response) const;
+
+    /**
+     * Elimina todos los resultados y vacía el archivo de registro
+     */
+    void clear();
+
+    /**
+     * Calcula el hash usado en los resúmenes
+     * @param data Datos a resumir
+     * @return Hash FNV-1a de 64 bits
+     */
+    static uint64_t hashBody(const std::string& data);
+
+    // Resúmenes por página del índice
+    static constexpr size_t PAGE_SIZE = 4096;
+
+    // Páginas del índice que se conservan en memoria además de la última
+    static constexpr size_t MAX_CACHED_PAGES = 16;
+
+private:
+    // Página del índice cargada en memoria
+    struct CachedPage {
+        size_t page;
+        std::vector<ResultSummary> summaries;
+    };
+
+    // Obtiene un resumen con m_mutex tomado; nullptr si no se pudo leer
+    const ResultSummary* findSummary(size_t index) const;
+
+    // Lee una página completa del índice con m_mutex tomado
+    bool readPage(size_t page, std::vector<ResultSummary>& summaries) const;
+
+    // Escribe la última página en el índice con m_mutex tomado
+    bool flushTail();
+
+    // Protege el contenido del registro frente a clear() mientras se lee
+    // sin m_mutex; se toma siempre antes que m_mutex
+    mutable std::shared_mutex m_fileMutex;
+
+    mutable std::mutex m_mutex;
+
+    // Descriptor del archivo de registro
+    int m_fd;
+
+    // Descriptor del índice de resúmenes (archivo temporal anónimo)
+    int m_indexFd;
+
+    // Tamaño actual del archivo de registro
+    uint64_t m_fileSize;
+
+    // Número de resultados almacenados
+    size_t m_count;
+
+    // Resúmenes de la última página, todavía sin escribir en el índice
+    std::vector<ResultSummary> m_tail;
+
+    // Páginas leídas del índice, de la más antigua a la más reciente
+    mutable std::deque<CachedPage> m_pageCache;
+};
+
+} // namespace Tools::BurpLike
@@ -0,0 +1,53 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Implementación de las funciones de texto compartidas
+ */
+
+#include "StringUtils.h"
+#include <cstdint>
+
+namespace Utils::Text {
+
+std::string toLower(std::string_view text) {
+    std::string result(text);
+    for (char& c : result) {
+        c = toLower(c);
+    }
+    return result;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+    return text;
+}
+
+const std::string* findHeader(const std::vector<std::pair<std::string, std::string>>& headers, std::string_view name) {
+    for (const auto& header : headers) {
+        if (equalsIgnoreCase(header.first, name)) {
+            return &header.second;
+        }
+    }
+    return nullptr;
+}
+
+std::string base64Encode(const std::string& input) {
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string output;
+    output.reserve((input.size() + 2) / 3 * 4);
+
+    for (size_t i = 0; i < input.size(); i += 3) {
+        uint32_t chunk = static_cast<unsigned char>(input[i]) << 16;
+        if (i + 1 < input.size()) chunk |= static_cast<unsigned char>(input[i + 1]) << 8;
+        if (i + 2 < input.size()) chunk |= static_cast<unsigned char>(input[i + 2]);
+
+        output += table[(chunk >> 18) & 0x3F];
+        output += table[(chunk >> 12) & 0x3F];
+        output += i + 1 < input.size() ? table[(chunk >> 6) & 0x3F] : '=';
+        output += i + 2 < input.size() ? table[chunk & 0x3F] : '=';
+    }
+    return output;
+}
+
+} // namespace Utils::Text
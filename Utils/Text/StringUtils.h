@@ -0,0 +1,69 @@
+/**
+ * BlackWidow Browser - Navegador orientado al bugbounty y hacking ético
+ *
+ * Funciones de texto compartidas por los distintos módulos
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Utils::Text {
+
+/**
+ * Pasa un carácter ASCII a minúsculas sin depender del locale
+ * @param c Carácter
+ * @return Carácter en minúsculas
+ */
+inline char toLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+/**
+ * Compara dos textos sin distinguir mayúsculas de minúsculas ASCII
+ * Los nombres de cabeceras HTTP, de tokens y de etiquetas HTML son ASCII.
+ * @param a Primer texto
+ * @param b Segundo texto
+ * @return true si son iguales
+ */
+inline bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (toLower(a[i]) != toLower(b[i])) return false;
+    }
+    return true;
+}
+
+/**
+ * Pasa un texto ASCII a minúsculas
+ * @param text Texto
+ * @return Copia en minúsculas
+ */
+std::string toLower(std::string_view text);
+
+/**
+ * Quita los espacios y tabuladores de los extremos (espacio opcional de HTTP)
+ * @param text Texto
+ * @return Vista sin los espacios de los extremos
+ */
+std::string_view trim(std::string_view text);
+
+/**
+ * Busca una cabecera sin distinguir mayúsculas en el nombre
+ * @param headers Cabeceras
+ * @param name Nombre de la cabecera
+ * @return Valor de la primera cabecera con ese nombre, o nullptr si no está
+ */
+const std::string* findHeader(const std::vector<std::pair<std::string, std::string>>& headers, std::string_view name);
+
+/**
+ * Codifica datos en Base64 (alfabeto estándar, con relleno)
+ * @param input Datos a codificar
+ * @return Texto Base64
+ */
+std::string base64Encode(const std::string& input);
+
+} // namespace Utils::Text